@@ -10,6 +10,7 @@
 #include "MtlLoader.hpp"
 #include "ObjLoader.hpp"
 #include "ParticleSystemLoader.hpp"
+#include "SdfLoader.hpp"
 #include "SpriteLoader.hpp"
 #include "TtfLoader.hpp"
 #include "VorbisLoader.hpp"
@@ -30,6 +31,7 @@ namespace ouzel::assets
         addLoader(std::make_unique<MtlLoader>(*this));
         addLoader(std::make_unique<ObjLoader>(*this));
         addLoader(std::make_unique<ParticleSystemLoader>(*this));
+        addLoader(std::make_unique<SdfLoader>(*this));
         addLoader(std::make_unique<SpriteLoader>(*this));
         addLoader(std::make_unique<TtfLoader>(*this));
         addLoader(std::make_unique<VorbisLoader>(*this));
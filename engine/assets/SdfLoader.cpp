@@ -0,0 +1,31 @@
+// Ouzel by Elviss Strazdins
+
+#include "SdfLoader.hpp"
+#include "Bundle.hpp"
+#include "../gui/SdfFont.hpp"
+
+namespace ouzel::assets
+{
+    SdfLoader::SdfLoader(Cache& initCache):
+        Loader(initCache, Type::font)
+    {
+    }
+
+    bool SdfLoader::loadAsset(Bundle& bundle,
+                              const std::string& name,
+                              const std::vector<std::byte>& data,
+                              bool mipmaps)
+    {
+        try
+        {
+            auto font = std::make_unique<gui::SdfFont>(data, mipmaps);
+            bundle.setFont(name, std::move(font));
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,21 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_ASSETS_SDFLOADER_HPP
+#define OUZEL_ASSETS_SDFLOADER_HPP
+
+#include "Loader.hpp"
+
+namespace ouzel::assets
+{
+    class SdfLoader final: public Loader
+    {
+    public:
+        explicit SdfLoader(Cache& initCache);
+        bool loadAsset(Bundle& bundle,
+                       const std::string& name,
+                       const std::vector<std::byte>& data,
+                       bool mipmaps = true) final;
+    };
+}
+
+#endif // OUZEL_ASSETS_SDFLOADER_HPP
@@ -136,7 +136,8 @@ namespace ouzel::audio
         device(createAudioDevice(driver,
                                  std::bind(&Audio::getSamples, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4),
                                  settings)),
-        mixer(device->getBufferSize(), device->getChannels(),
+        resampleQuality(settings.resampleQuality),
+        mixer(device->getBufferSize(), device->getChannels(), device->getSampleRate(), settings.latency,
               std::bind(&Audio::eventCallback, this, std::placeholders::_1)),
         masterMix(*this),
         rootNode(*this) // mixer.getRootObjectId()
@@ -145,36 +146,67 @@ namespace ouzel::audio
         device->start();
     }
 
+    Audio::~Audio()
+    {
+        // the device must not ask for samples after the mixer is destroyed
+        device->stop();
+    }
+
     void Audio::update()
     {
         // TODO: handle events from the audio device
 
-        mixer.submitCommandBuffer(std::move(commandBuffer));
-        commandBuffer = mixer::CommandBuffer();
+        // if the mixer has not caught up, the commands are submitted with the next update
+        mixer.submitCommandBuffer(commandBuffer);
     }
 
     void Audio::deleteObject(mixer::Mixer::ObjectId objectId)
     {
+        dataObjects.erase(objectId);
         addCommand(std::make_unique<mixer::DeleteObjectCommand>(objectId));
     }
 
+    mixer::Mixer::ObjectId Audio::initObject(std::unique_ptr<mixer::Source> source)
+    {
+        const auto objectId = mixer.getObjectId();
+        addCommand(std::make_unique<mixer::InitObjectCommand>(objectId, std::make_unique<mixer::Object>(std::move(source))));
+        return objectId;
+    }
+
     mixer::Mixer::ObjectId Audio::initBus()
     {
         const auto busId = mixer.getObjectId();
-        addCommand(std::make_unique<mixer::InitBusCommand>(busId));
+        addCommand(std::make_unique<mixer::InitBusCommand>(busId, std::make_unique<mixer::Bus>(device->getBufferSize(),
+                                                                                                device->getChannels())));
         return busId;
     }
 
     mixer::Mixer::ObjectId Audio::initStream(mixer::Mixer::ObjectId sourceId)
     {
+        const auto i = dataObjects.find(sourceId);
+        if (i == dataObjects.end())
+            throw std::runtime_error("Invalid audio data");
+
+        mixer::Data& data = *i->second;
+        auto stream = data.createStream();
+
+        // the resampler allocates its buffers here, so that the mixer does not allocate them
+        if (data.getSampleRate() != device->getSampleRate())
+            stream->setResampler(mixer::Resampler(resampleQuality,
+                                                  data.getChannels(),
+                                                  data.getSampleRate(),
+                                                  device->getSampleRate(),
+                                                  device->getBufferSize()));
+
         const auto streamId = mixer.getObjectId();
-        addCommand(std::make_unique<mixer::InitStreamCommand>(streamId, sourceId));
+        addCommand(std::make_unique<mixer::InitStreamCommand>(streamId, std::move(stream)));
         return streamId;
     }
 
     mixer::Mixer::ObjectId Audio::initData(std::unique_ptr<mixer::Data> data)
     {
         const auto dataId = mixer.getObjectId();
+        dataObjects[dataId] = data.get();
         addCommand(std::make_unique<mixer::InitDataCommand>(dataId, std::move(data)));
         return dataId;
     }
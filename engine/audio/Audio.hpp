@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include "AudioDevice.hpp"
 #include "Driver.hpp"
@@ -27,6 +28,13 @@ namespace ouzel::audio
     {
     public:
         Audio(Driver driver, const Settings& settings);
+        ~Audio();
+
+        Audio(const Audio&) = delete;
+        Audio& operator=(const Audio&) = delete;
+
+        Audio(Audio&&) = delete;
+        Audio& operator=(Audio&&) = delete;
 
         static Driver getDriver(const std::string& driver);
         static std::set<Driver> getAvailableAudioDrivers();
@@ -43,6 +51,7 @@ namespace ouzel::audio
         }
 
         void deleteObject(mixer::Mixer::ObjectId objectId);
+        mixer::Mixer::ObjectId initObject(std::unique_ptr<mixer::Source> source);
         mixer::Mixer::ObjectId initBus();
         mixer::Mixer::ObjectId initStream(mixer::Mixer::ObjectId sourceId);
         mixer::Mixer::ObjectId initData(std::unique_ptr<mixer::Data> data);
@@ -57,8 +66,13 @@ namespace ouzel::audio
         void eventCallback(const mixer::Mixer::Event& event);
 
         std::unique_ptr<AudioDevice> device;
+        mixer::Resampler::Quality resampleQuality;
         mixer::Mixer mixer;
         mixer::CommandBuffer commandBuffer;
+
+        // the streams are created on the game thread, so that the mixer does not allocate them
+        std::unordered_map<mixer::Mixer::ObjectId, mixer::Data*> dataObjects;
+
         Mix masterMix;
         Node rootNode;
     };
@@ -6,6 +6,7 @@
 #include <functional>
 #include <vector>
 #include "Driver.hpp"
+#include "SampleConverter.hpp"
 #include "SampleFormat.hpp"
 #include "Settings.hpp"
 
@@ -56,6 +57,7 @@ namespace ouzel::audio
     private:
         std::function<void(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate, std::vector<float>& samples)> dataGetter;
         std::vector<float> buffer;
+        SampleConverter sampleConverter;
     };
 }
 
@@ -16,7 +16,17 @@ namespace ouzel::audio
             {
                 child.parent = this;
                 children.push_back(&child);
-                audio.addCommand(std::make_unique<mixer::AddChildCommand>(objectId, child.objectId));
+
+                // the object on the mixer has the same children, so it gets storage for them when they
+                // outgrow the storage that was sent before
+                std::vector<mixer::Object*> storage;
+                if (children.size() > mixerChildCapacity)
+                {
+                    mixerChildCapacity = children.capacity();
+                    storage.reserve(mixerChildCapacity);
+                }
+
+                audio.addCommand(std::make_unique<mixer::AddChildCommand>(objectId, child.objectId, std::move(storage)));
             }
         }
     }
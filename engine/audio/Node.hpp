@@ -39,6 +39,7 @@ namespace ouzel::audio
         std::size_t objectId = 0;
         Node* parent = nullptr;
         std::vector<Node*> children;
+        std::size_t mixerChildCapacity = 0;
     };
 }
 
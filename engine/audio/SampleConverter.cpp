@@ -0,0 +1,354 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cmath>
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+#  include <arm_neon.h>
+#elif defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+#include "SampleConverter.hpp"
+#include "../utils/Utils.hpp"
+
+namespace ouzel::audio
+{
+    namespace
+    {
+        constexpr float int16Scale = 32767.0F;
+        constexpr float int24Scale = 8388607.0F;
+        constexpr float int32Scale = 2147483520.0F; // the largest float below 2^31, so that 1.0 does not overflow
+
+        struct Int24 final
+        {
+            std::uint8_t bytes[3]; // little-endian
+        };
+
+        static_assert(sizeof(Int24) == 3);
+
+        inline void storeInteger(std::int16_t* output, std::int32_t value) noexcept
+        {
+            *output = static_cast<std::int16_t>(value);
+        }
+
+        inline void storeInteger(Int24* output, std::int32_t value) noexcept
+        {
+            output->bytes[0] = static_cast<std::uint8_t>(value);
+            output->bytes[1] = static_cast<std::uint8_t>(value >> 8);
+            output->bytes[2] = static_cast<std::uint8_t>(value >> 16);
+        }
+
+        inline void storeInteger(std::int32_t* output, std::int32_t value) noexcept
+        {
+            *output = value;
+        }
+
+        template <class T>
+        inline void storeSample(T* output, float value) noexcept
+        {
+            storeInteger(output, static_cast<std::int32_t>(std::lrint(value)));
+        }
+
+        inline void storeSample(float* output, float value) noexcept
+        {
+            *output = value;
+        }
+
+        // xorshift32 mapped to [0, 1) through the mantissa, the same way as in the kernels
+        inline float getRandom(std::uint32_t& state) noexcept
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return bitCast<float>((state >> 9) | 0x3F800000U) - 1.0F;
+        }
+
+        // the kernels process a vector of frames of every channel at a time and the rest one by one,
+        // both round to the nearest integer
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+        using Float = float32x4_t;
+        constexpr std::uint32_t width = 4;
+        inline Float load(const float* data) noexcept { return vld1q_f32(data); }
+        inline void store(float* data, Float value) noexcept { vst1q_f32(data, value); }
+        inline Float set(float value) noexcept { return vdupq_n_f32(value); }
+        inline Float add(Float a, Float b) noexcept { return vaddq_f32(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return vmulq_f32(a, b); }
+        inline Float minimum(Float a, Float b) noexcept { return vminq_f32(a, b); }
+        inline Float maximum(Float a, Float b) noexcept { return vmaxq_f32(a, b); }
+        inline void storeInt32(std::int32_t* data, Float value) noexcept { vst1q_s32(data, vcvtnq_s32_f32(value)); }
+        inline void storeInt16(std::int16_t* data, Float a, Float b) noexcept
+        {
+            vst1q_s16(data, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b))));
+        }
+        inline void zip(Float a, Float b, Float& low, Float& high) noexcept
+        {
+            low = vzip1q_f32(a, b);
+            high = vzip2q_f32(a, b);
+        }
+        inline Float getRandom(uint32x4_t& state) noexcept
+        {
+            state = veorq_u32(state, vshlq_n_u32(state, 13));
+            state = veorq_u32(state, vshrq_n_u32(state, 17));
+            state = veorq_u32(state, vshlq_n_u32(state, 5));
+            return vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vshrq_n_u32(state, 9), vdupq_n_u32(0x3F800000U))), vdupq_n_f32(1.0F));
+        }
+        inline Float getNoise(std::uint32_t* randomState) noexcept
+        {
+            auto state = vld1q_u32(randomState);
+            const auto first = getRandom(state);
+            const auto second = getRandom(state);
+            vst1q_u32(randomState, state);
+            return vsubq_f32(first, second);
+        }
+#  define OUZEL_SAMPLE_SIMD
+#elif defined(__AVX2__)
+        using Float = __m256;
+        constexpr std::uint32_t width = 8;
+        inline Float load(const float* data) noexcept { return _mm256_loadu_ps(data); }
+        inline void store(float* data, Float value) noexcept { _mm256_storeu_ps(data, value); }
+        inline Float set(float value) noexcept { return _mm256_set1_ps(value); }
+        inline Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+        inline Float minimum(Float a, Float b) noexcept { return _mm256_min_ps(a, b); }
+        inline Float maximum(Float a, Float b) noexcept { return _mm256_max_ps(a, b); }
+        inline void storeInt32(std::int32_t* data, Float value) noexcept
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), _mm256_cvtps_epi32(value));
+        }
+        inline void storeInt16(std::int16_t* data, Float a, Float b) noexcept
+        {
+            // the packing works on 128-bit lanes, so the 64-bit quarters are put back in order
+            const auto packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+        inline void zip(Float a, Float b, Float& low, Float& high) noexcept
+        {
+            const auto lowLanes = _mm256_unpacklo_ps(a, b);
+            const auto highLanes = _mm256_unpackhi_ps(a, b);
+            low = _mm256_permute2f128_ps(lowLanes, highLanes, 0x20);
+            high = _mm256_permute2f128_ps(lowLanes, highLanes, 0x31);
+        }
+        inline Float getRandom(__m256i& state) noexcept
+        {
+            state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 13));
+            state = _mm256_xor_si256(state, _mm256_srli_epi32(state, 17));
+            state = _mm256_xor_si256(state, _mm256_slli_epi32(state, 5));
+            return _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_srli_epi32(state, 9), _mm256_set1_epi32(0x3F800000))),
+                                 _mm256_set1_ps(1.0F));
+        }
+        inline Float getNoise(std::uint32_t* randomState) noexcept
+        {
+            auto state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(randomState));
+            const auto first = getRandom(state);
+            const auto second = getRandom(state);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(randomState), state);
+            return _mm256_sub_ps(first, second);
+        }
+#  define OUZEL_SAMPLE_SIMD
+#elif defined(__SSE2__)
+        using Float = __m128;
+        constexpr std::uint32_t width = 4;
+        inline Float load(const float* data) noexcept { return _mm_loadu_ps(data); }
+        inline void store(float* data, Float value) noexcept { _mm_storeu_ps(data, value); }
+        inline Float set(float value) noexcept { return _mm_set1_ps(value); }
+        inline Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+        inline Float minimum(Float a, Float b) noexcept { return _mm_min_ps(a, b); }
+        inline Float maximum(Float a, Float b) noexcept { return _mm_max_ps(a, b); }
+        inline void storeInt32(std::int32_t* data, Float value) noexcept
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data), _mm_cvtps_epi32(value));
+        }
+        inline void storeInt16(std::int16_t* data, Float a, Float b) noexcept
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data), _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+        }
+        inline void zip(Float a, Float b, Float& low, Float& high) noexcept
+        {
+            low = _mm_unpacklo_ps(a, b);
+            high = _mm_unpackhi_ps(a, b);
+        }
+        inline Float getRandom(__m128i& state) noexcept
+        {
+            state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+            state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+            state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+            return _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(state, 9), _mm_set1_epi32(0x3F800000))),
+                              _mm_set1_ps(1.0F));
+        }
+        inline Float getNoise(std::uint32_t* randomState) noexcept
+        {
+            auto state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(randomState));
+            const auto first = getRandom(state);
+            const auto second = getRandom(state);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(randomState), state);
+            return _mm_sub_ps(first, second);
+        }
+#  define OUZEL_SAMPLE_SIMD
+#endif
+
+#if defined(OUZEL_SAMPLE_SIMD)
+        class Kernel final
+        {
+        public:
+            Kernel(float scale, bool initNoise, std::uint32_t* initRandomState) noexcept:
+                maximumValue{set(scale)},
+                minimumValue{set(-scale)},
+                noise{initNoise},
+                randomState{initRandomState}
+            {
+            }
+
+            // scales, dithers and clamps a vector of samples
+            Float process(const float* samples) const noexcept
+            {
+                auto value = multiply(load(samples), maximumValue);
+                if (noise) value = add(value, getNoise(randomState));
+                return minimum(maximum(value, minimumValue), maximumValue);
+            }
+
+        private:
+            Float maximumValue;
+            Float minimumValue;
+            bool noise;
+            std::uint32_t* randomState;
+        };
+
+        // stores two vectors of consecutive samples
+        inline void storeVectors(float* output, Float a, Float b) noexcept
+        {
+            store(output, a);
+            store(output + width, b);
+        }
+
+        inline void storeVectors(std::int32_t* output, Float a, Float b) noexcept
+        {
+            storeInt32(output, a);
+            storeInt32(output + width, b);
+        }
+
+        inline void storeVectors(std::int16_t* output, Float a, Float b) noexcept
+        {
+            storeInt16(output, a, b);
+        }
+
+        inline void storeVectors(Int24* output, Float a, Float b) noexcept
+        {
+            std::int32_t values[width * 2];
+            storeInt32(values, a);
+            storeInt32(values + width, b);
+            for (std::uint32_t i = 0; i < width * 2; ++i)
+                storeInteger(output + i, values[i]);
+        }
+
+        // stores a vector of samples stride samples apart
+        inline void scatter(float* output, std::uint32_t stride, Float value) noexcept
+        {
+            float values[width];
+            store(values, value);
+            for (std::uint32_t i = 0; i < width; ++i)
+                output[i * stride] = values[i];
+        }
+
+        template <class T>
+        inline void scatter(T* output, std::uint32_t stride, Float value) noexcept
+        {
+            std::int32_t values[width];
+            storeInt32(values, value);
+            for (std::uint32_t i = 0; i < width; ++i)
+                storeInteger(output + i * stride, values[i]);
+        }
+#endif
+
+        template <class T>
+        void convertSamples(const float* samples,
+                            std::uint32_t frames,
+                            std::uint32_t channels,
+                            float scale,
+                            bool noise,
+                            std::uint32_t* randomState,
+                            T* output) noexcept
+        {
+            std::uint32_t frame = 0;
+
+#if defined(OUZEL_SAMPLE_SIMD)
+            const Kernel kernel{scale, noise, randomState};
+
+            if (channels == 1)
+            {
+                for (; frame + width * 2 <= frames; frame += width * 2)
+                {
+                    const auto first = kernel.process(samples + frame);
+                    const auto second = kernel.process(samples + frame + width);
+                    storeVectors(output + frame, first, second);
+                }
+            }
+            else if (channels == 2)
+            {
+                const auto left = samples;
+                const auto right = samples + frames;
+
+                for (; frame + width <= frames; frame += width)
+                {
+                    Float low;
+                    Float high;
+                    zip(kernel.process(left + frame), kernel.process(right + frame), low, high);
+                    storeVectors(output + frame * 2, low, high);
+                }
+            }
+            else
+            {
+                for (; frame + width <= frames; frame += width)
+                    for (std::uint32_t channel = 0; channel < channels; ++channel)
+                        scatter(output + frame * channels + channel, channels,
+                                kernel.process(samples + channel * frames + frame));
+            }
+#endif
+
+            for (; frame < frames; ++frame)
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                {
+                    auto value = samples[channel * frames + frame] * scale;
+                    if (noise) value += getRandom(randomState[0]) - getRandom(randomState[0]);
+                    storeSample(output + frame * channels + channel, std::clamp(value, -scale, scale));
+                }
+        }
+    }
+
+    SampleConverter::SampleConverter(bool initDither) noexcept:
+        dither{initDither}
+    {
+        // xorshift needs a non-zero state, the odd multiplier keeps the lanes non-zero and apart
+        for (std::size_t i = 0; i < randomState.size(); ++i)
+            randomState[i] = 0x9E3779B9U * static_cast<std::uint32_t>(i + 1);
+    }
+
+    void SampleConverter::convert(const float* samples,
+                                  std::uint32_t frames,
+                                  std::uint32_t channels,
+                                  SampleFormat sampleFormat,
+                                  void* result) noexcept
+    {
+        switch (sampleFormat)
+        {
+            case SampleFormat::signedInt16:
+                convertSamples(samples, frames, channels, int16Scale, dither, randomState.data(),
+                               static_cast<std::int16_t*>(result));
+                break;
+            case SampleFormat::signedInt24:
+                convertSamples(samples, frames, channels, int24Scale, dither, randomState.data(),
+                               static_cast<Int24*>(result));
+                break;
+            case SampleFormat::signedInt32:
+                // one bit of noise is far below the precision of the float samples
+                convertSamples(samples, frames, channels, int32Scale, false, randomState.data(),
+                               static_cast<std::int32_t*>(result));
+                break;
+            case SampleFormat::float32:
+                convertSamples(samples, frames, channels, 1.0F, false, randomState.data(),
+                               static_cast<float*>(result));
+                break;
+        }
+    }
+}
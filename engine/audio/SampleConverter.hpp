@@ -0,0 +1,37 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_SAMPLECONVERTER_HPP
+#define OUZEL_AUDIO_SAMPLECONVERTER_HPP
+
+#include <array>
+#include <cstdint>
+#include "SampleFormat.hpp"
+
+namespace ouzel::audio
+{
+    // converts the planar float samples of the mixer to the interleaved samples of a device, clamping, scaling,
+    // dithering and interleaving them in a single pass with SSE2, AVX2 or NEON kernels where available
+    class SampleConverter final
+    {
+    public:
+        // the dither adds triangular noise of one least significant bit to the 16 and 24-bit samples
+        explicit SampleConverter(bool initDither = false) noexcept;
+
+        // the samples hold frames samples of every channel one after another,
+        // the result must have room for frames * channels * getSampleSize(sampleFormat) bytes
+        void convert(const float* samples,
+                     std::uint32_t frames,
+                     std::uint32_t channels,
+                     SampleFormat sampleFormat,
+                     void* result) noexcept;
+
+        auto isDithering() const noexcept { return dither; }
+        void setDither(bool newDither) noexcept { dither = newDither; }
+
+    private:
+        bool dither = false;
+        std::array<std::uint32_t, 8> randomState{}; // for every lane of the widest kernel
+    };
+}
+
+#endif // OUZEL_AUDIO_SAMPLECONVERTER_HPP
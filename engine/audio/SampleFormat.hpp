@@ -3,13 +3,30 @@
 #ifndef OUZEL_AUDIO_SAMPLEFORMAT_HPP
 #define OUZEL_AUDIO_SAMPLEFORMAT_HPP
 
+#include <cstddef>
+
 namespace ouzel::audio
 {
     enum class SampleFormat
     {
         signedInt16,
+        signedInt24, // packed in three bytes
+        signedInt32,
         float32
     };
+
+    constexpr std::size_t getSampleSize(SampleFormat sampleFormat) noexcept
+    {
+        switch (sampleFormat)
+        {
+            case SampleFormat::signedInt16: return 2;
+            case SampleFormat::signedInt24: return 3;
+            case SampleFormat::signedInt32: return 4;
+            case SampleFormat::float32: return 4;
+        }
+
+        return 0;
+    }
 }
 
 #endif // OUZEL_AUDIO_SAMPLEFORMAT_HPP
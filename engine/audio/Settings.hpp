@@ -4,7 +4,9 @@
 #define OUZEL_AUDIO_SETTINGS_HPP
 
 #include <cstdint>
+#include <string>
 #include "SampleFormat.hpp"
+#include "mixer/Resampler.hpp"
 
 namespace ouzel::audio
 {
@@ -14,7 +16,10 @@ namespace ouzel::audio
         std::uint32_t bufferSize = 512;
         std::uint32_t sampleRate = 44100;
         std::uint32_t channels = 0;
+        std::uint32_t latency = 0; // frames that the mixer renders ahead of the device, zero for three buffers
         SampleFormat sampleFormat = SampleFormat::float32;
+        bool dither = false; // adds noise to the 16 and 24-bit samples, so that the rounding error is not correlated with the signal
+        mixer::Resampler::Quality resampleQuality = mixer::Resampler::Quality::sinc16; // for the data with a different sample rate than the device
         std::string audioDevice;
     };
 }
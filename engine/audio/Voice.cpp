@@ -121,8 +121,7 @@ namespace ouzel::audio
 
         std::unique_ptr<mixer::Source> source = std::make_unique<VoiceSource>();
 
-        audio.addCommand(std::make_unique<mixer::InitObjectCommand>(audio.getMixer().getObjectId(),
-                                                                    std::move(source)));
+        audio.initObject(std::move(source));
     }
 
     Voice::Voice(Audio& initAudio, const Sound* initSound):
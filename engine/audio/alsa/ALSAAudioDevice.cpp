@@ -41,6 +41,20 @@ namespace ouzel::audio::alsa
 
             sampleFormat = SampleFormat::float32;
         }
+        else if (snd_pcm_hw_params_test_format(playbackHandle, hwParams, SND_PCM_FORMAT_S32_LE) == 0)
+        {
+            if (const auto result = snd_pcm_hw_params_set_format(playbackHandle, hwParams, SND_PCM_FORMAT_S32_LE); result != 0)
+                throw std::system_error(-result, std::system_category(), "Failed to set sample format");
+
+            sampleFormat = SampleFormat::signedInt32;
+        }
+        else if (snd_pcm_hw_params_test_format(playbackHandle, hwParams, SND_PCM_FORMAT_S24_3LE) == 0)
+        {
+            if (const auto result = snd_pcm_hw_params_set_format(playbackHandle, hwParams, SND_PCM_FORMAT_S24_3LE); result != 0)
+                throw std::system_error(-result, std::system_category(), "Failed to set sample format");
+
+            sampleFormat = SampleFormat::signedInt24;
+        }
         else if (snd_pcm_hw_params_test_format(playbackHandle, hwParams, SND_PCM_FORMAT_S16_LE) == 0)
         {
             if (const auto result = snd_pcm_hw_params_set_format(playbackHandle, hwParams, SND_PCM_FORMAT_S16_LE); result != 0)
@@ -0,0 +1,58 @@
+// Ouzel by Elviss Strazdins
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "AllocationGuard.hpp"
+
+#if OUZEL_ENABLE_AUDIO_ALLOCATION_CHECK
+namespace ouzel::audio::mixer
+{
+    namespace
+    {
+        thread_local unsigned int guardCount = 0;
+    }
+
+    AllocationGuard::AllocationGuard() noexcept
+    {
+        ++guardCount;
+    }
+
+    AllocationGuard::~AllocationGuard()
+    {
+        --guardCount;
+    }
+
+    static void checkAllocation() noexcept
+    {
+        if (guardCount)
+        {
+            std::fputs("Heap allocation while mixing audio\n", stderr);
+            std::abort();
+        }
+    }
+}
+
+// the array and the nothrow forms call these, the aligned forms are not checked
+void* operator new(std::size_t size)
+{
+    ouzel::audio::mixer::checkAllocation();
+
+    if (const auto result = std::malloc(size ? size : 1))
+        return result;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer) ouzel::audio::mixer::checkAllocation();
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    if (pointer) ouzel::audio::mixer::checkAllocation();
+    std::free(pointer);
+}
+#endif
@@ -0,0 +1,30 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_MIXER_ALLOCATIONGUARD_HPP
+#define OUZEL_AUDIO_MIXER_ALLOCATIONGUARD_HPP
+
+#include "../../core/Setup.h"
+
+namespace ouzel::audio::mixer
+{
+    // marks the scope in which the current thread must not allocate or free heap memory,
+    // with OUZEL_ENABLE_AUDIO_ALLOCATION_CHECK the global operator new and delete abort in it
+    class AllocationGuard final
+    {
+    public:
+#if OUZEL_ENABLE_AUDIO_ALLOCATION_CHECK
+        AllocationGuard() noexcept;
+        ~AllocationGuard();
+#else
+        AllocationGuard() noexcept {}
+#endif
+
+        AllocationGuard(const AllocationGuard&) = delete;
+        AllocationGuard& operator=(const AllocationGuard&) = delete;
+
+        AllocationGuard(AllocationGuard&&) = delete;
+        AllocationGuard& operator=(AllocationGuard&&) = delete;
+    };
+}
+
+#endif // OUZEL_AUDIO_MIXER_ALLOCATIONGUARD_HPP
@@ -16,7 +16,9 @@ namespace ouzel::audio::mixer
         friend Processor;
         friend Stream;
     public:
-        Bus() noexcept {}
+        // the scratch buffers are allocated up front for at most maxFrames frames per call to generateSamples,
+        // so that the mixing does not allocate on the audio thread
+        Bus(std::uint32_t initMaxFrames, std::uint32_t channels);
         ~Bus() override;
         Bus(const Bus&) = delete;
         Bus& operator=(const Bus&) = delete;
@@ -24,6 +26,8 @@ namespace ouzel::audio::mixer
         Bus(Bus&&) = delete;
         Bus& operator=(Bus&&) = delete;
 
+        void detach() noexcept override;
+
         void setOutput(Bus* newOutput);
 
         void generateSamples(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
@@ -31,14 +35,15 @@ namespace ouzel::audio::mixer
                              std::vector<float>& samples);
 
         void addProcessor(Processor* processor);
-        void removeProcessor(Processor* processor);
+        void removeProcessor(Processor* processor) noexcept;
 
     private:
         void addInput(Bus* bus);
-        void removeInput(Bus* bus);
+        void removeInput(Bus* bus) noexcept;
         void addInput(Stream* stream);
-        void removeInput(Stream* stream);
+        void removeInput(Stream* stream) noexcept;
 
+        std::uint32_t maxFrames;
         Bus* output = nullptr;
         std::vector<Bus*> inputBuses;
         std::vector<Stream*> inputStreams;
@@ -46,7 +51,7 @@ namespace ouzel::audio::mixer
 
         std::vector<float> resampleBuffer;
         std::vector<float> mixBuffer;
-        std::vector<float> buffer;
+        std::vector<float> buffer; // for the input buses
     };
 }
 
@@ -0,0 +1,251 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+#  include <arm_neon.h>
+#elif defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE__)
+#  include <xmmintrin.h>
+#endif
+#include "ChannelMatrix.hpp"
+
+namespace ouzel::audio::mixer
+{
+    namespace
+    {
+        enum Speaker: std::uint32_t
+        {
+            frontLeft,
+            frontRight,
+            frontCenter,
+            lowFrequency,
+            backLeft,
+            backRight,
+            backCenter,
+            sideLeft,
+            sideRight,
+            speakerCount
+        };
+
+        // the speakers of the layouts with 1 to 8 channels
+        constexpr Speaker layouts[ChannelMatrix::maxChannels][ChannelMatrix::maxChannels] = {
+            {frontCenter}, // mono
+            {frontLeft, frontRight}, // stereo
+            {frontLeft, frontRight, frontCenter}, // 3.0
+            {frontLeft, frontRight, backLeft, backRight}, // quad
+            {frontLeft, frontRight, frontCenter, backLeft, backRight}, // 5.0
+            {frontLeft, frontRight, frontCenter, lowFrequency, backLeft, backRight}, // 5.1
+            {frontLeft, frontRight, frontCenter, lowFrequency, backCenter, sideLeft, sideRight}, // 6.1
+            {frontLeft, frontRight, frontCenter, lowFrequency, backLeft, backRight, sideLeft, sideRight} // 7.1
+        };
+
+        constexpr float minus3dB = 0.70710678F;
+
+        using SpeakerMatrix = std::array<std::array<float, speakerCount>, speakerCount>;
+
+        // the coefficient of every source speaker (the second index) for every speaker (the first index),
+        // the speakers that are missing are folded into the nearest ones and the low-frequency channel is dropped
+        constexpr SpeakerMatrix getSpeakerMatrix(std::uint32_t sourceChannels, std::uint32_t channels) noexcept
+        {
+            SpeakerMatrix result{};
+
+            // mono is the average of the stereo downmix
+            if (channels == 1)
+            {
+                const auto stereo = getSpeakerMatrix(sourceChannels, 2);
+                for (std::uint32_t speaker = 0; speaker < speakerCount; ++speaker)
+                    result[frontCenter][speaker] = (stereo[frontLeft][speaker] + stereo[frontRight][speaker]) * 0.5F;
+                return result;
+            }
+
+            std::array<bool, speakerCount> present{};
+            for (std::uint32_t channel = 0; channel < channels; ++channel)
+                present[layouts[channels - 1][channel]] = true;
+
+            for (std::uint32_t sourceChannel = 0; sourceChannel < sourceChannels; ++sourceChannel)
+            {
+                const auto speaker = layouts[sourceChannels - 1][sourceChannel];
+
+                if (present[speaker])
+                {
+                    result[speaker][speaker] = 1.0F;
+                    continue;
+                }
+
+                switch (speaker)
+                {
+                    case frontCenter:
+                        // mono is played at full level on both of the front speakers
+                        result[frontLeft][speaker] = (sourceChannels == 1) ? 1.0F : minus3dB;
+                        result[frontRight][speaker] = (sourceChannels == 1) ? 1.0F : minus3dB;
+                        break;
+                    case backLeft:
+                        if (present[sideLeft]) result[sideLeft][speaker] = 1.0F;
+                        else result[frontLeft][speaker] = minus3dB;
+                        break;
+                    case backRight:
+                        if (present[sideRight]) result[sideRight][speaker] = 1.0F;
+                        else result[frontRight][speaker] = minus3dB;
+                        break;
+                    case sideLeft:
+                        if (present[backLeft]) result[backLeft][speaker] = 1.0F;
+                        else result[frontLeft][speaker] = minus3dB;
+                        break;
+                    case sideRight:
+                        if (present[backRight]) result[backRight][speaker] = 1.0F;
+                        else result[frontRight][speaker] = minus3dB;
+                        break;
+                    case backCenter:
+                        if (present[backLeft])
+                        {
+                            result[backLeft][speaker] = minus3dB;
+                            result[backRight][speaker] = minus3dB;
+                        }
+                        else if (present[sideLeft])
+                        {
+                            result[sideLeft][speaker] = minus3dB;
+                            result[sideRight][speaker] = minus3dB;
+                        }
+                        else
+                        {
+                            result[frontLeft][speaker] = 0.5F;
+                            result[frontRight][speaker] = 0.5F;
+                        }
+                        break;
+                    default: // the low-frequency channel and the front speakers, which every layout above mono has
+                        break;
+                }
+            }
+
+            return result;
+        }
+
+        // the kernels process a vector of frames of a channel at a time and the rest one by one
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+        using Float = float32x4_t;
+        constexpr std::uint32_t width = 4;
+        inline Float load(const float* data) noexcept { return vld1q_f32(data); }
+        inline void store(float* data, Float value) noexcept { vst1q_f32(data, value); }
+        inline Float set(float value) noexcept { return vdupq_n_f32(value); }
+        inline Float add(Float a, Float b) noexcept { return vaddq_f32(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return vmulq_f32(a, b); }
+#  define OUZEL_CHANNEL_SIMD
+#elif defined(__AVX__)
+        using Float = __m256;
+        constexpr std::uint32_t width = 8;
+        inline Float load(const float* data) noexcept { return _mm256_loadu_ps(data); }
+        inline void store(float* data, Float value) noexcept { _mm256_storeu_ps(data, value); }
+        inline Float set(float value) noexcept { return _mm256_set1_ps(value); }
+        inline Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+#  define OUZEL_CHANNEL_SIMD
+#elif defined(__SSE__)
+        using Float = __m128;
+        constexpr std::uint32_t width = 4;
+        inline Float load(const float* data) noexcept { return _mm_loadu_ps(data); }
+        inline void store(float* data, Float value) noexcept { _mm_storeu_ps(data, value); }
+        inline Float set(float value) noexcept { return _mm_set1_ps(value); }
+        inline Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+#  define OUZEL_CHANNEL_SIMD
+#endif
+    }
+
+    constexpr ChannelMatrix ChannelMatrix::create(std::uint32_t fromChannels, std::uint32_t toChannels) noexcept
+    {
+        ChannelMatrix result;
+        result.sourceChannels = fromChannels;
+        result.channels = toChannels;
+
+        const auto speakerMatrix = getSpeakerMatrix(fromChannels, toChannels);
+
+        for (std::uint32_t channel = 0; channel < toChannels; ++channel)
+            for (std::uint32_t sourceChannel = 0; sourceChannel < fromChannels; ++sourceChannel)
+                if (const auto coefficient = speakerMatrix[layouts[toChannels - 1][channel]][layouts[fromChannels - 1][sourceChannel]];
+                    coefficient != 0.0F)
+                {
+                    auto& input = result.inputs[channel][result.inputCounts[channel]++];
+                    input.sourceChannel = sourceChannel;
+                    input.coefficient = coefficient;
+                }
+
+        return result;
+    }
+
+    constexpr std::array<ChannelMatrix, ChannelMatrix::maxChannels * ChannelMatrix::maxChannels> ChannelMatrix::createAll() noexcept
+    {
+        std::array<ChannelMatrix, maxChannels * maxChannels> result{};
+
+        for (std::uint32_t fromChannels = 1; fromChannels <= maxChannels; ++fromChannels)
+            for (std::uint32_t toChannels = 1; toChannels <= maxChannels; ++toChannels)
+                result[(fromChannels - 1) * maxChannels + toChannels - 1] = create(fromChannels, toChannels);
+
+        return result;
+    }
+
+    constexpr std::array<ChannelMatrix, ChannelMatrix::maxChannels * ChannelMatrix::maxChannels> ChannelMatrix::matrices = createAll();
+
+    const ChannelMatrix& ChannelMatrix::get(std::uint32_t sourceChannels, std::uint32_t channels) noexcept
+    {
+        static constexpr ChannelMatrix empty;
+        if (!sourceChannels || !channels) return empty;
+
+        return matrices[(std::min(sourceChannels, maxChannels) - 1) * maxChannels + std::min(channels, maxChannels) - 1];
+    }
+
+    float ChannelMatrix::getCoefficient(std::uint32_t channel, std::uint32_t sourceChannel) const noexcept
+    {
+        if (channel >= channels) return 0.0F;
+
+        for (std::uint32_t i = 0; i < inputCounts[channel]; ++i)
+            if (inputs[channel][i].sourceChannel == sourceChannel)
+                return inputs[channel][i].coefficient;
+
+        return 0.0F;
+    }
+
+    void ChannelMatrix::mix(const float* sourceSamples, std::uint32_t frames,
+                            float* samples, std::uint32_t stride) const noexcept
+    {
+        for (std::uint32_t channel = 0; channel < channels; ++channel)
+        {
+            const auto count = inputCounts[channel];
+            if (!count) continue;
+
+            const float* sources[maxChannels];
+            float coefficients[maxChannels];
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                sources[i] = sourceSamples + inputs[channel][i].sourceChannel * frames;
+                coefficients[i] = inputs[channel][i].coefficient;
+            }
+
+            float* output = samples + channel * stride;
+            std::uint32_t frame = 0;
+
+#if defined(OUZEL_CHANNEL_SIMD)
+            Float coefficientVectors[maxChannels];
+            for (std::uint32_t i = 0; i < count; ++i)
+                coefficientVectors[i] = set(coefficients[i]);
+
+            // the output is loaded and stored once for all of the source channels
+            for (; frame + width <= frames; frame += width)
+            {
+                auto result = load(output + frame);
+                for (std::uint32_t i = 0; i < count; ++i)
+                    result = add(result, multiply(load(sources[i] + frame), coefficientVectors[i]));
+                store(output + frame, result);
+            }
+#endif
+
+            for (; frame < frames; ++frame)
+            {
+                float result = output[frame];
+                for (std::uint32_t i = 0; i < count; ++i)
+                    result += sources[i][frame] * coefficients[i];
+                output[frame] = result;
+            }
+        }
+    }
+}
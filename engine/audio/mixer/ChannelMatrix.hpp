@@ -0,0 +1,51 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_MIXER_CHANNELMATRIX_HPP
+#define OUZEL_AUDIO_MIXER_CHANNELMATRIX_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace ouzel::audio::mixer
+{
+    // coefficients of every source channel for every channel when converting between the channel layouts
+    // of the mono, stereo, 3.0, quad, 5.0, 5.1, 6.1 and 7.1 samples in the order of the WAVE speaker mask,
+    // the matrices of all of the layouts are computed at compile time
+    class ChannelMatrix final
+    {
+    public:
+        static constexpr std::uint32_t maxChannels = 8; // 7.1
+
+        // the channels above maxChannels are left out of the conversion
+        static const ChannelMatrix& get(std::uint32_t sourceChannels, std::uint32_t channels) noexcept;
+
+        constexpr ChannelMatrix() noexcept = default;
+
+        auto getSourceChannels() const noexcept { return sourceChannels; }
+        auto getChannels() const noexcept { return channels; }
+        float getCoefficient(std::uint32_t channel, std::uint32_t sourceChannel) const noexcept;
+
+        // adds frames of the planar source samples to the planar samples, whose channels are stride samples apart
+        void mix(const float* sourceSamples, std::uint32_t frames,
+                 float* samples, std::uint32_t stride) const noexcept;
+
+    private:
+        static constexpr ChannelMatrix create(std::uint32_t fromChannels, std::uint32_t toChannels) noexcept;
+        static constexpr std::array<ChannelMatrix, maxChannels * maxChannels> createAll() noexcept;
+        static const std::array<ChannelMatrix, maxChannels * maxChannels> matrices;
+
+        // only the source channels with a non-zero coefficient are mixed into a channel
+        struct Input final
+        {
+            std::uint32_t sourceChannel = 0;
+            float coefficient = 0.0F;
+        };
+
+        std::uint32_t sourceChannels = 0;
+        std::uint32_t channels = 0;
+        std::array<std::uint32_t, maxChannels> inputCounts{};
+        std::array<std::array<Input, maxChannels>, maxChannels> inputs{};
+    };
+}
+
+#endif // OUZEL_AUDIO_MIXER_CHANNELMATRIX_HPP
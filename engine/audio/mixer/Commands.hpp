@@ -6,9 +6,12 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "Bus.hpp"
+#include "Object.hpp"
 #include "Processor.hpp"
-#include "Source.hpp"
 #include "Stream.hpp"
 #include "Data.hpp"
 
@@ -50,45 +53,46 @@ namespace ouzel::audio::mixer
     class InitObjectCommand final: public Command
     {
     public:
-        explicit constexpr InitObjectCommand(ObjectId initObjectId) noexcept:
-            Command(Command::Type::initObject),
-            objectId(initObjectId)
-        {}
-
         InitObjectCommand(ObjectId initObjectId,
-                          std::unique_ptr<Source> initSource) noexcept:
+                          std::unique_ptr<Object> initObject) noexcept:
             Command(Command::Type::initObject),
             objectId(initObjectId),
-            source(std::move(initSource))
+            object(std::move(initObject))
         {}
 
         const ObjectId objectId;
-        std::unique_ptr<Source> source;
+        std::unique_ptr<Object> object;
     };
 
     class DeleteObjectCommand final: public Command
     {
     public:
-        explicit constexpr DeleteObjectCommand(ObjectId initObjectId) noexcept:
+        explicit DeleteObjectCommand(ObjectId initObjectId) noexcept:
             Command(Command::Type::deleteObject),
             objectId(initObjectId)
         {}
 
         const ObjectId objectId;
+        std::unique_ptr<Object> object; // the mixer moves the deleted object here to be destroyed on the game thread
     };
 
     class AddChildCommand final: public Command
     {
     public:
-        constexpr AddChildCommand(ObjectId initObjectId,
-                                  ObjectId initChildId) noexcept:
+        AddChildCommand(ObjectId initObjectId,
+                        ObjectId initChildId,
+                        std::vector<Object*> initChildren = {}) noexcept:
             Command(Command::Type::addChild),
             objectId(initObjectId),
-            childId(initChildId)
+            childId(initChildId),
+            children(std::move(initChildren))
         {}
 
         const ObjectId objectId;
         const ObjectId childId;
+        // storage allocated on the game thread for when the children of the object outgrow theirs,
+        // the mixer moves the old storage here to be freed on the game thread
+        std::vector<Object*> children;
     };
 
     class RemoveChildCommand final: public Command
@@ -133,12 +137,15 @@ namespace ouzel::audio::mixer
     class InitBusCommand final: public Command
     {
     public:
-        explicit constexpr InitBusCommand(ObjectId initBusId) noexcept:
+        InitBusCommand(ObjectId initBusId,
+                       std::unique_ptr<Bus> initBus) noexcept:
             Command(Command::Type::initBus),
-            busId(initBusId)
+            busId(initBusId),
+            bus(std::move(initBus))
         {}
 
         const ObjectId busId;
+        std::unique_ptr<Bus> bus;
     };
 
     class SetBusOutputCommand final: public Command
@@ -197,15 +204,15 @@ namespace ouzel::audio::mixer
     class InitStreamCommand final: public Command
     {
     public:
-        constexpr InitStreamCommand(ObjectId initStreamId,
-                                    ObjectId initDataId) noexcept:
+        InitStreamCommand(ObjectId initStreamId,
+                          std::unique_ptr<Stream> initStream) noexcept:
             Command(Command::Type::initStream),
             streamId(initStreamId),
-            dataId(initDataId)
+            stream(std::move(initStream))
         {}
 
         const ObjectId streamId;
-        const ObjectId dataId;
+        std::unique_ptr<Stream> stream;
     };
 
     class PlayStreamCommand final: public Command
@@ -304,24 +311,21 @@ namespace ouzel::audio::mixer
 
         void pushCommand(std::unique_ptr<Command> command)
         {
-            commands.push(std::move(command));
+            commands.push_back(std::move(command));
         }
 
-        std::unique_ptr<Command> popCommand()
-        {
-            auto result = std::move(commands.front());
-            commands.pop();
-            return result;
-        }
+        // the mixer executes the commands in place, they are destroyed only when the buffer is cleared
+        auto& getCommands() noexcept { return commands; }
+        auto& getCommands() const noexcept { return commands; }
 
-        auto& getCommands() const
+        void clear() noexcept
         {
-            return commands;
+            commands.clear();
         }
 
     private:
         std::string name;
-        std::queue<std::unique_ptr<Command>> commands;
+        std::vector<std::unique_ptr<Command>> commands;
     };
 }
 
@@ -1,82 +1,132 @@
 // Ouzel by Elviss Strazdins
 
 #include <algorithm>
+#include <chrono>
 #include "Mixer.hpp"
+#include "AllocationGuard.hpp"
 #include "Bus.hpp"
 #include "Data.hpp"
 #include "Stream.hpp"
 #include "../../math/MathUtils.hpp"
+#include "../../utils/Log.hpp"
 
 namespace ouzel::audio::mixer
 {
+    namespace
+    {
+        // whole buffers, at least two, so that the mixer thread can render one while the device reads the other
+        std::size_t getRingFrames(std::uint32_t bufferSize, std::uint32_t latency) noexcept
+        {
+            const std::uint32_t buffers = latency ? std::max((latency + bufferSize - 1) / bufferSize, 2U) : 3U;
+            return static_cast<std::size_t>(bufferSize) * buffers;
+        }
+    }
+
     Mixer::Mixer(std::uint32_t initBufferSize,
                  std::uint32_t initChannels,
+                 std::uint32_t initSampleRate,
+                 std::uint32_t latency,
                  const std::function<void(const Event&)>& initCallback):
         bufferSize(initBufferSize),
         channels(initChannels),
+        sampleRate(initSampleRate),
         callback(initCallback),
-        mixerThread(&Mixer::mixerMain, this),
-        buffer(initBufferSize * 3, initChannels)
+        buffer(getRingFrames(initBufferSize, latency), initChannels),
+        commandRing(16)
     {
         //mixerThread.setPriority(20.0F, true);
 
+        mixBuffer.reserve(static_cast<std::size_t>(bufferSize) * channels);
+
+        objectCapacity = 256;
+        objects.resize(objectCapacity);
+
         rootObjectId = getObjectId();
-        objects.resize(rootObjectId);
         auto object = std::make_unique<RootObject>();
         rootObject = object.get();
         objects[rootObjectId - 1] = std::move(object);
+
+        running = true;
+        mixerThread = thread::Thread(&Mixer::mixerMain, this);
     }
 
     Mixer::~Mixer()
     {
+        running = false;
+        bufferCondition.notify_all();
+
         if (mixerThread.isJoinable())
             mixerThread.join();
     }
 
-    void Mixer::process()
+    bool Mixer::submitCommandBuffer(CommandBuffer& commandBuffer)
     {
-        CommandBuffer commandBuffer;
-        std::unique_ptr<Command> command;
+        const auto slot = commandRing.getWriteSlot();
+        if (!slot) return false;
+
+        std::swap(slot->commandBuffer, commandBuffer);
+        commandBuffer.clear();
 
-        for (;;)
+        if (lastObjectId > objectCapacity)
         {
-            std::unique_lock lock(commandQueueMutex);
-            if (commandQueue.empty()) break;
-            commandBuffer = std::move(commandQueue.front());
-            commandQueue.pop();
-            lock.unlock();
+            while (objectCapacity < lastObjectId) objectCapacity *= 2;
+            slot->objects = std::vector<std::unique_ptr<Object>>(objectCapacity);
+        }
+        else
+            slot->objects = std::vector<std::unique_ptr<Object>>();
+
+        commandRing.commitWrite();
+        return true;
+    }
 
-            while (!commandBuffer.isEmpty())
+    void Mixer::process()
+    {
+        while (const auto slot = commandRing.getReadSlot())
+        {
+            if (!slot->objects.empty())
             {
-                command = commandBuffer.popCommand();
+                // the old table goes back to the game thread in the slot
+                std::move(objects.begin(), objects.end(), slot->objects.begin());
+                objects.swap(slot->objects);
+            }
 
+            for (const auto& command : slot->commandBuffer.getCommands())
+            {
                 switch (command->type)
                 {
                     case Command::Type::initObject:
                     {
                         auto initObjectCommand = static_cast<InitObjectCommand*>(command.get());
-                        objects[initObjectCommand->objectId - 1] = std::make_unique<Object>(std::move(initObjectCommand->source));
+                        objects[initObjectCommand->objectId - 1] = std::move(initObjectCommand->object);
                         break;
                     }
                     case Command::Type::deleteObject:
                     {
-                        auto deleteObjectCommand = static_cast<const DeleteObjectCommand*>(command.get());
-                        objects[deleteObjectCommand->objectId - 1].reset();
+                        auto deleteObjectCommand = static_cast<DeleteObjectCommand*>(command.get());
+                        auto& object = objects[deleteObjectCommand->objectId - 1];
+
+                        if (object)
+                        {
+                            if (object.get() == masterBus) masterBus = nullptr;
+                            object->detach();
+                        }
+
+                        deleteObjectCommand->object = std::move(object);
                         break;
                     }
                     case Command::Type::addChild:
                     {
-                        auto addChildCommand = static_cast<const AddChildCommand*>(command.get());
+                        auto addChildCommand = static_cast<AddChildCommand*>(command.get());
                         Object* object = objects[addChildCommand->objectId - 1].get();
-                        Object* child = objects[addChildCommand->objectId - 1].get();
-                        object->addChild(*child);
+                        Object* child = objects[addChildCommand->childId - 1].get();
+                        object->addChild(*child, addChildCommand->children);
                         break;
                     }
                     case Command::Type::removeChild:
                     {
                         auto removeChildCommand = static_cast<const RemoveChildCommand*>(command.get());
                         Object* object = objects[removeChildCommand->objectId - 1].get();
-                        Object* child = objects[removeChildCommand->objectId - 1].get();
+                        Object* child = objects[removeChildCommand->childId - 1].get();
                         object->removeChild(*child);
                         break;
                     }
@@ -96,12 +146,8 @@ namespace ouzel::audio::mixer
                     }
                     case Command::Type::initBus:
                     {
-                        auto initBusCommand = static_cast<const InitBusCommand*>(command.get());
-
-                        if (initBusCommand->busId > objects.size())
-                            objects.resize(initBusCommand->busId);
-
-                        objects[initBusCommand->busId - 1] = std::make_unique<Bus>();
+                        auto initBusCommand = static_cast<InitBusCommand*>(command.get());
+                        objects[initBusCommand->busId - 1] = std::move(initBusCommand->bus);
                         break;
                     }
                     case Command::Type::setBusOutput:
@@ -139,13 +185,8 @@ namespace ouzel::audio::mixer
                     }
                     case Command::Type::initStream:
                     {
-                        auto initStreamCommand = static_cast<const InitStreamCommand*>(command.get());
-
-                        if (initStreamCommand->streamId > objects.size())
-                            objects.resize(initStreamCommand->streamId);
-
-                        auto data = static_cast<Data*>(objects[initStreamCommand->dataId - 1].get());
-                        objects[initStreamCommand->streamId - 1] = data->createStream();
+                        auto initStreamCommand = static_cast<InitStreamCommand*>(command.get());
+                        objects[initStreamCommand->streamId - 1] = std::move(initStreamCommand->stream);
                         break;
                     }
                     case Command::Type::playStream:
@@ -175,20 +216,12 @@ namespace ouzel::audio::mixer
                     case Command::Type::initData:
                     {
                         auto initDataCommand = static_cast<InitDataCommand*>(command.get());
-
-                        if (initDataCommand->dataId > objects.size())
-                            objects.resize(initDataCommand->dataId);
-
                         objects[initDataCommand->dataId - 1] = std::move(initDataCommand->data);
                         break;
                     }
                     case Command::Type::initProcessor:
                     {
                         auto initProcessorCommand = static_cast<InitProcessorCommand*>(command.get());
-
-                        if (initProcessorCommand->processorId > objects.size())
-                            objects.resize(initProcessorCommand->processorId);
-
                         objects[initProcessorCommand->processorId - 1] = std::move(initProcessorCommand->processor);
                         break;
                     }
@@ -204,51 +237,76 @@ namespace ouzel::audio::mixer
                         throw std::runtime_error("Invalid command");
                 }
             }
+
+            commandRing.commitRead();
         }
     }
 
-    void Mixer::getSamples(std::uint32_t frames, std::uint32_t channelCount, std::uint32_t sampleRate, std::vector<float>& samples)
+    void Mixer::getSamples(std::uint32_t frames, std::uint32_t channelCount, std::uint32_t, std::vector<float>& samples)
     {
-        process();
-
         samples.resize(frames * channelCount);
 
-        if (masterBus)
+        const AllocationGuard allocationGuard;
+
+        const auto readFrames = static_cast<std::uint32_t>(std::min(buffer.getReadableFrames(), static_cast<std::size_t>(frames)));
+        buffer.read(samples.data(), readFrames, frames);
+
+        if (readFrames < frames)
         {
-            Vector<float, 3> listenerPosition;
-            Quaternion<float> listenerRotation;
+            for (std::uint32_t channel = 0; channel < channelCount; ++channel)
+                std::fill(samples.begin() + channel * frames + readFrames,
+                          samples.begin() + (channel + 1) * frames, 0.0F);
 
-            masterBus->generateSamples(frames, channelCount, sampleRate,
-                                       listenerPosition, listenerRotation, samples);
+            starved.store(true, std::memory_order_relaxed);
         }
 
-        for (float& sample : samples)
-            sample = std::clamp(sample, -1.0F, 1.0F);
+        // the mixer thread does not hold the mutex while it renders, so a missed notification only
+        // delays it until the timeout of its wait
+        bufferCondition.notify_one();
     }
 
     void Mixer::mixerMain()
     {
         thread::setCurrentThreadName("Mixer");
 
-        for (;;)
+        const auto bufferDuration = std::chrono::microseconds(static_cast<std::uint64_t>(bufferSize) * 1000000U / sampleRate);
+
+        while (running)
         {
-            break; // TODO: remove
+            try
+            {
+                if (starved.exchange(false, std::memory_order_relaxed))
+                    callback(Event(Event::Type::starvation));
 
-            /*process();
+                if (buffer.getWritableFrames() < bufferSize)
+                {
+                    std::unique_lock lock(bufferMutex);
+                    bufferCondition.wait_for(lock, bufferDuration);
+                    continue;
+                }
 
-            std::unique_lock lock(bufferMutex);
-            bufferCondition.wait(lock);
+                const AllocationGuard allocationGuard;
 
-            if (masterBus)
-            {
-                //Vector<float, 3> listenerPosition;
-                //Quaternion<float> listenerRotation;
+                process();
 
-                //masterBus->getData(frames, channels, sampleRate, listenerPosition, listenerRotation, samples);
-            }*/
+                if (masterBus)
+                {
+                    Vector<float, 3> listenerPosition;
+                    Quaternion<float> listenerRotation;
 
-            //for (float& f : samples)
-            //    f = std::clamp(f, -1.0F, 1.0F);
+                    // the audio device clamps the samples while it converts them
+                    masterBus->generateSamples(bufferSize, channels, sampleRate,
+                                               listenerPosition, listenerRotation, mixBuffer);
+                }
+                else
+                    mixBuffer.assign(static_cast<std::size_t>(bufferSize) * channels, 0.0F);
+
+                buffer.write(mixBuffer.data(), bufferSize);
+            }
+            catch (const std::exception& e)
+            {
+                logger.log(Log::Level::error) << e.what();
+            }
         }
     }
 }
@@ -3,17 +3,19 @@
 #ifndef OUZEL_AUDIO_MIXER_MIXER_HPP
 #define OUZEL_AUDIO_MIXER_MIXER_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <mutex>
-#include <queue>
 #include <set>
 #include <thread>
 #include <vector>
 #include "Commands.hpp"
 #include "Object.hpp"
 #include "Processor.hpp"
+#include "../../thread/RingBuffer.hpp"
 #include "../../thread/Thread.hpp"
 
 namespace ouzel::audio::mixer
@@ -61,8 +63,11 @@ namespace ouzel::audio::mixer
             std::size_t objectId;
         };
 
+        // the mixer thread renders up to latency frames ahead of the device, zero for three buffers
         Mixer(std::uint32_t initBufferSize,
               std::uint32_t initChannels,
+              std::uint32_t initSampleRate,
+              std::uint32_t latency,
               const std::function<void(const Event&)>& initCallback);
 
         ~Mixer();
@@ -73,7 +78,7 @@ namespace ouzel::audio::mixer
         Mixer(Mixer&&) = delete;
         Mixer& operator=(Mixer&&) = delete;
 
-        void process();
+        // copies the frames rendered by the mixer thread, called by the audio device
         void getSamples(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate, std::vector<float>& samples);
 
         using ObjectId = std::size_t;
@@ -96,12 +101,10 @@ namespace ouzel::audio::mixer
             deletedObjectIds.insert(objectId);
         }
 
-        void submitCommandBuffer(CommandBuffer&& commandBuffer)
-        {
-            std::unique_lock lock(commandQueueMutex);
-            commandQueue.push(std::move(commandBuffer));
-            lock.unlock();
-        }
+        // hands the commands over to the audio thread and fills the buffer with the commands that the mixer
+        // has finished with, so that they and the objects deleted by them are destroyed on the calling thread,
+        // returns false and leaves the buffer as it is if the mixer has not caught up with the earlier buffers
+        bool submitCommandBuffer(CommandBuffer& commandBuffer);
 
         auto getRootObjectId() const noexcept
         {
@@ -109,21 +112,27 @@ namespace ouzel::audio::mixer
         }
 
     private:
+        // executes the submitted commands, called on the mixer thread
+        void process();
         void mixerMain();
 
         std::uint32_t bufferSize;
         std::uint32_t channels;
+        std::uint32_t sampleRate;
         std::function<void(const Event&)> callback;
 
         ObjectId lastObjectId = 0;
         std::set<ObjectId> deletedObjectIds;
 
+        // written only by the mixer thread, the game thread sends a larger table when the ids outgrow it
         std::vector<std::unique_ptr<Object>> objects;
+        std::size_t objectCapacity = 0; // size of the last table sent by the game thread
         std::size_t rootObjectId = 0;
         RootObject* rootObject = nullptr;
 
         Bus* masterBus = nullptr;
 
+        // single-producer single-consumer ring of planar frames from the mixer thread to the audio device
         class Buffer final
         {
         public:
@@ -134,25 +143,84 @@ namespace ouzel::audio::mixer
             {
             }
 
-            bool canRead() const { return frames > 0; }
-            bool canWrite() const { return frames < maxFrames; }
+            // consumer
+            std::size_t getReadableFrames() const noexcept
+            {
+                return writePosition.load(std::memory_order_acquire) - readPosition.load(std::memory_order_relaxed);
+            }
+
+            // producer
+            std::size_t getWritableFrames() const noexcept
+            {
+                return maxFrames - (writePosition.load(std::memory_order_relaxed) - readPosition.load(std::memory_order_acquire));
+            }
+
+            bool canRead() const noexcept { return getReadableFrames() > 0; }
+            bool canWrite() const noexcept { return getWritableFrames() > 0; }
+
+            // producer: appends the frames of the planar samples, the caller checks that they fit
+            void write(const float* samples, std::size_t frames) noexcept
+            {
+                const auto position = writePosition.load(std::memory_order_relaxed);
+                const auto start = position % maxFrames;
+                const auto firstFrames = std::min(frames, maxFrames - start);
+
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                {
+                    const auto sourceChannel = samples + channel * frames;
+                    const auto bufferChannel = buffer.data() + channel * maxFrames;
+                    std::copy(sourceChannel, sourceChannel + firstFrames, bufferChannel + start);
+                    std::copy(sourceChannel + firstFrames, sourceChannel + frames, bufferChannel);
+                }
+
+                writePosition.store(position + frames, std::memory_order_release);
+            }
+
+            // consumer: takes the oldest frames to the planar samples with channels stride frames apart,
+            // the caller checks that they are readable
+            void read(float* samples, std::size_t frames, std::size_t stride) noexcept
+            {
+                const auto position = readPosition.load(std::memory_order_relaxed);
+                const auto start = position % maxFrames;
+                const auto firstFrames = std::min(frames, maxFrames - start);
+
+                for (std::uint32_t channel = 0; channel < channels; ++channel)
+                {
+                    const auto bufferChannel = buffer.data() + channel * maxFrames;
+                    const auto outputChannel = samples + channel * stride;
+                    std::copy(bufferChannel + start, bufferChannel + start + firstFrames, outputChannel);
+                    std::copy(bufferChannel, bufferChannel + (frames - firstFrames), outputChannel + firstFrames);
+                }
+
+                readPosition.store(position + frames, std::memory_order_release);
+            }
 
         private:
-            std::size_t frames = 0;
             std::size_t maxFrames;
             std::uint32_t channels;
-            std::size_t readPosition = 0;
-            std::size_t writePosition = 0;
             std::vector<float> buffer;
+
+            // the positions only grow, so that a full buffer can be told apart from an empty one
+            std::atomic<std::size_t> readPosition{0};
+            std::atomic<std::size_t> writePosition{0};
         };
 
         thread::Thread mixerThread;
+        std::atomic<bool> running{false};
+        std::atomic<bool> starved{false}; // set by the audio device, reported by the mixer thread
         std::mutex bufferMutex;
         std::condition_variable bufferCondition;
         Buffer buffer;
 
-        std::queue<CommandBuffer> commandQueue;
-        std::mutex commandQueueMutex;
+        struct CommandSlot final
+        {
+            CommandBuffer commandBuffer;
+            std::vector<std::unique_ptr<Object>> objects; // replaces the object table if not empty
+        };
+
+        thread::RingBuffer<CommandSlot> commandRing;
+
+        std::vector<float> mixBuffer;
     };
 }
 
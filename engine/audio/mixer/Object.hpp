@@ -3,6 +3,7 @@
 #ifndef OUZEL_AUDIO_MIXER_OBJECT_HPP
 #define OUZEL_AUDIO_MIXER_OBJECT_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -23,8 +24,7 @@ namespace ouzel::audio::mixer
 
         virtual ~Object()
         {
-            if (parent)
-                parent->removeChild(*this);
+            detach();
         }
 
         Object(const Object&) = delete;
@@ -33,7 +33,8 @@ namespace ouzel::audio::mixer
         Object(Object&&) = delete;
         Object& operator=(Object&&) = delete;
 
-        void addChild(Object& child)
+        // storage is swapped with the children if they don't fit, so that the mixer never allocates
+        void addChild(Object& child, std::vector<Object*>& storage)
         {
             if (child.parent != this)
             {
@@ -42,6 +43,13 @@ namespace ouzel::audio::mixer
 
                 if (std::find(children.begin(), children.end(), &child) == children.end())
                 {
+                    if (children.size() == children.capacity() &&
+                        storage.capacity() > children.size())
+                    {
+                        storage.assign(children.begin(), children.end());
+                        children.swap(storage);
+                    }
+
                     child.parent = this;
                     children.push_back(&child);
                 }
@@ -53,11 +61,24 @@ namespace ouzel::audio::mixer
             if (child.parent == this)
                 if (const auto i = std::find(children.begin(), children.end(), &child); i != children.end())
                 {
-                    child.parent = this;
+                    child.parent = nullptr;
                     children.erase(i);
                 }
         }
 
+        // disconnects the object from the rest of the graph without freeing any memory, so that
+        // the mixer can hand a deleted object back to the game thread to be destroyed there
+        virtual void detach() noexcept
+        {
+            if (parent)
+                parent->removeChild(*this);
+
+            for (auto child : children)
+                child->parent = nullptr;
+
+            children.clear();
+        }
+
         void play()
         {
             if (source)
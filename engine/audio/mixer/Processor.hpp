@@ -15,7 +15,7 @@ namespace ouzel::audio::mixer
         Processor() noexcept = default;
         ~Processor() override
         {
-            if (bus) bus->removeProcessor(this);
+            detach();
         }
 
         Processor(const Processor&) = delete;
@@ -24,6 +24,13 @@ namespace ouzel::audio::mixer
         Processor(Processor&&) = delete;
         Processor& operator=(Processor&&) = delete;
 
+        void detach() noexcept override
+        {
+            if (bus) bus->removeProcessor(this);
+
+            Object::detach();
+        }
+
         virtual void process(std::uint32_t frames, std::uint32_t channels, std::uint32_t sampleRate,
                              std::vector<float>& samples) = 0;
 
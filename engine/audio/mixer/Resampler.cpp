@@ -0,0 +1,335 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+#  include <arm_neon.h>
+#elif defined(__AVX__)
+#  include <immintrin.h>
+#elif defined(__SSE__)
+#  include <xmmintrin.h>
+#endif
+#include "Resampler.hpp"
+
+namespace ouzel::audio::mixer
+{
+    namespace
+    {
+        constexpr std::uint32_t filterPhases = 256; // the coefficients between the phases are interpolated
+        constexpr std::uint32_t maxTaps = 32;
+
+        std::uint32_t getTaps(Resampler::Quality quality) noexcept
+        {
+            switch (quality)
+            {
+                case Resampler::Quality::linear: return 2;
+                case Resampler::Quality::cubic: return 4;
+                case Resampler::Quality::sinc16: return 16;
+                case Resampler::Quality::sinc32: return 32;
+            }
+
+            return 2;
+        }
+
+        // modified Bessel function of the first kind of order zero
+        double besselI0(double x) noexcept
+        {
+            double sum = 1.0;
+            double term = 1.0;
+            for (std::uint32_t k = 1; k < 64; ++k)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+                if (term < sum * 1e-12) break;
+            }
+
+            return sum;
+        }
+
+        // filterPhases + 1 rows of taps coefficients, the row p is for the fraction p / filterPhases,
+        // so that the last phase can be interpolated with the next row
+        std::vector<float> createFilter(std::uint32_t taps, double cutoff, double beta)
+        {
+            constexpr double pi = 3.14159265358979323846;
+
+            std::vector<float> result(static_cast<std::size_t>(filterPhases + 1) * taps);
+            const double halfTaps = taps / 2;
+            const double windowScale = 1.0 / besselI0(beta);
+
+            std::vector<double> row(taps);
+
+            for (std::uint32_t p = 0; p <= filterPhases; ++p)
+            {
+                const double fraction = static_cast<double>(p) / filterPhases;
+                double sum = 0.0;
+
+                for (std::uint32_t tap = 0; tap < taps; ++tap)
+                {
+                    // distance of the tap from the output position
+                    const double x = static_cast<double>(tap) - (halfTaps - 1.0) - fraction;
+                    const double r = x / halfTaps;
+
+                    const double sinc = (x == 0.0) ? 2.0 * cutoff : std::sin(2.0 * pi * cutoff * x) / (pi * x);
+                    const double window = (r > -1.0 && r < 1.0) ? besselI0(beta * std::sqrt(1.0 - r * r)) * windowScale : 0.0;
+
+                    row[tap] = sinc * window;
+                    sum += row[tap];
+                }
+
+                // unity gain at every phase, so that the ripple of the filter does not modulate a constant signal
+                for (std::uint32_t tap = 0; tap < taps; ++tap)
+                    result[p * taps + tap] = static_cast<float>(row[tap] / sum);
+            }
+
+            return result;
+        }
+
+        // the filters are shared by all of the streams with the same quality and the same ratio of sample rates
+        std::shared_ptr<const std::vector<float>> getFilter(std::uint32_t taps, double cutoff, double beta)
+        {
+            static std::mutex mutex;
+            static std::map<std::pair<std::uint32_t, double>, std::shared_ptr<const std::vector<float>>> filters;
+
+            std::lock_guard lock(mutex);
+
+            auto& filter = filters[std::make_pair(taps, cutoff)];
+            if (!filter) filter = std::make_shared<const std::vector<float>>(createFilter(taps, cutoff, beta));
+            return filter;
+        }
+
+        // the kernels process a vector of taps at a time, the number of taps is a multiple of the width
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+        using Float = float32x4_t;
+        constexpr std::uint32_t width = 4;
+        inline Float load(const float* data) noexcept { return vld1q_f32(data); }
+        inline void store(float* data, Float value) noexcept { vst1q_f32(data, value); }
+        inline Float set(float value) noexcept { return vdupq_n_f32(value); }
+        inline Float add(Float a, Float b) noexcept { return vaddq_f32(a, b); }
+        inline Float subtract(Float a, Float b) noexcept { return vsubq_f32(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return vmulq_f32(a, b); }
+        inline float sum(Float value) noexcept { return vaddvq_f32(value); }
+#  define OUZEL_RESAMPLER_SIMD
+#elif defined(__AVX__)
+        using Float = __m256;
+        constexpr std::uint32_t width = 8;
+        inline Float load(const float* data) noexcept { return _mm256_loadu_ps(data); }
+        inline void store(float* data, Float value) noexcept { _mm256_storeu_ps(data, value); }
+        inline Float set(float value) noexcept { return _mm256_set1_ps(value); }
+        inline Float add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+        inline Float subtract(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+        inline float sum(Float value) noexcept
+        {
+            auto result = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+            result = _mm_add_ps(result, _mm_movehl_ps(result, result));
+            result = _mm_add_ss(result, _mm_shuffle_ps(result, result, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(result);
+        }
+#  define OUZEL_RESAMPLER_SIMD
+#elif defined(__SSE__)
+        using Float = __m128;
+        constexpr std::uint32_t width = 4;
+        inline Float load(const float* data) noexcept { return _mm_loadu_ps(data); }
+        inline void store(float* data, Float value) noexcept { _mm_storeu_ps(data, value); }
+        inline Float set(float value) noexcept { return _mm_set1_ps(value); }
+        inline Float add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+        inline Float subtract(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+        inline Float multiply(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+        inline float sum(Float value) noexcept
+        {
+            auto result = _mm_add_ps(value, _mm_movehl_ps(value, value));
+            result = _mm_add_ss(result, _mm_shuffle_ps(result, result, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(result);
+        }
+#  define OUZEL_RESAMPLER_SIMD
+#endif
+
+#if defined(OUZEL_RESAMPLER_SIMD)
+        static_assert(16 % width == 0 && maxTaps % width == 0);
+
+        // result = first + (second - first) * fraction
+        inline void interpolate(const float* first, const float* second, float fraction,
+                                float* result, std::uint32_t taps) noexcept
+        {
+            const auto fractionVector = set(fraction);
+            for (std::uint32_t tap = 0; tap < taps; tap += width)
+            {
+                const auto firstVector = load(first + tap);
+                store(result + tap, add(firstVector, multiply(subtract(load(second + tap), firstVector), fractionVector)));
+            }
+        }
+
+        inline float dotProduct(const float* samples, const float* coefficients, std::uint32_t taps) noexcept
+        {
+            auto result = multiply(load(samples), load(coefficients));
+            for (std::uint32_t tap = width; tap < taps; tap += width)
+                result = add(result, multiply(load(samples + tap), load(coefficients + tap)));
+            return sum(result);
+        }
+#else
+        inline void interpolate(const float* first, const float* second, float fraction,
+                                float* result, std::uint32_t taps) noexcept
+        {
+            for (std::uint32_t tap = 0; tap < taps; ++tap)
+                result[tap] = first[tap] + (second[tap] - first[tap]) * fraction;
+        }
+
+        inline float dotProduct(const float* samples, const float* coefficients, std::uint32_t taps) noexcept
+        {
+            float result = 0.0F;
+            for (std::uint32_t tap = 0; tap < taps; ++tap)
+                result += samples[tap] * coefficients[tap];
+            return result;
+        }
+#endif
+    }
+
+    Resampler::Resampler(Quality initQuality,
+                         std::uint32_t initChannels,
+                         std::uint32_t sourceSampleRate,
+                         std::uint32_t targetSampleRate,
+                         std::uint32_t initMaxInputFrames):
+        quality{initQuality},
+        taps{getTaps(initQuality)},
+        channels{initChannels},
+        maxInputFrames{initMaxInputFrames},
+        sourceRate{sourceSampleRate},
+        targetRate{targetSampleRate},
+        step{sourceSampleRate / targetSampleRate},
+        remainder{sourceSampleRate % targetSampleRate},
+        window(static_cast<std::size_t>(taps + maxInputFrames) * channels)
+    {
+        if (!sourceSampleRate || !targetSampleRate)
+            throw std::runtime_error("Invalid sample rate");
+
+        if (quality == Quality::sinc16 || quality == Quality::sinc32)
+        {
+            // the cutoff is lowered below the Nyquist frequency of the output when downsampling
+            const double ratio = std::min(static_cast<double>(targetSampleRate) / sourceSampleRate, 1.0);
+            const double cutoff = (quality == Quality::sinc16 ? 0.88 : 0.91) * 0.5 * ratio;
+            const double beta = (quality == Quality::sinc16) ? 6.0 : 8.0;
+            filter = getFilter(taps, cutoff, beta);
+        }
+
+        reset();
+    }
+
+    std::uint32_t Resampler::getInputFrames(std::uint32_t outputFrames) const noexcept
+    {
+        if (!outputFrames) return 0;
+
+        // the position of the last output frame
+        return static_cast<std::uint32_t>(position +
+                                          static_cast<std::uint64_t>(outputFrames - 1) * step +
+                                          (phase + static_cast<std::uint64_t>(outputFrames - 1) * remainder) / targetRate);
+    }
+
+    std::uint32_t Resampler::getMaxOutputFrames() const noexcept
+    {
+        const auto start = static_cast<std::uint64_t>(position) * targetRate + phase;
+        const auto end = (static_cast<std::uint64_t>(maxInputFrames) + 1) * targetRate;
+        if (start >= end) return 0;
+
+        return static_cast<std::uint32_t>(std::min((end - 1 - start) / sourceRate + 1,
+                                                   static_cast<std::uint64_t>(UINT32_MAX)));
+    }
+
+    void Resampler::process(const float* input, std::uint32_t inputFrames,
+                            float* output, std::uint32_t outputFrames) noexcept
+    {
+        const std::size_t windowSize = taps + maxInputFrames;
+
+        for (std::uint32_t channel = 0; channel < channels; ++channel)
+            std::copy(input + channel * inputFrames,
+                      input + (channel + 1) * inputFrames,
+                      window.begin() + static_cast<std::ptrdiff_t>(channel * windowSize + taps));
+
+        switch (quality)
+        {
+            case Quality::linear:
+            {
+                const float phaseScale = 1.0F / static_cast<float>(targetRate);
+
+                for (std::uint32_t frame = 0; frame < outputFrames; ++frame)
+                {
+                    const float fraction = static_cast<float>(phase) * phaseScale;
+
+                    for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    {
+                        const float* samples = &window[channel * windowSize + position];
+                        output[channel * outputFrames + frame] = samples[0] + (samples[1] - samples[0]) * fraction;
+                    }
+
+                    advance();
+                }
+                break;
+            }
+            case Quality::cubic:
+            {
+                const float phaseScale = 1.0F / static_cast<float>(targetRate);
+
+                for (std::uint32_t frame = 0; frame < outputFrames; ++frame)
+                {
+                    const float fraction = static_cast<float>(phase) * phaseScale;
+
+                    for (std::uint32_t channel = 0; channel < channels; ++channel)
+                    {
+                        const float* samples = &window[channel * windowSize + position];
+                        output[channel * outputFrames + frame] = samples[1] + 0.5F * fraction *
+                            (samples[2] - samples[0] + fraction *
+                             (2.0F * samples[0] - 5.0F * samples[1] + 4.0F * samples[2] - samples[3] + fraction *
+                              (3.0F * (samples[1] - samples[2]) + samples[3] - samples[0])));
+                    }
+
+                    advance();
+                }
+                break;
+            }
+            case Quality::sinc16:
+            case Quality::sinc32:
+            {
+                const float phaseScale = static_cast<float>(filterPhases) / static_cast<float>(targetRate);
+                alignas(32) float coefficients[maxTaps];
+
+                for (std::uint32_t frame = 0; frame < outputFrames; ++frame)
+                {
+                    // the coefficients are interpolated once for all of the channels
+                    const float phasePosition = static_cast<float>(phase) * phaseScale;
+                    const auto row = std::min(static_cast<std::uint32_t>(phasePosition), filterPhases - 1);
+                    const float* rowCoefficients = filter->data() + row * taps;
+                    interpolate(rowCoefficients, rowCoefficients + taps, phasePosition - static_cast<float>(row),
+                                coefficients, taps);
+
+                    for (std::uint32_t channel = 0; channel < channels; ++channel)
+                        output[channel * outputFrames + frame] = dotProduct(&window[channel * windowSize + position],
+                                                                            coefficients, taps);
+
+                    advance();
+                }
+                break;
+            }
+        }
+
+        // the last taps frames become the history for the next call
+        position -= inputFrames;
+
+        for (std::uint32_t channel = 0; channel < channels; ++channel)
+        {
+            const auto channelWindow = window.begin() + static_cast<std::ptrdiff_t>(channel * windowSize);
+            std::copy(channelWindow + inputFrames, channelWindow + inputFrames + taps, channelWindow);
+        }
+    }
+
+    void Resampler::reset() noexcept
+    {
+        std::fill(window.begin(), window.end(), 0.0F);
+
+        // the first output frame is at the first input frame, the filter sees silence before it
+        position = taps / 2 + 1;
+        phase = 0;
+    }
+}
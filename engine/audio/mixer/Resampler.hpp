@@ -0,0 +1,83 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_AUDIO_MIXER_RESAMPLER_HPP
+#define OUZEL_AUDIO_MIXER_RESAMPLER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ouzel::audio::mixer
+{
+    // converts the planar samples of a stream to the sample rate of the bus, the position between the input frames
+    // and the last input frames are kept between the calls, so that the output is continuous across the buffers
+    class Resampler final
+    {
+    public:
+        enum class Quality
+        {
+            linear,
+            cubic, // Catmull-Rom spline
+            sinc16, // Kaiser-windowed sinc with 16 taps
+            sinc32 // Kaiser-windowed sinc with 32 taps
+        };
+
+        Resampler() = default;
+
+        // the history, the window and the filter are allocated here, so that process does not allocate
+        Resampler(Quality initQuality,
+                  std::uint32_t initChannels,
+                  std::uint32_t sourceSampleRate,
+                  std::uint32_t targetSampleRate,
+                  std::uint32_t initMaxInputFrames);
+
+        auto getQuality() const noexcept { return quality; }
+        auto getChannels() const noexcept { return channels; }
+
+        // the number of input frames that process needs to produce outputFrames frames
+        std::uint32_t getInputFrames(std::uint32_t outputFrames) const noexcept;
+
+        // the most frames that can be produced without exceeding the maximum number of input frames
+        std::uint32_t getMaxOutputFrames() const noexcept;
+
+        // the input must hold getInputFrames(outputFrames) frames of every channel one after another
+        // and the output must have room for outputFrames frames of every channel
+        void process(const float* input, std::uint32_t inputFrames,
+                     float* output, std::uint32_t outputFrames) noexcept;
+
+        void reset() noexcept;
+
+    private:
+        void advance() noexcept
+        {
+            position += step;
+            phase += remainder;
+            if (phase >= targetRate)
+            {
+                phase -= targetRate;
+                ++position;
+            }
+        }
+
+        Quality quality = Quality::linear;
+        std::uint32_t taps = 2;
+        std::uint32_t channels = 0;
+        std::uint32_t maxInputFrames = 0;
+
+        // the input advances by step + remainder / targetRate frames per output frame
+        std::uint32_t sourceRate = 1;
+        std::uint32_t targetRate = 1;
+        std::uint32_t step = 1;
+        std::uint32_t remainder = 0;
+
+        // the first input frame under the filter for the next output frame is at window[position],
+        // the fraction of the next output frame between the input frames is phase / targetRate
+        std::uint32_t position = 0;
+        std::uint32_t phase = 0;
+
+        std::vector<float> window; // taps frames of history followed by up to maxInputFrames frames for every channel
+        std::shared_ptr<const std::vector<float>> filter; // coefficients for every phase of the sinc filters
+    };
+}
+
+#endif // OUZEL_AUDIO_MIXER_RESAMPLER_HPP
@@ -3,9 +3,11 @@
 #ifndef OUZEL_AUDIO_MIXER_STREAM_HPP
 #define OUZEL_AUDIO_MIXER_STREAM_HPP
 
+#include <utility>
 #include "Object.hpp"
 #include "Bus.hpp"
 #include "Data.hpp"
+#include "Resampler.hpp"
 
 namespace ouzel::audio::mixer
 {
@@ -23,7 +25,7 @@ namespace ouzel::audio::mixer
 
         ~Stream() override
         {
-            if (output) output->removeInput(this);
+            detach();
         }
 
         Stream(const Stream&) = delete;
@@ -34,6 +36,9 @@ namespace ouzel::audio::mixer
 
         auto& getData() const noexcept { return data; }
 
+        // must be set before the stream is passed to the mixer if the sample rate of the data differs from the device
+        void setResampler(Resampler newResampler) noexcept { resampler = std::move(newResampler); }
+
         void setOutput(Bus* newOutput)
         {
             if (output) output->removeInput(this);
@@ -41,13 +46,25 @@ namespace ouzel::audio::mixer
             if (output) output->addInput(this);
         }
 
+        void detach() noexcept override
+        {
+            if (output) output->removeInput(this);
+            output = nullptr;
+
+            Object::detach();
+        }
+
         auto isPlaying() const noexcept { return playing; }
         void play() { playing = true; }
 
         void stop(bool shouldReset)
         {
             playing = false;
-            if (shouldReset) reset();
+            if (shouldReset)
+            {
+                reset();
+                resampler.reset();
+            }
         }
 
         virtual void reset() = 0;
@@ -58,6 +75,9 @@ namespace ouzel::audio::mixer
         Data& data;
         Bus* output = nullptr;
         bool playing = false;
+
+    private:
+        Resampler resampler;
     };
 }
 
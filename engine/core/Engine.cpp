@@ -5,6 +5,7 @@
 #endif
 #include <algorithm>
 #include <stdexcept>
+#include <thread>
 #include "Setup.h"
 #include "Engine.hpp"
 #include "../utils/Utils.hpp"
@@ -19,24 +20,34 @@
 #  if OUZEL_OPENGLES
 #    include "opengl/ColorPSGLES2.h"
 #    include "opengl/ColorVSGLES2.h"
+#    include "opengl/DistanceFieldPSGLES2.h"
 #    include "opengl/TexturePSGLES2.h"
+#    include "opengl/TextureInstancedVSGLES2.h"
 #    include "opengl/TextureVSGLES2.h"
 #    include "opengl/ColorPSGLES3.h"
 #    include "opengl/ColorVSGLES3.h"
+#    include "opengl/DistanceFieldPSGLES3.h"
 #    include "opengl/TexturePSGLES3.h"
+#    include "opengl/TextureInstancedVSGLES3.h"
 #    include "opengl/TextureVSGLES3.h"
 #  else
 #    include "opengl/ColorPSGL2.h"
 #    include "opengl/ColorVSGL2.h"
+#    include "opengl/DistanceFieldPSGL2.h"
 #    include "opengl/TexturePSGL2.h"
+#    include "opengl/TextureInstancedVSGL2.h"
 #    include "opengl/TextureVSGL2.h"
 #    include "opengl/ColorPSGL3.h"
 #    include "opengl/ColorVSGL3.h"
+#    include "opengl/DistanceFieldPSGL3.h"
 #    include "opengl/TexturePSGL3.h"
+#    include "opengl/TextureInstancedVSGL3.h"
 #    include "opengl/TextureVSGL3.h"
 #    include "opengl/ColorPSGL4.h"
 #    include "opengl/ColorVSGL4.h"
+#    include "opengl/DistanceFieldPSGL4.h"
 #    include "opengl/TexturePSGL4.h"
+#    include "opengl/TextureInstancedVSGL4.h"
 #    include "opengl/TextureVSGL4.h"
 #  endif
 #endif
@@ -46,34 +57,41 @@
 #  include "direct3d11/TextureVSD3D11.h"
 #  include "direct3d11/ColorPSD3D11.h"
 #  include "direct3d11/ColorVSD3D11.h"
+#  include "direct3d11/DistanceFieldPSD3D11.h"
 #endif
 
 #if OUZEL_COMPILE_METAL
 #  if TARGET_OS_IOS
 #    include "metal/ColorPSIOS.h"
 #    include "metal/ColorVSIOS.h"
+#    include "metal/DistanceFieldPSIOS.h"
 #    include "metal/TexturePSIOS.h"
 #    include "metal/TextureVSIOS.h"
 #    define COLOR_PIXEL_SHADER_METAL ColorPSIOS_metallib
 #    define COLOR_VERTEX_SHADER_METAL ColorVSIOS_metallib
+#    define DISTANCE_FIELD_PIXEL_SHADER_METAL DistanceFieldPSIOS_metallib
 #    define TEXTURE_PIXEL_SHADER_METAL TexturePSIOS_metallib
 #    define TEXTURE_VERTEX_SHADER_METAL TextureVSIOS_metallib
 #  elif TARGET_OS_TV
 #    include "metal/ColorPSTVOS.h"
 #    include "metal/ColorVSTVOS.h"
+#    include "metal/DistanceFieldPSTVOS.h"
 #    include "metal/TexturePSTVOS.h"
 #    include "metal/TextureVSTVOS.h"
 #    define COLOR_PIXEL_SHADER_METAL ColorPSTVOS_metallib
 #    define COLOR_VERTEX_SHADER_METAL ColorVSTVOS_metallib
+#    define DISTANCE_FIELD_PIXEL_SHADER_METAL DistanceFieldPSTVOS_metallib
 #    define TEXTURE_PIXEL_SHADER_METAL TexturePSTVOS_metallib
 #    define TEXTURE_VERTEX_SHADER_METAL TextureVSTVOS_metallib
 #  elif TARGET_OS_MAC
 #    include "metal/ColorPSMacOS.h"
 #    include "metal/ColorVSMacOS.h"
+#    include "metal/DistanceFieldPSMacOS.h"
 #    include "metal/TexturePSMacOS.h"
 #    include "metal/TextureVSMacOS.h"
 #    define COLOR_PIXEL_SHADER_METAL ColorPSMacOS_metallib
 #    define COLOR_VERTEX_SHADER_METAL ColorVSMacOS_metallib
+#    define DISTANCE_FIELD_PIXEL_SHADER_METAL DistanceFieldPSMacOS_metallib
 #    define TEXTURE_PIXEL_SHADER_METAL TexturePSMacOS_metallib
 #    define TEXTURE_VERTEX_SHADER_METAL TextureVSMacOS_metallib
 #  endif
@@ -91,6 +109,13 @@ namespace ouzel::core
 
     namespace
     {
+        // the application thread helps with the jobs while it waits for them
+        std::size_t getDefaultWorkerCount() noexcept
+        {
+            const auto hardwareThreads = std::thread::hardware_concurrency();
+            return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
         struct Settings final
         {
             Size<std::uint32_t, 2> size;
@@ -102,6 +127,7 @@ namespace ouzel::core
             bool highDpi = true; // should high DPI resolution be used
             audio::Driver audioDriver;
             audio::Settings audioSettings;
+            std::size_t workerCount = getDefaultWorkerCount();
         };
 
         Settings parseSettings(const ini::Data& defaultSettings,
@@ -163,6 +189,11 @@ namespace ouzel::core
             const auto& debugRendererValue = userEngineSection.getValue("debugRenderer", defaultEngineSection.getValue("debugRenderer"));
             if (!debugRendererValue.empty()) settings.graphicsSettings.debugRenderer = (debugRendererValue == "true" || debugRendererValue == "1" || debugRendererValue == "yes");
 
+            const auto& framesInFlightValue = userEngineSection.getValue("framesInFlight", defaultEngineSection.getValue("framesInFlight"));
+            if (!framesInFlightValue.empty()) settings.graphicsSettings.framesInFlight = static_cast<std::uint32_t>(std::stoul(framesInFlightValue));
+
+            settings.graphicsSettings.captureFile = userEngineSection.getValue("captureFile", defaultEngineSection.getValue("captureFile"));
+
             const auto& highDpiValue = userEngineSection.getValue("highDpi", defaultEngineSection.getValue("highDpi"));
             if (!highDpiValue.empty()) settings.highDpi = (highDpiValue == "true" || highDpiValue == "1" || highDpiValue == "yes");
 
@@ -172,8 +203,32 @@ namespace ouzel::core
             const auto& debugAudioValue = userEngineSection.getValue("debugAudio", defaultEngineSection.getValue("debugAudio"));
             if (!debugAudioValue.empty()) settings.audioSettings.debugAudio = (debugAudioValue == "true" || debugAudioValue == "1" || debugAudioValue == "yes");
 
+            const auto& audioLatencyValue = userEngineSection.getValue("audioLatency", defaultEngineSection.getValue("audioLatency"));
+            if (!audioLatencyValue.empty()) settings.audioSettings.latency = static_cast<std::uint32_t>(std::stoul(audioLatencyValue));
+
+            const auto& audioDitherValue = userEngineSection.getValue("audioDither", defaultEngineSection.getValue("audioDither"));
+            if (!audioDitherValue.empty()) settings.audioSettings.dither = (audioDitherValue == "true" || audioDitherValue == "1" || audioDitherValue == "yes");
+
+            const auto& resampleQualityValue = userEngineSection.getValue("resampleQuality", defaultEngineSection.getValue("resampleQuality"));
+            if (!resampleQualityValue.empty())
+            {
+                if (resampleQualityValue == "linear")
+                    settings.audioSettings.resampleQuality = audio::mixer::Resampler::Quality::linear;
+                else if (resampleQualityValue == "cubic")
+                    settings.audioSettings.resampleQuality = audio::mixer::Resampler::Quality::cubic;
+                else if (resampleQualityValue == "sinc16")
+                    settings.audioSettings.resampleQuality = audio::mixer::Resampler::Quality::sinc16;
+                else if (resampleQualityValue == "sinc32")
+                    settings.audioSettings.resampleQuality = audio::mixer::Resampler::Quality::sinc32;
+                else
+                    throw std::runtime_error("Invalid resample quality specified");
+            }
+
             settings.audioSettings.audioDevice = userEngineSection.getValue("audioDevice", defaultEngineSection.getValue("audioDevice"));
 
+            const auto& workerCountValue = userEngineSection.getValue("workerCount", defaultEngineSection.getValue("workerCount"));
+            if (!workerCountValue.empty()) settings.workerCount = static_cast<std::size_t>(std::stoul(workerCountValue));
+
             return settings;
         }
     }
@@ -237,6 +292,8 @@ namespace ouzel::core
 
         inputManager = std::make_unique<input::InputManager>();
 
+        jobSystem = std::make_unique<thread::JobSystem>(settings.workerCount);
+
         // default assets
         switch (settings.graphicsDriver)
         {
@@ -346,6 +403,109 @@ namespace ouzel::core
 
                 assetBundle.setShader(shaderTexture, std::move(textureShader));
 
+                std::unique_ptr<graphics::Shader> distanceFieldShader;
+
+                switch (graphics->getDevice()->getAPIMajorVersion())
+                {
+#  if OUZEL_OPENGLES
+                    case 2:
+                        distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                 std::vector<std::uint8_t>(std::begin(DistanceFieldPSGLES2_glsl),
+                                                                                                           std::end(DistanceFieldPSGLES2_glsl)),
+                                                                                 std::vector<std::uint8_t>(std::begin(TextureVSGLES2_glsl),
+                                                                                                           std::end(TextureVSGLES2_glsl)),
+                                                                                 std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                     graphics::Vertex::Attribute::Usage::position,
+                                                                                     graphics::Vertex::Attribute::Usage::color,
+                                                                                     graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"color", graphics::DataType::float32Vector4}
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                                 });
+                        break;
+                    case 3:
+                        distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                 std::vector<std::uint8_t>(std::begin(DistanceFieldPSGLES3_glsl),
+                                                                                                           std::end(DistanceFieldPSGLES3_glsl)),
+                                                                                 std::vector<std::uint8_t>(std::begin(TextureVSGLES3_glsl),
+                                                                                                           std::end(TextureVSGLES3_glsl)),
+                                                                                 std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                     graphics::Vertex::Attribute::Usage::position,
+                                                                                     graphics::Vertex::Attribute::Usage::color,
+                                                                                     graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"color", graphics::DataType::float32Vector4}
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                                 });
+                        break;
+#  else
+                    case 2:
+                        distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                 std::vector<std::uint8_t>(std::begin(DistanceFieldPSGL2_glsl),
+                                                                                                           std::end(DistanceFieldPSGL2_glsl)),
+                                                                                 std::vector<std::uint8_t>(std::begin(TextureVSGL2_glsl),
+                                                                                                           std::end(TextureVSGL2_glsl)),
+                                                                                 std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                     graphics::Vertex::Attribute::Usage::position,
+                                                                                     graphics::Vertex::Attribute::Usage::color,
+                                                                                     graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"color", graphics::DataType::float32Vector4}
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                                 });
+                        break;
+                    case 3:
+                        distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                 std::vector<std::uint8_t>(std::begin(DistanceFieldPSGL3_glsl),
+                                                                                                           std::end(DistanceFieldPSGL3_glsl)),
+                                                                                 std::vector<std::uint8_t>(std::begin(TextureVSGL3_glsl),
+                                                                                                           std::end(TextureVSGL3_glsl)),
+                                                                                 std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                     graphics::Vertex::Attribute::Usage::position,
+                                                                                     graphics::Vertex::Attribute::Usage::color,
+                                                                                     graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"color", graphics::DataType::float32Vector4}
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                                 });
+                        break;
+                    case 4:
+                        distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                 std::vector<std::uint8_t>(std::begin(DistanceFieldPSGL4_glsl),
+                                                                                                           std::end(DistanceFieldPSGL4_glsl)),
+                                                                                 std::vector<std::uint8_t>(std::begin(TextureVSGL4_glsl),
+                                                                                                           std::end(TextureVSGL4_glsl)),
+                                                                                 std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                     graphics::Vertex::Attribute::Usage::position,
+                                                                                     graphics::Vertex::Attribute::Usage::color,
+                                                                                     graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"color", graphics::DataType::float32Vector4}
+                                                                                 },
+                                                                                 std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                     {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                                 });
+                        break;
+#  endif
+                    default:
+                        throw std::runtime_error("Unsupported OpenGL version");
+                }
+
+                assetBundle.setShader(shaderDistanceField, std::move(distanceFieldShader));
+
                 std::unique_ptr<graphics::Shader> colorShader;
 
                 switch (graphics->getDevice()->getAPIMajorVersion())
@@ -443,6 +603,113 @@ namespace ouzel::core
                 }
 
                 assetBundle.setShader(shaderColor, std::move(colorShader));
+
+                // the meshes are drawn one by one if the device can not execute the instanced draws
+                if (graphics->getDevice()->isInstancingSupported())
+                {
+                    std::unique_ptr<graphics::Shader> textureInstancedShader;
+
+                    switch (graphics->getDevice()->getAPIMajorVersion())
+                    {
+#  if OUZEL_OPENGLES
+                        case 2:
+                            textureInstancedShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                        std::vector<std::uint8_t>(std::begin(TexturePSGLES2_glsl),
+                                                                                                                  std::end(TexturePSGLES2_glsl)),
+                                                                                        std::vector<std::uint8_t>(std::begin(TextureInstancedVSGLES2_glsl),
+                                                                                                                  std::end(TextureInstancedVSGLES2_glsl)),
+                                                                                        std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                            graphics::Vertex::Attribute::Usage::position,
+                                                                                            graphics::Vertex::Attribute::Usage::color,
+                                                                                            graphics::Vertex::Attribute::Usage::textureCoordinates0,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceTransform,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceColor
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                            {"color", graphics::DataType::float32Vector4}
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{});
+                            break;
+                        case 3:
+                            textureInstancedShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                        std::vector<std::uint8_t>(std::begin(TexturePSGLES3_glsl),
+                                                                                                                  std::end(TexturePSGLES3_glsl)),
+                                                                                        std::vector<std::uint8_t>(std::begin(TextureInstancedVSGLES3_glsl),
+                                                                                                                  std::end(TextureInstancedVSGLES3_glsl)),
+                                                                                        std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                            graphics::Vertex::Attribute::Usage::position,
+                                                                                            graphics::Vertex::Attribute::Usage::color,
+                                                                                            graphics::Vertex::Attribute::Usage::textureCoordinates0,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceTransform,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceColor
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                            {"color", graphics::DataType::float32Vector4}
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{});
+                            break;
+#  else
+                        case 2:
+                            textureInstancedShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                        std::vector<std::uint8_t>(std::begin(TexturePSGL2_glsl),
+                                                                                                                  std::end(TexturePSGL2_glsl)),
+                                                                                        std::vector<std::uint8_t>(std::begin(TextureInstancedVSGL2_glsl),
+                                                                                                                  std::end(TextureInstancedVSGL2_glsl)),
+                                                                                        std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                            graphics::Vertex::Attribute::Usage::position,
+                                                                                            graphics::Vertex::Attribute::Usage::color,
+                                                                                            graphics::Vertex::Attribute::Usage::textureCoordinates0,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceTransform,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceColor
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                            {"color", graphics::DataType::float32Vector4}
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{});
+                            break;
+                        case 3:
+                            textureInstancedShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                        std::vector<std::uint8_t>(std::begin(TexturePSGL3_glsl),
+                                                                                                                  std::end(TexturePSGL3_glsl)),
+                                                                                        std::vector<std::uint8_t>(std::begin(TextureInstancedVSGL3_glsl),
+                                                                                                                  std::end(TextureInstancedVSGL3_glsl)),
+                                                                                        std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                            graphics::Vertex::Attribute::Usage::position,
+                                                                                            graphics::Vertex::Attribute::Usage::color,
+                                                                                            graphics::Vertex::Attribute::Usage::textureCoordinates0,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceTransform,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceColor
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                            {"color", graphics::DataType::float32Vector4}
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{});
+                            break;
+                        case 4:
+                            textureInstancedShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                                        std::vector<std::uint8_t>(std::begin(TexturePSGL4_glsl),
+                                                                                                                  std::end(TexturePSGL4_glsl)),
+                                                                                        std::vector<std::uint8_t>(std::begin(TextureInstancedVSGL4_glsl),
+                                                                                                                  std::end(TextureInstancedVSGL4_glsl)),
+                                                                                        std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                            graphics::Vertex::Attribute::Usage::position,
+                                                                                            graphics::Vertex::Attribute::Usage::color,
+                                                                                            graphics::Vertex::Attribute::Usage::textureCoordinates0,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceTransform,
+                                                                                            graphics::Vertex::Attribute::Usage::instanceColor
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                            {"color", graphics::DataType::float32Vector4}
+                                                                                        },
+                                                                                        std::vector<std::pair<std::string, graphics::DataType>>{});
+                            break;
+#  endif
+                        default:
+                            throw std::runtime_error("Unsupported OpenGL version");
+                    }
+
+                    assetBundle.setShader(shaderTextureInstanced, std::move(textureInstancedShader));
+                }
                 break;
             }
 #endif
@@ -469,6 +736,25 @@ namespace ouzel::core
 
                 assetBundle.setShader(shaderTexture, std::move(textureShader));
 
+                auto distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                              std::vector<std::uint8_t>(std::begin(DISTANCE_FIELD_PIXEL_SHADER_D3D11),
+                                                                                                        std::end(DISTANCE_FIELD_PIXEL_SHADER_D3D11)),
+                                                                              std::vector<std::uint8_t>(std::begin(TEXTURE_VERTEX_SHADER_D3D11),
+                                                                                                        std::end(TEXTURE_VERTEX_SHADER_D3D11)),
+                                                                              std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                  graphics::Vertex::Attribute::Usage::position,
+                                                                                  graphics::Vertex::Attribute::Usage::color,
+                                                                                  graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                              },
+                                                                              std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                  {"color", graphics::DataType::float32Vector4}
+                                                                              },
+                                                                              std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                  {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                              });
+
+                assetBundle.setShader(shaderDistanceField, std::move(distanceFieldShader));
+
                 auto colorShader = std::make_unique<graphics::Shader>(*graphics,
                                                                       std::vector<std::uint8_t>(std::begin(COLOR_PIXEL_SHADER_D3D11),
                                                                                                 std::end(COLOR_PIXEL_SHADER_D3D11)),
@@ -513,6 +799,26 @@ namespace ouzel::core
 
                 assetBundle.setShader(shaderTexture, std::move(textureShader));
 
+                auto distanceFieldShader = std::make_unique<graphics::Shader>(*graphics,
+                                                                              std::vector<std::uint8_t>(std::begin(DISTANCE_FIELD_PIXEL_SHADER_METAL),
+                                                                                                        std::end(DISTANCE_FIELD_PIXEL_SHADER_METAL)),
+                                                                              std::vector<std::uint8_t>(std::begin(TEXTURE_VERTEX_SHADER_METAL),
+                                                                                                        std::end(TEXTURE_VERTEX_SHADER_METAL)),
+                                                                              std::set<graphics::Vertex::Attribute::Usage>{
+                                                                                  graphics::Vertex::Attribute::Usage::position,
+                                                                                  graphics::Vertex::Attribute::Usage::color,
+                                                                                  graphics::Vertex::Attribute::Usage::textureCoordinates0
+                                                                              },
+                                                                              std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                  {"color", graphics::DataType::float32Vector4}
+                                                                              },
+                                                                              std::vector<std::pair<std::string, graphics::DataType>>{
+                                                                                  {"modelViewProj", graphics::DataType::float32Matrix4}
+                                                                              },
+                                                                              "mainPS", "mainVS");
+
+                assetBundle.setShader(shaderDistanceField, std::move(distanceFieldShader));
+
                 auto colorShader = std::make_unique<graphics::Shader>(*graphics,
                                                                       std::vector<std::uint8_t>(std::begin(COLOR_PIXEL_SHADER_METAL),
                                                                                                 std::end(COLOR_PIXEL_SHADER_METAL)),
@@ -725,6 +1031,8 @@ namespace ouzel::core
             updateEvent->type = Event::Type::update;
             updateEvent->delta = delta;
             eventDispatcher.dispatchEvent(std::move(updateEvent));
+
+            updateScheduler.update(delta);
         }
 
         inputManager->update();
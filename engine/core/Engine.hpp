@@ -16,10 +16,13 @@
 #include "../graphics/Graphics.hpp"
 #include "../audio/Audio.hpp"
 #include "../events/EventDispatcher.hpp"
+#include "../gui/GlyphAtlas.hpp"
 #include "../input/InputManager.hpp"
 #include "../scene/Scene.hpp"
 #include "../scene/SceneManager.hpp"
+#include "../scene/UpdateScheduler.hpp"
 #include "../storage/FileSystem.hpp"
+#include "../thread/JobSystem.hpp"
 #include "../assets/Bundle.hpp"
 #include "../assets/Cache.hpp"
 #include "../assets/Loader.hpp"
@@ -74,6 +77,14 @@ namespace ouzel::core
         [[nodiscard]] auto getGraphics() const noexcept { return graphics.get(); }
         [[nodiscard]] auto getAudio() const noexcept { return audio.get(); }
 
+        [[nodiscard]] auto getJobSystem() const noexcept { return jobSystem.get(); }
+
+        [[nodiscard]] auto& getGlyphAtlas() { return glyphAtlas; }
+        [[nodiscard]] auto& getGlyphAtlas() const { return glyphAtlas; }
+
+        [[nodiscard]] auto& getUpdateScheduler() { return updateScheduler; }
+        [[nodiscard]] auto& getUpdateScheduler() const { return updateScheduler; }
+
         [[nodiscard]] auto& getSceneManager() { return sceneManager; }
         [[nodiscard]] auto& getSceneManager() const { return sceneManager; }
 
@@ -130,9 +141,12 @@ namespace ouzel::core
         std::unique_ptr<graphics::Graphics> graphics;
         std::unique_ptr<audio::Audio> audio;
         std::unique_ptr<input::InputManager> inputManager;
+        std::unique_ptr<thread::JobSystem> jobSystem;
+        gui::GlyphAtlas glyphAtlas; // destroyed after the fonts and before the graphics
         Localization localization;
         assets::Cache cache;
         assets::Bundle assetBundle;
+        scene::UpdateScheduler updateScheduler; // destroyed after the scenes
         scene::SceneManager sceneManager;
         network::Network network;
 
@@ -158,6 +172,8 @@ namespace ouzel
 {
     const std::string shaderTexture = "shaderTexture";
     const std::string shaderColor = "shaderColor";
+    const std::string shaderDistanceField = "shaderDistanceField";
+    const std::string shaderTextureInstanced = "shaderTextureInstanced";
 
     const std::string blendNoBlend = "blendNoBlend";
     const std::string blendAdd = "blendAdd";
@@ -86,4 +86,9 @@
 #  define OUZEL_COMPILE_WASAPI 1
 #endif
 
+// Audio allocation check, aborts on the heap allocations while the audio is mixed
+#ifndef OUZEL_ENABLE_AUDIO_ALLOCATION_CHECK
+#  define OUZEL_ENABLE_AUDIO_ALLOCATION_CHECK 0
+#endif
+
 #endif // OUZEL_SETUP_H
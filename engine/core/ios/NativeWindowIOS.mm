@@ -80,6 +80,7 @@ namespace ouzel::core::ios
         switch (graphicsDriver)
         {
             case graphics::Driver::empty:
+            case graphics::Driver::software:
                 view = [[View alloc] initWithFrame:windowFrame];
                 break;
 #if OUZEL_COMPILE_OPENGL
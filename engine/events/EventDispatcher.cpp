@@ -13,12 +13,8 @@ namespace ouzel
             eventHandler->eventDispatcher = nullptr;
 
         for (EventHandler* eventHandler : eventHandlers)
-        {
-            const auto i = std::find(eventHandlerDeleteSet.begin(),
-                                     eventHandlerDeleteSet.end(),
-                                     eventHandler);
-            if (i == eventHandlerDeleteSet.end()) eventHandler->eventDispatcher = nullptr;
-        }
+            if (eventHandlerDeleteSet.find(eventHandler) == eventHandlerDeleteSet.end())
+                eventHandler->eventDispatcher = nullptr;
     }
 
     void EventDispatcher::dispatchEvents()
@@ -77,11 +73,7 @@ namespace ouzel
 
         for (const auto eventHandler : eventHandlers)
         {
-            const auto i = std::find(eventHandlerDeleteSet.begin(),
-                                     eventHandlerDeleteSet.end(),
-                                     eventHandler);
-
-            if (i == eventHandlerDeleteSet.end())
+            if (eventHandlerDeleteSet.find(eventHandler) == eventHandlerDeleteSet.end())
             {
                 switch (event->type)
                 {
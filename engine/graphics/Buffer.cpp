@@ -1,5 +1,6 @@
 // Ouzel by Elviss Strazdins
 
+#include <cstring>
 #include <stdexcept>
 #include "Buffer.hpp"
 #include "Graphics.hpp"
@@ -22,11 +23,11 @@ namespace ouzel::graphics
         flags(initFlags),
         size(initSize)
     {
-        initGraphics.addCommand(std::make_unique<InitBufferCommand>(resource,
-                                                                    initType,
-                                                                    initFlags,
-                                                                    std::vector<std::uint8_t>(),
-                                                                    initSize));
+        initGraphics.addCommand<InitBufferCommand>(resource,
+                                                   initType,
+                                                   initFlags,
+                                                   std::vector<std::uint8_t>(),
+                                                   initSize);
     }
 
     Buffer::Buffer(Graphics& initGraphics,
@@ -40,12 +41,12 @@ namespace ouzel::graphics
         flags(initFlags),
         size(initSize)
     {
-        initGraphics.addCommand(std::make_unique<InitBufferCommand>(resource,
-                                                                    initType,
-                                                                    initFlags,
-                                                                    std::vector<std::uint8_t>(static_cast<const std::uint8_t*>(initData),
-                                                                                              static_cast<const std::uint8_t*>(initData) + initSize),
-                                                                    initSize));
+        initGraphics.addCommand<InitBufferCommand>(resource,
+                                                   initType,
+                                                   initFlags,
+                                                   std::vector<std::uint8_t>(static_cast<const std::uint8_t*>(initData),
+                                                                             static_cast<const std::uint8_t*>(initData) + initSize),
+                                                   initSize);
     }
 
     Buffer::Buffer(Graphics& initGraphics,
@@ -62,32 +63,52 @@ namespace ouzel::graphics
         if (!initData.empty() && initSize != initData.size())
             throw std::runtime_error("Invalid buffer data");
 
-        initGraphics.addCommand(std::make_unique<InitBufferCommand>(resource,
-                                                                    initType,
-                                                                    initFlags,
-                                                                    initData,
-                                                                    initSize));
+        initGraphics.addCommand<InitBufferCommand>(resource,
+                                                   initType,
+                                                   initFlags,
+                                                   initData,
+                                                   initSize);
     }
 
     void Buffer::setData(const void* newData, std::uint32_t newSize)
     {
+        if ((flags & Flags::dynamic) != Flags::dynamic)
+            throw std::runtime_error("Buffer is not dynamic");
+
+        if (!newData || !newSize)
+            throw std::runtime_error("Invalid buffer data");
+
+        if (newSize > size) size = newSize;
+
         if (resource)
-            graphics->addCommand(std::make_unique<SetBufferDataCommand>(resource,
-                                                                        std::vector<std::uint8_t>(static_cast<const std::uint8_t*>(newData),
-                                                                                                  static_cast<const std::uint8_t*>(newData) + newSize)));
+        {
+            // the data is copied straight into the command buffer, the render device streams it from there
+            std::byte* data = graphics->allocateCommandData(newSize);
+            std::memcpy(data, newData, newSize);
+            graphics->addCommand<SetBufferDataCommand>(resource, data, newSize);
+        }
     }
 
-    void Buffer::setData(const std::vector<std::uint8_t>& newData)
+    void* Buffer::streamData(std::uint32_t newSize)
     {
         if ((flags & Flags::dynamic) != Flags::dynamic)
             throw std::runtime_error("Buffer is not dynamic");
 
-        if (newData.empty())
+        if (!newSize)
             throw std::runtime_error("Invalid buffer data");
 
-        if (newData.size() > size) size = static_cast<std::uint32_t>(newData.size());
+        if (!resource)
+            throw std::runtime_error("Buffer is not initialized");
 
-        if (resource)
-            graphics->addCommand(std::make_unique<SetBufferDataCommand>(resource, newData));
+        if (newSize > size) size = newSize;
+
+        std::byte* data = graphics->allocateCommandData(newSize);
+        graphics->addCommand<SetBufferDataCommand>(resource, data, newSize);
+        return data;
+    }
+
+    void Buffer::setData(const std::vector<std::uint8_t>& newData)
+    {
+        setData(newData.data(), static_cast<std::uint32_t>(newData.size()));
     }
 }
@@ -36,6 +36,10 @@ namespace ouzel::graphics
         void setData(const void* newData, std::uint32_t newSize);
         void setData(const std::vector<std::uint8_t>& newData);
 
+        // returns the memory for the new data of the buffer, which has to be filled before the frame is presented,
+        // so that the data can be written straight into the command buffer without an intermediate copy
+        void* streamData(std::uint32_t newSize);
+
         auto& getResource() const noexcept { return resource; }
 
         auto getType() const noexcept { return type; }
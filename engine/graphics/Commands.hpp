@@ -3,8 +3,17 @@
 #ifndef OUZEL_GRAPHICS_COMMANDS_HPP
 #define OUZEL_GRAPHICS_COMMANDS_HPP
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <set>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "BlendFactor.hpp"
 #include "BlendOperation.hpp"
 #include "BufferType.hpp"
@@ -45,6 +54,7 @@ namespace ouzel::graphics
             setDepthStencilState,
             setPipelineState,
             draw,
+            drawInstanced,
             initBlendState,
             initBuffer,
             setBufferData,
@@ -71,8 +81,6 @@ namespace ouzel::graphics
         {
         }
 
-        virtual ~Command() = default;
-
         const Type type;
     };
 
@@ -307,6 +315,39 @@ namespace ouzel::graphics
         const std::uint32_t startIndex;
     };
 
+    class DrawInstancedCommand final: public Command
+    {
+    public:
+        constexpr DrawInstancedCommand(ResourceId initIndexBuffer,
+                                       std::uint32_t initIndexCount,
+                                       std::uint32_t initIndexSize,
+                                       ResourceId initVertexBuffer,
+                                       ResourceId initInstanceBuffer,
+                                       std::uint32_t initInstanceCount,
+                                       DrawMode initDrawMode,
+                                       std::uint32_t initStartIndex) noexcept:
+            Command{Command::Type::drawInstanced},
+            indexBuffer{initIndexBuffer},
+            indexCount{initIndexCount},
+            indexSize{initIndexSize},
+            vertexBuffer{initVertexBuffer},
+            instanceBuffer{initInstanceBuffer},
+            instanceCount{initInstanceCount},
+            drawMode{initDrawMode},
+            startIndex{initStartIndex}
+        {
+        }
+
+        const ResourceId indexBuffer;
+        const std::uint32_t indexCount;
+        const std::uint32_t indexSize;
+        const ResourceId vertexBuffer;
+        const ResourceId instanceBuffer; // RenderDevice::instanceAttributes of every instance
+        const std::uint32_t instanceCount;
+        const DrawMode drawMode;
+        const std::uint32_t startIndex;
+    };
+
     class InitBlendStateCommand final: public Command
     {
     public:
@@ -370,16 +411,19 @@ namespace ouzel::graphics
     class SetBufferDataCommand final: public Command
     {
     public:
-        SetBufferDataCommand(ResourceId initBuffer,
-                             const std::vector<std::uint8_t>& initData) noexcept(false):
+        constexpr SetBufferDataCommand(ResourceId initBuffer,
+                                       const std::byte* initData,
+                                       std::uint32_t initSize) noexcept:
             Command{Command::Type::setBufferData},
             buffer{initBuffer},
-            data{initData}
+            data{initData},
+            size{initSize}
         {
         }
 
         const ResourceId buffer;
-        const std::vector<std::uint8_t> data;
+        const std::byte* const data; // points to the data allocated in the command buffer
+        const std::uint32_t size;
     };
 
     class InitShaderCommand final: public Command
@@ -415,19 +459,29 @@ namespace ouzel::graphics
         const std::string vertexShaderFunction;
     };
 
+    struct ShaderConstant final
+    {
+        std::uint32_t offset; // offset in the command buffer's shader constant data
+        std::uint32_t size;
+    };
+
     class SetShaderConstantsCommand final: public Command
     {
     public:
-        SetShaderConstantsCommand(std::vector<std::vector<float>> initFragmentShaderConstants,
-                                  std::vector<std::vector<float>> initVertexShaderConstants) noexcept(false):
+        constexpr SetShaderConstantsCommand(std::uint32_t initFirstShaderConstant,
+                                            std::uint32_t initFragmentShaderConstantCount,
+                                            std::uint32_t initVertexShaderConstantCount) noexcept:
             Command{Command::Type::setShaderConstants},
-            fragmentShaderConstants{initFragmentShaderConstants},
-            vertexShaderConstants{initVertexShaderConstants}
+            firstShaderConstant{initFirstShaderConstant},
+            fragmentShaderConstantCount{initFragmentShaderConstantCount},
+            vertexShaderConstantCount{initVertexShaderConstantCount}
         {
         }
 
-        const std::vector<std::vector<float>> fragmentShaderConstants;
-        const std::vector<std::vector<float>> vertexShaderConstants;
+        // fragment shader constants are followed by vertex shader constants in the command buffer
+        const std::uint32_t firstShaderConstant;
+        const std::uint32_t fragmentShaderConstantCount;
+        const std::uint32_t vertexShaderConstantCount;
     };
 
     class InitTextureCommand final: public Command
@@ -534,37 +588,291 @@ namespace ouzel::graphics
 
     class CommandBuffer final
     {
+        // commands are placement-constructed into memory blocks that are kept
+        // between frames, each command is preceded by an entry that links it to the next one
+        struct Entry final
+        {
+            Entry* next = nullptr;
+            Command* command = nullptr;
+            void (*destroy)(Command*) noexcept = nullptr;
+        };
+
+        static constexpr std::size_t alignment = alignof(std::max_align_t);
+        static constexpr std::size_t blockSize = 65536;
+
+        static constexpr std::size_t alignSize(std::size_t size) noexcept
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        template <class T>
+        static void destroyCommand(Command* command) noexcept
+        {
+            static_cast<T*>(command)->~T();
+        }
+
     public:
+        class ConstIterator final
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Command;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Command*;
+            using reference = const Command&;
+
+            explicit constexpr ConstIterator(const Entry* initEntry = nullptr) noexcept:
+                entry{initEntry}
+            {
+            }
+
+            reference operator*() const noexcept { return *entry->command; }
+            pointer operator->() const noexcept { return entry->command; }
+
+            ConstIterator& operator++() noexcept
+            {
+                entry = entry->next;
+                return *this;
+            }
+
+            ConstIterator operator++(int) noexcept
+            {
+                ConstIterator result = *this;
+                entry = entry->next;
+                return result;
+            }
+
+            bool operator==(const ConstIterator& other) const noexcept { return entry == other.entry; }
+            bool operator!=(const ConstIterator& other) const noexcept { return entry != other.entry; }
+
+        private:
+            const Entry* entry;
+        };
+
+        static constexpr std::size_t commandTypeCount = static_cast<std::size_t>(Command::Type::setLightParameters) + 1;
+
         CommandBuffer() = default;
-        explicit CommandBuffer(const std::string& initName) noexcept(false):
+
+        // the name is not copied and ends up in the frame stats, which can be read long after
+        // the buffer is gone, so it must be a string literal
+        explicit CommandBuffer(const char* initName) noexcept:
             name{initName}
         {
         }
 
-        auto& getName() const noexcept { return name; }
+        ~CommandBuffer()
+        {
+            clear();
+        }
 
-        auto isEmpty() const noexcept { return commands.empty(); }
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        CommandBuffer(CommandBuffer&& other) noexcept:
+            name{other.name},
+            shaderConstants{std::move(other.shaderConstants)},
+            shaderConstantData{std::move(other.shaderConstantData)},
+            blocks{std::move(other.blocks)},
+            currentBlock{other.currentBlock},
+            blockOffset{other.blockOffset},
+            firstEntry{other.firstEntry},
+            lastEntry{other.lastEntry},
+            commandCount{other.commandCount},
+            commandCounts{other.commandCounts},
+            bufferUploadSize{other.bufferUploadSize},
+            textureUploadSize{other.textureUploadSize}
+        {
+            other.shaderConstants.clear();
+            other.shaderConstantData.clear();
+            other.blocks.clear();
+            other.currentBlock = 0;
+            other.blockOffset = 0;
+            other.firstEntry = nullptr;
+            other.lastEntry = nullptr;
+            other.commandCount = 0;
+            other.commandCounts.fill(0);
+            other.bufferUploadSize = 0;
+            other.textureUploadSize = 0;
+        }
 
-        void pushCommand(std::unique_ptr<Command> command)
+        CommandBuffer& operator=(CommandBuffer&& other) noexcept
         {
-            commands.push(std::move(command));
+            if (&other == this) return *this;
+
+            clear();
+
+            name = other.name;
+            shaderConstants = std::move(other.shaderConstants);
+            shaderConstantData = std::move(other.shaderConstantData);
+            blocks = std::move(other.blocks);
+            currentBlock = other.currentBlock;
+            blockOffset = other.blockOffset;
+            firstEntry = other.firstEntry;
+            lastEntry = other.lastEntry;
+            commandCount = other.commandCount;
+            commandCounts = other.commandCounts;
+            bufferUploadSize = other.bufferUploadSize;
+            textureUploadSize = other.textureUploadSize;
+
+            other.shaderConstants.clear();
+            other.shaderConstantData.clear();
+            other.blocks.clear();
+            other.currentBlock = 0;
+            other.blockOffset = 0;
+            other.firstEntry = nullptr;
+            other.lastEntry = nullptr;
+            other.commandCount = 0;
+            other.commandCounts.fill(0);
+            other.bufferUploadSize = 0;
+            other.textureUploadSize = 0;
+
+            return *this;
         }
 
-        std::unique_ptr<Command> popCommand()
+        auto getName() const noexcept { return name; }
+
+        auto isEmpty() const noexcept { return commandCount == 0; }
+        auto getCommandCount() const noexcept { return commandCount; }
+
+        // the counters are updated as the commands are pushed, so they are available without walking the buffer
+        auto& getCommandCounts() const noexcept { return commandCounts; }
+        auto getCommandCount(Command::Type type) const noexcept
         {
-            auto result = std::move(commands.front());
-            commands.pop();
-            return result;
+            return commandCounts[static_cast<std::size_t>(type)];
         }
+        auto getBufferUploadSize() const noexcept { return bufferUploadSize; } // bytes
+        auto getTextureUploadSize() const noexcept { return textureUploadSize; } // bytes
 
-        auto& getCommands() const
+        template <class T, class ...Args>
+        T& pushCommand(Args&&... args)
         {
-            return commands;
+            static_assert(std::is_base_of_v<Command, T>, "Type must derive from Command");
+            static_assert(alignof(T) <= alignment, "Command is overaligned");
+
+            std::byte* memory = allocate(alignSize(sizeof(Entry)) + alignSize(sizeof(T)));
+            T* command = new(memory + alignSize(sizeof(Entry))) T(std::forward<Args>(args)...);
+
+            Entry* entry = new(memory) Entry{};
+            entry->command = command;
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                entry->destroy = &destroyCommand<T>;
+
+            if (lastEntry)
+                lastEntry->next = entry;
+            else
+                firstEntry = entry;
+
+            lastEntry = entry;
+            ++commandCount;
+            ++commandCounts[static_cast<std::size_t>(command->type)];
+
+            if constexpr (std::is_same_v<T, InitBufferCommand>)
+                bufferUploadSize += command->data.size();
+            else if constexpr (std::is_same_v<T, SetBufferDataCommand>)
+                bufferUploadSize += command->size;
+            else if constexpr (std::is_same_v<T, InitTextureCommand> ||
+                               std::is_same_v<T, SetTextureDataCommand>)
+                for (const auto& level : command->levels)
+                    textureUploadSize += level.second.size();
+
+            return *command;
         }
 
+        // allocates memory for command data that lives as long as the commands
+        std::byte* allocateData(std::size_t size)
+        {
+            return allocate(alignSize(size));
+        }
+
+        // copies the constant to the buffer's shader constant data and returns its index
+        std::uint32_t addShaderConstant(const float* data, std::size_t size)
+        {
+            const auto index = static_cast<std::uint32_t>(shaderConstants.size());
+            shaderConstants.push_back(ShaderConstant{
+                static_cast<std::uint32_t>(shaderConstantData.size()),
+                static_cast<std::uint32_t>(size)
+            });
+            shaderConstantData.insert(shaderConstantData.end(), data, data + size);
+            return index;
+        }
+
+        auto getShaderConstantCount() const noexcept
+        {
+            return static_cast<std::uint32_t>(shaderConstants.size());
+        }
+
+        auto& getShaderConstant(std::uint32_t index) const noexcept
+        {
+            return shaderConstants[index];
+        }
+
+        const float* getShaderConstantData(const ShaderConstant& shaderConstant) const noexcept
+        {
+            return shaderConstantData.data() + shaderConstant.offset;
+        }
+
+        // destroys all of the commands, but keeps the memory for the next frame
+        void clear() noexcept
+        {
+            for (Entry* entry = firstEntry; entry; entry = entry->next)
+                if (entry->destroy) entry->destroy(entry->command);
+
+            firstEntry = nullptr;
+            lastEntry = nullptr;
+            commandCount = 0;
+            commandCounts.fill(0);
+            bufferUploadSize = 0;
+            textureUploadSize = 0;
+            currentBlock = 0;
+            blockOffset = 0;
+
+            shaderConstants.clear();
+            shaderConstantData.clear();
+        }
+
+        ConstIterator begin() const noexcept { return ConstIterator{firstEntry}; }
+        ConstIterator end() const noexcept { return ConstIterator{}; }
+
     private:
-        std::string name;
-        std::queue<std::unique_ptr<Command>> commands;
+        struct Block final
+        {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size = 0;
+        };
+
+        std::byte* allocate(std::size_t size)
+        {
+            while (currentBlock < blocks.size() &&
+                   blockOffset + size > blocks[currentBlock].size)
+            {
+                ++currentBlock;
+                blockOffset = 0;
+            }
+
+            if (currentBlock == blocks.size())
+            {
+                const std::size_t newBlockSize = std::max(blockSize, size);
+                blocks.push_back(Block{std::make_unique<std::byte[]>(newBlockSize), newBlockSize});
+                blockOffset = 0;
+            }
+
+            std::byte* result = blocks[currentBlock].data.get() + blockOffset;
+            blockOffset += size;
+            return result;
+        }
+
+        const char* name = "";
+        std::vector<ShaderConstant> shaderConstants;
+        std::vector<float> shaderConstantData;
+        std::vector<Block> blocks;
+        std::size_t currentBlock = 0;
+        std::size_t blockOffset = 0;
+        Entry* firstEntry = nullptr;
+        Entry* lastEntry = nullptr;
+        std::size_t commandCount = 0;
+        std::array<std::uint32_t, commandTypeCount> commandCounts{};
+        std::uint64_t bufferUploadSize = 0;
+        std::uint64_t textureUploadSize = 0;
     };
 }
 
@@ -41,20 +41,20 @@ namespace ouzel::graphics
         backFaceStencilPassOperation(initBackFaceStencilPassOperation),
         backFaceStencilCompareFunction(initBackFaceStencilCompareFunction)
     {
-        initGraphics.addCommand(std::make_unique<InitDepthStencilStateCommand>(resource,
-                                                                               initDepthTest,
-                                                                               initDepthWrite,
-                                                                               initCompareFunction,
-                                                                               initStencilEnabled,
-                                                                               initStencilReadMask,
-                                                                               initStencilWriteMask,
-                                                                               initFrontFaceStencilFailureOperation,
-                                                                               initFrontFaceStencilDepthFailureOperation,
-                                                                               initFrontFaceStencilPassOperation,
-                                                                               initFrontFaceStencilCompareFunction,
-                                                                               initBackFaceStencilFailureOperation,
-                                                                               initBackFaceStencilDepthFailureOperation,
-                                                                               initBackFaceStencilPassOperation,
-                                                                               initBackFaceStencilCompareFunction));
+        initGraphics.addCommand<InitDepthStencilStateCommand>(resource,
+                                                              initDepthTest,
+                                                              initDepthWrite,
+                                                              initCompareFunction,
+                                                              initStencilEnabled,
+                                                              initStencilReadMask,
+                                                              initStencilWriteMask,
+                                                              initFrontFaceStencilFailureOperation,
+                                                              initFrontFaceStencilDepthFailureOperation,
+                                                              initFrontFaceStencilPassOperation,
+                                                              initFrontFaceStencilCompareFunction,
+                                                              initBackFaceStencilFailureOperation,
+                                                              initBackFaceStencilDepthFailureOperation,
+                                                              initBackFaceStencilPassOperation,
+                                                              initBackFaceStencilCompareFunction);
     }
 }
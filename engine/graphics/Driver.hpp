@@ -8,6 +8,7 @@ namespace ouzel::graphics
     enum class Driver
     {
         empty,
+        software,
         openGL,
         direct3D11,
         metal
@@ -0,0 +1,876 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include "FrameCapture.hpp"
+#include "../utils/Utils.hpp"
+
+namespace ouzel::graphics
+{
+    namespace
+    {
+        constexpr std::uint8_t magic[] = {'O', 'Z', 'C', 'P'};
+        constexpr std::uint32_t version = 2;
+
+        using TextureLevels = std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>>;
+
+        void writeUInt8(std::vector<std::uint8_t>& data, std::uint8_t value)
+        {
+            data.push_back(value);
+        }
+
+        void writeUInt32(std::vector<std::uint8_t>& data, std::uint32_t value)
+        {
+            std::uint8_t buffer[sizeof(value)];
+            encodeLittleEndian<std::uint32_t>(buffer, value);
+            data.insert(data.end(), std::begin(buffer), std::end(buffer));
+        }
+
+        void writeUInt64(std::vector<std::uint8_t>& data, std::uint64_t value)
+        {
+            std::uint8_t buffer[sizeof(value)];
+            encodeLittleEndian<std::uint64_t>(buffer, value);
+            data.insert(data.end(), std::begin(buffer), std::end(buffer));
+        }
+
+        void writeBool(std::vector<std::uint8_t>& data, bool value)
+        {
+            writeUInt8(data, value ? 1 : 0);
+        }
+
+        void writeFloat(std::vector<std::uint8_t>& data, float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            writeUInt32(data, bits);
+        }
+
+        template <class T>
+        void writeEnum(std::vector<std::uint8_t>& data, T value)
+        {
+            writeUInt32(data, static_cast<std::uint32_t>(value));
+        }
+
+        void writeResource(std::vector<std::uint8_t>& data, ResourceId resource)
+        {
+            writeUInt64(data, static_cast<std::uint64_t>(resource));
+        }
+
+        void writeBytes(std::vector<std::uint8_t>& data, const void* bytes, std::size_t size)
+        {
+            writeUInt32(data, static_cast<std::uint32_t>(size));
+            const auto begin = static_cast<const std::uint8_t*>(bytes);
+            data.insert(data.end(), begin, begin + size);
+        }
+
+        void writeString(std::vector<std::uint8_t>& data, const std::string& value)
+        {
+            writeBytes(data, value.data(), value.size());
+        }
+
+        void writeColor(std::vector<std::uint8_t>& data, Color color)
+        {
+            for (const auto component : color.v)
+                writeUInt8(data, component);
+        }
+
+        void writeRect(std::vector<std::uint8_t>& data, const Rect<float>& rect)
+        {
+            writeFloat(data, rect.position.v[0]);
+            writeFloat(data, rect.position.v[1]);
+            writeFloat(data, rect.size.v[0]);
+            writeFloat(data, rect.size.v[1]);
+        }
+
+        void writeShaderConstantInfo(std::vector<std::uint8_t>& data,
+                                     const std::vector<std::pair<std::string, DataType>>& constantInfo)
+        {
+            writeUInt32(data, static_cast<std::uint32_t>(constantInfo.size()));
+            for (const auto& [name, dataType] : constantInfo)
+            {
+                writeString(data, name);
+                writeEnum(data, dataType);
+            }
+        }
+
+        void writeLevels(std::vector<std::uint8_t>& data, const TextureLevels& levels)
+        {
+            writeUInt32(data, static_cast<std::uint32_t>(levels.size()));
+            for (const auto& [levelSize, levelData] : levels)
+            {
+                writeUInt32(data, levelSize.v[0]);
+                writeUInt32(data, levelSize.v[1]);
+                writeBytes(data, levelData.data(), levelData.size());
+            }
+        }
+
+        void writeCommand(std::vector<std::uint8_t>& data, const Command& command)
+        {
+            writeEnum(data, command.type);
+
+            switch (command.type)
+            {
+                case Command::Type::resize:
+                {
+                    auto resizeCommand = static_cast<const ResizeCommand*>(&command);
+                    writeUInt32(data, resizeCommand->size.v[0]);
+                    writeUInt32(data, resizeCommand->size.v[1]);
+                    break;
+                }
+
+                case Command::Type::present:
+                    break;
+
+                case Command::Type::deleteResource:
+                {
+                    auto deleteResourceCommand = static_cast<const DeleteResourceCommand*>(&command);
+                    writeResource(data, deleteResourceCommand->resource);
+                    break;
+                }
+
+                case Command::Type::initRenderTarget:
+                {
+                    auto initRenderTargetCommand = static_cast<const InitRenderTargetCommand*>(&command);
+                    writeResource(data, initRenderTargetCommand->renderTarget);
+                    writeUInt32(data, static_cast<std::uint32_t>(initRenderTargetCommand->colorTextures.size()));
+                    for (const auto colorTexture : initRenderTargetCommand->colorTextures)
+                        writeResource(data, colorTexture);
+                    writeResource(data, initRenderTargetCommand->depthTexture);
+                    break;
+                }
+
+                case Command::Type::setRenderTarget:
+                {
+                    auto setRenderTargetCommand = static_cast<const SetRenderTargetCommand*>(&command);
+                    writeResource(data, setRenderTargetCommand->renderTarget);
+                    break;
+                }
+
+                case Command::Type::clearRenderTarget:
+                {
+                    auto clearCommand = static_cast<const ClearRenderTargetCommand*>(&command);
+                    writeBool(data, clearCommand->clearColorBuffer);
+                    writeBool(data, clearCommand->clearDepthBuffer);
+                    writeBool(data, clearCommand->clearStencilBuffer);
+                    writeColor(data, clearCommand->clearColor);
+                    writeFloat(data, clearCommand->clearDepth);
+                    writeUInt32(data, clearCommand->clearStencil);
+                    break;
+                }
+
+                case Command::Type::setScissorTest:
+                {
+                    auto setScissorTestCommand = static_cast<const SetScissorTestCommand*>(&command);
+                    writeBool(data, setScissorTestCommand->enabled);
+                    writeRect(data, setScissorTestCommand->rectangle);
+                    break;
+                }
+
+                case Command::Type::setViewport:
+                {
+                    auto setViewportCommand = static_cast<const SetViewportCommand*>(&command);
+                    writeRect(data, setViewportCommand->viewport);
+                    break;
+                }
+
+                case Command::Type::initDepthStencilState:
+                {
+                    auto initDepthStencilStateCommand = static_cast<const InitDepthStencilStateCommand*>(&command);
+                    writeResource(data, initDepthStencilStateCommand->depthStencilState);
+                    writeBool(data, initDepthStencilStateCommand->depthTest);
+                    writeBool(data, initDepthStencilStateCommand->depthWrite);
+                    writeEnum(data, initDepthStencilStateCommand->compareFunction);
+                    writeBool(data, initDepthStencilStateCommand->stencilEnabled);
+                    writeUInt32(data, initDepthStencilStateCommand->stencilReadMask);
+                    writeUInt32(data, initDepthStencilStateCommand->stencilWriteMask);
+                    writeEnum(data, initDepthStencilStateCommand->frontFaceStencilFailureOperation);
+                    writeEnum(data, initDepthStencilStateCommand->frontFaceStencilDepthFailureOperation);
+                    writeEnum(data, initDepthStencilStateCommand->frontFaceStencilPassOperation);
+                    writeEnum(data, initDepthStencilStateCommand->frontFaceStencilCompareFunction);
+                    writeEnum(data, initDepthStencilStateCommand->backFaceStencilFailureOperation);
+                    writeEnum(data, initDepthStencilStateCommand->backFaceStencilDepthFailureOperation);
+                    writeEnum(data, initDepthStencilStateCommand->backFaceStencilPassOperation);
+                    writeEnum(data, initDepthStencilStateCommand->backFaceStencilCompareFunction);
+                    break;
+                }
+
+                case Command::Type::setDepthStencilState:
+                {
+                    auto setDepthStencilStateCommand = static_cast<const SetDepthStencilStateCommand*>(&command);
+                    writeResource(data, setDepthStencilStateCommand->depthStencilState);
+                    writeUInt32(data, setDepthStencilStateCommand->stencilReferenceValue);
+                    break;
+                }
+
+                case Command::Type::setPipelineState:
+                {
+                    auto setPipelineStateCommand = static_cast<const SetPipelineStateCommand*>(&command);
+                    writeResource(data, setPipelineStateCommand->blendState);
+                    writeResource(data, setPipelineStateCommand->shader);
+                    writeEnum(data, setPipelineStateCommand->cullMode);
+                    writeEnum(data, setPipelineStateCommand->fillMode);
+                    break;
+                }
+
+                case Command::Type::draw:
+                {
+                    auto drawCommand = static_cast<const DrawCommand*>(&command);
+                    writeResource(data, drawCommand->indexBuffer);
+                    writeUInt32(data, drawCommand->indexCount);
+                    writeUInt32(data, drawCommand->indexSize);
+                    writeResource(data, drawCommand->vertexBuffer);
+                    writeEnum(data, drawCommand->drawMode);
+                    writeUInt32(data, drawCommand->startIndex);
+                    break;
+                }
+
+                case Command::Type::drawInstanced:
+                {
+                    auto drawInstancedCommand = static_cast<const DrawInstancedCommand*>(&command);
+                    writeResource(data, drawInstancedCommand->indexBuffer);
+                    writeUInt32(data, drawInstancedCommand->indexCount);
+                    writeUInt32(data, drawInstancedCommand->indexSize);
+                    writeResource(data, drawInstancedCommand->vertexBuffer);
+                    writeResource(data, drawInstancedCommand->instanceBuffer);
+                    writeUInt32(data, drawInstancedCommand->instanceCount);
+                    writeEnum(data, drawInstancedCommand->drawMode);
+                    writeUInt32(data, drawInstancedCommand->startIndex);
+                    break;
+                }
+
+                case Command::Type::initBlendState:
+                {
+                    auto initBlendStateCommand = static_cast<const InitBlendStateCommand*>(&command);
+                    writeResource(data, initBlendStateCommand->blendState);
+                    writeBool(data, initBlendStateCommand->enableBlending);
+                    writeEnum(data, initBlendStateCommand->colorBlendSource);
+                    writeEnum(data, initBlendStateCommand->colorBlendDest);
+                    writeEnum(data, initBlendStateCommand->colorOperation);
+                    writeEnum(data, initBlendStateCommand->alphaBlendSource);
+                    writeEnum(data, initBlendStateCommand->alphaBlendDest);
+                    writeEnum(data, initBlendStateCommand->alphaOperation);
+                    writeEnum(data, initBlendStateCommand->colorMask);
+                    break;
+                }
+
+                case Command::Type::initBuffer:
+                {
+                    auto initBufferCommand = static_cast<const InitBufferCommand*>(&command);
+                    writeResource(data, initBufferCommand->buffer);
+                    writeEnum(data, initBufferCommand->bufferType);
+                    writeEnum(data, initBufferCommand->flags);
+                    writeBytes(data, initBufferCommand->data.data(), initBufferCommand->data.size());
+                    writeUInt32(data, initBufferCommand->size);
+                    break;
+                }
+
+                case Command::Type::setBufferData:
+                {
+                    auto setBufferDataCommand = static_cast<const SetBufferDataCommand*>(&command);
+                    writeResource(data, setBufferDataCommand->buffer);
+                    writeBytes(data, setBufferDataCommand->data, setBufferDataCommand->size);
+                    break;
+                }
+
+                case Command::Type::initShader:
+                {
+                    auto initShaderCommand = static_cast<const InitShaderCommand*>(&command);
+                    writeResource(data, initShaderCommand->shader);
+                    writeBytes(data, initShaderCommand->fragmentShader.data(), initShaderCommand->fragmentShader.size());
+                    writeBytes(data, initShaderCommand->vertexShader.data(), initShaderCommand->vertexShader.size());
+                    writeUInt32(data, static_cast<std::uint32_t>(initShaderCommand->vertexAttributes.size()));
+                    for (const auto vertexAttribute : initShaderCommand->vertexAttributes)
+                        writeEnum(data, vertexAttribute);
+                    writeShaderConstantInfo(data, initShaderCommand->fragmentShaderConstantInfo);
+                    writeShaderConstantInfo(data, initShaderCommand->vertexShaderConstantInfo);
+                    writeString(data, initShaderCommand->fragmentShaderFunction);
+                    writeString(data, initShaderCommand->vertexShaderFunction);
+                    break;
+                }
+
+                case Command::Type::setShaderConstants:
+                {
+                    auto setShaderConstantsCommand = static_cast<const SetShaderConstantsCommand*>(&command);
+                    writeUInt32(data, setShaderConstantsCommand->firstShaderConstant);
+                    writeUInt32(data, setShaderConstantsCommand->fragmentShaderConstantCount);
+                    writeUInt32(data, setShaderConstantsCommand->vertexShaderConstantCount);
+                    break;
+                }
+
+                case Command::Type::initTexture:
+                {
+                    auto initTextureCommand = static_cast<const InitTextureCommand*>(&command);
+                    writeResource(data, initTextureCommand->texture);
+                    writeLevels(data, initTextureCommand->levels);
+                    writeEnum(data, initTextureCommand->textureType);
+                    writeEnum(data, initTextureCommand->flags);
+                    writeUInt32(data, initTextureCommand->sampleCount);
+                    writeEnum(data, initTextureCommand->pixelFormat);
+                    writeEnum(data, initTextureCommand->filter);
+                    writeUInt32(data, initTextureCommand->maxAnisotropy);
+                    break;
+                }
+
+                case Command::Type::setTextureData:
+                {
+                    auto setTextureDataCommand = static_cast<const SetTextureDataCommand*>(&command);
+                    writeResource(data, setTextureDataCommand->texture);
+                    writeLevels(data, setTextureDataCommand->levels);
+                    writeEnum(data, setTextureDataCommand->face);
+                    break;
+                }
+
+                case Command::Type::setTextureParameters:
+                {
+                    auto setTextureParametersCommand = static_cast<const SetTextureParametersCommand*>(&command);
+                    writeResource(data, setTextureParametersCommand->texture);
+                    writeEnum(data, setTextureParametersCommand->filter);
+                    writeEnum(data, setTextureParametersCommand->addressX);
+                    writeEnum(data, setTextureParametersCommand->addressY);
+                    writeEnum(data, setTextureParametersCommand->addressZ);
+                    writeColor(data, setTextureParametersCommand->borderColor);
+                    writeUInt32(data, setTextureParametersCommand->maxAnisotropy);
+                    break;
+                }
+
+                case Command::Type::setTextures:
+                {
+                    auto setTexturesCommand = static_cast<const SetTexturesCommand*>(&command);
+                    writeUInt32(data, static_cast<std::uint32_t>(setTexturesCommand->textures.size()));
+                    for (const auto texture : setTexturesCommand->textures)
+                        writeResource(data, texture);
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("Command can not be captured");
+            }
+        }
+
+        class FrameDecoder final
+        {
+        public:
+            explicit FrameDecoder(const std::vector<std::uint8_t>& initData) noexcept:
+                data{initData}
+            {
+            }
+
+            std::uint8_t readUInt8()
+            {
+                return *read(sizeof(std::uint8_t));
+            }
+
+            std::uint32_t readUInt32()
+            {
+                return decodeLittleEndian<std::uint32_t>(read(sizeof(std::uint32_t)));
+            }
+
+            std::uint64_t readUInt64()
+            {
+                return decodeLittleEndian<std::uint64_t>(read(sizeof(std::uint64_t)));
+            }
+
+            bool readBool()
+            {
+                return readUInt8() != 0;
+            }
+
+            float readFloat()
+            {
+                const auto bits = readUInt32();
+                float result;
+                std::memcpy(&result, &bits, sizeof(result));
+                return result;
+            }
+
+            template <class T>
+            T readEnum()
+            {
+                return static_cast<T>(readUInt32());
+            }
+
+            ResourceId readResource()
+            {
+                return static_cast<ResourceId>(readUInt64());
+            }
+
+            // returns a pointer to the bytes in the frame data
+            const std::uint8_t* readBytes(std::uint32_t& size)
+            {
+                size = readUInt32();
+                return read(size);
+            }
+
+            std::vector<std::uint8_t> readByteVector()
+            {
+                std::uint32_t size;
+                const auto bytes = readBytes(size);
+                return std::vector<std::uint8_t>(bytes, bytes + size);
+            }
+
+            std::string readString()
+            {
+                std::uint32_t size;
+                const auto bytes = readBytes(size);
+                return std::string(bytes, bytes + size);
+            }
+
+            Color readColor()
+            {
+                const auto red = readUInt8();
+                const auto green = readUInt8();
+                const auto blue = readUInt8();
+                const auto alpha = readUInt8();
+                return Color{red, green, blue, alpha};
+            }
+
+            Rect<float> readRect()
+            {
+                const auto x = readFloat();
+                const auto y = readFloat();
+                const auto width = readFloat();
+                const auto height = readFloat();
+                return Rect<float>{x, y, width, height};
+            }
+
+            std::vector<std::pair<std::string, DataType>> readShaderConstantInfo()
+            {
+                std::vector<std::pair<std::string, DataType>> result(readUInt32());
+                for (auto& [name, dataType] : result)
+                {
+                    name = readString();
+                    dataType = readEnum<DataType>();
+                }
+                return result;
+            }
+
+            TextureLevels readLevels()
+            {
+                TextureLevels result(readUInt32());
+                for (auto& [levelSize, levelData] : result)
+                {
+                    levelSize.v[0] = readUInt32();
+                    levelSize.v[1] = readUInt32();
+                    levelData = readByteVector();
+                }
+                return result;
+            }
+
+            bool isEnd() const noexcept { return offset == data.size(); }
+
+        private:
+            const std::uint8_t* read(std::size_t size)
+            {
+                if (data.size() - offset < size)
+                    throw std::runtime_error("Invalid capture file");
+
+                const auto result = data.data() + offset;
+                offset += size;
+                return result;
+            }
+
+            const std::vector<std::uint8_t>& data;
+            std::size_t offset = 0;
+        };
+
+        // the arguments are read into locals first, because the evaluation order of function arguments is unspecified
+        void readCommand(FrameDecoder& decoder, CommandBuffer& commandBuffer)
+        {
+            switch (decoder.readEnum<Command::Type>())
+            {
+                case Command::Type::resize:
+                {
+                    const auto width = decoder.readUInt32();
+                    const auto height = decoder.readUInt32();
+                    commandBuffer.pushCommand<ResizeCommand>(Size<std::uint32_t, 2>{width, height});
+                    break;
+                }
+
+                case Command::Type::present:
+                    commandBuffer.pushCommand<PresentCommand>();
+                    break;
+
+                case Command::Type::deleteResource:
+                    commandBuffer.pushCommand<DeleteResourceCommand>(decoder.readResource());
+                    break;
+
+                case Command::Type::initRenderTarget:
+                {
+                    const auto renderTarget = decoder.readResource();
+                    std::set<std::size_t> colorTextures;
+                    for (auto i = decoder.readUInt32(); i > 0; --i)
+                        colorTextures.insert(decoder.readResource());
+                    const auto depthTexture = decoder.readResource();
+                    commandBuffer.pushCommand<InitRenderTargetCommand>(renderTarget, colorTextures, depthTexture);
+                    break;
+                }
+
+                case Command::Type::setRenderTarget:
+                    commandBuffer.pushCommand<SetRenderTargetCommand>(decoder.readResource());
+                    break;
+
+                case Command::Type::clearRenderTarget:
+                {
+                    const auto clearColorBuffer = decoder.readBool();
+                    const auto clearDepthBuffer = decoder.readBool();
+                    const auto clearStencilBuffer = decoder.readBool();
+                    const auto clearColor = decoder.readColor();
+                    const auto clearDepth = decoder.readFloat();
+                    const auto clearStencil = decoder.readUInt32();
+                    commandBuffer.pushCommand<ClearRenderTargetCommand>(clearColorBuffer,
+                                                                        clearDepthBuffer,
+                                                                        clearStencilBuffer,
+                                                                        clearColor,
+                                                                        clearDepth,
+                                                                        clearStencil);
+                    break;
+                }
+
+                case Command::Type::setScissorTest:
+                {
+                    const auto enabled = decoder.readBool();
+                    const auto rectangle = decoder.readRect();
+                    commandBuffer.pushCommand<SetScissorTestCommand>(enabled, rectangle);
+                    break;
+                }
+
+                case Command::Type::setViewport:
+                    commandBuffer.pushCommand<SetViewportCommand>(decoder.readRect());
+                    break;
+
+                case Command::Type::initDepthStencilState:
+                {
+                    const auto depthStencilState = decoder.readResource();
+                    const auto depthTest = decoder.readBool();
+                    const auto depthWrite = decoder.readBool();
+                    const auto compareFunction = decoder.readEnum<CompareFunction>();
+                    const auto stencilEnabled = decoder.readBool();
+                    const auto stencilReadMask = decoder.readUInt32();
+                    const auto stencilWriteMask = decoder.readUInt32();
+                    const auto frontFaceStencilFailureOperation = decoder.readEnum<StencilOperation>();
+                    const auto frontFaceStencilDepthFailureOperation = decoder.readEnum<StencilOperation>();
+                    const auto frontFaceStencilPassOperation = decoder.readEnum<StencilOperation>();
+                    const auto frontFaceStencilCompareFunction = decoder.readEnum<CompareFunction>();
+                    const auto backFaceStencilFailureOperation = decoder.readEnum<StencilOperation>();
+                    const auto backFaceStencilDepthFailureOperation = decoder.readEnum<StencilOperation>();
+                    const auto backFaceStencilPassOperation = decoder.readEnum<StencilOperation>();
+                    const auto backFaceStencilCompareFunction = decoder.readEnum<CompareFunction>();
+                    commandBuffer.pushCommand<InitDepthStencilStateCommand>(depthStencilState,
+                                                                            depthTest,
+                                                                            depthWrite,
+                                                                            compareFunction,
+                                                                            stencilEnabled,
+                                                                            stencilReadMask,
+                                                                            stencilWriteMask,
+                                                                            frontFaceStencilFailureOperation,
+                                                                            frontFaceStencilDepthFailureOperation,
+                                                                            frontFaceStencilPassOperation,
+                                                                            frontFaceStencilCompareFunction,
+                                                                            backFaceStencilFailureOperation,
+                                                                            backFaceStencilDepthFailureOperation,
+                                                                            backFaceStencilPassOperation,
+                                                                            backFaceStencilCompareFunction);
+                    break;
+                }
+
+                case Command::Type::setDepthStencilState:
+                {
+                    const auto depthStencilState = decoder.readResource();
+                    const auto stencilReferenceValue = decoder.readUInt32();
+                    commandBuffer.pushCommand<SetDepthStencilStateCommand>(depthStencilState, stencilReferenceValue);
+                    break;
+                }
+
+                case Command::Type::setPipelineState:
+                {
+                    const auto blendState = decoder.readResource();
+                    const auto shader = decoder.readResource();
+                    const auto cullMode = decoder.readEnum<CullMode>();
+                    const auto fillMode = decoder.readEnum<FillMode>();
+                    commandBuffer.pushCommand<SetPipelineStateCommand>(blendState, shader, cullMode, fillMode);
+                    break;
+                }
+
+                case Command::Type::draw:
+                {
+                    const auto indexBuffer = decoder.readResource();
+                    const auto indexCount = decoder.readUInt32();
+                    const auto indexSize = decoder.readUInt32();
+                    const auto vertexBuffer = decoder.readResource();
+                    const auto drawMode = decoder.readEnum<DrawMode>();
+                    const auto startIndex = decoder.readUInt32();
+                    commandBuffer.pushCommand<DrawCommand>(indexBuffer,
+                                                           indexCount,
+                                                           indexSize,
+                                                           vertexBuffer,
+                                                           drawMode,
+                                                           startIndex);
+                    break;
+                }
+
+                case Command::Type::drawInstanced:
+                {
+                    const auto indexBuffer = decoder.readResource();
+                    const auto indexCount = decoder.readUInt32();
+                    const auto indexSize = decoder.readUInt32();
+                    const auto vertexBuffer = decoder.readResource();
+                    const auto instanceBuffer = decoder.readResource();
+                    const auto instanceCount = decoder.readUInt32();
+                    const auto drawMode = decoder.readEnum<DrawMode>();
+                    const auto startIndex = decoder.readUInt32();
+                    commandBuffer.pushCommand<DrawInstancedCommand>(indexBuffer,
+                                                                    indexCount,
+                                                                    indexSize,
+                                                                    vertexBuffer,
+                                                                    instanceBuffer,
+                                                                    instanceCount,
+                                                                    drawMode,
+                                                                    startIndex);
+                    break;
+                }
+
+                case Command::Type::initBlendState:
+                {
+                    const auto blendState = decoder.readResource();
+                    const auto enableBlending = decoder.readBool();
+                    const auto colorBlendSource = decoder.readEnum<BlendFactor>();
+                    const auto colorBlendDest = decoder.readEnum<BlendFactor>();
+                    const auto colorOperation = decoder.readEnum<BlendOperation>();
+                    const auto alphaBlendSource = decoder.readEnum<BlendFactor>();
+                    const auto alphaBlendDest = decoder.readEnum<BlendFactor>();
+                    const auto alphaOperation = decoder.readEnum<BlendOperation>();
+                    const auto colorMask = decoder.readEnum<ColorMask>();
+                    commandBuffer.pushCommand<InitBlendStateCommand>(blendState,
+                                                                     enableBlending,
+                                                                     colorBlendSource,
+                                                                     colorBlendDest,
+                                                                     colorOperation,
+                                                                     alphaBlendSource,
+                                                                     alphaBlendDest,
+                                                                     alphaOperation,
+                                                                     colorMask);
+                    break;
+                }
+
+                case Command::Type::initBuffer:
+                {
+                    const auto buffer = decoder.readResource();
+                    const auto bufferType = decoder.readEnum<BufferType>();
+                    const auto flags = decoder.readEnum<Flags>();
+                    const auto data = decoder.readByteVector();
+                    const auto size = decoder.readUInt32();
+                    commandBuffer.pushCommand<InitBufferCommand>(buffer, bufferType, flags, data, size);
+                    break;
+                }
+
+                case Command::Type::setBufferData:
+                {
+                    const auto buffer = decoder.readResource();
+                    std::uint32_t size;
+                    const auto bytes = decoder.readBytes(size);
+                    std::byte* data = commandBuffer.allocateData(size);
+                    std::memcpy(data, bytes, size);
+                    commandBuffer.pushCommand<SetBufferDataCommand>(buffer, data, size);
+                    break;
+                }
+
+                case Command::Type::initShader:
+                {
+                    const auto shader = decoder.readResource();
+                    const auto fragmentShader = decoder.readByteVector();
+                    const auto vertexShader = decoder.readByteVector();
+                    std::set<Vertex::Attribute::Usage> vertexAttributes;
+                    for (auto i = decoder.readUInt32(); i > 0; --i)
+                        vertexAttributes.insert(decoder.readEnum<Vertex::Attribute::Usage>());
+                    const auto fragmentShaderConstantInfo = decoder.readShaderConstantInfo();
+                    const auto vertexShaderConstantInfo = decoder.readShaderConstantInfo();
+                    const auto fragmentShaderFunction = decoder.readString();
+                    const auto vertexShaderFunction = decoder.readString();
+                    commandBuffer.pushCommand<InitShaderCommand>(shader,
+                                                                 fragmentShader,
+                                                                 vertexShader,
+                                                                 vertexAttributes,
+                                                                 fragmentShaderConstantInfo,
+                                                                 vertexShaderConstantInfo,
+                                                                 fragmentShaderFunction,
+                                                                 vertexShaderFunction);
+                    break;
+                }
+
+                case Command::Type::setShaderConstants:
+                {
+                    const auto firstShaderConstant = decoder.readUInt32();
+                    const auto fragmentShaderConstantCount = decoder.readUInt32();
+                    const auto vertexShaderConstantCount = decoder.readUInt32();
+                    if (static_cast<std::uint64_t>(firstShaderConstant) + fragmentShaderConstantCount + vertexShaderConstantCount >
+                        commandBuffer.getShaderConstantCount())
+                        throw std::runtime_error("Invalid capture file");
+                    commandBuffer.pushCommand<SetShaderConstantsCommand>(firstShaderConstant,
+                                                                         fragmentShaderConstantCount,
+                                                                         vertexShaderConstantCount);
+                    break;
+                }
+
+                case Command::Type::initTexture:
+                {
+                    const auto texture = decoder.readResource();
+                    const auto levels = decoder.readLevels();
+                    const auto textureType = decoder.readEnum<TextureType>();
+                    const auto flags = decoder.readEnum<Flags>();
+                    const auto sampleCount = decoder.readUInt32();
+                    const auto pixelFormat = decoder.readEnum<PixelFormat>();
+                    const auto filter = decoder.readEnum<SamplerFilter>();
+                    const auto maxAnisotropy = decoder.readUInt32();
+                    commandBuffer.pushCommand<InitTextureCommand>(texture,
+                                                                  levels,
+                                                                  textureType,
+                                                                  flags,
+                                                                  sampleCount,
+                                                                  pixelFormat,
+                                                                  filter,
+                                                                  maxAnisotropy);
+                    break;
+                }
+
+                case Command::Type::setTextureData:
+                {
+                    const auto texture = decoder.readResource();
+                    const auto levels = decoder.readLevels();
+                    const auto face = decoder.readEnum<CubeFace>();
+                    commandBuffer.pushCommand<SetTextureDataCommand>(texture, levels, face);
+                    break;
+                }
+
+                case Command::Type::setTextureParameters:
+                {
+                    const auto texture = decoder.readResource();
+                    const auto filter = decoder.readEnum<SamplerFilter>();
+                    const auto addressX = decoder.readEnum<SamplerAddressMode>();
+                    const auto addressY = decoder.readEnum<SamplerAddressMode>();
+                    const auto addressZ = decoder.readEnum<SamplerAddressMode>();
+                    const auto borderColor = decoder.readColor();
+                    const auto maxAnisotropy = decoder.readUInt32();
+                    commandBuffer.pushCommand<SetTextureParametersCommand>(texture,
+                                                                           filter,
+                                                                           addressX,
+                                                                           addressY,
+                                                                           addressZ,
+                                                                           borderColor,
+                                                                           maxAnisotropy);
+                    break;
+                }
+
+                case Command::Type::setTextures:
+                {
+                    std::vector<ResourceId> textures(decoder.readUInt32());
+                    for (auto& texture : textures)
+                        texture = decoder.readResource();
+                    commandBuffer.pushCommand<SetTexturesCommand>(textures);
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("Invalid capture file");
+            }
+        }
+    }
+
+    FrameCaptureWriter::FrameCaptureWriter(const std::string& filename,
+                                           const Size<std::uint32_t, 2>& size):
+        file{filename, std::ios::binary | std::ios::trunc}
+    {
+        if (!file)
+            throw std::runtime_error("Failed to open file " + filename);
+
+        writeUInt32(frameData, version);
+        writeUInt32(frameData, size.v[0]);
+        writeUInt32(frameData, size.v[1]);
+
+        file.write(reinterpret_cast<const char*>(magic), sizeof(magic));
+        file.write(reinterpret_cast<const char*>(frameData.data()), static_cast<std::streamsize>(frameData.size()));
+    }
+
+    void FrameCaptureWriter::writeCommandBuffer(const CommandBuffer& commandBuffer)
+    {
+        frameData.clear();
+
+        writeUInt32(frameData, commandBuffer.getShaderConstantCount());
+        for (std::uint32_t i = 0; i < commandBuffer.getShaderConstantCount(); ++i)
+        {
+            const auto& shaderConstant = commandBuffer.getShaderConstant(i);
+            const float* shaderConstantData = commandBuffer.getShaderConstantData(shaderConstant);
+
+            writeUInt32(frameData, shaderConstant.size);
+            for (std::uint32_t c = 0; c < shaderConstant.size; ++c)
+                writeFloat(frameData, shaderConstantData[c]);
+        }
+
+        writeUInt32(frameData, static_cast<std::uint32_t>(commandBuffer.getCommandCount()));
+        for (const auto& command : commandBuffer)
+            writeCommand(frameData, command);
+
+        std::uint8_t sizeData[sizeof(std::uint64_t)];
+        encodeLittleEndian<std::uint64_t>(sizeData, frameData.size());
+        file.write(reinterpret_cast<const char*>(sizeData), sizeof(sizeData));
+        file.write(reinterpret_cast<const char*>(frameData.data()), static_cast<std::streamsize>(frameData.size()));
+
+        if (!file)
+            throw std::runtime_error("Failed to write the capture file");
+    }
+
+    FrameCaptureReader::FrameCaptureReader(const std::string& filename):
+        file{filename, std::ios::binary}
+    {
+        if (!file)
+            throw std::runtime_error("Failed to open file " + filename);
+
+        std::uint8_t header[sizeof(magic) + sizeof(std::uint32_t) * 3];
+        if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            !std::equal(std::begin(magic), std::end(magic), header))
+            throw std::runtime_error("Invalid capture file");
+
+        if (decodeLittleEndian<std::uint32_t>(header + sizeof(magic)) != version)
+            throw std::runtime_error("Unsupported capture file version");
+
+        size.v[0] = decodeLittleEndian<std::uint32_t>(header + sizeof(magic) + sizeof(std::uint32_t));
+        size.v[1] = decodeLittleEndian<std::uint32_t>(header + sizeof(magic) + sizeof(std::uint32_t) * 2);
+    }
+
+    bool FrameCaptureReader::readCommandBuffer(CommandBuffer& commandBuffer)
+    {
+        commandBuffer.clear();
+
+        std::uint8_t sizeData[sizeof(std::uint64_t)];
+        if (!file.read(reinterpret_cast<char*>(sizeData), sizeof(sizeData)))
+        {
+            if (file.gcount() == 0) return false; // end of the capture
+            throw std::runtime_error("Invalid capture file");
+        }
+
+        frameData.resize(static_cast<std::size_t>(decodeLittleEndian<std::uint64_t>(sizeData)));
+        if (!file.read(reinterpret_cast<char*>(frameData.data()), static_cast<std::streamsize>(frameData.size())))
+            throw std::runtime_error("Invalid capture file");
+
+        FrameDecoder decoder{frameData};
+
+        std::vector<float> shaderConstantData;
+        for (auto i = decoder.readUInt32(); i > 0; --i)
+        {
+            shaderConstantData.resize(decoder.readUInt32());
+            for (auto& value : shaderConstantData)
+                value = decoder.readFloat();
+
+            commandBuffer.addShaderConstant(shaderConstantData.data(), shaderConstantData.size());
+        }
+
+        for (auto i = decoder.readUInt32(); i > 0; --i)
+            readCommand(decoder, commandBuffer);
+
+        if (!decoder.isEnd())
+            throw std::runtime_error("Invalid capture file");
+
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_FRAMECAPTURE_HPP
+#define OUZEL_GRAPHICS_FRAMECAPTURE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Commands.hpp"
+#include "../math/Size.hpp"
+
+namespace ouzel::graphics
+{
+    // binary format of the capture files (all of the values are little-endian):
+    // header: magic "OZCP", version, width and height of the frame buffer
+    // frame: byte count, shader constants, command count and the commands with their payloads
+    // the shaders are stored as they were compiled for the recording driver
+    class FrameCaptureWriter final
+    {
+    public:
+        FrameCaptureWriter(const std::string& filename,
+                           const Size<std::uint32_t, 2>& size);
+
+        void writeCommandBuffer(const CommandBuffer& commandBuffer);
+
+    private:
+        std::ofstream file;
+        std::vector<std::uint8_t> frameData; // reused between frames
+    };
+
+    class FrameCaptureReader final
+    {
+    public:
+        explicit FrameCaptureReader(const std::string& filename);
+
+        auto& getSize() const noexcept { return size; }
+
+        // clears the command buffer and fills it with the next frame, returns false at the end of the file
+        bool readCommandBuffer(CommandBuffer& commandBuffer);
+
+    private:
+        std::ifstream file;
+        Size<std::uint32_t, 2> size;
+        std::vector<std::uint8_t> frameData; // reused between frames
+    };
+}
+
+#endif // OUZEL_GRAPHICS_FRAMECAPTURE_HPP
@@ -0,0 +1,44 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_FRAMESTATS_HPP
+#define OUZEL_GRAPHICS_FRAMESTATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "Commands.hpp"
+
+namespace ouzel::graphics
+{
+    // timings and counters of one submitted command buffer
+    struct FrameStats final
+    {
+        static constexpr std::size_t commandTypeCount = CommandBuffer::commandTypeCount;
+
+        std::uint64_t frameIndex = 0; // starts at 1 and grows with every submitted command buffer
+        const char* name = ""; // name of the command buffer, a string literal
+
+        // application thread
+        std::chrono::steady_clock::duration recordingTime{}; // since the previous submission
+        std::chrono::steady_clock::duration submitWaitTime{}; // blocked until a frame was free
+
+        // render thread
+        std::chrono::steady_clock::duration queueTime{}; // from the submission to the start of the execution
+        std::chrono::steady_clock::duration executionTime{};
+
+        // filled in later, because the timer queries complete a few frames after the execution
+        bool gpuTimeValid = false;
+        std::chrono::nanoseconds gpuTime{};
+
+        std::array<std::uint32_t, commandTypeCount> commandCounts{};
+        std::uint64_t bufferUploadSize = 0; // bytes
+        std::uint64_t textureUploadSize = 0; // bytes
+
+        auto getCommandCount(Command::Type type) const noexcept
+        {
+            return commandCounts[static_cast<std::size_t>(type)];
+        }
+    };
+}
+
+#endif // OUZEL_GRAPHICS_FRAMESTATS_HPP
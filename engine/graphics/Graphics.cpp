@@ -34,6 +34,7 @@
 #endif
 
 #include "empty/EmptyRenderDevice.hpp"
+#include "software/SoftwareRenderDevice.hpp"
 #include "opengl/OGLRenderDevice.hpp"
 #include "direct3d11/D3D11RenderDevice.hpp"
 #include "metal/MetalRenderDevice.hpp"
@@ -57,6 +58,8 @@ namespace ouzel::graphics
         }
         else if (driver == "empty")
             return Driver::empty;
+        else if (driver == "software")
+            return Driver::software;
         else if (driver == "opengl")
             return Driver::openGL;
         else if (driver == "direct3d11")
@@ -74,6 +77,7 @@ namespace ouzel::graphics
         if (availableDrivers.empty())
         {
             availableDrivers.insert(Driver::empty);
+            availableDrivers.insert(Driver::software);
 
 #if OUZEL_COMPILE_OPENGL
             availableDrivers.insert(Driver::openGL);
@@ -99,6 +103,9 @@ namespace ouzel::graphics
         {
             switch (driver)
             {
+                case Driver::software:
+                    logger.log(Log::Level::info) << "Using software render driver";
+                    return std::make_unique<software::RenderDevice>(settings, window, callback);
 #if OUZEL_COMPILE_OPENGL
                 case Driver::openGL:
                     logger.log(Log::Level::info) << "Using OpenGL render driver";
@@ -149,28 +156,16 @@ namespace ouzel::graphics
         textureFilter(settings.textureFilter),
         maxAnisotropy(settings.maxAnisotropy),
         size(initWindow.getResolution()),
-        device(createRenderDevice(driver, initWindow, settings, std::bind(&Graphics::handleEvent, this, std::placeholders::_1))),
+        device(createRenderDevice(driver, initWindow, settings, nullptr)),
         renderer(*device)
     {
     }
 
-    void Graphics::handleEvent(const RenderDevice::Event& event)
-    {
-        if (event.type == RenderDevice::Event::Type::frame)
-        {
-            std::unique_lock lock(frameMutex);
-            newFrame = true;
-            refillQueue = true;
-            lock.unlock();
-            frameCondition.notify_all();
-        }
-    }
-
     void Graphics::setSize(const Size<std::uint32_t, 2>& newSize)
     {
         size = newSize;
 
-        addCommand(std::make_unique<ResizeCommand>(newSize));
+        addCommand<ResizeCommand>(newSize);
     }
 
     void Graphics::saveScreenshot(const std::string& filename)
@@ -180,7 +175,17 @@ namespace ouzel::graphics
 
     void Graphics::setRenderTarget(std::size_t renderTarget)
     {
-        addCommand(std::make_unique<SetRenderTargetCommand>(renderTarget));
+        if (boundState.renderTargetValid &&
+            boundState.renderTarget == renderTarget)
+        {
+            ++frameElidedCommandCounts.setRenderTarget;
+            return;
+        }
+
+        addCommand<SetRenderTargetCommand>(renderTarget);
+
+        boundState.renderTargetValid = true;
+        boundState.renderTarget = renderTarget;
     }
 
     void Graphics::clearRenderTarget(bool clearColorBuffer,
@@ -190,29 +195,41 @@ namespace ouzel::graphics
                                      float clearDepth,
                                      std::uint32_t clearStencil)
     {
-        addCommand(std::make_unique<ClearRenderTargetCommand>(clearColorBuffer,
-                                                              clearDepthBuffer,
-                                                              clearStencilBuffer,
-                                                              clearColor,
-                                                              clearDepth,
-                                                              clearStencil));
+        addCommand<ClearRenderTargetCommand>(clearColorBuffer,
+                                             clearDepthBuffer,
+                                             clearStencilBuffer,
+                                             clearColor,
+                                             clearDepth,
+                                             clearStencil);
     }
 
     void Graphics::setScissorTest(bool enabled, const Rect<float>& rectangle)
     {
-        addCommand(std::make_unique<SetScissorTestCommand>(enabled, rectangle));
+        addCommand<SetScissorTestCommand>(enabled, rectangle);
     }
 
     void Graphics::setViewport(const Rect<float>& viewport)
     {
-        addCommand(std::make_unique<SetViewportCommand>(viewport));
+        addCommand<SetViewportCommand>(viewport);
     }
 
     void Graphics::setDepthStencilState(std::size_t depthStencilState,
                                         std::uint32_t stencilReferenceValue)
     {
-        addCommand(std::make_unique<SetDepthStencilStateCommand>(depthStencilState,
-                                                                 stencilReferenceValue));
+        if (boundState.depthStencilStateValid &&
+            boundState.depthStencilState == depthStencilState &&
+            boundState.stencilReferenceValue == stencilReferenceValue)
+        {
+            ++frameElidedCommandCounts.setDepthStencilState;
+            return;
+        }
+
+        addCommand<SetDepthStencilStateCommand>(depthStencilState,
+                                                stencilReferenceValue);
+
+        boundState.depthStencilStateValid = true;
+        boundState.depthStencilState = depthStencilState;
+        boundState.stencilReferenceValue = stencilReferenceValue;
     }
 
     void Graphics::setPipelineState(std::size_t blendState,
@@ -220,10 +237,26 @@ namespace ouzel::graphics
                                     CullMode cullMode,
                                     FillMode fillMode)
     {
-        addCommand(std::make_unique<SetPipelineStateCommand>(blendState,
-                                                             shader,
-                                                             cullMode,
-                                                             fillMode));
+        if (boundState.pipelineStateValid &&
+            boundState.blendState == blendState &&
+            boundState.shader == shader &&
+            boundState.cullMode == cullMode &&
+            boundState.fillMode == fillMode)
+        {
+            ++frameElidedCommandCounts.setPipelineState;
+            return;
+        }
+
+        addCommand<SetPipelineStateCommand>(blendState,
+                                            shader,
+                                            cullMode,
+                                            fillMode);
+
+        boundState.pipelineStateValid = true;
+        boundState.blendState = blendState;
+        boundState.shader = shader;
+        boundState.cullMode = cullMode;
+        boundState.fillMode = fillMode;
     }
 
     void Graphics::draw(std::size_t indexBuffer,
@@ -236,38 +269,79 @@ namespace ouzel::graphics
         if (!indexBuffer || !vertexBuffer)
             throw std::runtime_error("Invalid mesh buffer passed to render queue");
 
-        addCommand(std::make_unique<DrawCommand>(indexBuffer,
-                                                 indexCount,
-                                                 indexSize,
-                                                 vertexBuffer,
-                                                 drawMode,
-                                                 startIndex));
+        addCommand<DrawCommand>(indexBuffer,
+                                indexCount,
+                                indexSize,
+                                vertexBuffer,
+                                drawMode,
+                                startIndex);
     }
 
-    void Graphics::setShaderConstants(const std::vector<std::vector<float>>& fragmentShaderConstants,
-                                      const std::vector<std::vector<float>>& vertexShaderConstants)
+    void Graphics::drawInstanced(std::size_t indexBuffer,
+                                 std::uint32_t indexCount,
+                                 std::uint32_t indexSize,
+                                 std::size_t vertexBuffer,
+                                 std::size_t instanceBuffer,
+                                 std::uint32_t instanceCount,
+                                 DrawMode drawMode,
+                                 std::uint32_t startIndex)
     {
-        addCommand(std::make_unique<SetShaderConstantsCommand>(fragmentShaderConstants,
-                                                               vertexShaderConstants));
+        if (!indexBuffer || !vertexBuffer)
+            throw std::runtime_error("Invalid mesh buffer passed to render queue");
+
+        if (!instanceBuffer)
+            throw std::runtime_error("Invalid instance buffer passed to render queue");
+
+        if (!device->isInstancingSupported())
+            throw std::runtime_error("Instancing is not supported");
+
+        addCommand<DrawInstancedCommand>(indexBuffer,
+                                         indexCount,
+                                         indexSize,
+                                         vertexBuffer,
+                                         instanceBuffer,
+                                         instanceCount,
+                                         drawMode,
+                                         startIndex);
     }
 
-    void Graphics::setTextures(const std::vector<std::size_t>& textures)
+    void Graphics::setShaderConstants(std::initializer_list<ShaderConstantData> fragmentShaderConstants,
+                                      std::initializer_list<ShaderConstantData> vertexShaderConstants)
     {
-        addCommand(std::make_unique<SetTexturesCommand>(textures));
+        const auto firstShaderConstant = commandBuffer.getShaderConstantCount();
+
+        for (const auto& fragmentShaderConstant : fragmentShaderConstants)
+            commandBuffer.addShaderConstant(fragmentShaderConstant.first, fragmentShaderConstant.second);
+
+        for (const auto& vertexShaderConstant : vertexShaderConstants)
+            commandBuffer.addShaderConstant(vertexShaderConstant.first, vertexShaderConstant.second);
+
+        addCommand<SetShaderConstantsCommand>(firstShaderConstant,
+                                              static_cast<std::uint32_t>(fragmentShaderConstants.size()),
+                                              static_cast<std::uint32_t>(vertexShaderConstants.size()));
     }
 
-    void Graphics::present()
+    void Graphics::setTextures(const std::vector<std::size_t>& textures)
     {
-        refillQueue = false;
-        addCommand(std::make_unique<PresentCommand>());
-        device->submitCommandBuffer(std::move(commandBuffer));
-        commandBuffer = CommandBuffer();
+        if (boundState.texturesValid &&
+            boundState.textures == textures)
+        {
+            ++frameElidedCommandCounts.setTextures;
+            return;
+        }
+
+        addCommand<SetTexturesCommand>(textures);
+
+        boundState.texturesValid = true;
+        boundState.textures = textures;
     }
 
-    void Graphics::waitForNextFrame()
+    void Graphics::present()
     {
-        std::unique_lock lock(frameMutex);
-        while (!newFrame) frameCondition.wait(lock);
-        newFrame = false;
+        addCommand<PresentCommand>();
+
+        elidedCommandCounts = frameElidedCommandCounts;
+        frameElidedCommandCounts = ElidedCommandCounts{};
+        device->submitCommandBuffer(commandBuffer);
     }
 }
@@ -5,8 +5,10 @@
 
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <queue>
 #include <set>
@@ -64,18 +66,45 @@ namespace ouzel::graphics
                   std::size_t vertexBuffer,
                   DrawMode drawMode,
                   std::uint32_t startIndex);
-        void setShaderConstants(const std::vector<std::vector<float>>& fragmentShaderConstants,
-                                const std::vector<std::vector<float>>& vertexShaderConstants);
+        // draws the mesh once for every instance in the instance buffer, requires instancing support of the device
+        void drawInstanced(std::size_t indexBuffer,
+                           std::uint32_t indexCount,
+                           std::uint32_t indexSize,
+                           std::size_t vertexBuffer,
+                           std::size_t instanceBuffer,
+                           std::uint32_t instanceCount,
+                           DrawMode drawMode,
+                           std::uint32_t startIndex);
+        using ShaderConstantData = std::pair<const float*, std::size_t>;
+        void setShaderConstants(std::initializer_list<ShaderConstantData> fragmentShaderConstants,
+                                std::initializer_list<ShaderConstantData> vertexShaderConstants);
         void setTextures(const std::vector<std::size_t>& textures);
 
-        void addCommand(std::unique_ptr<Command> command)
+        template <class T, class ...Args>
+        void addCommand(Args&&... args)
         {
-            commandBuffer.pushCommand(std::move(command));
+            const T& command = commandBuffer.pushCommand<T>(std::forward<Args>(args)...);
+            invalidateBoundState(command.type);
+        }
+        std::byte* allocateCommandData(std::size_t dataSize)
+        {
+            return commandBuffer.allocateData(dataSize);
         }
         void present();
 
-        void waitForNextFrame();
-        bool getRefillQueue() const noexcept { return refillQueue; }
+        struct ElidedCommandCounts final
+        {
+            std::uint32_t setRenderTarget = 0;
+            std::uint32_t setDepthStencilState = 0;
+            std::uint32_t setPipelineState = 0;
+            std::uint32_t setTextures = 0;
+        };
+
+        // redundant state commands dropped in the last presented frame
+        auto& getElidedCommandCounts() const noexcept { return elidedCommandCounts; }
+
+        void waitForNextFrame() { device->waitForFreeFrame(); }
+        bool getRefillQueue() const noexcept { return device->canSubmitCommandBuffer(); }
 
         Vector<float, 2> convertScreenToNormalizedLocation(const Vector<float, 2>& position)
         {
@@ -94,19 +123,71 @@ namespace ouzel::graphics
         }
 
     private:
-        void handleEvent(const RenderDevice::Event& event);
         void setSize(const Size<std::uint32_t, 2>& newSize);
 
+        void invalidateBoundState(Command::Type commandType) noexcept
+        {
+            switch (commandType)
+            {
+                case Command::Type::setScissorTest:
+                case Command::Type::setViewport:
+                case Command::Type::setDepthStencilState:
+                case Command::Type::setPipelineState:
+                case Command::Type::draw:
+                case Command::Type::drawInstanced:
+                case Command::Type::setShaderConstants:
+                case Command::Type::setTextures:
+                // buffers are bound by every draw call
+                case Command::Type::setBufferData:
+                    break;
+
+                // render passes start with a fresh encoder and clears touch the write masks
+                case Command::Type::setRenderTarget:
+                case Command::Type::clearRenderTarget:
+                    boundState.depthStencilStateValid = false;
+                    boundState.pipelineStateValid = false;
+                    boundState.texturesValid = false;
+                    break;
+
+                // resource commands can rebind objects on the render thread
+                default:
+                    boundState.renderTargetValid = false;
+                    boundState.depthStencilStateValid = false;
+                    boundState.pipelineStateValid = false;
+                    boundState.texturesValid = false;
+                    break;
+            }
+        }
+
         SamplerFilter textureFilter = SamplerFilter::point;
         std::uint32_t maxAnisotropy = 1;
 
         Size<std::uint32_t, 2> size;
         CommandBuffer commandBuffer;
 
-        bool newFrame = false;
-        std::mutex frameMutex;
-        std::condition_variable frameCondition;
-        std::atomic_bool refillQueue{true};
+        // shadow of the state the render device has bound, used to drop redundant commands
+        struct BoundState final
+        {
+            bool renderTargetValid = false;
+            std::size_t renderTarget = 0;
+
+            bool depthStencilStateValid = false;
+            std::size_t depthStencilState = 0;
+            std::uint32_t stencilReferenceValue = 0;
+
+            bool pipelineStateValid = false;
+            std::size_t blendState = 0;
+            std::size_t shader = 0;
+            CullMode cullMode = CullMode::none;
+            FillMode fillMode = FillMode::solid;
+
+            bool texturesValid = false;
+            std::vector<std::size_t> textures;
+        };
+
+        BoundState boundState;
+        ElidedCommandCounts elidedCommandCounts;
+        ElidedCommandCounts frameElidedCommandCounts;
 
         std::unique_ptr<RenderDevice> device;
         renderer::Renderer renderer;
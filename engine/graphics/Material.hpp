@@ -3,6 +3,7 @@
 #ifndef OUZEL_GRAPHICS_MATERIAL_HPP
 #define OUZEL_GRAPHICS_MATERIAL_HPP
 
+#include <cstdint>
 #include <memory>
 #include "Graphics.hpp"
 #include "BlendState.hpp"
@@ -25,6 +26,21 @@ namespace ouzel::graphics
         Material(Material&&) = delete;
         Material& operator=(Material&&) = delete;
 
+        // equal for the materials that share the blend state, shader and textures
+        std::uint32_t getSortKey() const noexcept
+        {
+            std::uint64_t hash = 14695981039346656037ULL; // FNV-1a over the state pointers
+            const auto combine = [&hash](const void* pointer) noexcept {
+                hash = (hash ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer))) * 1099511628211ULL;
+            };
+
+            combine(blendState);
+            combine(shader);
+            for (const auto& texture : textures) combine(texture.get());
+
+            return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+        }
+
         const BlendState* blendState = nullptr;
         const Shader* shader = nullptr;
         std::shared_ptr<Texture> textures[textureLayers];
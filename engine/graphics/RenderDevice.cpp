@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include "RenderDevice.hpp"
+#include "../core/Window.hpp"
 
 namespace ouzel::graphics
 {
@@ -24,15 +25,21 @@ namespace ouzel::graphics
         clampToBorderSupported(false),
         multisamplingSupported(false),
         uintIndicesSupported(false),
-        previousFrameTime(std::chrono::steady_clock::now())
+        instancingSupported(false),
+        frames(std::clamp(settings.framesInFlight, 1U, maxFramesInFlight)),
+        previousSubmitTime(std::chrono::steady_clock::now()),
+        frameStatsHistory(frameStatsHistorySize),
+        previousFrameTime(previousSubmitTime)
     {
+        if (!settings.captureFile.empty())
+            frameCaptureWriter = std::make_unique<FrameCaptureWriter>(settings.captureFile, window.getResolution());
     }
 
     void RenderDevice::process()
     {
         Event event;
         event.type = Event::Type::frame;
-        callback(event);
+        if (callback) callback(event);
 
         const auto currentTime = std::chrono::steady_clock::now();
         const auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(currentTime - previousFrameTime);
@@ -54,6 +61,151 @@ namespace ouzel::graphics
         }
     }
 
+    void RenderDevice::submitCommandBuffer(CommandBuffer& commandBuffer)
+    {
+        const auto recordingEndTime = std::chrono::steady_clock::now();
+
+        if (frameCaptureWriter) frameCaptureWriter->writeCommandBuffer(commandBuffer);
+
+        Frame* frame = frames.getWriteSlot();
+
+        if (!frame)
+        {
+            std::unique_lock lock(frameMutex);
+            applicationThreadWaiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!(frame = frames.getWriteSlot())) frameCondition.wait(lock);
+            applicationThreadWaiting = false;
+        }
+
+        const auto submitTime = std::chrono::steady_clock::now();
+
+        FrameStats& stats = frame->stats;
+        stats.frameIndex = ++submittedFrameCount;
+        stats.name = commandBuffer.getName();
+        stats.recordingTime = recordingEndTime - previousSubmitTime;
+        stats.submitWaitTime = submitTime - recordingEndTime;
+        stats.queueTime = {};
+        stats.executionTime = {};
+        stats.gpuTimeValid = false;
+        stats.gpuTime = {};
+        stats.commandCounts = commandBuffer.getCommandCounts();
+        stats.bufferUploadSize = commandBuffer.getBufferUploadSize();
+        stats.textureUploadSize = commandBuffer.getTextureUploadSize();
+
+        frame->submitTime = submitTime;
+        std::swap(frame->commandBuffer, commandBuffer);
+        frames.commitWrite();
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (renderThreadWaiting)
+        {
+            std::lock_guard lock(frameMutex);
+            frameCondition.notify_all();
+        }
+
+        previousSubmitTime = std::chrono::steady_clock::now();
+    }
+
+    void RenderDevice::waitForFreeFrame()
+    {
+        if (!frames.isFull()) return;
+
+        std::unique_lock lock(frameMutex);
+        applicationThreadWaiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (frames.isFull()) frameCondition.wait(lock);
+        applicationThreadWaiting = false;
+    }
+
+    const CommandBuffer& RenderDevice::getNextCommandBuffer()
+    {
+        // the previous command buffer was not released if its execution threw
+        releaseCommandBuffer();
+
+        Frame* frame = frames.getReadSlot();
+
+        if (!frame)
+        {
+            std::unique_lock lock(frameMutex);
+            renderThreadWaiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!(frame = frames.getReadSlot()) && !wakeRequested) frameCondition.wait(lock);
+            renderThreadWaiting = false;
+
+            if (!frame)
+            {
+                wakeRequested = false;
+                wakeCommandBuffer.clear();
+                wakeCommandBuffer.pushCommand<PresentCommand>();
+                executingFrameIndex = 0;
+                return wakeCommandBuffer;
+            }
+        }
+
+        executionStartTime = std::chrono::steady_clock::now();
+        frame->stats.queueTime = executionStartTime - frame->submitTime;
+        executingCommandBuffer = true;
+        executingFrameIndex = frame->stats.frameIndex;
+        return frame->commandBuffer;
+    }
+
+    void RenderDevice::releaseCommandBuffer()
+    {
+        if (!executingCommandBuffer) return;
+
+        Frame* frame = frames.getReadSlot();
+        frame->stats.executionTime = std::chrono::steady_clock::now() - executionStartTime;
+
+        {
+            std::lock_guard lock(frameStatsMutex);
+            frameStatsHistory[frame->stats.frameIndex % frameStatsHistorySize] = frame->stats;
+            lastFrameStatsIndex = frame->stats.frameIndex;
+        }
+
+        frame->commandBuffer.clear();
+        executingCommandBuffer = false;
+        frames.commitRead();
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (applicationThreadWaiting)
+        {
+            std::lock_guard lock(frameMutex);
+            frameCondition.notify_all();
+        }
+    }
+
+    void RenderDevice::wakeRenderThread()
+    {
+        std::lock_guard lock(frameMutex);
+        wakeRequested = true;
+        frameCondition.notify_all();
+    }
+
+    void RenderDevice::setFrameGpuTime(std::uint64_t frameIndex, std::chrono::nanoseconds gpuTime)
+    {
+        std::lock_guard lock(frameStatsMutex);
+
+        // the stats were already overwritten if the query took longer than the history size
+        auto& stats = frameStatsHistory[frameIndex % frameStatsHistorySize];
+        if (stats.frameIndex == frameIndex)
+        {
+            stats.gpuTimeValid = true;
+            stats.gpuTime = gpuTime;
+        }
+    }
+
+    void RenderDevice::getFrameStats(std::vector<FrameStats>& result) const
+    {
+        result.clear();
+
+        std::lock_guard lock(frameStatsMutex);
+
+        const auto count = std::min(lastFrameStatsIndex, static_cast<std::uint64_t>(frameStatsHistorySize));
+        for (auto frameIndex = lastFrameStatsIndex - count + 1; frameIndex <= lastFrameStatsIndex; ++frameIndex)
+            result.push_back(frameStatsHistory[frameIndex % frameStatsHistorySize]);
+    }
+
     std::vector<Size<std::uint32_t, 2>> RenderDevice::getSupportedResolutions() const
     {
         return std::vector<Size<std::uint32_t, 2>>{};
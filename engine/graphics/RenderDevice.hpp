@@ -5,18 +5,24 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <set>
+#include <vector>
 #include "Commands.hpp"
 #include "Driver.hpp"
+#include "FrameCapture.hpp"
+#include "FrameStats.hpp"
 #include "SamplerFilter.hpp"
 #include "Settings.hpp"
 #include "Vertex.hpp"
 #include "../math/Matrix.hpp"
 #include "../math/Size.hpp"
+#include "../thread/RingBuffer.hpp"
 
 namespace ouzel::core
 {
@@ -63,6 +69,12 @@ namespace ouzel::graphics
             Vertex::Attribute{Vertex::Attribute::Usage::normal, DataType::float32Vector3}
         };
 
+        // attributes of the instance buffers passed to drawInstanced, read once per instance
+        static constexpr std::array<Vertex::Attribute, 2> instanceAttributes{
+            Vertex::Attribute{Vertex::Attribute::Usage::instanceTransform, DataType::float32Matrix4},
+            Vertex::Attribute{Vertex::Attribute::Usage::instanceColor, DataType::unsignedByteVector4Norm}
+        };
+
         struct Event final
         {
             enum class Type
@@ -93,15 +105,19 @@ namespace ouzel::graphics
 
         virtual std::vector<Size<std::uint32_t, 2>> getSupportedResolutions() const;
 
-        void submitCommandBuffer(CommandBuffer&& commandBuffer)
-        {
-            std::unique_lock lock(commandQueueMutex);
-            commandQueue.push(std::move(commandBuffer));
-            lock.unlock();
-            commandQueueCondition.notify_all();
-        }
+        // hands the command buffer to the render thread and replaces it with an already executed one,
+        // so that its memory can be reused, blocks only while the maximum number of frames is in flight
+        void submitCommandBuffer(CommandBuffer& commandBuffer);
+
+        auto getFramesInFlight() const noexcept { return static_cast<std::uint32_t>(frames.getCapacity()); }
+        bool canSubmitCommandBuffer() const noexcept { return !frames.isFull(); }
+        void waitForFreeFrame();
+
+        std::uint32_t getDrawCallCount() const noexcept { return drawCallCount; }
 
-        auto getDrawCallCount() const noexcept { return drawCallCount; }
+        // copies the stats of the recently executed command buffers to the result, oldest first,
+        // can be called from any thread
+        void getFrameStats(std::vector<FrameStats>& result) const;
 
         auto getAPIMajorVersion() const noexcept { return apiVersion.v[0]; }
         auto getAPIMinorVersion() const noexcept { return apiVersion.v[1]; }
@@ -109,6 +125,8 @@ namespace ouzel::graphics
         auto isNPOTTexturesSupported() const noexcept { return npotTexturesSupported; }
         auto isAnisotropicFilteringSupported() const noexcept { return anisotropicFilteringSupported; }
         auto isRenderTargetsSupported() const noexcept { return renderTargetsSupported; }
+        // draw instanced commands can be executed, either natively or by drawing the instances one by one
+        auto isInstancingSupported() const noexcept { return instancingSupported; }
 
         auto& getProjectionTransform(bool renderTarget) const noexcept
         {
@@ -170,6 +188,18 @@ namespace ouzel::graphics
 
         virtual void generateScreenshot(const std::string& filename);
 
+        // blocks until the application thread submits a command buffer or wakeRenderThread is called,
+        // in which case a command buffer with only a present command is returned
+        const CommandBuffer& getNextCommandBuffer();
+        // clears the executed command buffer and hands its slot back to the application thread
+        void releaseCommandBuffer();
+        void wakeRenderThread();
+
+        // index of the command buffer returned by getNextCommandBuffer (0 for the wake command buffer)
+        auto getExecutingFrameIndex() const noexcept { return executingFrameIndex; }
+        // called by the drivers when the timer query of an already executed command buffer completes
+        void setFrameGpuTime(std::uint64_t frameIndex, std::chrono::nanoseconds gpuTime);
+
         Driver driver;
         core::Window& window;
         std::function<void(const Event&)> callback;
@@ -191,15 +221,45 @@ namespace ouzel::graphics
         bool clampToBorderSupported:1;
         bool multisamplingSupported:1;
         bool uintIndicesSupported:1;
+        bool instancingSupported:1;
 
         Matrix<float, 4> projectionTransform = Matrix<float, 4>::identity();
         Matrix<float, 4> renderTargetProjectionTransform = Matrix<float, 4>::identity();
 
-        std::uint32_t drawCallCount = 0;
+        std::atomic<std::uint32_t> drawCallCount{0}; // draw calls in the last presented frame
+        std::uint32_t frameDrawCallCount = 0;
+
+        static constexpr std::uint32_t maxFramesInFlight = 3;
+
+        // the application thread writes frames and the render thread reads them,
+        // the mutex and condition variable are used only when one of them has to wait
+        struct Frame final
+        {
+            CommandBuffer commandBuffer;
+            FrameStats stats;
+            std::chrono::steady_clock::time_point submitTime;
+        };
 
-        std::queue<CommandBuffer> commandQueue;
-        std::mutex commandQueueMutex;
-        std::condition_variable commandQueueCondition;
+        thread::RingBuffer<Frame> frames;
+        bool executingCommandBuffer = false;
+        std::uint64_t executingFrameIndex = 0;
+        std::chrono::steady_clock::time_point executionStartTime;
+        bool wakeRequested = false;
+        CommandBuffer wakeCommandBuffer;
+        std::atomic_bool applicationThreadWaiting{false};
+        std::atomic_bool renderThreadWaiting{false};
+        std::mutex frameMutex;
+        std::condition_variable frameCondition;
+
+        std::unique_ptr<FrameCaptureWriter> frameCaptureWriter; // written on the application thread
+
+        std::uint64_t submittedFrameCount = 0; // application thread
+        std::chrono::steady_clock::time_point previousSubmitTime; // application thread
+
+        static constexpr std::size_t frameStatsHistorySize = 120;
+        std::vector<FrameStats> frameStatsHistory; // indexed by the frame index modulo the history size
+        std::uint64_t lastFrameStatsIndex = 0;
+        mutable std::mutex frameStatsMutex;
 
         std::atomic<float> currentFPS{0.0F};
         std::chrono::steady_clock::time_point previousFrameTime;
@@ -4,6 +4,7 @@
 #define OUZEL_GRAPHICS_SETTINGS_HPP
 
 #include <cstdint>
+#include <string>
 #include "SamplerFilter.hpp"
 
 namespace ouzel::graphics
@@ -18,6 +19,8 @@ namespace ouzel::graphics
         bool depth = false;
         bool stencil = false;
         bool debugRenderer = false;
+        std::uint32_t framesInFlight = 2; // 1 for the lowest latency, up to 3 for the highest throughput
+        std::string captureFile; // records all of the submitted command buffers to this file if not empty
     };
 }
 
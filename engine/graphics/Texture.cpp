@@ -685,14 +685,14 @@ namespace ouzel::graphics
 
         std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>> levels = calculateSizes(size, mipmaps, pixelFormat);
 
-        initGraphics.addCommand(std::make_unique<InitTextureCommand>(resource,
-                                                                    levels,
-                                                                    TextureType::twoDimensional,
-                                                                    flags,
-                                                                    sampleCount,
-                                                                    pixelFormat,
-                                                                    filter,
-                                                                    maxAnisotropy));
+        initGraphics.addCommand<InitTextureCommand>(resource,
+                                                   levels,
+                                                   TextureType::twoDimensional,
+                                                   flags,
+                                                   sampleCount,
+                                                   pixelFormat,
+                                                   filter,
+                                                   maxAnisotropy);
     }
 
     Texture::Texture(Graphics& initGraphics,
@@ -720,14 +720,14 @@ namespace ouzel::graphics
 
         std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>> levels = calculateSizes(size, initData, mipmaps, pixelFormat);
 
-        initGraphics.addCommand(std::make_unique<InitTextureCommand>(resource,
-                                                                     levels,
-                                                                     TextureType::twoDimensional,
-                                                                     flags,
-                                                                     sampleCount,
-                                                                     pixelFormat,
-                                                                     filter,
-                                                                     maxAnisotropy));
+        initGraphics.addCommand<InitTextureCommand>(resource,
+                                                    levels,
+                                                    TextureType::twoDimensional,
+                                                    flags,
+                                                    sampleCount,
+                                                    pixelFormat,
+                                                    filter,
+                                                    maxAnisotropy);
     }
 
     Texture::Texture(Graphics& initGraphics,
@@ -757,14 +757,14 @@ namespace ouzel::graphics
             levels.resize(1);
         }
 
-        initGraphics.addCommand(std::make_unique<InitTextureCommand>(resource,
-                                                                     levels,
-                                                                     TextureType::twoDimensional,
-                                                                     flags,
-                                                                     sampleCount,
-                                                                     pixelFormat,
-                                                                     filter,
-                                                                     maxAnisotropy));
+        initGraphics.addCommand<InitTextureCommand>(resource,
+                                                    levels,
+                                                    TextureType::twoDimensional,
+                                                    flags,
+                                                    sampleCount,
+                                                    pixelFormat,
+                                                    filter,
+                                                    maxAnisotropy);
     }
 
     void Texture::setData(const std::vector<std::uint8_t>& newData, CubeFace face)
@@ -776,9 +776,9 @@ namespace ouzel::graphics
         const std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>> levels = calculateSizes(size, newData, mipmaps, pixelFormat);
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureDataCommand>(resource,
-                                                                         levels,
-                                                                         face));
+            graphics->addCommand<SetTextureDataCommand>(resource,
+                                                        levels,
+                                                        face);
     }
 
     void Texture::setFilter(SamplerFilter newFilter)
@@ -786,13 +786,13 @@ namespace ouzel::graphics
         filter = newFilter;
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureParametersCommand>(resource,
-                                                                               filter,
-                                                                               addressX,
-                                                                               addressY,
-                                                                               addressZ,
-                                                                               borderColor,
-                                                                               maxAnisotropy));
+            graphics->addCommand<SetTextureParametersCommand>(resource,
+                                                              filter,
+                                                              addressX,
+                                                              addressY,
+                                                              addressZ,
+                                                              borderColor,
+                                                              maxAnisotropy);
     }
 
     void Texture::setAddressX(SamplerAddressMode newAddressX)
@@ -800,13 +800,13 @@ namespace ouzel::graphics
         addressX = newAddressX;
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureParametersCommand>(resource,
-                                                                               filter,
-                                                                               addressX,
-                                                                               addressY,
-                                                                               addressZ,
-                                                                               borderColor,
-                                                                               maxAnisotropy));
+            graphics->addCommand<SetTextureParametersCommand>(resource,
+                                                              filter,
+                                                              addressX,
+                                                              addressY,
+                                                              addressZ,
+                                                              borderColor,
+                                                              maxAnisotropy);
     }
 
     void Texture::setAddressY(SamplerAddressMode newAddressY)
@@ -814,13 +814,13 @@ namespace ouzel::graphics
         addressY = newAddressY;
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureParametersCommand>(resource,
-                                                                               filter,
-                                                                               addressX,
-                                                                               addressY,
-                                                                               addressZ,
-                                                                               borderColor,
-                                                                               maxAnisotropy));
+            graphics->addCommand<SetTextureParametersCommand>(resource,
+                                                              filter,
+                                                              addressX,
+                                                              addressY,
+                                                              addressZ,
+                                                              borderColor,
+                                                              maxAnisotropy);
     }
 
     void Texture::setAddressZ(SamplerAddressMode newAddressZ)
@@ -828,13 +828,13 @@ namespace ouzel::graphics
         addressZ = newAddressZ;
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureParametersCommand>(resource,
-                                                                               filter,
-                                                                               addressX,
-                                                                               addressY,
-                                                                               addressZ,
-                                                                               borderColor,
-                                                                               maxAnisotropy));
+            graphics->addCommand<SetTextureParametersCommand>(resource,
+                                                              filter,
+                                                              addressX,
+                                                              addressY,
+                                                              addressZ,
+                                                              borderColor,
+                                                              maxAnisotropy);
     }
 
     void Texture::setBorderColor(Color newBorderColor)
@@ -842,13 +842,13 @@ namespace ouzel::graphics
         borderColor = newBorderColor;
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureParametersCommand>(resource,
-                                                                               filter,
-                                                                               addressX,
-                                                                               addressY,
-                                                                               addressZ,
-                                                                               borderColor,
-                                                                               maxAnisotropy));
+            graphics->addCommand<SetTextureParametersCommand>(resource,
+                                                              filter,
+                                                              addressX,
+                                                              addressY,
+                                                              addressZ,
+                                                              borderColor,
+                                                              maxAnisotropy);
     }
 
     void Texture::setMaxAnisotropy(std::uint32_t newMaxAnisotropy)
@@ -856,12 +856,12 @@ namespace ouzel::graphics
         maxAnisotropy = newMaxAnisotropy;
 
         if (resource)
-            graphics->addCommand(std::make_unique<SetTextureParametersCommand>(resource,
-                                                                               filter,
-                                                                               addressX,
-                                                                               addressY,
-                                                                               addressZ,
-                                                                               borderColor,
-                                                                               maxAnisotropy));
+            graphics->addCommand<SetTextureParametersCommand>(resource,
+                                                              filter,
+                                                              addressX,
+                                                              addressY,
+                                                              addressZ,
+                                                              borderColor,
+                                                              maxAnisotropy);
     }
 }
@@ -5,8 +5,9 @@
 
 #include <array>
 #include "DataType.hpp"
-#include "../math/Vector.hpp"
 #include "../math/Color.hpp"
+#include "../math/Matrix.hpp"
+#include "../math/Vector.hpp"
 
 namespace ouzel::graphics
 {
@@ -22,6 +23,8 @@ namespace ouzel::graphics
                 blendIndices,
                 blendWeight,
                 color,
+                instanceColor,
+                instanceTransform,
                 normal,
                 position,
                 positionTransformed,
@@ -50,6 +53,20 @@ namespace ouzel::graphics
         std::array<Vector<float, 2>, 2> texCoords;
         Vector<float, 3> normal;
     };
+
+    // element of the instance buffers, laid out as RenderDevice::instanceAttributes
+    class Instance final
+    {
+    public:
+        constexpr Instance() noexcept = default;
+        constexpr Instance(const Matrix<float, 4>& initTransform, Color initColor) noexcept:
+            transform(initTransform), color(initColor)
+        {
+        }
+
+        Matrix<float, 4> transform; // model view projection of the instance
+        Color color; // multiplied with the vertex color
+    };
 }
 
 #endif // OUZEL_GRAPHICS_VERTEX_HPP
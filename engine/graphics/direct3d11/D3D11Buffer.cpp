@@ -4,6 +4,7 @@
 
 #if OUZEL_COMPILE_DIRECT3D11
 
+#include <cstring>
 #include "D3D11Buffer.hpp"
 #include "D3D11RenderDevice.hpp"
 
@@ -19,39 +20,37 @@ namespace ouzel::graphics::d3d11
         flags(initFlags),
         size(static_cast<UINT>(initSize))
     {
-        createBuffer(initSize, data);
+        createBuffer(initSize, data.empty() ? nullptr : data.data());
     }
 
-    void Buffer::setData(const std::vector<std::uint8_t>& data)
+    void Buffer::setData(const void* data, std::size_t dataSize)
     {
         if ((flags & Flags::dynamic) != Flags::dynamic)
             throw std::runtime_error("Buffer is not dynamic");
 
-        if (data.empty())
+        if (!dataSize)
             throw std::runtime_error("Data is empty");
 
-        if (!buffer || data.size() > size)
-            createBuffer(static_cast<UINT>(data.size()), data);
+        if (!buffer || dataSize > size)
+            createBuffer(static_cast<UINT>(dataSize), data);
         else
         {
-            if (!data.empty())
-            {
-                D3D11_MAPPED_SUBRESOURCE mappedSubresource;
-                mappedSubresource.pData = nullptr;
-                mappedSubresource.RowPitch = 0;
-                mappedSubresource.DepthPitch = 0;
+            // discarding lets the driver hand out a new region while the GPU reads the old one
+            D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+            mappedSubresource.pData = nullptr;
+            mappedSubresource.RowPitch = 0;
+            mappedSubresource.DepthPitch = 0;
 
-                if (const auto hr = renderDevice.getContext()->Map(buffer.get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource); FAILED(hr))
-                    throw std::system_error(hr, getErrorCategory(), "Failed to lock Direct3D 11 buffer");
+            if (const auto hr = renderDevice.getContext()->Map(buffer.get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource); FAILED(hr))
+                throw std::system_error(hr, getErrorCategory(), "Failed to lock Direct3D 11 buffer");
 
-                std::copy(data.begin(), data.end(), static_cast<std::uint8_t*>(mappedSubresource.pData));
+            std::memcpy(mappedSubresource.pData, data, dataSize);
 
-                renderDevice.getContext()->Unmap(buffer.get(), 0);
-            }
+            renderDevice.getContext()->Unmap(buffer.get(), 0);
         }
     }
 
-    void Buffer::createBuffer(UINT newSize, const std::vector<std::uint8_t>& data)
+    void Buffer::createBuffer(UINT newSize, const void* data)
     {
         if (newSize)
         {
@@ -77,7 +76,7 @@ namespace ouzel::graphics::d3d11
             bufferDesc.MiscFlags = 0;
             bufferDesc.StructureByteStride = 0;
 
-            if (data.empty())
+            if (!data)
             {
                 ID3D11Buffer* newBuffer;
                 if (const auto hr = renderDevice.getDevice()->CreateBuffer(&bufferDesc, nullptr, &newBuffer); FAILED(hr))
@@ -88,7 +87,7 @@ namespace ouzel::graphics::d3d11
             else
             {
                 D3D11_SUBRESOURCE_DATA bufferResourceData;
-                bufferResourceData.pSysMem = data.data();
+                bufferResourceData.pSysMem = data;
                 bufferResourceData.SysMemPitch = 0;
                 bufferResourceData.SysMemSlicePitch = 0;
 
@@ -37,7 +37,7 @@ namespace ouzel::graphics::d3d11
                const std::vector<std::uint8_t>& data,
                std::uint32_t initSize);
 
-        void setData(const std::vector<std::uint8_t>& data);
+        void setData(const void* data, std::size_t dataSize);
 
         auto getFlags() const noexcept { return flags; }
         auto getType() const noexcept { return type; }
@@ -46,7 +46,7 @@ namespace ouzel::graphics::d3d11
         auto& getBuffer() const noexcept { return buffer; }
 
     private:
-        void createBuffer(UINT newSize, const std::vector<std::uint8_t>& data);
+        void createBuffer(UINT newSize, const void* data);
 
         BufferType type;
         Flags flags = Flags::none;
@@ -4,9 +4,13 @@
 
 #if OUZEL_COMPILE_DIRECT3D11
 
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
+#include <string>
 #include "D3D11Shader.hpp"
 #include "D3D11RenderDevice.hpp"
+#include <d3dcompiler.h>
 
 namespace ouzel::graphics::d3d11
 {
@@ -78,6 +82,39 @@ namespace ouzel::graphics::d3d11
                 default: throw std::runtime_error("Invalid data type");
             }
         }
+
+        // the shaders that are not compiled ahead of time by compile.bat are passed as HLSL source
+        // and compiled with the compiler of the system
+        std::vector<std::uint8_t> compileShader(const std::vector<std::uint8_t>& data, const char* target)
+        {
+            constexpr std::uint8_t bytecodeMagic[] = {'D', 'X', 'B', 'C'};
+            if (data.size() >= std::size(bytecodeMagic) &&
+                std::equal(std::begin(bytecodeMagic), std::end(bytecodeMagic), data.begin()))
+                return data;
+
+            static const HMODULE compilerLibrary = LoadLibraryW(D3DCOMPILER_DLL_W);
+            if (!compilerLibrary)
+                throw std::runtime_error("Failed to load " D3DCOMPILER_DLL_A);
+
+            const auto compileProc = reinterpret_cast<pD3DCompile>(GetProcAddress(compilerLibrary, "D3DCompile"));
+            if (!compileProc)
+                throw std::system_error(GetLastError(), std::system_category(), "Failed to get address of D3DCompile");
+
+            ID3DBlob* newCode = nullptr;
+            ID3DBlob* newErrors = nullptr;
+            const auto hr = compileProc(data.data(), data.size(), nullptr, nullptr, nullptr,
+                                        "main", target, D3DCOMPILE_OPTIMIZATION_LEVEL3, 0,
+                                        &newCode, &newErrors);
+            const Pointer<ID3DBlob> code = newCode;
+            const Pointer<ID3DBlob> errors = newErrors;
+
+            if (FAILED(hr))
+                throw std::system_error(hr, getErrorCategory(), "Failed to compile a Direct3D 11 shader" +
+                                        (errors ? ", " + std::string(static_cast<const char*>(errors->GetBufferPointer()), errors->GetBufferSize()) : std::string()));
+
+            const auto codeData = static_cast<const std::uint8_t*>(code->GetBufferPointer());
+            return std::vector<std::uint8_t>(codeData, codeData + code->GetBufferSize());
+        }
     }
 
     Shader::Shader(RenderDevice& initRenderDevice,
@@ -93,14 +130,17 @@ namespace ouzel::graphics::d3d11
         fragmentShaderConstantInfo(initFragmentShaderConstantInfo),
         vertexShaderConstantInfo(initVertexShaderConstantInfo)
     {
+        const auto fragmentShaderCode = compileShader(fragmentShaderData, "ps_4_0_level_9_3");
+        const auto vertexShaderCode = compileShader(vertexShaderData, "vs_4_0_level_9_3");
+
         ID3D11PixelShader* newPixelShader;
-        if (const auto hr = renderDevice.getDevice()->CreatePixelShader(fragmentShaderData.data(), fragmentShaderData.size(), nullptr, &newPixelShader); FAILED(hr))
+        if (const auto hr = renderDevice.getDevice()->CreatePixelShader(fragmentShaderCode.data(), fragmentShaderCode.size(), nullptr, &newPixelShader); FAILED(hr))
             throw std::system_error(hr, getErrorCategory(), "Failed to create a Direct3D 11 pixel shader");
 
         fragmentShader = newPixelShader;
 
         ID3D11VertexShader* newVertexShader;
-        if (const auto hr = renderDevice.getDevice()->CreateVertexShader(vertexShaderData.data(), vertexShaderData.size(), nullptr, &newVertexShader); FAILED(hr))
+        if (const auto hr = renderDevice.getDevice()->CreateVertexShader(vertexShaderCode.data(), vertexShaderCode.size(), nullptr, &newVertexShader); FAILED(hr))
             throw std::system_error(hr, getErrorCategory(), "Failed to create a Direct3D 11 vertex shader");
 
         vertexShader = newVertexShader;
@@ -175,8 +215,8 @@ namespace ouzel::graphics::d3d11
 
         if (const auto hr = renderDevice.getDevice()->CreateInputLayout(vertexInputElements.data(),
                                                                         static_cast<UINT>(vertexInputElements.size()),
-                                                                        vertexShaderData.data(),
-                                                                        vertexShaderData.size(),
+                                                                        vertexShaderCode.data(),
+                                                                        vertexShaderCode.size(),
                                                                         &newInputLayout); FAILED(hr))
             throw std::system_error(hr, getErrorCategory(), "Failed to create Direct3D 11 input layout for vertex shader");
 
@@ -18,7 +18,30 @@ namespace ouzel::graphics::empty
         }
 
     private:
-        void process() final {}
+        // nothing is drawn, the submitted command buffers are only walked and released,
+        // so that the application thread does not block on the full frame queue
+        void process() final
+        {
+            while (frames.getReadSlot())
+            {
+                for (const auto& command : getNextCommandBuffer())
+                    switch (command.type)
+                    {
+                        case Command::Type::draw:
+                        case Command::Type::drawInstanced:
+                            ++frameDrawCallCount;
+                            break;
+                        case Command::Type::present:
+                            drawCallCount = frameDrawCallCount;
+                            frameDrawCallCount = 0;
+                            break;
+                        default:
+                            break;
+                    }
+
+                releaseCommandBuffer();
+            }
+        }
     };
 }
 
@@ -15,6 +15,8 @@ typedef id<MTLBuffer> MTLBufferPtr;
 using MTLBufferPtr = id;
 #endif
 
+#include <array>
+#include <cstdint>
 #include "MetalRenderResource.hpp"
 #include "MetalPointer.hpp"
 #include "../BufferType.hpp"
@@ -33,21 +35,37 @@ namespace ouzel::graphics::metal
                const std::vector<std::uint8_t>& initData,
                std::uint32_t initSize);
 
-        void setData(const std::vector<std::uint8_t>& data);
+        void setData(const void* data, std::size_t dataSize);
 
         auto getFlags() const noexcept { return flags; }
         auto getType() const noexcept { return type; }
         auto getSize() const noexcept { return size; }
 
-        auto& getBuffer() const noexcept { return buffer; }
+        auto& getBuffer() const noexcept { return slots[currentSlot].buffer; }
+        auto getOffset() const noexcept { return currentOffset; }
 
     private:
-        void createBuffer(NSUInteger newSize);
+        void write(const void* data, std::size_t dataSize);
+
+        // dynamic buffers stream their data through a ring of buffers, one for each command buffer
+        // the render device can have in flight, the data of a frame is appended to the buffer of its slot,
+        // so that the GPU never reads the data of the frames in flight while it is written
+        static constexpr std::size_t streamingBufferCount = 3;
+
+        struct Slot final
+        {
+            Pointer<MTLBufferPtr> buffer;
+            NSUInteger size = 0;
+            NSUInteger offset = 0; // where the next data of the frame is written
+            std::uint64_t frameIndex = 0; // of the last frame that wrote to the buffer
+        };
 
         BufferType type = BufferType::index;
         Flags flags = Flags::none;
 
-        Pointer<MTLBufferPtr> buffer;
+        std::array<Slot, streamingBufferCount> slots;
+        std::size_t currentSlot = 0;
+        NSUInteger currentOffset = 0;
         NSUInteger size = 0;
     };
 }
@@ -5,12 +5,19 @@
 #if OUZEL_COMPILE_METAL
 
 #include <algorithm>
+#include <cstring>
 #include "MetalBuffer.hpp"
 #include "MetalError.hpp"
 #include "MetalRenderDevice.hpp"
 
 namespace ouzel::graphics::metal
 {
+    namespace
+    {
+        // the offsets of the vertex and index buffers must be aligned
+        constexpr NSUInteger alignment = 256;
+    }
+
     Buffer::Buffer(RenderDevice& initRenderDevice,
                    BufferType initType,
                    Flags initFlags,
@@ -20,38 +27,66 @@ namespace ouzel::graphics::metal
         type(initType),
         flags(initFlags)
     {
-        createBuffer(initSize);
+        if (initSize)
+        {
+            write(nullptr, initSize);
 
-        if (!data.empty())
-            std::copy(data.begin(), data.end(), static_cast<std::uint8_t*>([buffer.get() contents]));
+            if (!data.empty())
+                std::copy(data.begin(), data.end(), static_cast<std::uint8_t*>([getBuffer().get() contents]) + currentOffset);
+        }
     }
 
-    void Buffer::setData(const std::vector<std::uint8_t>& data)
+    void Buffer::setData(const void* data, std::size_t dataSize)
     {
         if ((flags & Flags::dynamic) != Flags::dynamic)
             throw Error("Buffer is not dynamic");
 
-        if (data.empty())
+        if (!dataSize)
             throw Error("Data is empty");
 
-        if (!buffer || data.size() > size)
-            createBuffer(static_cast<std::uint32_t>(data.size()));
-
-        std::copy(data.begin(), data.end(), static_cast<std::uint8_t*>([buffer.get() contents]));
+        write(data, dataSize);
     }
 
-    void Buffer::createBuffer(NSUInteger newSize)
+    void Buffer::write(const void* data, std::size_t dataSize)
     {
-        if (newSize > 0)
+        static_assert(streamingBufferCount == RenderDevice::bufferCount);
+
+        const auto frameIndex = renderDevice.getFrameIndex();
+        const auto slotIndex = static_cast<std::size_t>(frameIndex % streamingBufferCount);
+        Slot& slot = slots[slotIndex];
+
+        // the render device waits for the frame that wrote the slot before, but if the current data
+        // was written by it, the frames after it can still read it, so the slot gets a new buffer
+        if (slot.frameIndex != frameIndex)
         {
-            size = newSize;
+            if (slotIndex == currentSlot) slot.buffer = nil;
+            slot.frameIndex = frameIndex;
+            slot.offset = 0;
+        }
+
+        currentSlot = slotIndex;
 
-            buffer = [renderDevice.getDevice().get() newBufferWithLength:size
-                                                                 options:MTLResourceCPUCacheModeWriteCombined];
+        const auto newSize = static_cast<NSUInteger>(dataSize);
+        currentOffset = ((slot.offset + alignment - 1) / alignment) * alignment;
+
+        if (!slot.buffer || currentOffset + newSize > slot.size)
+        {
+            // the command buffers retain the replaced buffer until the GPU has read it
+            slot.size = slot.buffer ? std::max(newSize, slot.size * 2) : std::max(newSize, slot.size);
+            slot.buffer = [renderDevice.getDevice().get() newBufferWithLength:slot.size
+                                                                      options:MTLResourceCPUCacheModeWriteCombined];
 
-            if (!buffer)
+            if (!slot.buffer)
                 throw Error("Failed to create Metal buffer");
+
+            currentOffset = 0;
         }
+
+        if (data)
+            std::memcpy(static_cast<std::uint8_t*>([slot.buffer.get() contents]) + currentOffset, data, dataSize);
+
+        slot.offset = currentOffset + newSize;
+        if (newSize > size) size = newSize;
     }
 }
 
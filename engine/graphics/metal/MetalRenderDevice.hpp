@@ -63,6 +63,9 @@ namespace ouzel::graphics::metal
         static bool available();
 
         auto& getDevice() const noexcept { return device; }
+        // incremented for every encoded command buffer, the resources written by a frame
+        // can be written again by the frame bufferCount frames later
+        auto getFrameIndex() const noexcept { return frameIndex; }
 
         MTLSamplerStatePtr getSamplerState(const SamplerStateDescriptor& descriptor);
 
@@ -111,6 +114,7 @@ namespace ouzel::graphics::metal
             std::uint32_t offset = 0;
         };
 
+        std::uint64_t frameIndex = 0;
         std::uint32_t shaderConstantBufferIndex = 0;
         ShaderConstantBuffer shaderConstantBuffers[bufferCount];
 
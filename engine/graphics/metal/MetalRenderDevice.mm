@@ -251,6 +251,7 @@ namespace ouzel::graphics::metal
         PipelineStateDesc currentPipelineStateDesc;
         std::vector<float> shaderData;
 
+        ++frameIndex;
         if (++shaderConstantBufferIndex >= bufferCount) shaderConstantBufferIndex = 0;
         ShaderConstantBuffer& shaderConstantBuffer = shaderConstantBuffers[shaderConstantBufferIndex];
         shaderConstantBuffer.index = 0;
@@ -258,26 +259,19 @@ namespace ouzel::graphics::metal
         const RenderTarget* currentRenderTarget = nullptr;
         const Shader* currentShader = nullptr;
 
-        CommandBuffer commandBuffer;
-        std::unique_ptr<Command> command;
-
         for (;;)
         {
-            std::unique_lock lock(commandQueueMutex);
-            while (commandQueue.empty()) commandQueueCondition.wait(lock);
-            commandBuffer = std::move(commandQueue.front());
-            commandQueue.pop();
-            lock.unlock();
+            const CommandBuffer& commandBuffer = getNextCommandBuffer();
 
-            while (!commandBuffer.isEmpty())
-            {
-                command = commandBuffer.popCommand();
+            bool presented = false;
 
-                switch (command->type)
+            for (const auto& command : commandBuffer)
+            {
+                switch (command.type)
                 {
                     case Command::Type::resize:
                     {
-                        auto resizeCommand = static_cast<const ResizeCommand*>(command.get());
+                        auto resizeCommand = static_cast<const ResizeCommand*>(&command);
                         const CGSize drawableSize = CGSizeMake(resizeCommand->size.v[0],
                                                                resizeCommand->size.v[1]);
                         metalLayer.drawableSize = drawableSize;
@@ -286,6 +280,9 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::present:
                     {
+                        drawCallCount = frameDrawCallCount;
+                        frameDrawCallCount = 0;
+
                         if (currentRenderCommandEncoder)
                             [currentRenderCommandEncoder endEncoding];
 
@@ -299,14 +296,14 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::deleteResource:
                     {
-                        auto deleteResourceCommand = static_cast<const DeleteResourceCommand*>(command.get());
+                        auto deleteResourceCommand = static_cast<const DeleteResourceCommand*>(&command);
                         resources[deleteResourceCommand->resource - 1].reset();
                         break;
                     }
 
                     case Command::Type::initRenderTarget:
                     {
-                        auto initRenderTargetCommand = static_cast<const InitRenderTargetCommand*>(command.get());
+                        auto initRenderTargetCommand = static_cast<const InitRenderTargetCommand*>(&command);
 
                         std::set<Texture*> colorTextures;
                         for (const auto colorTextureId : initRenderTargetCommand->colorTextures)
@@ -324,7 +321,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setRenderTarget:
                     {
-                        auto setRenderTargetCommand = static_cast<const SetRenderTargetCommand*>(command.get());
+                        auto setRenderTargetCommand = static_cast<const SetRenderTargetCommand*>(&command);
 
                         MTLRenderPassDescriptorPtr newRenderPassDescriptor;
 
@@ -370,7 +367,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::clearRenderTarget:
                     {
-                        auto clearCommand = static_cast<const ClearRenderTargetCommand*>(command.get());
+                        auto clearCommand = static_cast<const ClearRenderTargetCommand*>(&command);
 
                         if (currentRenderCommandEncoder)
                             [currentRenderCommandEncoder endEncoding];
@@ -406,7 +403,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setScissorTest:
                     {
-                        auto setScissorTestCommand = static_cast<const SetScissorTestCommand*>(command.get());
+                        auto setScissorTestCommand = static_cast<const SetScissorTestCommand*>(&command);
 
                         // create a new render command encoder to set up a new scissor rect
                         if (currentRenderCommandEncoder)
@@ -428,7 +425,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setViewport:
                     {
-                        auto setViewportCommand = static_cast<const SetViewportCommand*>(command.get());
+                        auto setViewportCommand = static_cast<const SetViewportCommand*>(&command);
 
                         if (!currentRenderCommandEncoder)
                             throw Error("Metal render command encoder not initialized");
@@ -448,7 +445,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::initDepthStencilState:
                     {
-                        auto initDepthStencilStateCommand = static_cast<const InitDepthStencilStateCommand*>(command.get());
+                        auto initDepthStencilStateCommand = static_cast<const InitDepthStencilStateCommand*>(&command);
                         auto depthStencilState = std::make_unique<DepthStencilState>(*this,
                                                                                      initDepthStencilStateCommand->depthTest,
                                                                                      initDepthStencilStateCommand->depthWrite,
@@ -474,7 +471,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setDepthStencilState:
                     {
-                        auto setDepthStencilStateCommand = static_cast<const SetDepthStencilStateCommand*>(command.get());
+                        auto setDepthStencilStateCommand = static_cast<const SetDepthStencilStateCommand*>(&command);
 
                         if (!currentRenderCommandEncoder)
                             throw Error("Metal render command encoder not initialized");
@@ -495,7 +492,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setPipelineState:
                     {
-                        auto setPipelineStateCommand = static_cast<const SetPipelineStateCommand*>(command.get());
+                        auto setPipelineStateCommand = static_cast<const SetPipelineStateCommand*>(&command);
 
                         if (!currentRenderCommandEncoder)
                             throw Error("Metal render command encoder not initialized");
@@ -518,7 +515,9 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::draw:
                     {
-                        auto drawCommand = static_cast<const DrawCommand*>(command.get());
+                        ++frameDrawCallCount;
+
+                        auto drawCommand = static_cast<const DrawCommand*>(&command);
 
                         if (!currentRenderCommandEncoder)
                             throw Error("Metal render command encoder not initialized");
@@ -532,7 +531,7 @@ namespace ouzel::graphics::metal
                         assert(vertexBuffer);
                         assert(vertexBuffer->getBuffer());
 
-                        [currentRenderCommandEncoder setVertexBuffer:vertexBuffer->getBuffer().get() offset:0 atIndex:0];
+                        [currentRenderCommandEncoder setVertexBuffer:vertexBuffer->getBuffer().get() offset:vertexBuffer->getOffset() atIndex:0];
 
                         // draw
                         assert(drawCommand->indexCount);
@@ -543,14 +542,14 @@ namespace ouzel::graphics::metal
                                                                 indexCount:drawCommand->indexCount
                                                                  indexType:getIndexType(drawCommand->indexSize)
                                                                indexBuffer:indexBuffer->getBuffer().get()
-                                                         indexBufferOffset:drawCommand->startIndex * drawCommand->indexSize];
+                                                         indexBufferOffset:indexBuffer->getOffset() + drawCommand->startIndex * drawCommand->indexSize];
 
                         break;
                     }
 
                     case Command::Type::initBlendState:
                     {
-                        auto initBlendStateCommand = static_cast<const InitBlendStateCommand*>(command.get());
+                        auto initBlendStateCommand = static_cast<const InitBlendStateCommand*>(&command);
 
                         auto blendState = std::make_unique<BlendState>(*this,
                                                                        initBlendStateCommand->enableBlending,
@@ -570,7 +569,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::initBuffer:
                     {
-                        auto initBufferCommand = static_cast<const InitBufferCommand*>(command.get());
+                        auto initBufferCommand = static_cast<const InitBufferCommand*>(&command);
 
                         auto buffer = std::make_unique<Buffer>(*this,
                                                                 initBufferCommand->bufferType,
@@ -586,16 +585,16 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setBufferData:
                     {
-                        auto setBufferDataCommand = static_cast<const SetBufferDataCommand*>(command.get());
+                        auto setBufferDataCommand = static_cast<const SetBufferDataCommand*>(&command);
 
                         auto buffer = getResource<Buffer>(setBufferDataCommand->buffer);
-                        buffer->setData(setBufferDataCommand->data);
+                        buffer->setData(setBufferDataCommand->data, setBufferDataCommand->size);
                         break;
                     }
 
                     case Command::Type::initShader:
                     {
-                        auto initShaderCommand = static_cast<const InitShaderCommand*>(command.get());
+                        auto initShaderCommand = static_cast<const InitShaderCommand*>(&command);
 
                         auto shader = std::make_unique<Shader>(*this,
                                                                initShaderCommand->fragmentShader,
@@ -614,7 +613,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setShaderConstants:
                     {
-                        auto setShaderConstantsCommand = static_cast<const SetShaderConstantsCommand*>(command.get());
+                        auto setShaderConstantsCommand = static_cast<const SetShaderConstantsCommand*>(&command);
 
                         if (!currentRenderCommandEncoder)
                             throw Error("Metal render command encoder not initialized");
@@ -625,20 +624,21 @@ namespace ouzel::graphics::metal
                         // pixel shader constants
                         const std::vector<Shader::Location>& fragmentShaderConstantLocations = currentShader->getFragmentShaderConstantLocations();
 
-                        if (setShaderConstantsCommand->fragmentShaderConstants.size() > fragmentShaderConstantLocations.size())
+                        if (setShaderConstantsCommand->fragmentShaderConstantCount > fragmentShaderConstantLocations.size())
                             throw Error("Invalid pixel shader constant size");
 
                         shaderData.clear();
 
-                        for (std::size_t i = 0; i < setShaderConstantsCommand->fragmentShaderConstants.size(); ++i)
+                        for (std::uint32_t i = 0; i < setShaderConstantsCommand->fragmentShaderConstantCount; ++i)
                         {
                             const Shader::Location& fragmentShaderConstantLocation = fragmentShaderConstantLocations[i];
-                            const std::vector<float>& fragmentShaderConstant = setShaderConstantsCommand->fragmentShaderConstants[i];
+                            const auto& fragmentShaderConstant = commandBuffer.getShaderConstant(setShaderConstantsCommand->firstShaderConstant + i);
+                            const float* fragmentShaderConstantData = commandBuffer.getShaderConstantData(fragmentShaderConstant);
 
-                            if (sizeof(float) * fragmentShaderConstant.size() != fragmentShaderConstantLocation.size)
+                            if (sizeof(float) * fragmentShaderConstant.size != fragmentShaderConstantLocation.size)
                                 throw Error("Invalid pixel shader constant size");
 
-                            shaderData.insert(shaderData.end(), fragmentShaderConstant.begin(), fragmentShaderConstant.end());
+                            shaderData.insert(shaderData.end(), fragmentShaderConstantData, fragmentShaderConstantData + fragmentShaderConstant.size);
                         }
 
                         shaderConstantBuffer.offset = ((shaderConstantBuffer.offset + currentShader->getFragmentShaderAlignment() - 1) /
@@ -676,20 +676,22 @@ namespace ouzel::graphics::metal
                         // vertex shader constants
                         const std::vector<Shader::Location>& vertexShaderConstantLocations = currentShader->getVertexShaderConstantLocations();
 
-                        if (setShaderConstantsCommand->vertexShaderConstants.size() > vertexShaderConstantLocations.size())
+                        if (setShaderConstantsCommand->vertexShaderConstantCount > vertexShaderConstantLocations.size())
                             throw Error("Invalid vertex shader constant size");
 
                         shaderData.clear();
 
-                        for (std::size_t i = 0; i < setShaderConstantsCommand->vertexShaderConstants.size(); ++i)
+                        for (std::uint32_t i = 0; i < setShaderConstantsCommand->vertexShaderConstantCount; ++i)
                         {
                             const Shader::Location& vertexShaderConstantLocation = vertexShaderConstantLocations[i];
-                            const std::vector<float>& vertexShaderConstant = setShaderConstantsCommand->vertexShaderConstants[i];
+                            const auto& vertexShaderConstant = commandBuffer.getShaderConstant(setShaderConstantsCommand->firstShaderConstant +
+                                                                                               setShaderConstantsCommand->fragmentShaderConstantCount + i);
+                            const float* vertexShaderConstantData = commandBuffer.getShaderConstantData(vertexShaderConstant);
 
-                            if (sizeof(float) * vertexShaderConstant.size() != vertexShaderConstantLocation.size)
+                            if (sizeof(float) * vertexShaderConstant.size != vertexShaderConstantLocation.size)
                                 throw Error("Invalid vertex shader constant size");
 
-                            shaderData.insert(shaderData.end(), vertexShaderConstant.begin(), vertexShaderConstant.end());
+                            shaderData.insert(shaderData.end(), vertexShaderConstantData, vertexShaderConstantData + vertexShaderConstant.size);
                         }
 
                         shaderConstantBuffer.offset = ((shaderConstantBuffer.offset + currentShader->getVertexShaderAlignment() - 1) /
@@ -729,7 +731,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::initTexture:
                     {
-                        auto initTextureCommand = static_cast<const InitTextureCommand*>(command.get());
+                        auto initTextureCommand = static_cast<const InitTextureCommand*>(&command);
 
                         auto texture = std::make_unique<Texture>(*this,
                                                                  initTextureCommand->levels,
@@ -748,7 +750,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setTextureData:
                     {
-                        auto setTextureDataCommand = static_cast<const SetTextureDataCommand*>(command.get());
+                        auto setTextureDataCommand = static_cast<const SetTextureDataCommand*>(&command);
 
                         auto texture = getResource<Texture>(setTextureDataCommand->texture);
                         texture->setData(setTextureDataCommand->levels);
@@ -758,7 +760,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setTextureParameters:
                     {
-                        auto setTextureParametersCommand = static_cast<const SetTextureParametersCommand*>(command.get());
+                        auto setTextureParametersCommand = static_cast<const SetTextureParametersCommand*>(&command);
 
                         auto texture = getResource<Texture>(setTextureParametersCommand->texture);
                         texture->setFilter(setTextureParametersCommand->filter);
@@ -772,7 +774,7 @@ namespace ouzel::graphics::metal
 
                     case Command::Type::setTextures:
                     {
-                        auto setTexturesCommand = static_cast<const SetTexturesCommand*>(command.get());
+                        auto setTexturesCommand = static_cast<const SetTexturesCommand*>(&command);
 
                         if (!currentRenderCommandEncoder)
                             throw Error("Metal render command encoder not initialized");
@@ -797,8 +799,15 @@ namespace ouzel::graphics::metal
                     default: throw Error("Invalid command");
                 }
 
-                if (command->type == Command::Type::present) return;
+                if (command.type == Command::Type::present)
+                {
+                    presented = true;
+                    break;
+                }
             }
+
+            releaseCommandBuffer();
+            if (presented) return;
         }
     }
 
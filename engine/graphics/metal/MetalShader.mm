@@ -6,6 +6,7 @@
 
 #include <TargetConditionals.h>
 #include <algorithm>
+#include <iterator>
 #include "MetalShader.hpp"
 #include "MetalError.hpp"
 #include "MetalRenderDevice.hpp"
@@ -80,6 +81,28 @@ namespace ouzel::graphics::metal
                 default: throw Error("Invalid data type");
             }
         }
+
+        // the shaders that are not compiled ahead of time by compile.sh are passed as Metal source
+        // and compiled by the device
+        id<MTLLibrary> newLibrary(id<MTLDevice> device, const std::vector<std::uint8_t>& data, NSError** err)
+        {
+            constexpr std::uint8_t libraryMagic[] = {'M', 'T', 'L', 'B'};
+            if (data.size() >= std::size(libraryMagic) &&
+                std::equal(std::begin(libraryMagic), std::end(libraryMagic), data.begin()))
+            {
+                dispatch_data_t dispatchData = dispatch_data_create(data.data(), data.size(), nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
+                id<MTLLibrary> library = [device newLibraryWithData:dispatchData error:err];
+                dispatch_release(dispatchData);
+                return library;
+            }
+
+            Pointer<NSString*> source = [[NSString alloc] initWithBytes:data.data()
+                                                                 length:data.size()
+                                                               encoding:NSUTF8StringEncoding];
+            id<MTLLibrary> library = [device newLibraryWithSource:source.get() options:nil error:err];
+            if (library) *err = nil; // the warnings are reported as an error too
+            return library;
+        }
     }
 
     Shader::Shader(RenderDevice& initRenderDevice,
@@ -124,9 +147,7 @@ namespace ouzel::graphics::metal
 
         NSError* err;
 
-        dispatch_data_t fragmentShaderDispatchData = dispatch_data_create(fragmentShaderData.data(), fragmentShaderData.size(), nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
-        Pointer<id<MTLLibrary>> fragmentShaderLibrary = [renderDevice.getDevice().get() newLibraryWithData:fragmentShaderDispatchData error:&err];
-        dispatch_release(fragmentShaderDispatchData);
+        Pointer<id<MTLLibrary>> fragmentShaderLibrary = newLibrary(renderDevice.getDevice().get(), fragmentShaderData, &err);
 
         if (!fragmentShaderLibrary || err != nil)
             throw Error("Failed to load pixel shader, " + std::string(err ? [err.localizedDescription cStringUsingEncoding:NSUTF8StringEncoding] : "unknown error"));
@@ -148,9 +169,7 @@ namespace ouzel::graphics::metal
             }
         }
 
-        dispatch_data_t vertexShaderDispatchData = dispatch_data_create(vertexShaderData.data(), vertexShaderData.size(), nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT);
-        Pointer<id<MTLLibrary>> vertexShaderLibrary = [renderDevice.getDevice().get() newLibraryWithData:vertexShaderDispatchData error:&err];
-        dispatch_release(vertexShaderDispatchData);
+        Pointer<id<MTLLibrary>> vertexShaderLibrary = newLibrary(renderDevice.getDevice().get(), vertexShaderData, &err);
 
         if (!vertexShaderLibrary || err != nil)
             throw Error("Failed to load vertex shader, " + std::string(err ? [err.localizedDescription cStringUsingEncoding:NSUTF8StringEncoding] : "unknown error"));
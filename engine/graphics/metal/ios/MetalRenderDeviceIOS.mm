@@ -56,9 +56,7 @@ namespace ouzel::graphics::metal::ios
     RenderDevice::~RenderDevice()
     {
         displayLink.stop();
-        CommandBuffer commandBuffer;
-        commandBuffer.pushCommand(std::make_unique<PresentCommand>());
-        submitCommandBuffer(std::move(commandBuffer));
+        wakeRenderThread();
     }
 
     void RenderDevice::renderCallback()
@@ -52,9 +52,7 @@ namespace ouzel::graphics::metal::tvos
     RenderDevice::~RenderDevice()
     {
         displayLink.stop();
-        CommandBuffer commandBuffer;
-        commandBuffer.pushCommand(std::make_unique<PresentCommand>());
-        submitCommandBuffer(std::move(commandBuffer));
+        wakeRenderThread();
     }
 
     void RenderDevice::renderCallback()
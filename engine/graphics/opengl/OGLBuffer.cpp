@@ -4,6 +4,8 @@
 
 #if OUZEL_COMPILE_OPENGL
 
+#include <cstring>
+#include <stdexcept>
 #include "OGLBuffer.hpp"
 #include "OGLError.hpp"
 #include "OGLRenderDevice.hpp"
@@ -19,94 +21,110 @@ namespace ouzel::graphics::opengl
         type(initType),
         flags(initFlags),
         data(initData),
+        bufferCount((initFlags & Flags::dynamic) == Flags::dynamic ? streamingBufferCount : 1),
         size(static_cast<GLsizeiptr>(initSize))
     {
-        createBuffer();
-
-        if (size > 0)
-        {
-            renderDevice.bindBuffer(bufferType, bufferId);
-
-            if (data.empty())
-                renderDevice.glBufferDataProc(bufferType, size, nullptr,
-                                              (flags & Flags::dynamic) == Flags::dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-            else
-                renderDevice.glBufferDataProc(bufferType, size, data.data(),
-                                              (flags & Flags::dynamic) == Flags::dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-
-            if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
-                throw std::system_error(makeErrorCode(error), "Failed to create buffer");
-        }
+        createBuffers();
     }
 
     Buffer::~Buffer()
     {
-        if (bufferId)
-            renderDevice.deleteBuffer(bufferId);
+        for (std::size_t i = 0; i < bufferCount; ++i)
+        {
+            if (fences[i])
+                renderDevice.glDeleteSyncProc(fences[i]);
+
+            if (bufferIds[i])
+                renderDevice.deleteBuffer(bufferIds[i]);
+        }
     }
 
     void Buffer::reload()
     {
-        bufferId = 0;
+        // the buffers and fences were lost with the context
+        bufferIds = {};
+        bufferSizes = {};
+        fences = {};
+        currentBuffer = 0;
 
-        createBuffer();
-
-        if (size > 0)
-        {
-            renderDevice.bindBuffer(bufferType, bufferId);
-
-            if (data.empty())
-                renderDevice.glBufferDataProc(bufferType, size, nullptr,
-                                              (flags & Flags::dynamic) == Flags::dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-            else
-                renderDevice.glBufferDataProc(bufferType, size, data.data(),
-                                              (flags & Flags::dynamic) == Flags::dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-
-            if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
-                throw std::system_error(makeErrorCode(error), "Failed to create buffer");
-        }
+        createBuffers();
     }
 
-    void Buffer::setData(const std::vector<std::uint8_t>& newData)
+    void Buffer::setData(const void* newData, std::size_t newSize)
     {
         if ((flags & Flags::dynamic) != Flags::dynamic)
             throw Error("Buffer is not dynamic");
 
-        if (newData.empty())
+        if (!newSize)
             throw std::invalid_argument("Data is empty");
 
-        data = newData;
-
-        if (!bufferId)
+        if (!bufferIds[currentBuffer])
             throw Error("Buffer not initialized");
 
-        renderDevice.bindBuffer(bufferType, bufferId);
+        const auto bytes = static_cast<const std::uint8_t*>(newData);
+        data.assign(bytes, bytes + newSize);
+
+        // mark the point after which the GPU is done with the current buffer and move to the next one
+        if (renderDevice.glFenceSyncProc)
+        {
+            if (fences[currentBuffer]) renderDevice.glDeleteSyncProc(fences[currentBuffer]);
+            fences[currentBuffer] = renderDevice.glFenceSyncProc(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        if (++currentBuffer >= bufferCount) currentBuffer = 0;
+
+        const auto dataSize = static_cast<GLsizeiptr>(newSize);
+        if (dataSize > size) size = dataSize;
 
-        if (static_cast<GLsizeiptr>(data.size()) > size)
+        renderDevice.bindBuffer(bufferType, bufferIds[currentBuffer]);
+
+        if (dataSize > bufferSizes[currentBuffer])
         {
-            size = static_cast<GLsizeiptr>(data.size());
+            bufferSizes[currentBuffer] = dataSize;
 
-            renderDevice.glBufferDataProc(bufferType, size, data.data(), GL_DYNAMIC_DRAW);
+            renderDevice.glBufferDataProc(bufferType, dataSize, newData, GL_DYNAMIC_DRAW);
 
             if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
                 throw std::system_error(makeErrorCode(error), "Failed to create buffer");
         }
+        else if (renderDevice.glMapBufferRangeProc && isIdle(currentBuffer))
+        {
+            // the GPU has finished reading the buffer, so it can be written without synchronization
+            void* mappedData = renderDevice.glMapBufferRangeProc(bufferType, 0, dataSize,
+                                                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+            if (!mappedData)
+                throw std::system_error(makeErrorCode(renderDevice.glGetErrorProc()), "Failed to map buffer");
+
+            std::memcpy(mappedData, newData, newSize);
+
+            if (renderDevice.glUnmapBufferProc(bufferType) != GL_TRUE)
+                throw Error("Failed to unmap buffer");
+        }
         else
         {
-            renderDevice.glBufferSubDataProc(bufferType, 0, static_cast<GLsizeiptr>(data.size()), data.data());
+            renderDevice.glBufferSubDataProc(bufferType, 0, dataSize, newData);
 
             if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
                 throw std::system_error(makeErrorCode(error), "Failed to upload buffer");
         }
     }
 
-    void Buffer::createBuffer()
+    bool Buffer::isIdle(std::size_t index)
     {
-        renderDevice.glGenBuffersProc(1, &bufferId);
+        if (!fences[index]) return false;
 
-        if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
-            throw std::system_error(makeErrorCode(error), "Failed to create buffer");
+        const auto result = renderDevice.glClientWaitSyncProc(fences[index], 0, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            return false;
 
+        renderDevice.glDeleteSyncProc(fences[index]);
+        fences[index] = nullptr;
+        return true;
+    }
+
+    void Buffer::createBuffers()
+    {
         switch (type)
         {
             case BufferType::index:
@@ -118,6 +136,36 @@ namespace ouzel::graphics::opengl
             default:
                 throw Error("Unsupported buffer type");
         }
+
+        renderDevice.glGenBuffersProc(static_cast<GLsizei>(bufferCount), bufferIds.data());
+
+        if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
+            throw std::system_error(makeErrorCode(error), "Failed to create buffer");
+
+        if (size > 0)
+        {
+            for (std::size_t i = 0; i < bufferCount; ++i)
+            {
+                renderDevice.bindBuffer(bufferType, bufferIds[i]);
+
+                const auto usage = (flags & Flags::dynamic) == Flags::dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+
+                // the last data uploaded to a dynamic buffer can be smaller than the buffer
+                if (static_cast<GLsizeiptr>(data.size()) == size)
+                    renderDevice.glBufferDataProc(bufferType, size, data.data(), usage);
+                else
+                {
+                    renderDevice.glBufferDataProc(bufferType, size, nullptr, usage);
+                    if (!data.empty())
+                        renderDevice.glBufferSubDataProc(bufferType, 0, static_cast<GLsizeiptr>(data.size()), data.data());
+                }
+
+                if (const auto error = renderDevice.glGetErrorProc(); error != GL_NO_ERROR)
+                    throw std::system_error(makeErrorCode(error), "Failed to create buffer");
+
+                bufferSizes[i] = size;
+            }
+        }
     }
 }
 
@@ -7,6 +7,8 @@
 
 #if OUZEL_COMPILE_OPENGL
 
+#include <array>
+#include <vector>
 #include "OGL.h"
 
 #if OUZEL_OPENGLES
@@ -39,23 +41,33 @@ namespace ouzel::graphics::opengl
 
         void reload() final;
 
-        void setData(const std::vector<std::uint8_t>& newData);
+        void setData(const void* newData, std::size_t newSize);
 
         auto getFlags() const noexcept { return flags; }
         auto getType() const noexcept { return type; }
         auto getSize() const noexcept { return size; }
+        auto& getData() const noexcept { return data; }
 
-        auto getBufferId() const noexcept { return bufferId; }
+        auto getBufferId() const noexcept { return bufferIds[currentBuffer]; }
         auto getBufferType() const noexcept { return bufferType; }
 
     private:
-        void createBuffer();
+        void createBuffers();
+        bool isIdle(std::size_t index);
+
+        // dynamic buffers stream their data through a ring of buffers,
+        // so that the buffer being written is not the one the GPU is reading from
+        static constexpr std::size_t streamingBufferCount = 3;
 
         BufferType type;
         Flags flags = Flags::none;
-        std::vector<std::uint8_t> data;
+        std::vector<std::uint8_t> data; // kept for reloading the buffer after a context loss
 
-        GLuint bufferId = 0;
+        std::array<GLuint, streamingBufferCount> bufferIds{};
+        std::array<GLsizeiptr, streamingBufferCount> bufferSizes{};
+        std::array<GLsync, streamingBufferCount> fences{};
+        std::size_t bufferCount = 1;
+        std::size_t currentBuffer = 0;
         GLsizeiptr size = 0;
 
         GLuint bufferType = 0;
@@ -289,8 +289,18 @@ namespace ouzel::graphics::opengl
 
     RenderDevice::~RenderDevice()
     {
+        for (const auto& vertexArray : vertexArrays)
+            glDeleteVertexArraysProc(1, &vertexArray.second);
+        vertexArrays.clear();
+
         if (vertexArrayId) glDeleteVertexArraysProc(1, &vertexArrayId);
 
+#if !OUZEL_OPENGLES
+        if (timerQueryActive) glEndQueryProc(GL_TIME_ELAPSED);
+        for (const auto& timerQuery : timerQueries)
+            if (timerQuery.id) glDeleteQueriesProc(1, &timerQuery.id);
+#endif
+
         resources.clear();
     }
 
@@ -412,6 +422,13 @@ namespace ouzel::graphics::opengl
         glEnableVertexAttribArrayProc = getter.get<PFNGLENABLEVERTEXATTRIBARRAYPROC>("glEnableVertexAttribArray", ApiVersion(2, 0));
         glDisableVertexAttribArrayProc = getter.get<PFNGLDISABLEVERTEXATTRIBARRAYPROC>("glDisableVertexAttribArray", ApiVersion(2, 0));
         glVertexAttribPointerProc = getter.get<PFNGLVERTEXATTRIBPOINTERPROC>("glVertexAttribPointer", ApiVersion(2, 0));
+        glVertexAttrib4fvProc = getter.get<PFNGLVERTEXATTRIB4FVPROC>("glVertexAttrib4fv", ApiVersion(2, 0));
+        glVertexAttribDivisorProc = getter.get<PFNGLVERTEXATTRIBDIVISORPROC>("glVertexAttribDivisor", ApiVersion(3, 0),
+                                                                             {{"glVertexAttribDivisorEXT", "GL_EXT_instanced_arrays"},
+                                                                              {"glVertexAttribDivisorANGLE", "GL_ANGLE_instanced_arrays"}});
+        glDrawElementsInstancedProc = getter.get<PFNGLDRAWELEMENTSINSTANCEDPROC>("glDrawElementsInstanced", ApiVersion(3, 0),
+                                                                                 {{"glDrawElementsInstancedEXT", "GL_EXT_instanced_arrays"},
+                                                                                  {"glDrawElementsInstancedANGLE", "GL_ANGLE_instanced_arrays"}});
 
         glGenFramebuffersProc = getter.get<PFNGLGENFRAMEBUFFERSPROC>("glGenFramebuffers", ApiVersion(2, 0));
         glDeleteFramebuffersProc = getter.get<PFNGLDELETEFRAMEBUFFERSPROC>("glDeleteFramebuffers", ApiVersion(2, 0));
@@ -440,6 +457,13 @@ namespace ouzel::graphics::opengl
         glUnmapBufferProc = getter.get<PFNGLUNMAPBUFFERPROC>("glUnmapBuffer", ApiVersion(3, 0),
                                                              {{"glUnmapBufferOES", "GL_OES_mapbuffer"}});
 
+        glFenceSyncProc = getter.get<PFNGLFENCESYNCPROC>("glFenceSync", ApiVersion(3, 0),
+                                                         {{"glFenceSyncAPPLE", "GL_APPLE_sync"}});
+        glDeleteSyncProc = getter.get<PFNGLDELETESYNCPROC>("glDeleteSync", ApiVersion(3, 0),
+                                                           {{"glDeleteSyncAPPLE", "GL_APPLE_sync"}});
+        glClientWaitSyncProc = getter.get<PFNGLCLIENTWAITSYNCPROC>("glClientWaitSync", ApiVersion(3, 0),
+                                                                   {{"glClientWaitSyncAPPLE", "GL_APPLE_sync"}});
+
         glGenVertexArraysProc = getter.get<PFNGLGENVERTEXARRAYSPROC>("glGenVertexArrays", ApiVersion(3, 0),
                                                                      {{"glGenVertexArraysOES", "GL_OES_vertex_array_object"}});
         glBindVertexArrayProc = getter.get<PFNGLBINDVERTEXARRAYPROC>("glBindVertexArray", ApiVersion(3, 0),
@@ -561,6 +585,12 @@ namespace ouzel::graphics::opengl
         glEnableVertexAttribArrayProc = getter.get<PFNGLENABLEVERTEXATTRIBARRAYPROC>("glEnableVertexAttribArray", ApiVersion(2, 0));
         glDisableVertexAttribArrayProc = getter.get<PFNGLDISABLEVERTEXATTRIBARRAYPROC>("glDisableVertexAttribArray", ApiVersion(2, 0));
         glVertexAttribPointerProc = getter.get<PFNGLVERTEXATTRIBPOINTERPROC>("glVertexAttribPointer", ApiVersion(2, 0));
+        glVertexAttrib4fvProc = getter.get<PFNGLVERTEXATTRIB4FVPROC>("glVertexAttrib4fv", ApiVersion(2, 0));
+        glVertexAttribDivisorProc = getter.get<PFNGLVERTEXATTRIBDIVISORPROC>("glVertexAttribDivisor", ApiVersion(3, 3),
+                                                                             {{"glVertexAttribDivisorARB", "GL_ARB_instanced_arrays"}});
+        glDrawElementsInstancedProc = getter.get<PFNGLDRAWELEMENTSINSTANCEDPROC>("glDrawElementsInstanced", ApiVersion(3, 1),
+                                                                                 {{"glDrawElementsInstancedARB", "GL_ARB_draw_instanced"},
+                                                                                  {"glDrawElementsInstancedEXT", "GL_EXT_draw_instanced"}});
 
         glMapBufferProc = getter.get<PFNGLMAPBUFFERPROC>("glMapBuffer", ApiVersion(2, 0));
         glUnmapBufferProc = getter.get<PFNGLUNMAPBUFFERPROC>("glUnmapBuffer", ApiVersion(2, 0));
@@ -573,6 +603,13 @@ namespace ouzel::graphics::opengl
         glMapBufferRangeProc = getter.get<PFNGLMAPBUFFERRANGEPROC>("glMapBufferRange", ApiVersion(3, 0),
                                                                    {{"glMapBufferRange", "GL_ARB_map_buffer_range"}});
 
+        glFenceSyncProc = getter.get<PFNGLFENCESYNCPROC>("glFenceSync", ApiVersion(3, 2),
+                                                         {{"glFenceSync", "GL_ARB_sync"}});
+        glDeleteSyncProc = getter.get<PFNGLDELETESYNCPROC>("glDeleteSync", ApiVersion(3, 2),
+                                                           {{"glDeleteSync", "GL_ARB_sync"}});
+        glClientWaitSyncProc = getter.get<PFNGLCLIENTWAITSYNCPROC>("glClientWaitSync", ApiVersion(3, 2),
+                                                                   {{"glClientWaitSync", "GL_ARB_sync"}});
+
         glGenVertexArraysProc = getter.get<PFNGLGENVERTEXARRAYSPROC>("glGenVertexArrays", ApiVersion(3, 0),
                                                                      {{"glGenVertexArrays", "GL_ARB_vertex_array_object"}});
         glBindVertexArrayProc = getter.get<PFNGLBINDVERTEXARRAYPROC>("glBindVertexArray", ApiVersion(3, 0),
@@ -632,10 +669,30 @@ namespace ouzel::graphics::opengl
 
         glPushGroupMarkerEXTProc = getter.get<PFNGLPUSHGROUPMARKEREXTPROC>("glPushGroupMarkerEXT", "GL_EXT_debug_marker");
         glPopGroupMarkerEXTProc = getter.get<PFNGLPOPGROUPMARKEREXTPROC>("glPopGroupMarkerEXT", "GL_EXT_debug_marker");
+
+        if (apiVersion >= ApiVersion(3, 3) || getter.hasExtension("GL_ARB_timer_query"))
+        {
+            glGenQueriesProc = getter.get<PFNGLGENQUERIESPROC>("glGenQueries", ApiVersion(1, 5));
+            glDeleteQueriesProc = getter.get<PFNGLDELETEQUERIESPROC>("glDeleteQueries", ApiVersion(1, 5));
+            glBeginQueryProc = getter.get<PFNGLBEGINQUERYPROC>("glBeginQuery", ApiVersion(1, 5));
+            glEndQueryProc = getter.get<PFNGLENDQUERYPROC>("glEndQuery", ApiVersion(1, 5));
+            glGetQueryObjectuivProc = getter.get<PFNGLGETQUERYOBJECTUIVPROC>("glGetQueryObjectuiv", ApiVersion(1, 5));
+            glGetQueryObjectui64vProc = getter.get<PFNGLGETQUERYOBJECTUI64VPROC>("glGetQueryObjectui64v", ApiVersion(3, 3),
+                                                                                 {{"glGetQueryObjectui64v", "GL_ARB_timer_query"}});
+        }
 #endif
 
         if (!multisamplingSupported) sampleCount = 1;
 
+        GLint maxVertexAttributes;
+        glGetIntegervProc(GL_MAX_VERTEX_ATTRIBS, &maxVertexAttributes);
+
+        if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+            throw std::system_error(makeErrorCode(error), "Failed to get maximum vertex attribute count");
+
+        // without the instanced arrays the instances are drawn one by one with constant attributes
+        instancingSupported = static_cast<GLuint>(maxVertexAttributes) >= getInstanceAttributeLocation(instanceAttributes.size());
+
         glDisableProc(GL_DITHER);
 
         if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
@@ -661,13 +718,25 @@ namespace ouzel::graphics::opengl
         {
             glGenVertexArraysProc(1, &vertexArrayId);
 
-            glBindVertexArrayProc(vertexArrayId);
+            bindVertexArray(vertexArrayId);
 
             if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
                 throw std::system_error(makeErrorCode(error), "Failed to bind vertex array");
         }
 
         setFrontFace(GL_CW);
+
+#if !OUZEL_OPENGLES
+        if (glGenQueriesProc && glDeleteQueriesProc && glBeginQueryProc && glEndQueryProc &&
+            glGetQueryObjectuivProc && glGetQueryObjectui64vProc)
+        {
+            for (auto& timerQuery : timerQueries)
+                glGenQueriesProc(1, &timerQuery.id);
+
+            if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+                throw std::system_error(makeErrorCode(error), "Failed to create timer queries");
+        }
+#endif
     }
 
     void RenderDevice::setUniform(GLint location, DataType dataType, const void* data)
@@ -725,6 +794,17 @@ namespace ouzel::graphics::opengl
         }
     }
 
+    void RenderDevice::setUniform(const Shader::Location& location, const float* data, std::size_t size)
+    {
+        // uniform values are part of the program state, so skip the upload if the value has not changed
+        if (location.value.size() == size &&
+            std::equal(data, data + size, location.value.begin()))
+            return;
+
+        location.value.assign(data, data + size);
+        setUniform(location.location, location.dataType, data);
+    }
+
     void RenderDevice::process()
     {
         graphics::RenderDevice::process();
@@ -733,26 +813,24 @@ namespace ouzel::graphics::opengl
         const RenderTarget* currentRenderTarget = nullptr;
         const Shader* currentShader = nullptr;
 
-        CommandBuffer commandBuffer;
-        std::unique_ptr<Command> command;
-
         for (;;)
         {
-            std::unique_lock lock(commandQueueMutex);
-            while (commandQueue.empty()) commandQueueCondition.wait(lock);
-            commandBuffer = std::move(commandQueue.front());
-            commandQueue.pop();
-            lock.unlock();
+            const CommandBuffer& commandBuffer = getNextCommandBuffer();
 
-            while (!commandBuffer.isEmpty())
-            {
-                command = commandBuffer.popCommand();
+#if !OUZEL_OPENGLES
+            if (const auto frameIndex = getExecutingFrameIndex())
+                beginTimerQuery(frameIndex);
+#endif
 
-                switch (command->type)
+            bool presented = false;
+
+            for (const auto& command : commandBuffer)
+            {
+                switch (command.type)
                 {
                     case Command::Type::resize:
                     {
-                        auto resizeCommand = static_cast<const ResizeCommand*>(command.get());
+                        auto resizeCommand = static_cast<const ResizeCommand*>(&command);
                         frameBufferWidth = static_cast<GLsizei>(resizeCommand->size.v[0]);
                         frameBufferHeight = static_cast<GLsizei>(resizeCommand->size.v[1]);
                         resizeFrameBuffer();
@@ -761,20 +839,23 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::present:
                     {
+                        drawCallCount = frameDrawCallCount;
+                        frameDrawCallCount = 0;
+
                         present();
                         break;
                     }
 
                     case Command::Type::deleteResource:
                     {
-                        auto deleteResourceCommand = static_cast<const DeleteResourceCommand*>(command.get());
+                        auto deleteResourceCommand = static_cast<const DeleteResourceCommand*>(&command);
                         resources[deleteResourceCommand->resource - 1].reset();
                         break;
                     }
 
                     case Command::Type::initRenderTarget:
                     {
-                        auto initRenderTargetCommand = static_cast<const InitRenderTargetCommand*>(command.get());
+                        auto initRenderTargetCommand = static_cast<const InitRenderTargetCommand*>(&command);
 
                         std::set<Texture*> colorTextures;
                         for (const auto colorTextureId : initRenderTargetCommand->colorTextures)
@@ -792,7 +873,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setRenderTarget:
                     {
-                        auto setRenderTargetCommand = static_cast<const SetRenderTargetCommand*>(command.get());
+                        auto setRenderTargetCommand = static_cast<const SetRenderTargetCommand*>(&command);
 
                         if (setRenderTargetCommand->renderTarget)
                         {
@@ -813,7 +894,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::clearRenderTarget:
                     {
-                        auto clearCommand = static_cast<const ClearRenderTargetCommand*>(command.get());
+                        auto clearCommand = static_cast<const ClearRenderTargetCommand*>(&command);
 
                         const GLbitfield clearMask = (clearCommand->clearColorBuffer ? GL_COLOR_BUFFER_BIT : 0) |
                             (clearCommand->clearDepthBuffer ? GL_DEPTH_BUFFER_BIT : 0 |
@@ -867,7 +948,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setScissorTest:
                     {
-                        auto setScissorTestCommand = static_cast<const SetScissorTestCommand*>(command.get());
+                        auto setScissorTestCommand = static_cast<const SetScissorTestCommand*>(&command);
 
                         setScissorTest(setScissorTestCommand->enabled,
                                        static_cast<GLint>(setScissorTestCommand->rectangle.position.v[0]),
@@ -880,7 +961,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setViewport:
                     {
-                        auto setViewportCommand = static_cast<const SetViewportCommand*>(command.get());
+                        auto setViewportCommand = static_cast<const SetViewportCommand*>(&command);
 
                         setViewport(static_cast<GLint>(setViewportCommand->viewport.position.v[0]),
                                     static_cast<GLint>(setViewportCommand->viewport.position.v[1]),
@@ -892,7 +973,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::initDepthStencilState:
                     {
-                        auto initDepthStencilStateCommand = static_cast<const InitDepthStencilStateCommand*>(command.get());
+                        auto initDepthStencilStateCommand = static_cast<const InitDepthStencilStateCommand*>(&command);
                         auto depthStencilState = std::make_unique<DepthStencilState>(*this,
                                                                                      initDepthStencilStateCommand->depthTest,
                                                                                      initDepthStencilStateCommand->depthWrite,
@@ -917,7 +998,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setDepthStencilState:
                     {
-                        auto setDepthStencilStateCommand = static_cast<const SetDepthStencilStateCommand*>(command.get());
+                        auto setDepthStencilStateCommand = static_cast<const SetDepthStencilStateCommand*>(&command);
 
                         if (setDepthStencilStateCommand->depthStencilState)
                         {
@@ -962,7 +1043,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setPipelineState:
                     {
-                        auto setPipelineStateCommand = static_cast<const SetPipelineStateCommand*>(command.get());
+                        auto setPipelineStateCommand = static_cast<const SetPipelineStateCommand*>(&command);
 
                         auto blendState = getResource<BlendState>(setPipelineStateCommand->blendState);
                         auto shader = getResource<Shader>(setPipelineStateCommand->shader);
@@ -1012,7 +1093,9 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::draw:
                     {
-                        auto drawCommand = static_cast<const DrawCommand*>(command.get());
+                        ++frameDrawCallCount;
+
+                        auto drawCommand = static_cast<const DrawCommand*>(&command);
 
                         // mesh buffer
                         auto indexBuffer = getResource<Buffer>(drawCommand->indexBuffer);
@@ -1024,29 +1107,15 @@ namespace ouzel::graphics::opengl
                         assert(vertexBuffer->getBufferId());
 
                         // draw
-                        bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getBufferId());
-                        bindBuffer(GL_ARRAY_BUFFER, vertexBuffer->getBufferId());
-
-                        const std::byte* vertexOffset = nullptr;
-
-                        for (GLuint index = 0; index < RenderDevice::vertexAttributes.size(); ++index)
+                        if (vertexArrayId)
+                            bindVertexArray(getVertexArray(vertexBuffer->getBufferId(), indexBuffer->getBufferId()));
+                        else
                         {
-                            const auto& vertexAttribute = RenderDevice::vertexAttributes[index];
-
-                            glEnableVertexAttribArrayProc(index);
-                            glVertexAttribPointerProc(index,
-                                                      getArraySize(vertexAttribute.dataType),
-                                                      getVertexType(vertexAttribute.dataType),
-                                                      isNormalized(vertexAttribute.dataType),
-                                                      static_cast<GLsizei>(sizeof(Vertex)),
-                                                      vertexOffset);
-
-                            vertexOffset += getDataTypeSize(vertexAttribute.dataType);
+                            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getBufferId());
+                            bindBuffer(GL_ARRAY_BUFFER, vertexBuffer->getBufferId());
+                            setVertexAttributes();
                         }
 
-                        if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
-                            throw std::system_error(makeErrorCode(error), "Failed to update vertex attributes");
-
                         assert(drawCommand->indexCount);
                         assert(indexBuffer->getSize());
                         assert(vertexBuffer->getSize());
@@ -1059,15 +1128,23 @@ namespace ouzel::graphics::opengl
                                            getIndexType(drawCommand->indexSize),
                                            indexOffset);
 
-                        if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
-                            throw std::system_error(makeErrorCode(error), "Failed to draw elements");
+                        if (debugRenderer)
+                            if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+                                throw std::system_error(makeErrorCode(error), "Failed to draw elements");
 
                         break;
                     }
 
+                    case Command::Type::drawInstanced:
+                    {
+                        auto drawInstancedCommand = static_cast<const DrawInstancedCommand*>(&command);
+                        drawInstanced(*drawInstancedCommand);
+                        break;
+                    }
+
                     case Command::Type::initBlendState:
                     {
-                        auto initBlendStateCommand = static_cast<const InitBlendStateCommand*>(command.get());
+                        auto initBlendStateCommand = static_cast<const InitBlendStateCommand*>(&command);
 
                         auto blendState = std::make_unique<BlendState>(*this,
                                                                        initBlendStateCommand->enableBlending,
@@ -1087,7 +1164,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::initBuffer:
                     {
-                        auto initBufferCommand = static_cast<const InitBufferCommand*>(command.get());
+                        auto initBufferCommand = static_cast<const InitBufferCommand*>(&command);
 
                         auto buffer = std::make_unique<Buffer>(*this,
                                                                initBufferCommand->bufferType,
@@ -1103,16 +1180,16 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setBufferData:
                     {
-                        auto setBufferDataCommand = static_cast<const SetBufferDataCommand*>(command.get());
+                        auto setBufferDataCommand = static_cast<const SetBufferDataCommand*>(&command);
 
                         auto buffer = getResource<Buffer>(setBufferDataCommand->buffer);
-                        buffer->setData(setBufferDataCommand->data);
+                        buffer->setData(setBufferDataCommand->data, setBufferDataCommand->size);
                         break;
                     }
 
                     case Command::Type::initShader:
                     {
-                        auto initShaderCommand = static_cast<const InitShaderCommand*>(command.get());
+                        auto initShaderCommand = static_cast<const InitShaderCommand*>(&command);
 
                         auto shader = std::make_unique<Shader>(*this,
                                                                initShaderCommand->fragmentShader,
@@ -1131,7 +1208,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setShaderConstants:
                     {
-                        auto setShaderConstantsCommand = static_cast<const SetShaderConstantsCommand*>(command.get());
+                        auto setShaderConstantsCommand = static_cast<const SetShaderConstantsCommand*>(&command);
 
                         if (!currentShader)
                             throw Error("No shader set");
@@ -1139,33 +1216,34 @@ namespace ouzel::graphics::opengl
                         // pixel shader constants
                         const std::vector<Shader::Location>& fragmentShaderConstantLocations = currentShader->getFragmentShaderConstantLocations();
 
-                        if (setShaderConstantsCommand->fragmentShaderConstants.size() > fragmentShaderConstantLocations.size())
+                        if (setShaderConstantsCommand->fragmentShaderConstantCount > fragmentShaderConstantLocations.size())
                             throw Error("Invalid pixel shader constant size");
 
-                        for (std::size_t i = 0; i < setShaderConstantsCommand->fragmentShaderConstants.size(); ++i)
+                        for (std::uint32_t i = 0; i < setShaderConstantsCommand->fragmentShaderConstantCount; ++i)
                         {
                             const auto& fragmentShaderConstantLocation = fragmentShaderConstantLocations[i];
-                            const auto& fragmentShaderConstant = setShaderConstantsCommand->fragmentShaderConstants[i];
+                            const auto& fragmentShaderConstant = commandBuffer.getShaderConstant(setShaderConstantsCommand->firstShaderConstant + i);
 
-                            setUniform(fragmentShaderConstantLocation.location,
-                                       fragmentShaderConstantLocation.dataType,
-                                       fragmentShaderConstant.data());
+                            setUniform(fragmentShaderConstantLocation,
+                                       commandBuffer.getShaderConstantData(fragmentShaderConstant),
+                                       fragmentShaderConstant.size);
                         }
 
                         // vertex shader constants
                         const std::vector<Shader::Location>& vertexShaderConstantLocations = currentShader->getVertexShaderConstantLocations();
 
-                        if (setShaderConstantsCommand->vertexShaderConstants.size() > vertexShaderConstantLocations.size())
+                        if (setShaderConstantsCommand->vertexShaderConstantCount > vertexShaderConstantLocations.size())
                             throw Error("Invalid vertex shader constant size");
 
-                        for (std::size_t i = 0; i < setShaderConstantsCommand->vertexShaderConstants.size(); ++i)
+                        for (std::uint32_t i = 0; i < setShaderConstantsCommand->vertexShaderConstantCount; ++i)
                         {
                             const auto& vertexShaderConstantLocation = vertexShaderConstantLocations[i];
-                            const auto& vertexShaderConstant = setShaderConstantsCommand->vertexShaderConstants[i];
+                            const auto& vertexShaderConstant = commandBuffer.getShaderConstant(setShaderConstantsCommand->firstShaderConstant +
+                                                                                               setShaderConstantsCommand->fragmentShaderConstantCount + i);
 
-                            setUniform(vertexShaderConstantLocation.location,
-                                       vertexShaderConstantLocation.dataType,
-                                       vertexShaderConstant.data());
+                            setUniform(vertexShaderConstantLocation,
+                                       commandBuffer.getShaderConstantData(vertexShaderConstant),
+                                       vertexShaderConstant.size);
                         }
 
                         break;
@@ -1173,7 +1251,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::initTexture:
                     {
-                        auto initTextureCommand = static_cast<const InitTextureCommand*>(command.get());
+                        auto initTextureCommand = static_cast<const InitTextureCommand*>(&command);
 
                         auto texture = std::make_unique<Texture>(*this,
                                                                  initTextureCommand->levels,
@@ -1192,7 +1270,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setTextureData:
                     {
-                        auto setTextureDataCommand = static_cast<const SetTextureDataCommand*>(command.get());
+                        auto setTextureDataCommand = static_cast<const SetTextureDataCommand*>(&command);
 
                         auto texture = getResource<Texture>(setTextureDataCommand->texture);
                         texture->setData(setTextureDataCommand->levels);
@@ -1202,7 +1280,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setTextureParameters:
                     {
-                        auto setTextureParametersCommand = static_cast<const SetTextureParametersCommand*>(command.get());
+                        auto setTextureParametersCommand = static_cast<const SetTextureParametersCommand*>(&command);
 
                         auto texture = getResource<Texture>(setTextureParametersCommand->texture);
                         texture->setFilter(setTextureParametersCommand->filter);
@@ -1215,7 +1293,7 @@ namespace ouzel::graphics::opengl
 
                     case Command::Type::setTextures:
                     {
-                        auto setTexturesCommand = static_cast<const SetTexturesCommand*>(command.get());
+                        auto setTexturesCommand = static_cast<const SetTexturesCommand*>(&command);
 
                         for (std::uint32_t layer = 0; layer < setTexturesCommand->textures.size(); ++layer)
                         {
@@ -1232,9 +1310,246 @@ namespace ouzel::graphics::opengl
                         throw Error("Invalid command");
                 }
 
-                if (command->type == Command::Type::present) return;
+                if (command.type == Command::Type::present)
+                {
+                    presented = true;
+                    break;
+                }
+            }
+
+#if !OUZEL_OPENGLES
+            endTimerQuery();
+#endif
+
+            releaseCommandBuffer();
+            if (presented) return;
+        }
+    }
+
+    void RenderDevice::setVertexAttributes()
+    {
+        const std::byte* vertexOffset = nullptr;
+
+        for (GLuint index = 0; index < RenderDevice::vertexAttributes.size(); ++index)
+        {
+            const auto& vertexAttribute = RenderDevice::vertexAttributes[index];
+
+            glEnableVertexAttribArrayProc(index);
+            glVertexAttribPointerProc(index,
+                                      getArraySize(vertexAttribute.dataType),
+                                      getVertexType(vertexAttribute.dataType),
+                                      isNormalized(vertexAttribute.dataType),
+                                      static_cast<GLsizei>(sizeof(Vertex)),
+                                      vertexOffset);
+
+            vertexOffset += getDataTypeSize(vertexAttribute.dataType);
+        }
+
+        if (debugRenderer)
+            if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+                throw std::system_error(makeErrorCode(error), "Failed to update vertex attributes");
+    }
+
+    void RenderDevice::drawInstanced(const DrawInstancedCommand& command)
+    {
+        auto indexBuffer = getResource<Buffer>(command.indexBuffer);
+        auto vertexBuffer = getResource<Buffer>(command.vertexBuffer);
+        auto instanceBuffer = getResource<Buffer>(command.instanceBuffer);
+
+        assert(indexBuffer);
+        assert(indexBuffer->getBufferId());
+        assert(vertexBuffer);
+        assert(vertexBuffer->getBufferId());
+        assert(instanceBuffer);
+        assert(instanceBuffer->getBufferId());
+
+        if (!command.instanceCount) return;
+
+        if (vertexArrayId)
+            bindVertexArray(getVertexArray(vertexBuffer->getBufferId(), indexBuffer->getBufferId()));
+        else
+        {
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getBufferId());
+            bindBuffer(GL_ARRAY_BUFFER, vertexBuffer->getBufferId());
+            setVertexAttributes();
+        }
+
+        assert(command.indexCount);
+
+        const std::byte* indexOffset = nullptr;
+        indexOffset += command.startIndex * command.indexSize;
+
+        if (glDrawElementsInstancedProc && glVertexAttribDivisorProc)
+        {
+            ++frameDrawCallCount;
+
+            bindBuffer(GL_ARRAY_BUFFER, instanceBuffer->getBufferId());
+
+            const std::byte* instanceOffset = nullptr;
+
+            for (std::size_t i = 0; i < instanceAttributes.size(); ++i)
+            {
+                const auto& instanceAttribute = instanceAttributes[i];
+                const auto locationCount = getAttributeLocationCount(instanceAttribute.dataType);
+                const auto arraySize = getArraySize(instanceAttribute.dataType) / static_cast<GLint>(locationCount);
+                const auto columnSize = getDataTypeSize(instanceAttribute.dataType) / locationCount;
+
+                for (GLuint column = 0; column < locationCount; ++column)
+                {
+                    const auto location = getInstanceAttributeLocation(i) + column;
+
+                    glEnableVertexAttribArrayProc(location);
+                    glVertexAttribPointerProc(location,
+                                              arraySize,
+                                              getVertexType(instanceAttribute.dataType),
+                                              isNormalized(instanceAttribute.dataType),
+                                              static_cast<GLsizei>(sizeof(Instance)),
+                                              instanceOffset + column * columnSize);
+                    glVertexAttribDivisorProc(location, 1);
+                }
+
+                instanceOffset += getDataTypeSize(instanceAttribute.dataType);
+            }
+
+            glDrawElementsInstancedProc(getDrawMode(command.drawMode),
+                                        static_cast<GLsizei>(command.indexCount),
+                                        getIndexType(command.indexSize),
+                                        indexOffset,
+                                        static_cast<GLsizei>(command.instanceCount));
+
+            // the vertex arrays are shared with the draws that do not read the instance attributes
+            for (GLuint location = getInstanceAttributeLocation(0);
+                 location < getInstanceAttributeLocation(instanceAttributes.size()); ++location)
+                glDisableVertexAttribArrayProc(location);
+        }
+        else
+        {
+            static_assert(instanceAttributes[0].dataType == DataType::float32Matrix4 &&
+                          instanceAttributes[1].dataType == DataType::unsignedByteVector4Norm);
+
+            // the disabled attribute arrays read the constant attribute values, which are set for every instance
+            const auto& data = instanceBuffer->getData();
+
+            if (data.size() < command.instanceCount * sizeof(Instance))
+                throw Error("Instance buffer is too small");
+
+            for (std::uint32_t instance = 0; instance < command.instanceCount; ++instance)
+            {
+                ++frameDrawCallCount;
+
+                const auto instanceData = data.data() + instance * sizeof(Instance);
+
+                GLfloat transform[16];
+                std::memcpy(transform, instanceData, sizeof(transform));
+                for (GLuint column = 0; column < 4; ++column)
+                    glVertexAttrib4fvProc(getInstanceAttributeLocation(0) + column, transform + column * 4);
+
+                const auto color = instanceData + getDataTypeSize(instanceAttributes[0].dataType);
+                const GLfloat colorVector[] = {
+                    color[0] / 255.0F,
+                    color[1] / 255.0F,
+                    color[2] / 255.0F,
+                    color[3] / 255.0F
+                };
+                glVertexAttrib4fvProc(getInstanceAttributeLocation(1), colorVector);
+
+                glDrawElementsProc(getDrawMode(command.drawMode),
+                                   static_cast<GLsizei>(command.indexCount),
+                                   getIndexType(command.indexSize),
+                                   indexOffset);
             }
         }
+
+        if (debugRenderer)
+            if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+                throw std::system_error(makeErrorCode(error), "Failed to draw instances");
+    }
+
+#if !OUZEL_OPENGLES
+    void RenderDevice::beginTimerQuery(std::uint64_t frameIndex)
+    {
+        if (!timerQueries.front().id) return;
+
+        if (timerQueryActive) // the execution of the previous command buffer threw
+        {
+            glEndQueryProc(GL_TIME_ELAPSED);
+            timerQueryActive = false;
+            timerQueries[(firstTimerQuery + timerQueryCount - 1) % timerQueries.size()].frameIndex = 0;
+        }
+
+        readTimerQueries();
+
+        // skip the measurement if the GPU is too far behind
+        if (timerQueryCount == timerQueries.size()) return;
+
+        auto& timerQuery = timerQueries[(firstTimerQuery + timerQueryCount) % timerQueries.size()];
+        timerQuery.frameIndex = frameIndex;
+        glBeginQueryProc(GL_TIME_ELAPSED, timerQuery.id);
+
+        if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+            throw std::system_error(makeErrorCode(error), "Failed to begin timer query");
+
+        ++timerQueryCount;
+        timerQueryActive = true;
+    }
+
+    void RenderDevice::endTimerQuery()
+    {
+        if (!timerQueryActive) return;
+
+        glEndQueryProc(GL_TIME_ELAPSED);
+        timerQueryActive = false;
+
+        if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+            throw std::system_error(makeErrorCode(error), "Failed to end timer query");
+    }
+
+    void RenderDevice::readTimerQueries()
+    {
+        while (timerQueryCount)
+        {
+            const auto& timerQuery = timerQueries[firstTimerQuery];
+
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuivProc(timerQuery.id, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) break;
+
+            GLuint64 elapsedTime = 0;
+            glGetQueryObjectui64vProc(timerQuery.id, GL_QUERY_RESULT, &elapsedTime);
+
+            if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+                throw std::system_error(makeErrorCode(error), "Failed to get timer query result");
+
+            if (timerQuery.frameIndex)
+                setFrameGpuTime(timerQuery.frameIndex, std::chrono::nanoseconds(elapsedTime));
+
+            firstTimerQuery = (firstTimerQuery + 1) % timerQueries.size();
+            --timerQueryCount;
+        }
+    }
+#endif
+
+    GLuint RenderDevice::getVertexArray(GLuint vertexBufferId, GLuint indexBufferId)
+    {
+        const auto key = std::pair(vertexBufferId, indexBufferId);
+        if (const auto i = vertexArrays.find(key); i != vertexArrays.end())
+            return i->second;
+
+        GLuint newVertexArrayId = 0;
+        glGenVertexArraysProc(1, &newVertexArrayId);
+
+        if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+            throw std::system_error(makeErrorCode(error), "Failed to create vertex array");
+
+        bindVertexArray(newVertexArrayId);
+
+        // bound directly, the state cache tracks the element array buffer of the default vertex array only
+        glBindBufferProc(GL_ELEMENT_ARRAY_BUFFER, indexBufferId);
+        bindBuffer(GL_ARRAY_BUFFER, vertexBufferId);
+        setVertexAttributes();
+
+        vertexArrays[key] = newVertexArrayId;
+        return newVertexArrayId;
     }
 
     void RenderDevice::present()
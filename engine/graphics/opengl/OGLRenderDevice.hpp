@@ -10,6 +10,7 @@
 #include <cstring>
 #include <array>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <queue>
 #include <system_error>
@@ -42,6 +43,27 @@ namespace ouzel::graphics::opengl
         return std::error_code(static_cast<int>(e), getErrorCategory());
     }
 
+    // matrix attributes take a location for every column
+    constexpr GLuint getAttributeLocationCount(DataType dataType) noexcept
+    {
+        switch (dataType)
+        {
+            case DataType::float32Matrix3: return 3;
+            case DataType::float32Matrix4: return 4;
+            default: return 1;
+        }
+    }
+
+    // the instance attributes are bound to fixed locations after the vertex attributes,
+    // so the vertex arrays of the meshes can be used for the instanced draws
+    constexpr GLuint getInstanceAttributeLocation(std::size_t index) noexcept
+    {
+        auto location = static_cast<GLuint>(graphics::RenderDevice::vertexAttributes.size());
+        for (std::size_t i = 0; i < index; ++i)
+            location += getAttributeLocationCount(graphics::RenderDevice::instanceAttributes[i].dataType);
+        return location;
+    }
+
     class RenderDevice: public graphics::RenderDevice
     {
         friend Graphics;
@@ -115,6 +137,10 @@ namespace ouzel::graphics::opengl
         PFNGLMAPBUFFERRANGEPROC glMapBufferRangeProc = nullptr;
         PFNGLUNMAPBUFFERPROC glUnmapBufferProc = nullptr;
 
+        PFNGLFENCESYNCPROC glFenceSyncProc = nullptr;
+        PFNGLDELETESYNCPROC glDeleteSyncProc = nullptr;
+        PFNGLCLIENTWAITSYNCPROC glClientWaitSyncProc = nullptr;
+
         PFNGLCOPYIMAGESUBDATAPROC glCopyImageSubDataProc = nullptr;
 
 #if OUZEL_OPENGLES
@@ -129,6 +155,13 @@ namespace ouzel::graphics::opengl
         PFNGLPOLYGONMODEPROC glPolygonModeProc = nullptr;
         PFNGLCLEARDEPTHPROC glClearDepthProc = nullptr;
         PFNGLMAPBUFFERPROC glMapBufferProc = nullptr;
+
+        PFNGLGENQUERIESPROC glGenQueriesProc = nullptr;
+        PFNGLDELETEQUERIESPROC glDeleteQueriesProc = nullptr;
+        PFNGLBEGINQUERYPROC glBeginQueryProc = nullptr;
+        PFNGLENDQUERYPROC glEndQueryProc = nullptr;
+        PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuivProc = nullptr;
+        PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64vProc = nullptr;
 #endif
 
         PFNGLCREATESHADERPROC glCreateShaderProc = nullptr;
@@ -161,6 +194,9 @@ namespace ouzel::graphics::opengl
         PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArrayProc = nullptr;
         PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArrayProc = nullptr;
         PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointerProc = nullptr;
+        PFNGLVERTEXATTRIB4FVPROC glVertexAttrib4fvProc = nullptr;
+        PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisorProc = nullptr;
+        PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstancedProc = nullptr;
 
         PFNGLGETSTRINGIPROC glGetStringiProc = nullptr;
         PFNGLPUSHGROUPMARKEREXTPROC glPushGroupMarkerEXTProc = nullptr;
@@ -223,8 +259,25 @@ namespace ouzel::graphics::opengl
             }
         }
 
+        void bindVertexArray(GLuint newVertexArrayId)
+        {
+            if (stateCache.vertexArrayId != newVertexArrayId)
+            {
+                glBindVertexArrayProc(newVertexArrayId);
+                stateCache.vertexArrayId = newVertexArrayId;
+
+                if (debugRenderer)
+                    if (const auto error = glGetErrorProc(); error != GL_NO_ERROR)
+                        throw std::system_error(makeErrorCode(error), "Failed to bind vertex array");
+            }
+        }
+
         void bindBuffer(GLuint target, GLuint bufferId)
         {
+            // element array buffer binding is part of the vertex array state, so keep the cached vertex arrays intact
+            if (target == GL_ELEMENT_ARRAY_BUFFER && vertexArrayId)
+                bindVertexArray(vertexArrayId);
+
             GLuint& currentBufferId = stateCache.bufferId[target];
 
             if (currentBufferId != bufferId)
@@ -515,6 +568,17 @@ namespace ouzel::graphics::opengl
 
         void deleteBuffer(GLuint bufferId)
         {
+            for (auto i = vertexArrays.begin(); i != vertexArrays.end();)
+            {
+                if (i->first.first == bufferId || i->first.second == bufferId)
+                {
+                    deleteVertexArray(i->second);
+                    i = vertexArrays.erase(i);
+                }
+                else
+                    ++i;
+            }
+
             GLuint& elementArrayBufferId = stateCache.bufferId[GL_ELEMENT_ARRAY_BUFFER];
             if (elementArrayBufferId == bufferId) elementArrayBufferId = 0;
             GLuint& arrayBufferId = stateCache.bufferId[GL_ARRAY_BUFFER];
@@ -522,6 +586,12 @@ namespace ouzel::graphics::opengl
             glDeleteBuffersProc(1, &bufferId);
         }
 
+        void deleteVertexArray(GLuint deletedVertexArrayId)
+        {
+            if (stateCache.vertexArrayId == deletedVertexArrayId) stateCache.vertexArrayId = 0;
+            glDeleteVertexArraysProc(1, &deletedVertexArrayId);
+        }
+
         void deleteRenderBuffer(GLuint renderBufferId)
         {
             glDeleteRenderbuffersProc(1, &renderBufferId);
@@ -577,6 +647,16 @@ namespace ouzel::graphics::opengl
         virtual void present();
         void generateScreenshot(const std::string& filename) override;
         void setUniform(GLint location, DataType dataType, const void* data);
+        void setUniform(const Shader::Location& location, const float* data, std::size_t size);
+        void setVertexAttributes();
+        void drawInstanced(const DrawInstancedCommand& command);
+        GLuint getVertexArray(GLuint vertexBufferId, GLuint indexBufferId);
+
+#if !OUZEL_OPENGLES
+        void beginTimerQuery(std::uint64_t frameIndex);
+        void endTimerQuery();
+        void readTimerQueries();
+#endif
 
         bool embedded = false;
 
@@ -585,11 +665,29 @@ namespace ouzel::graphics::opengl
         GLsizei frameBufferHeight = 0;
         GLuint vertexArrayId = 0;
 
+        // vertex arrays keyed by the vertex and index buffer they bind
+        std::map<std::pair<GLuint, GLuint>, GLuint> vertexArrays;
+
         bool textureBaseLevelSupported:1;
         bool textureMaxLevelSupported:1;
 
         StateCache stateCache;
 
+#if !OUZEL_OPENGLES
+        // GL_TIME_ELAPSED queries of the executed command buffers, their results are read
+        // without stalling once the GPU has finished the command buffers
+        struct TimerQuery final
+        {
+            GLuint id = 0;
+            std::uint64_t frameIndex = 0; // 0 if the result has to be discarded
+        };
+
+        std::array<TimerQuery, 8> timerQueries;
+        std::size_t firstTimerQuery = 0; // oldest pending query
+        std::size_t timerQueryCount = 0;
+        bool timerQueryActive = false;
+#endif
+
         std::vector<std::unique_ptr<RenderResource>> resources;
     };
 }
@@ -86,6 +86,8 @@ namespace ouzel::graphics::opengl
                 case Vertex::Attribute::Usage::blendIndices: return "blendIndices0";
                 case Vertex::Attribute::Usage::blendWeight: return "blendWeight0";
                 case Vertex::Attribute::Usage::color: return "color0";
+                case Vertex::Attribute::Usage::instanceColor: return "instanceColor";
+                case Vertex::Attribute::Usage::instanceTransform: return "instanceTransform";
                 case Vertex::Attribute::Usage::normal: return "normal0";
                 case Vertex::Attribute::Usage::position: return "position0";
                 case Vertex::Attribute::Usage::positionTransformed: return "positionT0";
@@ -143,6 +145,12 @@ namespace ouzel::graphics::opengl
                 ++index;
             }
 
+        for (std::size_t i = 0; i < RenderDevice::instanceAttributes.size(); ++i)
+            if (vertexAttributes.find(RenderDevice::instanceAttributes[i].usage) != vertexAttributes.end())
+                renderDevice.glBindAttribLocationProc(programId,
+                                                      getInstanceAttributeLocation(i),
+                                                      usageToString(RenderDevice::instanceAttributes[i].usage));
+
         renderDevice.glLinkProgramProc(programId);
 
         renderDevice.glGetProgramivProc(programId, GL_LINK_STATUS, &status);
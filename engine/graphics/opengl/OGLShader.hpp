@@ -4,6 +4,7 @@
 #define OUZEL_GRAPHICS_OGLSHADER_HPP
 
 #include <utility>
+#include <vector>
 
 #include "../../core/Setup.h"
 
@@ -53,6 +54,7 @@ namespace ouzel::graphics::opengl
 
             GLint location;
             DataType dataType;
+            mutable std::vector<float> value; // last value uploaded to the location
         };
 
         auto& getVertexAttributes() const noexcept { return vertexAttributes; }
@@ -40,6 +40,7 @@ namespace ouzel::graphics::opengl
         };
         GLuint programId = 0;
         GLuint frameBufferId = 0;
+        GLuint vertexArrayId = 0;
 
         std::unordered_map<GLenum, GLuint> bufferId{
             {GL_ELEMENT_ARRAY_BUFFER, 0},
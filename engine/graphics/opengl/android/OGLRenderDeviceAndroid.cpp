@@ -184,9 +184,7 @@ namespace ouzel::graphics::opengl::android
     RenderDevice::~RenderDevice()
     {
         running = false;
-        CommandBuffer commandBuffer;
-        commandBuffer.pushCommand(std::make_unique<PresentCommand>());
-        submitCommandBuffer(std::move(commandBuffer));
+        wakeRenderThread();
 
         if (renderThread.isJoinable()) renderThread.join();
 
@@ -208,9 +206,7 @@ namespace ouzel::graphics::opengl::android
     void RenderDevice::reload()
     {
         running = false;
-        CommandBuffer commandBuffer;
-        commandBuffer.pushCommand(std::make_unique<PresentCommand>());
-        submitCommandBuffer(std::move(commandBuffer));
+        wakeRenderThread();
 
         if (renderThread.isJoinable()) renderThread.join();
 
@@ -311,6 +307,7 @@ namespace ouzel::graphics::opengl::android
         frameBufferHeight = surfaceHeight;
 
         stateCache = StateCache();
+        vertexArrays.clear(); // vertex arrays are lost with the context
 
         glDisableProc(GL_DITHER);
         glDepthFuncProc(GL_LEQUAL);
@@ -336,9 +333,7 @@ namespace ouzel::graphics::opengl::android
     void RenderDevice::destroy()
     {
         running = false;
-        CommandBuffer commandBuffer;
-        commandBuffer.pushCommand(std::make_unique<PresentCommand>());
-        submitCommandBuffer(std::move(commandBuffer));
+        wakeRenderThread();
 
         if (renderThread.isJoinable()) renderThread.join();
 
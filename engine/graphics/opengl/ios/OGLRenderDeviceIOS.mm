@@ -87,9 +87,7 @@ namespace ouzel::graphics::opengl::ios
     RenderDevice::~RenderDevice()
     {
         displayLink.stop();
-        CommandBuffer commandBuffer;
-        commandBuffer.pushCommand(std::make_unique<PresentCommand>());
-        submitCommandBuffer(std::move(commandBuffer));
+        wakeRenderThread();
 
         if (msaaColorRenderBufferId) glDeleteRenderbuffersProc(1, &msaaColorRenderBufferId);
         if (msaaFrameBufferId) glDeleteFramebuffersProc(1, &msaaFrameBufferId);
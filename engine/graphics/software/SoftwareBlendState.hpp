@@ -0,0 +1,60 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWAREBLENDSTATE_HPP
+#define OUZEL_GRAPHICS_SOFTWAREBLENDSTATE_HPP
+
+#include "SoftwareRenderResource.hpp"
+#include "../BlendFactor.hpp"
+#include "../BlendOperation.hpp"
+#include "../ColorMask.hpp"
+
+namespace ouzel::graphics::software
+{
+    class RenderDevice;
+
+    class BlendState final: public RenderResource
+    {
+    public:
+        BlendState(RenderDevice& initRenderDevice,
+                   bool initEnableBlending,
+                   BlendFactor initColorBlendSource,
+                   BlendFactor initColorBlendDest,
+                   BlendOperation initColorOperation,
+                   BlendFactor initAlphaBlendSource,
+                   BlendFactor initAlphaBlendDest,
+                   BlendOperation initAlphaOperation,
+                   ColorMask initColorMask):
+            RenderResource(initRenderDevice),
+            enableBlending(initEnableBlending),
+            colorBlendSource(initColorBlendSource),
+            colorBlendDest(initColorBlendDest),
+            colorOperation(initColorOperation),
+            alphaBlendSource(initAlphaBlendSource),
+            alphaBlendDest(initAlphaBlendDest),
+            alphaOperation(initAlphaOperation),
+            colorMask(initColorMask)
+        {
+        }
+
+        auto isBlendingEnabled() const noexcept { return enableBlending; }
+        auto getColorBlendSource() const noexcept { return colorBlendSource; }
+        auto getColorBlendDest() const noexcept { return colorBlendDest; }
+        auto getColorOperation() const noexcept { return colorOperation; }
+        auto getAlphaBlendSource() const noexcept { return alphaBlendSource; }
+        auto getAlphaBlendDest() const noexcept { return alphaBlendDest; }
+        auto getAlphaOperation() const noexcept { return alphaOperation; }
+        auto getColorMask() const noexcept { return colorMask; }
+
+    private:
+        bool enableBlending = false;
+        BlendFactor colorBlendSource = BlendFactor::one;
+        BlendFactor colorBlendDest = BlendFactor::zero;
+        BlendOperation colorOperation = BlendOperation::add;
+        BlendFactor alphaBlendSource = BlendFactor::one;
+        BlendFactor alphaBlendDest = BlendFactor::zero;
+        BlendOperation alphaOperation = BlendOperation::add;
+        ColorMask colorMask = ColorMask::all;
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWAREBLENDSTATE_HPP
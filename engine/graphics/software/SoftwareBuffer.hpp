@@ -0,0 +1,52 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWAREBUFFER_HPP
+#define OUZEL_GRAPHICS_SOFTWAREBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "SoftwareRenderResource.hpp"
+#include "../BufferType.hpp"
+#include "../Flags.hpp"
+
+namespace ouzel::graphics::software
+{
+    class RenderDevice;
+
+    class Buffer final: public RenderResource
+    {
+    public:
+        Buffer(RenderDevice& initRenderDevice,
+               BufferType initType,
+               Flags initFlags,
+               const std::vector<std::uint8_t>& initData,
+               std::uint32_t initSize):
+            RenderResource(initRenderDevice),
+            type(initType),
+            flags(initFlags),
+            data(initData.size() > initSize ? initData.size() : initSize)
+        {
+            if (!initData.empty()) std::memcpy(data.data(), initData.data(), initData.size());
+        }
+
+        void setData(const void* newData, std::size_t newSize)
+        {
+            if (newSize > data.size()) data.resize(newSize);
+            std::memcpy(data.data(), newData, newSize);
+        }
+
+        auto getType() const noexcept { return type; }
+        auto getFlags() const noexcept { return flags; }
+        auto getSize() const noexcept { return data.size(); }
+        auto getData() const noexcept { return data.data(); }
+
+    private:
+        BufferType type;
+        Flags flags = Flags::none;
+        std::vector<std::byte> data;
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWAREBUFFER_HPP
@@ -0,0 +1,84 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWAREDEPTHSTENCILSTATE_HPP
+#define OUZEL_GRAPHICS_SOFTWAREDEPTHSTENCILSTATE_HPP
+
+#include <cstdint>
+#include "SoftwareRenderResource.hpp"
+#include "../CompareFunction.hpp"
+#include "../StencilOperation.hpp"
+
+namespace ouzel::graphics::software
+{
+    class RenderDevice;
+
+    class DepthStencilState final: public RenderResource
+    {
+    public:
+        struct StencilFace final
+        {
+            StencilOperation failureOperation = StencilOperation::keep;
+            StencilOperation depthFailureOperation = StencilOperation::keep;
+            StencilOperation passOperation = StencilOperation::keep;
+            CompareFunction compareFunction = CompareFunction::always;
+        };
+
+        DepthStencilState(RenderDevice& initRenderDevice,
+                          bool initDepthTest,
+                          bool initDepthWrite,
+                          CompareFunction initCompareFunction,
+                          bool initStencilEnabled,
+                          std::uint32_t initStencilReadMask,
+                          std::uint32_t initStencilWriteMask,
+                          StencilOperation initFrontFaceStencilFailureOperation,
+                          StencilOperation initFrontFaceStencilDepthFailureOperation,
+                          StencilOperation initFrontFaceStencilPassOperation,
+                          CompareFunction initFrontFaceStencilCompareFunction,
+                          StencilOperation initBackFaceStencilFailureOperation,
+                          StencilOperation initBackFaceStencilDepthFailureOperation,
+                          StencilOperation initBackFaceStencilPassOperation,
+                          CompareFunction initBackFaceStencilCompareFunction):
+            RenderResource(initRenderDevice),
+            depthTest(initDepthTest),
+            depthWrite(initDepthWrite),
+            compareFunction(initCompareFunction),
+            stencilEnabled(initStencilEnabled),
+            stencilReadMask(static_cast<std::uint8_t>(initStencilReadMask)),
+            stencilWriteMask(static_cast<std::uint8_t>(initStencilWriteMask)),
+            frontFace{
+                initFrontFaceStencilFailureOperation,
+                initFrontFaceStencilDepthFailureOperation,
+                initFrontFaceStencilPassOperation,
+                initFrontFaceStencilCompareFunction
+            },
+            backFace{
+                initBackFaceStencilFailureOperation,
+                initBackFaceStencilDepthFailureOperation,
+                initBackFaceStencilPassOperation,
+                initBackFaceStencilCompareFunction
+            }
+        {
+        }
+
+        auto getDepthTest() const noexcept { return depthTest; }
+        auto getDepthWrite() const noexcept { return depthWrite; }
+        auto getCompareFunction() const noexcept { return compareFunction; }
+        auto isStencilEnabled() const noexcept { return stencilEnabled; }
+        auto getStencilReadMask() const noexcept { return stencilReadMask; }
+        auto getStencilWriteMask() const noexcept { return stencilWriteMask; }
+        auto& getFrontFace() const noexcept { return frontFace; }
+        auto& getBackFace() const noexcept { return backFace; }
+
+    private:
+        bool depthTest = false;
+        bool depthWrite = false;
+        CompareFunction compareFunction = CompareFunction::less;
+        bool stencilEnabled = false;
+        std::uint8_t stencilReadMask = 0xFF;
+        std::uint8_t stencilWriteMask = 0xFF;
+        StencilFace frontFace;
+        StencilFace backFace;
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWAREDEPTHSTENCILSTATE_HPP
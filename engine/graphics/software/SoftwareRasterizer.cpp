@@ -0,0 +1,480 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "SoftwareRasterizer.hpp"
+#include "SoftwareBlendState.hpp"
+#include "SoftwareDepthStencilState.hpp"
+#include "SoftwareTexture.hpp"
+
+namespace ouzel::graphics::software
+{
+    namespace
+    {
+        template <class T>
+        constexpr bool compare(CompareFunction compareFunction, T value, T reference) noexcept
+        {
+            switch (compareFunction)
+            {
+                case CompareFunction::never: return false;
+                case CompareFunction::less: return value < reference;
+                case CompareFunction::equal: return value == reference;
+                case CompareFunction::lessEqual: return value <= reference;
+                case CompareFunction::greater: return value > reference;
+                case CompareFunction::notEqual: return value != reference;
+                case CompareFunction::greaterEqual: return value >= reference;
+                case CompareFunction::always:
+                default: return true;
+            }
+        }
+
+        constexpr std::uint8_t applyStencilOperation(StencilOperation stencilOperation,
+                                                     std::uint8_t value,
+                                                     std::uint8_t reference,
+                                                     std::uint8_t writeMask) noexcept
+        {
+            std::uint8_t result = value;
+
+            switch (stencilOperation)
+            {
+                case StencilOperation::keep: return value;
+                case StencilOperation::zero: result = 0; break;
+                case StencilOperation::replace: result = reference; break;
+                case StencilOperation::incrementClamp: result = (value == 0xFF) ? value : static_cast<std::uint8_t>(value + 1); break;
+                case StencilOperation::decrementClamp: result = (value == 0) ? value : static_cast<std::uint8_t>(value - 1); break;
+                case StencilOperation::invert: result = static_cast<std::uint8_t>(~value); break;
+                case StencilOperation::incrementWrap: result = static_cast<std::uint8_t>(value + 1); break;
+                case StencilOperation::decrementWrap: result = static_cast<std::uint8_t>(value - 1); break;
+                default: return value;
+            }
+
+            return static_cast<std::uint8_t>((value & ~writeMask) | (result & writeMask));
+        }
+
+        constexpr float getBlendFactor(BlendFactor blendFactor,
+                                       const float (&source)[4],
+                                       const float (&destination)[4],
+                                       std::size_t channel) noexcept
+        {
+            switch (blendFactor)
+            {
+                case BlendFactor::zero: return 0.0F;
+                case BlendFactor::one: return 1.0F;
+                case BlendFactor::srcColor: return source[channel];
+                case BlendFactor::invSrcColor: return 1.0F - source[channel];
+                case BlendFactor::srcAlpha: return source[3];
+                case BlendFactor::invSrcAlpha: return 1.0F - source[3];
+                case BlendFactor::destAlpha: return destination[3];
+                case BlendFactor::invDestAlpha: return 1.0F - destination[3];
+                case BlendFactor::destColor: return destination[channel];
+                case BlendFactor::invDestColor: return 1.0F - destination[channel];
+                case BlendFactor::srcAlphaSat: return (channel == 3) ? 1.0F : std::min(source[3], 1.0F - destination[3]);
+                // the blend factor is not settable, so it is always white like in Direct3D 11
+                case BlendFactor::blendFactor: return 1.0F;
+                case BlendFactor::invBlendFactor: return 0.0F;
+                default: return 0.0F;
+            }
+        }
+
+        constexpr float applyBlendOperation(BlendOperation blendOperation,
+                                            float source, float sourceFactor,
+                                            float destination, float destinationFactor) noexcept
+        {
+            switch (blendOperation)
+            {
+                case BlendOperation::add: return source * sourceFactor + destination * destinationFactor;
+                case BlendOperation::subtract: return source * sourceFactor - destination * destinationFactor;
+                case BlendOperation::reverseSubtract: return destination * destinationFactor - source * sourceFactor;
+                case BlendOperation::min: return std::min(source, destination);
+                case BlendOperation::max: return std::max(source, destination);
+                default: return source;
+            }
+        }
+
+        // a pixel center that lies exactly on an edge belongs to only one of the triangles sharing the edge
+        constexpr bool isInclusiveEdge(std::int64_t stepX, std::int64_t stepY) noexcept
+        {
+            return stepX > 0 || (stepX == 0 && stepY > 0);
+        }
+    }
+
+    Rasterizer::Rasterizer(std::size_t threadCount)
+    {
+        // the calling thread rasterizes tiles as well
+        for (std::size_t i = 1; i < threadCount; ++i)
+            workers.emplace_back(&Rasterizer::workerMain, this);
+    }
+
+    Rasterizer::~Rasterizer()
+    {
+        std::unique_lock lock(workMutex);
+        running = false;
+        lock.unlock();
+        workCondition.notify_all();
+
+        workers.clear();
+    }
+
+    void Rasterizer::setTarget(const RasterTarget& newTarget)
+    {
+        flush();
+
+        target = newTarget;
+        tilesX = (target.width + tileSize - 1) / tileSize;
+        tilesY = (target.height + tileSize - 1) / tileSize;
+        bins.resize(tilesX * tilesY);
+    }
+
+    void Rasterizer::setState(const RasterState& newState)
+    {
+        currentState = newState;
+        stateChanged = true;
+    }
+
+    void Rasterizer::clear(bool clearColor, Color color,
+                           bool clearDepth, float depth,
+                           bool clearStencil, std::uint8_t stencil)
+    {
+        flush();
+
+        const auto pixelCount = static_cast<std::size_t>(target.width) * target.height;
+
+        if (clearColor && target.colors)
+            for (std::size_t i = 0; i < pixelCount; ++i)
+                std::copy(color.v.begin(), color.v.end(), target.colors + i * 4);
+
+        if (clearDepth && target.depths)
+            std::fill(target.depths, target.depths + pixelCount, depth);
+
+        if (clearStencil && target.stencils)
+            std::fill(target.stencils, target.stencils + pixelCount, stencil);
+    }
+
+    void Rasterizer::drawTriangle(const RasterVertex& v0,
+                                  const RasterVertex& v1,
+                                  const RasterVertex& v2,
+                                  bool frontFacing)
+    {
+        constexpr float maxCoordinate = 1048576.0F;
+        constexpr float subpixelScale = static_cast<float>(1 << subpixelBits);
+
+        Triangle triangle{};
+        triangle.vertices[0] = v0;
+        triangle.vertices[1] = v1;
+        triangle.vertices[2] = v2;
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            triangle.x[i] = static_cast<std::int64_t>(std::lround(std::clamp(triangle.vertices[i].x, -maxCoordinate, maxCoordinate) * subpixelScale));
+            triangle.y[i] = static_cast<std::int64_t>(std::lround(std::clamp(triangle.vertices[i].y, -maxCoordinate, maxCoordinate) * subpixelScale));
+        }
+
+        auto area = (triangle.x[2] - triangle.x[1]) * (triangle.y[0] - triangle.y[1]) -
+            (triangle.y[2] - triangle.y[1]) * (triangle.x[0] - triangle.x[1]);
+
+        if (area == 0) return;
+
+        // make the edge functions positive inside of the triangle
+        if (area < 0)
+        {
+            std::swap(triangle.vertices[1], triangle.vertices[2]);
+            std::swap(triangle.x[1], triangle.x[2]);
+            std::swap(triangle.y[1], triangle.y[2]);
+            area = -area;
+        }
+
+        const auto minX = std::min({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const auto minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+        const auto maxX = std::max({triangle.x[0], triangle.x[1], triangle.x[2]});
+        const auto maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+
+        // pixels whose centers can be inside of the bounding box
+        constexpr std::int64_t half = 1 << (subpixelBits - 1);
+        triangle.minX = std::max(currentState.clipLeft, static_cast<std::int32_t>((minX - half + (1 << subpixelBits) - 1) >> subpixelBits));
+        triangle.minY = std::max(currentState.clipTop, static_cast<std::int32_t>((minY - half + (1 << subpixelBits) - 1) >> subpixelBits));
+        triangle.maxX = std::min(currentState.clipRight, static_cast<std::int32_t>(((maxX - half) >> subpixelBits) + 1));
+        triangle.maxY = std::min(currentState.clipBottom, static_cast<std::int32_t>(((maxY - half) >> subpixelBits) + 1));
+
+        if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY) return;
+
+        if (stateChanged)
+        {
+            states.push_back(currentState);
+            stateChanged = false;
+        }
+
+        triangle.state = static_cast<std::uint32_t>(states.size() - 1);
+        triangle.frontFacing = frontFacing;
+        triangle.inverseArea = 1.0F / static_cast<float>(area);
+
+        const auto index = static_cast<std::uint32_t>(triangles.size());
+        triangles.push_back(triangle);
+
+        const auto firstTileX = static_cast<std::size_t>(triangle.minX / tileSize);
+        const auto firstTileY = static_cast<std::size_t>(triangle.minY / tileSize);
+        const auto lastTileX = static_cast<std::size_t>((triangle.maxX - 1) / tileSize);
+        const auto lastTileY = static_cast<std::size_t>((triangle.maxY - 1) / tileSize);
+
+        for (auto tileY = firstTileY; tileY <= lastTileY; ++tileY)
+            for (auto tileX = firstTileX; tileX <= lastTileX; ++tileX)
+                bins[tileY * tilesX + tileX].push_back(index);
+    }
+
+    void Rasterizer::flush()
+    {
+        if (triangles.empty()) return;
+
+        nextTile = 0;
+
+        if (!workers.empty())
+        {
+            std::unique_lock lock(workMutex);
+            ++workGeneration;
+            busyWorkers = workers.size();
+            lock.unlock();
+            workCondition.notify_all();
+        }
+
+        rasterizeTiles();
+
+        if (!workers.empty())
+        {
+            std::unique_lock lock(workMutex);
+            while (busyWorkers) doneCondition.wait(lock);
+        }
+
+        for (auto& bin : bins) bin.clear();
+        triangles.clear();
+        states.clear();
+        stateChanged = true;
+    }
+
+    void Rasterizer::rasterizeTiles() noexcept
+    {
+        for (;;)
+        {
+            const auto tile = nextTile.fetch_add(1, std::memory_order_relaxed);
+            if (tile >= bins.size()) break;
+            rasterizeTile(tile);
+        }
+    }
+
+    void Rasterizer::rasterizeTile(std::size_t tile) noexcept
+    {
+        const auto& bin = bins[tile];
+        if (bin.empty()) return;
+
+        const auto tileLeft = static_cast<std::int32_t>(tile % tilesX) * tileSize;
+        const auto tileTop = static_cast<std::int32_t>(tile / tilesX) * tileSize;
+        const auto tileRight = std::min(tileLeft + tileSize, static_cast<std::int32_t>(target.width));
+        const auto tileBottom = std::min(tileTop + tileSize, static_cast<std::int32_t>(target.height));
+
+        for (const auto index : bin)
+            rasterizeTriangle(triangles[index], tileLeft, tileTop, tileRight, tileBottom);
+    }
+
+    void Rasterizer::rasterizeTriangle(const Triangle& triangle,
+                                       std::int32_t tileLeft, std::int32_t tileTop,
+                                       std::int32_t tileRight, std::int32_t tileBottom) noexcept
+    {
+        const auto left = std::max(tileLeft, triangle.minX);
+        const auto top = std::max(tileTop, triangle.minY);
+        const auto right = std::min(tileRight, triangle.maxX);
+        const auto bottom = std::min(tileBottom, triangle.maxY);
+
+        if (left >= right || top >= bottom) return;
+
+        const RasterState& state = states[triangle.state];
+        const BlendState* blendState = state.blendState;
+        const DepthStencilState* depthStencilState = state.depthStencilState;
+        const bool blending = blendState && blendState->isBlendingEnabled();
+        const auto colorMask = blendState ? blendState->getColorMask() : ColorMask::all;
+        const bool writeChannels[4] = {
+            (colorMask & ColorMask::red) != ColorMask::none,
+            (colorMask & ColorMask::green) != ColorMask::none,
+            (colorMask & ColorMask::blue) != ColorMask::none,
+            (colorMask & ColorMask::alpha) != ColorMask::none
+        };
+
+        const bool depthTest = depthStencilState && depthStencilState->getDepthTest() && target.depths;
+        const bool depthWrite = depthStencilState && depthStencilState->getDepthWrite() && target.depths;
+        const bool stencilTest = depthStencilState && depthStencilState->isStencilEnabled() && target.stencils;
+        const auto* stencilFace = depthStencilState ?
+            (triangle.frontFacing ? &depthStencilState->getFrontFace() : &depthStencilState->getBackFace()) : nullptr;
+
+        const auto& v0 = triangle.vertices[0];
+        const auto& v1 = triangle.vertices[1];
+        const auto& v2 = triangle.vertices[2];
+
+        // edge i is opposite of vertex i, so its function is the barycentric weight of the vertex
+        const std::int64_t edgeStartX[3] = {triangle.x[1], triangle.x[2], triangle.x[0]};
+        const std::int64_t edgeStartY[3] = {triangle.y[1], triangle.y[2], triangle.y[0]};
+        const std::int64_t edgeEndX[3] = {triangle.x[2], triangle.x[0], triangle.x[1]};
+        const std::int64_t edgeEndY[3] = {triangle.y[2], triangle.y[0], triangle.y[1]};
+
+        constexpr std::int64_t pixelSize = 1 << subpixelBits;
+        constexpr std::int64_t half = pixelSize / 2;
+
+        std::int64_t stepX[3];
+        std::int64_t stepY[3];
+        std::int64_t rowWeights[3];
+        bool inclusive[3];
+
+        const auto startX = static_cast<std::int64_t>(left) * pixelSize + half;
+        const auto startY = static_cast<std::int64_t>(top) * pixelSize + half;
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            stepX[i] = edgeStartY[i] - edgeEndY[i];
+            stepY[i] = edgeEndX[i] - edgeStartX[i];
+            inclusive[i] = isInclusiveEdge(stepX[i], stepY[i]);
+            rowWeights[i] = (edgeEndX[i] - edgeStartX[i]) * (startY - edgeStartY[i]) -
+                (edgeEndY[i] - edgeStartY[i]) * (startX - edgeStartX[i]);
+        }
+
+        for (auto y = top; y < bottom; ++y)
+        {
+            std::int64_t weights[3] = {rowWeights[0], rowWeights[1], rowWeights[2]};
+
+            for (auto x = left; x < right; ++x)
+            {
+                const bool inside =
+                    (weights[0] > 0 || (weights[0] == 0 && inclusive[0])) &&
+                    (weights[1] > 0 || (weights[1] == 0 && inclusive[1])) &&
+                    (weights[2] > 0 || (weights[2] == 0 && inclusive[2]));
+
+                if (inside)
+                {
+                    const auto pixel = static_cast<std::size_t>(y) * target.width + static_cast<std::size_t>(x);
+
+                    const auto l0 = static_cast<float>(weights[0]) * triangle.inverseArea;
+                    const auto l1 = static_cast<float>(weights[1]) * triangle.inverseArea;
+                    const auto l2 = 1.0F - l0 - l1;
+
+                    const auto z = l0 * v0.z + l1 * v1.z + l2 * v2.z;
+
+                    bool passed = true;
+                    std::uint8_t stencilValue = 0;
+
+                    if (stencilTest)
+                    {
+                        const auto readMask = depthStencilState->getStencilReadMask();
+                        const auto writeMask = depthStencilState->getStencilWriteMask();
+                        stencilValue = target.stencils[pixel];
+
+                        if (!compare<std::uint8_t>(stencilFace->compareFunction,
+                                                   state.stencilReferenceValue & readMask,
+                                                   stencilValue & readMask))
+                        {
+                            target.stencils[pixel] = applyStencilOperation(stencilFace->failureOperation, stencilValue,
+                                                                           state.stencilReferenceValue, writeMask);
+                            passed = false;
+                        }
+                    }
+
+                    if (passed && depthTest &&
+                        !compare(depthStencilState->getCompareFunction(), z, target.depths[pixel]))
+                    {
+                        if (stencilTest)
+                            target.stencils[pixel] = applyStencilOperation(stencilFace->depthFailureOperation, stencilValue,
+                                                                           state.stencilReferenceValue,
+                                                                           depthStencilState->getStencilWriteMask());
+                        passed = false;
+                    }
+
+                    if (passed)
+                    {
+                        if (stencilTest)
+                            target.stencils[pixel] = applyStencilOperation(stencilFace->passOperation, stencilValue,
+                                                                           state.stencilReferenceValue,
+                                                                           depthStencilState->getStencilWriteMask());
+
+                        if (depthWrite) target.depths[pixel] = z;
+                    }
+
+                    if (passed && target.colors)
+                    {
+
+                        const auto w = 1.0F / (l0 * v0.inverseW + l1 * v1.inverseW + l2 * v2.inverseW);
+
+                        float source[4];
+                        for (std::size_t channel = 0; channel < 4; ++channel)
+                            source[channel] = (l0 * v0.color[channel] + l1 * v1.color[channel] + l2 * v2.color[channel]) * w;
+
+                        if (state.texture)
+                        {
+                            float texel[4];
+                            state.texture->sample((l0 * v0.texCoords[0] + l1 * v1.texCoords[0] + l2 * v2.texCoords[0]) * w,
+                                                  (l0 * v0.texCoords[1] + l1 * v1.texCoords[1] + l2 * v2.texCoords[1]) * w,
+                                                  texel);
+
+                            for (std::size_t channel = 0; channel < 4; ++channel)
+                                source[channel] *= texel[channel];
+                        }
+
+                        std::uint8_t* destinationColor = target.colors + pixel * 4;
+
+                        if (blending)
+                        {
+                            float destination[4];
+                            for (std::size_t channel = 0; channel < 4; ++channel)
+                                destination[channel] = static_cast<float>(destinationColor[channel]) / 255.0F;
+
+                            float result[4];
+                            for (std::size_t channel = 0; channel < 3; ++channel)
+                                result[channel] = applyBlendOperation(blendState->getColorOperation(),
+                                                                      source[channel],
+                                                                      getBlendFactor(blendState->getColorBlendSource(), source, destination, channel),
+                                                                      destination[channel],
+                                                                      getBlendFactor(blendState->getColorBlendDest(), source, destination, channel));
+
+                            result[3] = applyBlendOperation(blendState->getAlphaOperation(),
+                                                            source[3],
+                                                            getBlendFactor(blendState->getAlphaBlendSource(), source, destination, 3),
+                                                            destination[3],
+                                                            getBlendFactor(blendState->getAlphaBlendDest(), source, destination, 3));
+
+                            std::copy(std::begin(result), std::end(result), std::begin(source));
+                        }
+
+                        for (std::size_t channel = 0; channel < 4; ++channel)
+                            if (writeChannels[channel])
+                                destinationColor[channel] = static_cast<std::uint8_t>(std::clamp(source[channel], 0.0F, 1.0F) * 255.0F + 0.5F);
+                    }
+                }
+
+                for (std::size_t i = 0; i < 3; ++i)
+                    weights[i] += stepX[i] * pixelSize;
+            }
+
+            for (std::size_t i = 0; i < 3; ++i)
+                rowWeights[i] += stepY[i] * pixelSize;
+        }
+    }
+
+    void Rasterizer::workerMain()
+    {
+        thread::setCurrentThreadName("Rasterizer");
+
+        std::uint64_t finishedGeneration = 0;
+
+        for (;;)
+        {
+            std::unique_lock lock(workMutex);
+            while (running && workGeneration == finishedGeneration) workCondition.wait(lock);
+            if (!running) return;
+            finishedGeneration = workGeneration;
+            lock.unlock();
+
+            rasterizeTiles();
+
+            lock.lock();
+            if (--busyWorkers == 0)
+            {
+                lock.unlock();
+                doneCondition.notify_all();
+            }
+        }
+    }
+}
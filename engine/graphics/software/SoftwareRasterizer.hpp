@@ -0,0 +1,137 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWARERASTERIZER_HPP
+#define OUZEL_GRAPHICS_SOFTWARERASTERIZER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "../../math/Color.hpp"
+#include "../../thread/Thread.hpp"
+
+namespace ouzel::graphics::software
+{
+    class BlendState;
+    class DepthStencilState;
+    class Texture;
+
+    // screen space vertex, the color and texture coordinates are multiplied by inverseW,
+    // so that they can be interpolated linearly in screen space
+    struct RasterVertex final
+    {
+        float x = 0.0F;
+        float y = 0.0F;
+        float z = 0.0F;
+        float inverseW = 1.0F;
+        float color[4]{};
+        float texCoords[2]{};
+    };
+
+    struct RasterState final
+    {
+        const BlendState* blendState = nullptr;
+        const DepthStencilState* depthStencilState = nullptr;
+        std::uint8_t stencilReferenceValue = 0;
+        const Texture* texture = nullptr;
+
+        // viewport, scissor rectangle and target bounds combined, right and bottom are exclusive
+        std::int32_t clipLeft = 0;
+        std::int32_t clipTop = 0;
+        std::int32_t clipRight = 0;
+        std::int32_t clipBottom = 0;
+    };
+
+    struct RasterTarget final
+    {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::uint8_t* colors = nullptr; // RGBA8, the first row is the top one
+        float* depths = nullptr;
+        std::uint8_t* stencils = nullptr;
+    };
+
+    // bins triangles into screen tiles and rasterizes the tiles in parallel when flushed,
+    // triangles are rasterized in submission order inside each tile, so the result does not depend
+    // on the number of threads
+    class Rasterizer final
+    {
+    public:
+        explicit Rasterizer(std::size_t threadCount);
+        ~Rasterizer();
+
+        Rasterizer(const Rasterizer&) = delete;
+        Rasterizer& operator=(const Rasterizer&) = delete;
+
+        Rasterizer(Rasterizer&&) = delete;
+        Rasterizer& operator=(Rasterizer&&) = delete;
+
+        auto& getTarget() const noexcept { return target; }
+        void setTarget(const RasterTarget& newTarget);
+
+        // applies to the triangles drawn after it
+        void setState(const RasterState& newState);
+
+        void clear(bool clearColor, Color color,
+                   bool clearDepth, float depth,
+                   bool clearStencil, std::uint8_t stencil);
+
+        void drawTriangle(const RasterVertex& v0,
+                          const RasterVertex& v1,
+                          const RasterVertex& v2,
+                          bool frontFacing);
+
+        // rasterizes all of the binned triangles and waits for the workers to finish
+        void flush();
+
+    private:
+        static constexpr std::int32_t tileSize = 64;
+        static constexpr std::int32_t subpixelBits = 4;
+
+        struct Triangle final
+        {
+            RasterVertex vertices[3];
+            // vertex positions snapped to the subpixel grid, so that the edge functions are exact
+            // and the pixels on an edge shared by two triangles are drawn only once
+            std::int64_t x[3];
+            std::int64_t y[3];
+            std::uint32_t state;
+            bool frontFacing;
+            float inverseArea;
+            std::int32_t minX;
+            std::int32_t minY;
+            std::int32_t maxX; // exclusive
+            std::int32_t maxY; // exclusive
+        };
+
+        void rasterizeTiles() noexcept;
+        void rasterizeTile(std::size_t tile) noexcept;
+        void rasterizeTriangle(const Triangle& triangle,
+                               std::int32_t tileLeft, std::int32_t tileTop,
+                               std::int32_t tileRight, std::int32_t tileBottom) noexcept;
+        void workerMain();
+
+        RasterTarget target;
+        std::size_t tilesX = 0;
+        std::size_t tilesY = 0;
+
+        std::vector<RasterState> states;
+        bool stateChanged = true;
+        RasterState currentState;
+        std::vector<Triangle> triangles;
+        std::vector<std::vector<std::uint32_t>> bins;
+
+        std::vector<thread::Thread> workers;
+        std::mutex workMutex;
+        std::condition_variable workCondition;
+        std::condition_variable doneCondition;
+        std::uint64_t workGeneration = 0;
+        std::size_t busyWorkers = 0;
+        bool running = true;
+        std::atomic<std::size_t> nextTile{0};
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWARERASTERIZER_HPP
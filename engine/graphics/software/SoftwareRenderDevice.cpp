@@ -0,0 +1,778 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include "SoftwareRenderDevice.hpp"
+#include "SoftwareBlendState.hpp"
+#include "SoftwareBuffer.hpp"
+#include "SoftwareDepthStencilState.hpp"
+#include "SoftwareRenderTarget.hpp"
+#include "SoftwareShader.hpp"
+#include "SoftwareTexture.hpp"
+#include "../../core/Window.hpp"
+#include "../../utils/Log.hpp"
+#include "stb_image_write.h"
+
+namespace ouzel::graphics::software
+{
+    namespace
+    {
+        std::size_t getRasterizerThreadCount() noexcept
+        {
+            const auto hardwareThreads = std::thread::hardware_concurrency();
+            return hardwareThreads ? hardwareThreads : 1;
+        }
+
+        // the clip planes, the rasterizer clips x and y to the render target
+        constexpr float minW = 1e-5F;
+
+        float getNearDistance(const Vector<float, 4>& position) noexcept { return position.v[2]; }
+        float getFarDistance(const Vector<float, 4>& position) noexcept { return position.v[3] - position.v[2]; }
+        float getWDistance(const Vector<float, 4>& position) noexcept { return position.v[3] - minW; }
+
+        constexpr float (*clipPlanes[])(const Vector<float, 4>&) noexcept = {
+            getNearDistance,
+            getFarDistance,
+            getWDistance
+        };
+
+        template <class T>
+        T interpolate(const T& a, const T& b, float t) noexcept
+        {
+            T result;
+            for (std::size_t i = 0; i < 4; ++i)
+                result.position.v[i] = a.position.v[i] + (b.position.v[i] - a.position.v[i]) * t;
+            for (std::size_t i = 0; i < 4; ++i)
+                result.color[i] = a.color[i] + (b.color[i] - a.color[i]) * t;
+            for (std::size_t i = 0; i < 2; ++i)
+                result.texCoords[i] = a.texCoords[i] + (b.texCoords[i] - a.texCoords[i]) * t;
+            return result;
+        }
+
+        RasterVertex offset(const RasterVertex& vertex, float x, float y) noexcept
+        {
+            RasterVertex result = vertex;
+            result.x += x;
+            result.y += y;
+            return result;
+        }
+    }
+
+    RenderDevice::RenderDevice(const Settings& settings,
+                               core::Window& initWindow,
+                               const std::function<void(const Event&)>& initCallback):
+        graphics::RenderDevice(Driver::software, settings, initWindow, initCallback),
+        rasterizer(getRasterizerThreadCount())
+    {
+        npotTexturesSupported = true;
+        renderTargetsSupported = true;
+        clampToBorderSupported = true;
+        uintIndicesSupported = true;
+
+        const auto& resolution = window.getResolution();
+        resizeFrameBuffer(resolution.v[0], resolution.v[1]);
+        viewport = Rect<float>{static_cast<float>(frameBufferWidth), static_cast<float>(frameBufferHeight)};
+
+        running = true;
+        renderThread = thread::Thread(&RenderDevice::renderMain, this);
+    }
+
+    RenderDevice::~RenderDevice()
+    {
+        running = false;
+        wakeRenderThread();
+
+        if (renderThread.isJoinable()) renderThread.join();
+    }
+
+    void RenderDevice::process()
+    {
+        graphics::RenderDevice::process();
+        executeAll();
+
+        for (;;)
+        {
+            const CommandBuffer& commandBuffer = getNextCommandBuffer();
+
+            bool presented = false;
+
+            for (const auto& command : commandBuffer)
+            {
+                switch (command.type)
+                {
+                    case Command::Type::resize:
+                    {
+                        auto resizeCommand = static_cast<const ResizeCommand*>(&command);
+                        resizeFrameBuffer(resizeCommand->size.v[0], resizeCommand->size.v[1]);
+                        break;
+                    }
+
+                    case Command::Type::present:
+                    {
+                        drawCallCount = frameDrawCallCount;
+                        frameDrawCallCount = 0;
+
+                        rasterizer.flush();
+                        std::swap(backBuffer, frontBuffer);
+                        if (!currentRenderTarget) bindRenderTarget();
+                        break;
+                    }
+
+                    case Command::Type::deleteResource:
+                    {
+                        auto deleteResourceCommand = static_cast<const DeleteResourceCommand*>(&command);
+
+                        // the binned triangles may still reference the resource
+                        rasterizer.flush();
+
+                        const auto resource = resources[deleteResourceCommand->resource - 1].get();
+                        if (resource == currentRenderTarget)
+                        {
+                            currentRenderTarget = nullptr;
+                            bindRenderTarget();
+                        }
+                        if (resource == currentShader) currentShader = nullptr;
+                        if (resource == currentBlendState) currentBlendState = nullptr;
+                        if (resource == currentDepthStencilState) currentDepthStencilState = nullptr;
+                        std::replace(textures.begin(), textures.end(), static_cast<Texture*>(resource), static_cast<Texture*>(nullptr));
+                        rasterStateDirty = true;
+
+                        resources[deleteResourceCommand->resource - 1].reset();
+                        break;
+                    }
+
+                    case Command::Type::initRenderTarget:
+                    {
+                        auto initRenderTargetCommand = static_cast<const InitRenderTargetCommand*>(&command);
+
+                        std::set<Texture*> colorTextures;
+                        for (const auto colorTextureId : initRenderTargetCommand->colorTextures)
+                            colorTextures.insert(getResource<Texture>(colorTextureId));
+
+                        auto renderTarget = std::make_unique<RenderTarget>(*this,
+                                                                           colorTextures,
+                                                                           getResource<Texture>(initRenderTargetCommand->depthTexture));
+
+                        if (initRenderTargetCommand->renderTarget > resources.size())
+                            resources.resize(initRenderTargetCommand->renderTarget);
+                        resources[initRenderTargetCommand->renderTarget - 1] = std::move(renderTarget);
+                        break;
+                    }
+
+                    case Command::Type::setRenderTarget:
+                    {
+                        auto setRenderTargetCommand = static_cast<const SetRenderTargetCommand*>(&command);
+
+                        currentRenderTarget = getResource<RenderTarget>(setRenderTargetCommand->renderTarget);
+                        bindRenderTarget();
+                        break;
+                    }
+
+                    case Command::Type::clearRenderTarget:
+                    {
+                        auto clearCommand = static_cast<const ClearRenderTargetCommand*>(&command);
+
+                        rasterizer.clear(clearCommand->clearColorBuffer, clearCommand->clearColor,
+                                         clearCommand->clearDepthBuffer, clearCommand->clearDepth,
+                                         clearCommand->clearStencilBuffer, static_cast<std::uint8_t>(clearCommand->clearStencil));
+                        break;
+                    }
+
+                    case Command::Type::setScissorTest:
+                    {
+                        auto setScissorTestCommand = static_cast<const SetScissorTestCommand*>(&command);
+
+                        scissorTest = setScissorTestCommand->enabled;
+                        scissorRectangle = setScissorTestCommand->rectangle;
+                        rasterStateDirty = true;
+                        break;
+                    }
+
+                    case Command::Type::setViewport:
+                    {
+                        auto setViewportCommand = static_cast<const SetViewportCommand*>(&command);
+
+                        viewport = setViewportCommand->viewport;
+                        rasterStateDirty = true;
+                        break;
+                    }
+
+                    case Command::Type::initDepthStencilState:
+                    {
+                        auto initDepthStencilStateCommand = static_cast<const InitDepthStencilStateCommand*>(&command);
+                        auto depthStencilState = std::make_unique<DepthStencilState>(*this,
+                                                                                     initDepthStencilStateCommand->depthTest,
+                                                                                     initDepthStencilStateCommand->depthWrite,
+                                                                                     initDepthStencilStateCommand->compareFunction,
+                                                                                     initDepthStencilStateCommand->stencilEnabled,
+                                                                                     initDepthStencilStateCommand->stencilReadMask,
+                                                                                     initDepthStencilStateCommand->stencilWriteMask,
+                                                                                     initDepthStencilStateCommand->frontFaceStencilFailureOperation,
+                                                                                     initDepthStencilStateCommand->frontFaceStencilDepthFailureOperation,
+                                                                                     initDepthStencilStateCommand->frontFaceStencilPassOperation,
+                                                                                     initDepthStencilStateCommand->frontFaceStencilCompareFunction,
+                                                                                     initDepthStencilStateCommand->backFaceStencilFailureOperation,
+                                                                                     initDepthStencilStateCommand->backFaceStencilDepthFailureOperation,
+                                                                                     initDepthStencilStateCommand->backFaceStencilPassOperation,
+                                                                                     initDepthStencilStateCommand->backFaceStencilCompareFunction);
+
+                        if (initDepthStencilStateCommand->depthStencilState > resources.size())
+                            resources.resize(initDepthStencilStateCommand->depthStencilState);
+                        resources[initDepthStencilStateCommand->depthStencilState - 1] = std::move(depthStencilState);
+                        break;
+                    }
+
+                    case Command::Type::setDepthStencilState:
+                    {
+                        auto setDepthStencilStateCommand = static_cast<const SetDepthStencilStateCommand*>(&command);
+
+                        currentDepthStencilState = getResource<DepthStencilState>(setDepthStencilStateCommand->depthStencilState);
+                        stencilReferenceValue = static_cast<std::uint8_t>(setDepthStencilStateCommand->stencilReferenceValue);
+                        rasterStateDirty = true;
+                        break;
+                    }
+
+                    case Command::Type::setPipelineState:
+                    {
+                        auto setPipelineStateCommand = static_cast<const SetPipelineStateCommand*>(&command);
+
+                        currentBlendState = getResource<BlendState>(setPipelineStateCommand->blendState);
+                        currentShader = getResource<Shader>(setPipelineStateCommand->shader);
+                        cullMode = setPipelineStateCommand->cullMode;
+                        fillMode = setPipelineStateCommand->fillMode;
+                        rasterStateDirty = true;
+                        break;
+                    }
+
+                    case Command::Type::draw:
+                    {
+                        ++frameDrawCallCount;
+
+                        auto drawCommand = static_cast<const DrawCommand*>(&command);
+                        draw(*drawCommand);
+                        break;
+                    }
+
+                    case Command::Type::initBlendState:
+                    {
+                        auto initBlendStateCommand = static_cast<const InitBlendStateCommand*>(&command);
+
+                        auto blendState = std::make_unique<BlendState>(*this,
+                                                                       initBlendStateCommand->enableBlending,
+                                                                       initBlendStateCommand->colorBlendSource,
+                                                                       initBlendStateCommand->colorBlendDest,
+                                                                       initBlendStateCommand->colorOperation,
+                                                                       initBlendStateCommand->alphaBlendSource,
+                                                                       initBlendStateCommand->alphaBlendDest,
+                                                                       initBlendStateCommand->alphaOperation,
+                                                                       initBlendStateCommand->colorMask);
+
+                        if (initBlendStateCommand->blendState > resources.size())
+                            resources.resize(initBlendStateCommand->blendState);
+                        resources[initBlendStateCommand->blendState - 1] = std::move(blendState);
+                        break;
+                    }
+
+                    case Command::Type::initBuffer:
+                    {
+                        auto initBufferCommand = static_cast<const InitBufferCommand*>(&command);
+
+                        auto buffer = std::make_unique<Buffer>(*this,
+                                                               initBufferCommand->bufferType,
+                                                               initBufferCommand->flags,
+                                                               initBufferCommand->data,
+                                                               initBufferCommand->size);
+
+                        if (initBufferCommand->buffer > resources.size())
+                            resources.resize(initBufferCommand->buffer);
+                        resources[initBufferCommand->buffer - 1] = std::move(buffer);
+                        break;
+                    }
+
+                    case Command::Type::setBufferData:
+                    {
+                        auto setBufferDataCommand = static_cast<const SetBufferDataCommand*>(&command);
+
+                        // the vertices are transformed when drawn, so the binned triangles do not reference the buffer
+                        auto buffer = getResource<Buffer>(setBufferDataCommand->buffer);
+                        buffer->setData(setBufferDataCommand->data, setBufferDataCommand->size);
+                        break;
+                    }
+
+                    case Command::Type::initShader:
+                    {
+                        auto initShaderCommand = static_cast<const InitShaderCommand*>(&command);
+
+                        auto shader = std::make_unique<Shader>(*this,
+                                                               initShaderCommand->vertexAttributes,
+                                                               initShaderCommand->fragmentShaderConstantInfo,
+                                                               initShaderCommand->vertexShaderConstantInfo);
+
+                        if (initShaderCommand->shader > resources.size())
+                            resources.resize(initShaderCommand->shader);
+                        resources[initShaderCommand->shader - 1] = std::move(shader);
+                        break;
+                    }
+
+                    case Command::Type::setShaderConstants:
+                    {
+                        auto setShaderConstantsCommand = static_cast<const SetShaderConstantsCommand*>(&command);
+
+                        if (!currentShader)
+                            throw std::runtime_error("No shader set");
+
+                        for (std::uint32_t i = 0; i < setShaderConstantsCommand->fragmentShaderConstantCount; ++i)
+                        {
+                            const auto& fragmentShaderConstant = commandBuffer.getShaderConstant(setShaderConstantsCommand->firstShaderConstant + i);
+                            currentShader->setFragmentShaderConstant(i,
+                                                                     commandBuffer.getShaderConstantData(fragmentShaderConstant),
+                                                                     fragmentShaderConstant.size);
+                        }
+
+                        for (std::uint32_t i = 0; i < setShaderConstantsCommand->vertexShaderConstantCount; ++i)
+                        {
+                            const auto& vertexShaderConstant = commandBuffer.getShaderConstant(setShaderConstantsCommand->firstShaderConstant +
+                                                                                               setShaderConstantsCommand->fragmentShaderConstantCount + i);
+                            currentShader->setVertexShaderConstant(i,
+                                                                   commandBuffer.getShaderConstantData(vertexShaderConstant),
+                                                                   vertexShaderConstant.size);
+                        }
+
+                        break;
+                    }
+
+                    case Command::Type::initTexture:
+                    {
+                        auto initTextureCommand = static_cast<const InitTextureCommand*>(&command);
+
+                        auto texture = std::make_unique<Texture>(*this,
+                                                                 initTextureCommand->levels,
+                                                                 initTextureCommand->textureType,
+                                                                 initTextureCommand->flags,
+                                                                 initTextureCommand->sampleCount,
+                                                                 initTextureCommand->pixelFormat,
+                                                                 initTextureCommand->filter,
+                                                                 initTextureCommand->maxAnisotropy);
+
+                        if (initTextureCommand->texture > resources.size())
+                            resources.resize(initTextureCommand->texture);
+                        resources[initTextureCommand->texture - 1] = std::move(texture);
+                        break;
+                    }
+
+                    case Command::Type::setTextureData:
+                    {
+                        auto setTextureDataCommand = static_cast<const SetTextureDataCommand*>(&command);
+
+                        // the binned triangles may sample the old data
+                        rasterizer.flush();
+
+                        auto texture = getResource<Texture>(setTextureDataCommand->texture);
+                        texture->setData(setTextureDataCommand->levels);
+                        break;
+                    }
+
+                    case Command::Type::setTextureParameters:
+                    {
+                        auto setTextureParametersCommand = static_cast<const SetTextureParametersCommand*>(&command);
+
+                        rasterizer.flush();
+
+                        auto texture = getResource<Texture>(setTextureParametersCommand->texture);
+                        texture->setFilter(setTextureParametersCommand->filter);
+                        texture->setAddressX(setTextureParametersCommand->addressX);
+                        texture->setAddressY(setTextureParametersCommand->addressY);
+                        texture->setBorderColor(setTextureParametersCommand->borderColor);
+                        break;
+                    }
+
+                    case Command::Type::setTextures:
+                    {
+                        auto setTexturesCommand = static_cast<const SetTexturesCommand*>(&command);
+
+                        textures.clear();
+                        for (const auto texture : setTexturesCommand->textures)
+                            textures.push_back(getResource<Texture>(texture));
+
+                        rasterStateDirty = true;
+                        break;
+                    }
+
+                    default:
+                        throw std::runtime_error("Invalid command");
+                }
+
+                if (command.type == Command::Type::present)
+                {
+                    presented = true;
+                    break;
+                }
+            }
+
+            releaseCommandBuffer();
+            if (presented) return;
+        }
+    }
+
+    void RenderDevice::generateScreenshot(const std::string& filename)
+    {
+        if (frontBuffer.empty())
+            throw std::runtime_error("No frame was presented");
+
+        if (!stbi_write_png(filename.c_str(),
+                            static_cast<int>(frameBufferWidth),
+                            static_cast<int>(frameBufferHeight),
+                            4, frontBuffer.data(),
+                            static_cast<int>(frameBufferWidth * 4)))
+            throw std::runtime_error("Failed to save image to file");
+    }
+
+    void RenderDevice::renderMain()
+    {
+        thread::setCurrentThreadName("Render");
+
+        while (running)
+        {
+            try
+            {
+                process();
+            }
+            catch (const std::exception& e)
+            {
+                logger.log(Log::Level::error) << e.what();
+            }
+        }
+    }
+
+    void RenderDevice::resizeFrameBuffer(std::uint32_t newWidth, std::uint32_t newHeight)
+    {
+        rasterizer.flush();
+
+        frameBufferWidth = newWidth;
+        frameBufferHeight = newHeight;
+
+        const auto pixelCount = static_cast<std::size_t>(frameBufferWidth) * frameBufferHeight;
+        backBuffer.assign(pixelCount * 4, 0);
+        frontBuffer.clear();
+        depthBuffer.assign(depth ? pixelCount : 0, 1.0F);
+        stencilBuffer.assign(stencil ? pixelCount : 0, 0);
+
+        if (!currentRenderTarget) bindRenderTarget();
+    }
+
+    void RenderDevice::bindRenderTarget()
+    {
+        RasterTarget target;
+
+        if (currentRenderTarget)
+        {
+            if (Texture* colorTexture = currentRenderTarget->getColorTexture())
+            {
+                target.width = colorTexture->getWidth();
+                target.height = colorTexture->getHeight();
+                target.colors = colorTexture->getColorData();
+            }
+
+            if (Texture* depthTexture = currentRenderTarget->getDepthTexture())
+            {
+                if (!target.colors)
+                {
+                    target.width = depthTexture->getWidth();
+                    target.height = depthTexture->getHeight();
+                }
+                else if (depthTexture->getWidth() != target.width ||
+                         depthTexture->getHeight() != target.height)
+                    throw std::runtime_error("Render target textures must have the same size");
+
+                target.depths = depthTexture->getDepthData();
+                target.stencils = depthTexture->getStencilData();
+            }
+        }
+        else
+        {
+            target.width = frameBufferWidth;
+            target.height = frameBufferHeight;
+            target.colors = backBuffer.empty() ? nullptr : backBuffer.data();
+            target.depths = depthBuffer.empty() ? nullptr : depthBuffer.data();
+            target.stencils = stencilBuffer.empty() ? nullptr : stencilBuffer.data();
+        }
+
+        rasterizer.setTarget(target);
+        rasterStateDirty = true;
+    }
+
+    void RenderDevice::updateRasterState()
+    {
+        const auto& target = rasterizer.getTarget();
+
+        RasterState state;
+        state.blendState = currentBlendState;
+        state.depthStencilState = currentDepthStencilState;
+        state.stencilReferenceValue = stencilReferenceValue;
+        state.texture = (currentShader && currentShader->isTextured() && !textures.empty()) ? textures.front() : nullptr;
+
+        auto left = std::max(0.0F, std::floor(viewport.position.v[0]));
+        auto top = std::max(0.0F, std::floor(viewport.position.v[1]));
+        auto right = std::min(static_cast<float>(target.width), std::ceil(viewport.position.v[0] + viewport.size.v[0]));
+        auto bottom = std::min(static_cast<float>(target.height), std::ceil(viewport.position.v[1] + viewport.size.v[1]));
+
+        if (scissorTest)
+        {
+            left = std::max(left, std::floor(scissorRectangle.position.v[0]));
+            top = std::max(top, std::floor(scissorRectangle.position.v[1]));
+            right = std::min(right, std::floor(scissorRectangle.position.v[0] + scissorRectangle.size.v[0]));
+            bottom = std::min(bottom, std::floor(scissorRectangle.position.v[1] + scissorRectangle.size.v[1]));
+        }
+
+        state.clipLeft = static_cast<std::int32_t>(left);
+        state.clipTop = static_cast<std::int32_t>(top);
+        state.clipRight = static_cast<std::int32_t>(std::max(left, right));
+        state.clipBottom = static_cast<std::int32_t>(std::max(top, bottom));
+
+        rasterizer.setState(state);
+        rasterStateDirty = false;
+    }
+
+    void RenderDevice::draw(const DrawCommand& drawCommand)
+    {
+        auto indexBuffer = getResource<Buffer>(drawCommand.indexBuffer);
+        auto vertexBuffer = getResource<Buffer>(drawCommand.vertexBuffer);
+
+        if (!indexBuffer || !vertexBuffer)
+            throw std::runtime_error("Invalid mesh buffer");
+
+        if (!currentShader)
+            throw std::runtime_error("No shader set");
+
+        if (drawCommand.indexSize != sizeof(std::uint16_t) &&
+            drawCommand.indexSize != sizeof(std::uint32_t))
+            throw std::runtime_error("Invalid index size");
+
+        if ((static_cast<std::size_t>(drawCommand.startIndex) + drawCommand.indexCount) * drawCommand.indexSize > indexBuffer->getSize())
+            throw std::runtime_error("Invalid index count");
+
+        if (rasterStateDirty) updateRasterState();
+
+        const std::byte* indexData = indexBuffer->getData() + static_cast<std::size_t>(drawCommand.startIndex) * drawCommand.indexSize;
+        const auto getIndex = [indexData, &drawCommand](std::uint32_t i) noexcept -> std::uint32_t {
+            if (drawCommand.indexSize == sizeof(std::uint16_t))
+            {
+                std::uint16_t index;
+                std::memcpy(&index, indexData + i * sizeof(index), sizeof(index));
+                return index;
+            }
+            else
+            {
+                std::uint32_t index;
+                std::memcpy(&index, indexData + i * sizeof(index), sizeof(index));
+                return index;
+            }
+        };
+
+        if (drawCommand.indexCount == 0) return;
+
+        // transform the range of vertices that the draw call uses
+        std::uint32_t firstVertex = getIndex(0);
+        std::uint32_t lastVertex = firstVertex;
+        for (std::uint32_t i = 1; i < drawCommand.indexCount; ++i)
+        {
+            const auto index = getIndex(i);
+            firstVertex = std::min(firstVertex, index);
+            lastVertex = std::max(lastVertex, index);
+        }
+
+        if ((static_cast<std::size_t>(lastVertex) + 1) * sizeof(Vertex) > vertexBuffer->getSize())
+            throw std::runtime_error("Invalid vertex index");
+
+        const auto& modelViewProj = currentShader->getModelViewProj();
+        const auto& color = currentShader->getColor();
+
+        clipVertices.resize(static_cast<std::size_t>(lastVertex - firstVertex) + 1);
+
+        for (std::size_t i = 0; i < clipVertices.size(); ++i)
+        {
+            Vertex vertex;
+            std::memcpy(&vertex, vertexBuffer->getData() + (firstVertex + i) * sizeof(Vertex), sizeof(Vertex));
+
+            ClipVertex& clipVertex = clipVertices[i];
+            modelViewProj.transformVector(Vector<float, 4>{vertex.position.v[0], vertex.position.v[1], vertex.position.v[2], 1.0F},
+                                          clipVertex.position);
+
+            for (std::size_t channel = 0; channel < 4; ++channel)
+                clipVertex.color[channel] = static_cast<float>(vertex.color.v[channel]) / 255.0F * color[channel];
+
+            clipVertex.texCoords[0] = vertex.texCoords[0].v[0];
+            clipVertex.texCoords[1] = vertex.texCoords[0].v[1];
+        }
+
+        const auto getVertex = [this, &getIndex, firstVertex](std::uint32_t i) noexcept -> const ClipVertex& {
+            return clipVertices[getIndex(i) - firstVertex];
+        };
+
+        switch (drawCommand.drawMode)
+        {
+            case DrawMode::pointList:
+                for (std::uint32_t i = 0; i < drawCommand.indexCount; ++i)
+                    drawPoint(getVertex(i));
+                break;
+            case DrawMode::lineList:
+                for (std::uint32_t i = 0; i + 1 < drawCommand.indexCount; i += 2)
+                    drawLine(getVertex(i), getVertex(i + 1));
+                break;
+            case DrawMode::lineStrip:
+                for (std::uint32_t i = 0; i + 1 < drawCommand.indexCount; ++i)
+                    drawLine(getVertex(i), getVertex(i + 1));
+                break;
+            case DrawMode::triangleList:
+                for (std::uint32_t i = 0; i + 2 < drawCommand.indexCount; i += 3)
+                    drawTriangle(getVertex(i), getVertex(i + 1), getVertex(i + 2));
+                break;
+            case DrawMode::triangleStrip:
+                // every other triangle in a strip has the opposite winding
+                for (std::uint32_t i = 0; i + 2 < drawCommand.indexCount; ++i)
+                    if (i % 2)
+                        drawTriangle(getVertex(i + 1), getVertex(i), getVertex(i + 2));
+                    else
+                        drawTriangle(getVertex(i), getVertex(i + 1), getVertex(i + 2));
+                break;
+            default:
+                throw std::runtime_error("Invalid draw mode");
+        }
+    }
+
+    void RenderDevice::drawTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2)
+    {
+        // a triangle clipped by three planes has at most six vertices
+        ClipVertex polygons[2][6] = {{v0, v1, v2}};
+        std::size_t vertexCount = 3;
+        std::size_t current = 0;
+
+        for (const auto getDistance : clipPlanes)
+        {
+            const ClipVertex* input = polygons[current];
+            ClipVertex* output = polygons[current ^ 1];
+            std::size_t outputCount = 0;
+
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                const ClipVertex& a = input[i];
+                const ClipVertex& b = input[(i + 1) % vertexCount];
+                const auto distanceA = getDistance(a.position);
+                const auto distanceB = getDistance(b.position);
+
+                if (distanceA >= 0.0F) output[outputCount++] = a;
+                if ((distanceA >= 0.0F) != (distanceB >= 0.0F))
+                    output[outputCount++] = interpolate(a, b, distanceA / (distanceA - distanceB));
+            }
+
+            vertexCount = outputCount;
+            current ^= 1;
+
+            if (vertexCount < 3) return;
+        }
+
+        RasterVertex rasterVertices[6];
+        float signedArea = 0.0F;
+        for (std::size_t i = 0; i < vertexCount; ++i)
+            rasterVertices[i] = project(polygons[current][i]);
+
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            const auto& a = rasterVertices[i];
+            const auto& b = rasterVertices[(i + 1) % vertexCount];
+            signedArea += a.x * b.y - b.x * a.y;
+        }
+
+        // the front faces are clockwise on the screen like in Direct3D
+        const bool frontFacing = signedArea > 0.0F;
+
+        if ((cullMode == CullMode::back && !frontFacing) ||
+            (cullMode == CullMode::front && frontFacing))
+            return;
+
+        if (fillMode == FillMode::wireframe)
+        {
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                const auto& a = rasterVertices[i];
+                const auto& b = rasterVertices[(i + 1) % vertexCount];
+                const auto dx = b.x - a.x;
+                const auto dy = b.y - a.y;
+                const auto length = std::sqrt(dx * dx + dy * dy);
+                if (length <= 0.0F) continue;
+
+                const auto nx = -dy / length * 0.5F;
+                const auto ny = dx / length * 0.5F;
+                rasterizer.drawTriangle(offset(a, nx, ny), offset(a, -nx, -ny), offset(b, -nx, -ny), true);
+                rasterizer.drawTriangle(offset(a, nx, ny), offset(b, -nx, -ny), offset(b, nx, ny), true);
+            }
+        }
+        else
+            for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+                rasterizer.drawTriangle(rasterVertices[0], rasterVertices[i], rasterVertices[i + 1], frontFacing);
+    }
+
+    void RenderDevice::drawLine(const ClipVertex& v0, const ClipVertex& v1)
+    {
+        ClipVertex a = v0;
+        ClipVertex b = v1;
+
+        for (const auto getDistance : clipPlanes)
+        {
+            const auto distanceA = getDistance(a.position);
+            const auto distanceB = getDistance(b.position);
+
+            if (distanceA < 0.0F && distanceB < 0.0F) return;
+            if (distanceA < 0.0F)
+                a = interpolate(a, b, distanceA / (distanceA - distanceB));
+            else if (distanceB < 0.0F)
+                b = interpolate(a, b, distanceA / (distanceA - distanceB));
+        }
+
+        const auto start = project(a);
+        const auto end = project(b);
+
+        // lines are drawn as one pixel wide quads
+        const auto dx = end.x - start.x;
+        const auto dy = end.y - start.y;
+        const auto length = std::sqrt(dx * dx + dy * dy);
+        if (length <= 0.0F) return;
+
+        const auto nx = -dy / length * 0.5F;
+        const auto ny = dx / length * 0.5F;
+        rasterizer.drawTriangle(offset(start, nx, ny), offset(start, -nx, -ny), offset(end, -nx, -ny), true);
+        rasterizer.drawTriangle(offset(start, nx, ny), offset(end, -nx, -ny), offset(end, nx, ny), true);
+    }
+
+    void RenderDevice::drawPoint(const ClipVertex& v)
+    {
+        for (const auto getDistance : clipPlanes)
+            if (getDistance(v.position) < 0.0F) return;
+
+        // points are drawn as one pixel quads
+        const auto point = project(v);
+        rasterizer.drawTriangle(offset(point, -0.5F, -0.5F), offset(point, 0.5F, -0.5F), offset(point, 0.5F, 0.5F), true);
+        rasterizer.drawTriangle(offset(point, -0.5F, -0.5F), offset(point, 0.5F, 0.5F), offset(point, -0.5F, 0.5F), true);
+    }
+
+    RasterVertex RenderDevice::project(const ClipVertex& clipVertex) const noexcept
+    {
+        const auto inverseW = 1.0F / clipVertex.position.v[3];
+
+        RasterVertex result;
+        result.x = viewport.position.v[0] + (clipVertex.position.v[0] * inverseW + 1.0F) * 0.5F * viewport.size.v[0];
+        result.y = viewport.position.v[1] + (1.0F - clipVertex.position.v[1] * inverseW) * 0.5F * viewport.size.v[1];
+        result.z = clipVertex.position.v[2] * inverseW;
+        result.inverseW = inverseW;
+
+        for (std::size_t i = 0; i < 4; ++i)
+            result.color[i] = clipVertex.color[i] * inverseW;
+        for (std::size_t i = 0; i < 2; ++i)
+            result.texCoords[i] = clipVertex.texCoords[i] * inverseW;
+
+        return result;
+    }
+}
@@ -0,0 +1,95 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWARERENDERDEVICE_HPP
+#define OUZEL_GRAPHICS_SOFTWARERENDERDEVICE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../RenderDevice.hpp"
+#include "SoftwareRasterizer.hpp"
+#include "SoftwareRenderResource.hpp"
+#include "../../math/Rect.hpp"
+#include "../../math/Vector.hpp"
+#include "../../thread/Thread.hpp"
+
+namespace ouzel::graphics::software
+{
+    class BlendState;
+    class DepthStencilState;
+    class RenderTarget;
+    class Shader;
+    class Texture;
+
+    // executes the command buffers on the CPU without presenting them to the window,
+    // the frames can be read back with screenshots, follows the Direct3D conventions
+    // for the coordinate systems (the first row is the top one and the depth range is [0, 1])
+    class RenderDevice final: public graphics::RenderDevice
+    {
+    public:
+        RenderDevice(const Settings& settings,
+                     core::Window& initWindow,
+                     const std::function<void(const Event&)>& initCallback);
+        ~RenderDevice() override;
+
+        template <class T>
+        auto getResource(std::size_t id) const
+        {
+            return id ? static_cast<T*>(resources[id - 1].get()) : nullptr;
+        }
+
+    private:
+        struct ClipVertex final
+        {
+            Vector<float, 4> position;
+            float color[4];
+            float texCoords[2];
+        };
+
+        void process() final;
+        void generateScreenshot(const std::string& filename) final;
+        void renderMain();
+
+        void resizeFrameBuffer(std::uint32_t newWidth, std::uint32_t newHeight);
+        void bindRenderTarget();
+        void updateRasterState();
+
+        void draw(const DrawCommand& drawCommand);
+        void drawTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+        void drawLine(const ClipVertex& v0, const ClipVertex& v1);
+        void drawPoint(const ClipVertex& v);
+        RasterVertex project(const ClipVertex& clipVertex) const noexcept;
+
+        std::uint32_t frameBufferWidth = 0;
+        std::uint32_t frameBufferHeight = 0;
+        std::vector<std::uint8_t> backBuffer;
+        std::vector<std::uint8_t> frontBuffer; // the last presented frame
+        std::vector<float> depthBuffer;
+        std::vector<std::uint8_t> stencilBuffer;
+
+        Rasterizer rasterizer;
+        bool rasterStateDirty = true;
+
+        RenderTarget* currentRenderTarget = nullptr;
+        Shader* currentShader = nullptr;
+        const BlendState* currentBlendState = nullptr;
+        const DepthStencilState* currentDepthStencilState = nullptr;
+        std::uint8_t stencilReferenceValue = 0;
+        CullMode cullMode = CullMode::none;
+        FillMode fillMode = FillMode::solid;
+        Rect<float> viewport;
+        bool scissorTest = false;
+        Rect<float> scissorRectangle;
+        std::vector<Texture*> textures;
+        std::vector<ClipVertex> clipVertices;
+
+        std::atomic_bool running{false};
+        thread::Thread renderThread;
+
+        std::vector<std::unique_ptr<RenderResource>> resources;
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWARERENDERDEVICE_HPP
@@ -0,0 +1,36 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWARERENDERTARGET_HPP
+#define OUZEL_GRAPHICS_SOFTWARERENDERTARGET_HPP
+
+#include <set>
+#include "SoftwareRenderResource.hpp"
+
+namespace ouzel::graphics::software
+{
+    class RenderDevice;
+    class Texture;
+
+    class RenderTarget final: public RenderResource
+    {
+    public:
+        RenderTarget(RenderDevice& initRenderDevice,
+                     const std::set<Texture*>& initColorTextures,
+                     Texture* initDepthTexture):
+            RenderResource(initRenderDevice),
+            colorTextures(initColorTextures),
+            depthTexture(initDepthTexture)
+        {
+        }
+
+        // the fixed function pipeline has one output, so only the first color texture is rendered to
+        Texture* getColorTexture() const noexcept { return colorTextures.empty() ? nullptr : *colorTextures.begin(); }
+        auto getDepthTexture() const noexcept { return depthTexture; }
+
+    private:
+        std::set<Texture*> colorTextures;
+        Texture* depthTexture = nullptr;
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWARERENDERTARGET_HPP
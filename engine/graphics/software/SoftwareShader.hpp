@@ -0,0 +1,78 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWARESHADER_HPP
+#define OUZEL_GRAPHICS_SOFTWARESHADER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SoftwareRenderResource.hpp"
+#include "../DataType.hpp"
+#include "../Vertex.hpp"
+#include "../../math/Matrix.hpp"
+
+namespace ouzel::graphics::software
+{
+    class RenderDevice;
+
+    // the rasterizer can not execute shader programs, so every shader is implemented by a fixed function
+    // pipeline that matches the built-in color and texture shaders: the position is transformed by the
+    // "modelViewProj" vertex shader constant and the vertex color is modulated by the "color" fragment shader
+    // constant and, if the shader has texture coordinates, by the texture in the first layer
+    class Shader final: public RenderResource
+    {
+    public:
+        Shader(RenderDevice& initRenderDevice,
+               const std::set<Vertex::Attribute::Usage>& initVertexAttributes,
+               const std::vector<std::pair<std::string, DataType>>& initFragmentShaderConstantInfo,
+               const std::vector<std::pair<std::string, DataType>>& initVertexShaderConstantInfo):
+            RenderResource(initRenderDevice),
+            textured(initVertexAttributes.find(Vertex::Attribute::Usage::textureCoordinates0) != initVertexAttributes.end()),
+            colorConstant(findConstant(initFragmentShaderConstantInfo, "color")),
+            modelViewProjConstant(findConstant(initVertexShaderConstantInfo, "modelViewProj"))
+        {
+        }
+
+        void setFragmentShaderConstant(std::uint32_t index, const float* data, std::size_t size) noexcept
+        {
+            if (index == colorConstant)
+                std::copy(data, data + std::min(size, color.size()), color.begin());
+        }
+
+        void setVertexShaderConstant(std::uint32_t index, const float* data, std::size_t size) noexcept
+        {
+            if (index == modelViewProjConstant)
+                std::copy(data, data + std::min(size, modelViewProj.m.size()), modelViewProj.m.begin());
+        }
+
+        auto isTextured() const noexcept { return textured; }
+        auto& getColor() const noexcept { return color; }
+        auto& getModelViewProj() const noexcept { return modelViewProj; }
+
+    private:
+        static constexpr std::uint32_t noConstant = ~std::uint32_t{0};
+
+        static std::uint32_t findConstant(const std::vector<std::pair<std::string, DataType>>& constantInfo,
+                                          const std::string& name) noexcept
+        {
+            for (std::size_t i = 0; i < constantInfo.size(); ++i)
+                if (constantInfo[i].first == name) return static_cast<std::uint32_t>(i);
+
+            return noConstant;
+        }
+
+        bool textured = false;
+        std::uint32_t colorConstant = noConstant;
+        std::uint32_t modelViewProjConstant = noConstant;
+
+        // shader constants are part of the shader state like OpenGL uniforms
+        std::array<float, 4> color{1.0F, 1.0F, 1.0F, 1.0F};
+        Matrix<float, 4> modelViewProj = Matrix<float, 4>::identity();
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWARESHADER_HPP
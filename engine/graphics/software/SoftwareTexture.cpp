@@ -0,0 +1,119 @@
+// Ouzel by Elviss Strazdins
+
+#include <stdexcept>
+#include "SoftwareTexture.hpp"
+#include "SoftwareRenderDevice.hpp"
+
+namespace ouzel::graphics::software
+{
+    namespace
+    {
+        bool isDepthFormat(PixelFormat pixelFormat) noexcept
+        {
+            return pixelFormat == PixelFormat::depth ||
+                pixelFormat == PixelFormat::depthStencil;
+        }
+
+        void convertToRGBA8(const std::vector<std::uint8_t>& source,
+                            PixelFormat pixelFormat,
+                            std::size_t pixelCount,
+                            std::vector<std::uint8_t>& destination)
+        {
+            if (source.size() < pixelCount * getPixelSize(pixelFormat))
+                throw std::runtime_error("Invalid texture data size");
+
+            switch (pixelFormat)
+            {
+                case PixelFormat::rgba8UnsignedNorm:
+                case PixelFormat::rgba8UnsignedNormSRGB:
+                    std::copy(source.begin(), source.begin() + static_cast<std::ptrdiff_t>(pixelCount * 4), destination.begin());
+                    break;
+                case PixelFormat::rg8UnsignedNorm:
+                    for (std::size_t i = 0; i < pixelCount; ++i)
+                    {
+                        destination[i * 4 + 0] = source[i * 2 + 0];
+                        destination[i * 4 + 1] = source[i * 2 + 1];
+                        destination[i * 4 + 2] = 0;
+                        destination[i * 4 + 3] = 255;
+                    }
+                    break;
+                case PixelFormat::r8UnsignedNorm:
+                    for (std::size_t i = 0; i < pixelCount; ++i)
+                    {
+                        destination[i * 4 + 0] = source[i];
+                        destination[i * 4 + 1] = 0;
+                        destination[i * 4 + 2] = 0;
+                        destination[i * 4 + 3] = 255;
+                    }
+                    break;
+                case PixelFormat::a8UnsignedNorm:
+                    for (std::size_t i = 0; i < pixelCount; ++i)
+                    {
+                        destination[i * 4 + 0] = 0;
+                        destination[i * 4 + 1] = 0;
+                        destination[i * 4 + 2] = 0;
+                        destination[i * 4 + 3] = source[i];
+                    }
+                    break;
+                default:
+                    throw std::runtime_error("Unsupported pixel format");
+            }
+        }
+    }
+
+    Texture::Texture(RenderDevice& initRenderDevice,
+                     const std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>>& initLevels,
+                     TextureType initType,
+                     Flags initFlags,
+                     std::uint32_t initSampleCount,
+                     PixelFormat initPixelFormat,
+                     SamplerFilter initFilter,
+                     std::uint32_t):
+        RenderResource(initRenderDevice),
+        flags(initFlags),
+        pixelFormat(initPixelFormat),
+        filter(initFilter)
+    {
+        if (initType != TextureType::twoDimensional)
+            throw std::runtime_error("Invalid texture type");
+
+        if (initSampleCount > 1)
+            throw std::runtime_error("Multisample textures are not supported");
+
+        if (initLevels.empty())
+            throw std::runtime_error("Invalid mip map count");
+
+        width = initLevels.front().first.v[0];
+        height = initLevels.front().first.v[1];
+
+        if (width == 0 || height == 0)
+            throw std::runtime_error("Invalid texture size");
+
+        const auto pixelCount = static_cast<std::size_t>(width) * height;
+
+        if (isDepthFormat(pixelFormat))
+        {
+            depths.resize(pixelCount, 1.0F);
+            if (pixelFormat == PixelFormat::depthStencil)
+                stencils.resize(pixelCount, 0);
+        }
+        else
+        {
+            colors.resize(pixelCount * 4, 0);
+            setData(initLevels);
+        }
+    }
+
+    void Texture::setData(const std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>>& levels)
+    {
+        if (isDepthFormat(pixelFormat))
+            throw std::runtime_error("Depth textures can not be updated");
+
+        if (levels.empty() || levels.front().second.empty()) return;
+
+        if (levels.front().first.v[0] != width || levels.front().first.v[1] != height)
+            throw std::runtime_error("Invalid texture size");
+
+        convertToRGBA8(levels.front().second, pixelFormat, static_cast<std::size_t>(width) * height, colors);
+    }
+}
@@ -0,0 +1,161 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GRAPHICS_SOFTWARETEXTURE_HPP
+#define OUZEL_GRAPHICS_SOFTWARETEXTURE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SoftwareRenderResource.hpp"
+#include "../Flags.hpp"
+#include "../PixelFormat.hpp"
+#include "../SamplerAddressMode.hpp"
+#include "../SamplerFilter.hpp"
+#include "../TextureType.hpp"
+#include "../../math/Color.hpp"
+#include "../../math/Size.hpp"
+
+namespace ouzel::graphics::software
+{
+    class RenderDevice;
+
+    // color textures are stored as RGBA8 and depth textures as float depth and 8-bit stencil,
+    // only the first level is kept and sampled
+    class Texture final: public RenderResource
+    {
+    public:
+        Texture(RenderDevice& initRenderDevice,
+                const std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>>& initLevels,
+                TextureType initType,
+                Flags initFlags,
+                std::uint32_t initSampleCount,
+                PixelFormat initPixelFormat,
+                SamplerFilter initFilter,
+                std::uint32_t initMaxAnisotropy);
+
+        void setData(const std::vector<std::pair<Size<std::uint32_t, 2>, std::vector<std::uint8_t>>>& levels);
+        void setFilter(SamplerFilter newFilter) noexcept { filter = newFilter; }
+        void setAddressX(SamplerAddressMode newAddressX) noexcept { addressX = newAddressX; }
+        void setAddressY(SamplerAddressMode newAddressY) noexcept { addressY = newAddressY; }
+        void setBorderColor(Color newBorderColor) noexcept { borderColor = newBorderColor; }
+
+        auto getFlags() const noexcept { return flags; }
+        auto getPixelFormat() const noexcept { return pixelFormat; }
+        auto getWidth() const noexcept { return width; }
+        auto getHeight() const noexcept { return height; }
+
+        auto getColorData() noexcept { return colors.empty() ? nullptr : colors.data(); }
+        auto getColorData() const noexcept { return colors.empty() ? nullptr : colors.data(); }
+        auto getDepthData() noexcept { return depths.empty() ? nullptr : depths.data(); }
+        auto getStencilData() noexcept { return stencils.empty() ? nullptr : stencils.data(); }
+
+        // returns the normalized RGBA color at the texture coordinates
+        void sample(float u, float v, float (&result)[4]) const noexcept
+        {
+            if (colors.empty())
+            {
+                result[0] = result[1] = result[2] = result[3] = 0.0F;
+                return;
+            }
+
+            const auto textureWidth = static_cast<std::int32_t>(width);
+            const auto textureHeight = static_cast<std::int32_t>(height);
+
+            // keep the coordinates in the range where the conversion to an integer is defined
+            const auto x = std::clamp(u * static_cast<float>(width), -maxCoordinate, maxCoordinate);
+            const auto y = std::clamp(v * static_cast<float>(height), -maxCoordinate, maxCoordinate);
+
+            if (filter == SamplerFilter::point)
+            {
+                fetch(address(static_cast<std::int32_t>(std::floor(x)), textureWidth, addressX),
+                      address(static_cast<std::int32_t>(std::floor(y)), textureHeight, addressY),
+                      result);
+                return;
+            }
+
+            const auto fx = x - 0.5F;
+            const auto fy = y - 0.5F;
+            const auto floorX = std::floor(fx);
+            const auto floorY = std::floor(fy);
+            const auto tx = fx - floorX;
+            const auto ty = fy - floorY;
+            const auto x0 = static_cast<std::int32_t>(floorX);
+            const auto y0 = static_cast<std::int32_t>(floorY);
+
+            const auto left = address(x0, textureWidth, addressX);
+            const auto right = address(x0 + 1, textureWidth, addressX);
+            const auto top = address(y0, textureHeight, addressY);
+            const auto bottom = address(y0 + 1, textureHeight, addressY);
+
+            float topLeft[4];
+            float topRight[4];
+            float bottomLeft[4];
+            float bottomRight[4];
+            fetch(left, top, topLeft);
+            fetch(right, top, topRight);
+            fetch(left, bottom, bottomLeft);
+            fetch(right, bottom, bottomRight);
+
+            for (std::size_t channel = 0; channel < 4; ++channel)
+            {
+                const auto upper = topLeft[channel] + (topRight[channel] - topLeft[channel]) * tx;
+                const auto lower = bottomLeft[channel] + (bottomRight[channel] - bottomLeft[channel]) * tx;
+                result[channel] = upper + (lower - upper) * ty;
+            }
+        }
+
+    private:
+        static constexpr float maxCoordinate = 16777216.0F;
+
+        // returns -1 for the coordinates that should sample the border color
+        static std::int32_t address(std::int32_t coordinate, std::int32_t size, SamplerAddressMode mode) noexcept
+        {
+            switch (mode)
+            {
+                case SamplerAddressMode::clampToBorder:
+                    return (coordinate < 0 || coordinate >= size) ? -1 : coordinate;
+                case SamplerAddressMode::repeat:
+                {
+                    const auto result = coordinate % size;
+                    return result < 0 ? result + size : result;
+                }
+                case SamplerAddressMode::mirrorRepeat:
+                {
+                    const auto period = size * 2;
+                    auto result = coordinate % period;
+                    if (result < 0) result += period;
+                    return result < size ? result : period - 1 - result;
+                }
+                case SamplerAddressMode::clampToEdge:
+                default:
+                    return std::clamp(coordinate, 0, size - 1);
+            }
+        }
+
+        void fetch(std::int32_t x, std::int32_t y, float (&result)[4]) const noexcept
+        {
+            const std::uint8_t* texel = (x < 0 || y < 0) ? borderColor.v.data() :
+                &colors[(static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)) * 4];
+
+            for (std::size_t channel = 0; channel < 4; ++channel)
+                result[channel] = static_cast<float>(texel[channel]) / 255.0F;
+        }
+
+        Flags flags = Flags::none;
+        PixelFormat pixelFormat = PixelFormat::rgba8UnsignedNorm;
+        SamplerFilter filter = SamplerFilter::point;
+        SamplerAddressMode addressX = SamplerAddressMode::clampToEdge;
+        SamplerAddressMode addressY = SamplerAddressMode::clampToEdge;
+        Color borderColor;
+
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::vector<std::uint8_t> colors;
+        std::vector<float> depths;
+        std::vector<std::uint8_t> stencils;
+    };
+}
+
+#endif // OUZEL_GRAPHICS_SOFTWARETEXTURE_HPP
@@ -441,7 +441,8 @@ namespace ouzel::gui
             vertex.position.v[1] *= fontSize;
         }
 
-        return std::make_tuple(std::move(indices), std::move(vertices), fontTexture);
+        const auto indexCount = static_cast<std::uint32_t>(indices.size());
+        return RenderData{std::move(indices), std::move(vertices), {{fontTexture, 0, indexCount}}};
     }
 
     std::int16_t BMFont::getKerningPair(char32_t first, char32_t second) const
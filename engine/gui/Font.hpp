@@ -27,16 +27,28 @@ namespace ouzel::gui
         Font(Font&&) = delete;
         Font& operator=(Font&&) = delete;
 
-        // TODO: return data in a struct
-
-        using RenderData = std::tuple<std::vector<std::uint16_t>,
-            std::vector<graphics::Vertex>,
-            std::shared_ptr<graphics::Texture>>;
+        struct RenderData final
+        {
+            // range of indices that are drawn with the same texture
+            struct Batch final
+            {
+                std::shared_ptr<graphics::Texture> texture;
+                std::uint32_t startIndex = 0;
+                std::uint32_t indexCount = 0;
+            };
+
+            std::vector<std::uint16_t> indices;
+            std::vector<graphics::Vertex> vertices;
+            std::vector<Batch> batches;
+        };
 
         virtual RenderData getRenderData(const std::string& text,
                                          Color color,
                                          float fontSize,
                                          const Vector<float, 2>& anchor) const = 0;
+
+        // the alpha of the textures is the distance to the edges of the glyphs instead of their coverage
+        virtual bool isDistanceField() const noexcept { return false; }
     };
 }
 
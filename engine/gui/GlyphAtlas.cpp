@@ -0,0 +1,179 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "GlyphAtlas.hpp"
+#include "../core/Engine.hpp"
+
+namespace ouzel::gui
+{
+    namespace
+    {
+        // empty pixels between the glyphs, so that the filtering does not bleed the neighbours in
+        constexpr std::uint32_t padding = 1;
+
+        constexpr std::size_t noPage = std::numeric_limits<std::size_t>::max();
+
+        void clearPixels(std::vector<std::uint8_t>& data) noexcept
+        {
+            for (std::size_t i = 0; i < data.size(); i += 4)
+            {
+                data[i + 0] = 255;
+                data[i + 1] = 255;
+                data[i + 2] = 255;
+                data[i + 3] = 0;
+            }
+        }
+    }
+
+    const GlyphAtlas::Glyph* GlyphAtlas::getGlyph(const Key& key) noexcept
+    {
+        const auto i = glyphs.find(key);
+        if (i == glyphs.end()) return nullptr;
+
+        if (i->second.width && i->second.height)
+            pages[i->second.page].lastUse = currentUse;
+
+        return &i->second;
+    }
+
+    const GlyphAtlas::Glyph& GlyphAtlas::addGlyph(const Key& key, const Glyph& glyph, const std::uint8_t* bitmap)
+    {
+        Glyph result = glyph;
+        result.page = 0;
+        result.x = 0;
+        result.y = 0;
+
+        // the glyphs without pixels (like spaces) only have metrics
+        if (glyph.width && glyph.height)
+        {
+            const auto width = glyph.width + padding;
+            const auto height = glyph.height + padding;
+
+            auto page = noPage;
+            for (std::size_t i = 0; i < pages.size() && page == noPage; ++i)
+                if (allocate(pages[i], width, height, result.x, result.y))
+                    page = i;
+
+            if (page == noPage)
+            {
+                // the least recently used page that is not referenced by any text
+                if (pages.size() >= maxPageCount)
+                    for (std::size_t i = 0; i < pages.size(); ++i)
+                        if (pages[i].lastUse != currentUse &&
+                            pages[i].size >= width + padding && pages[i].size >= height + padding &&
+                            (!pages[i].texture || pages[i].texture.use_count() == 1) &&
+                            (page == noPage || pages[i].lastUse < pages[page].lastUse))
+                            page = i;
+
+                if (page != noPage)
+                    clearPage(page);
+                else
+                {
+                    // the glyphs that are bigger than a page get a bigger page
+                    auto size = pageSize;
+                    while (size < std::max(width, height) + padding) size *= 2;
+                    page = createPage(size);
+                }
+
+                if (!allocate(pages[page], width, height, result.x, result.y))
+                    throw std::runtime_error("Failed to allocate space for the glyph");
+            }
+
+            auto& data = pages[page].data;
+            const auto stride = pages[page].size;
+
+            for (std::uint32_t y = 0; y < glyph.height; ++y)
+                for (std::uint32_t x = 0; x < glyph.width; ++x)
+                    data[((result.y + y) * stride + result.x + x) * 4 + 3] = bitmap[y * glyph.width + x];
+
+            pages[page].dirty = true;
+            pages[page].lastUse = currentUse;
+            result.page = page;
+        }
+
+        return glyphs.insert_or_assign(key, result).first->second;
+    }
+
+    void GlyphAtlas::removeFont(const Font& font) noexcept
+    {
+        // the space of the glyphs is reclaimed when their page is cleared
+        for (auto i = glyphs.begin(); i != glyphs.end();)
+            if (i->first.font == &font)
+                i = glyphs.erase(i);
+            else
+                ++i;
+    }
+
+    const std::shared_ptr<graphics::Texture>& GlyphAtlas::getTexture(std::size_t page)
+    {
+        auto& p = pages[page];
+
+        if (!p.texture)
+            p.texture = std::make_shared<graphics::Texture>(*engine->getGraphics(),
+                                                            p.data,
+                                                            Size<std::uint32_t, 2>{p.size, p.size},
+                                                            graphics::Flags::dynamic,
+                                                            1);
+        else if (p.dirty)
+            p.texture->setData(p.data);
+
+        p.dirty = false;
+
+        return p.texture;
+    }
+
+    std::size_t GlyphAtlas::createPage(std::uint32_t size)
+    {
+        Page page;
+        page.size = size;
+        page.data.resize(static_cast<std::size_t>(size) * size * 4);
+        clearPixels(page.data);
+
+        pages.push_back(std::move(page));
+        return pages.size() - 1;
+    }
+
+    void GlyphAtlas::clearPage(std::size_t page) noexcept
+    {
+        for (auto i = glyphs.begin(); i != glyphs.end();)
+            if (i->second.width && i->second.height && i->second.page == page)
+                i = glyphs.erase(i);
+            else
+                ++i;
+
+        pages[page].shelves.clear();
+        pages[page].shelvesHeight = 0;
+        clearPixels(pages[page].data);
+        pages[page].dirty = true;
+    }
+
+    bool GlyphAtlas::allocate(Page& page, std::uint32_t width, std::uint32_t height,
+                              std::uint32_t& x, std::uint32_t& y) noexcept
+    {
+        // the shortest shelf that fits the glyph without wasting more than a quarter of its height
+        Shelf* best = nullptr;
+        for (auto& shelf : page.shelves)
+            if (shelf.height >= height && shelf.height <= height + height / 4 &&
+                shelf.width + width + padding <= page.size &&
+                (!best || shelf.height < best->height))
+                best = &shelf;
+
+        if (!best)
+        {
+            if (page.shelvesHeight + height + padding > page.size ||
+                width + padding > page.size)
+                return false;
+
+            page.shelves.push_back(Shelf{page.shelvesHeight, height, 0});
+            page.shelvesHeight += height;
+            best = &page.shelves.back();
+        }
+
+        x = best->width + padding;
+        y = best->y + padding;
+        best->width += width;
+        return true;
+    }
+}
@@ -0,0 +1,115 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GUI_GLYPHATLAS_HPP
+#define OUZEL_GUI_GLYPHATLAS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../math/Vector.hpp"
+#include "../graphics/Texture.hpp"
+
+namespace ouzel::gui
+{
+    class Font;
+
+    // rasterized glyphs of the fonts packed into shared texture pages, when all of the pages are full
+    // the least recently used page that no text is drawn with anymore is cleared and reused
+    class GlyphAtlas final
+    {
+    public:
+        static constexpr std::uint32_t pageSize = 512;
+        static constexpr std::size_t maxPageCount = 4; // more pages are created if all of them are in use
+
+        struct Key final
+        {
+            const Font* font = nullptr;
+            float size = 0.0F;
+            char32_t codepoint = 0;
+
+            bool operator==(const Key& other) const noexcept
+            {
+                return font == other.font && size == other.size && codepoint == other.codepoint;
+            }
+        };
+
+        struct Glyph final
+        {
+            std::size_t page = 0;
+            std::uint32_t x = 0;
+            std::uint32_t y = 0;
+            std::uint32_t width = 0;
+            std::uint32_t height = 0;
+            Vector<float, 2> offset;
+            float advance = 0.0F;
+        };
+
+        GlyphAtlas() = default;
+
+        GlyphAtlas(const GlyphAtlas&) = delete;
+        GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+        GlyphAtlas(GlyphAtlas&&) = delete;
+        GlyphAtlas& operator=(GlyphAtlas&&) = delete;
+
+        // the pages of the glyphs returned after this call are not evicted until the next call
+        void beginText() noexcept { ++currentUse; }
+
+        const Glyph* getGlyph(const Key& key) noexcept;
+
+        // copies the 8-bit coverage bitmap of the glyph to a page, the glyph's page, x and y are ignored
+        const Glyph& addGlyph(const Key& key, const Glyph& glyph, const std::uint8_t* bitmap);
+
+        void removeFont(const Font& font) noexcept;
+
+        auto getPageCount() const noexcept { return pages.size(); }
+        std::uint32_t getPageSize(std::size_t page) const noexcept { return pages[page].size; }
+
+        // uploads the glyphs that were added to the page since the last call
+        const std::shared_ptr<graphics::Texture>& getTexture(std::size_t page);
+
+    private:
+        struct KeyHash final
+        {
+            std::size_t operator()(const Key& key) const noexcept
+            {
+                auto hash = std::hash<const Font*>{}(key.font);
+                hash = hash * 31 + std::hash<float>{}(key.size);
+                return hash * 31 + std::hash<char32_t>{}(key.codepoint);
+            }
+        };
+
+        // the glyphs are placed on shelves from left to right
+        struct Shelf final
+        {
+            std::uint32_t y = 0;
+            std::uint32_t height = 0;
+            std::uint32_t width = 0;
+        };
+
+        struct Page final
+        {
+            std::uint32_t size = 0;
+            std::vector<Shelf> shelves;
+            std::uint32_t shelvesHeight = 0;
+            std::vector<std::uint8_t> data;
+            std::shared_ptr<graphics::Texture> texture;
+            std::uint64_t lastUse = 0;
+            bool dirty = false;
+        };
+
+        std::size_t createPage(std::uint32_t size);
+        void clearPage(std::size_t page) noexcept;
+        static bool allocate(Page& page, std::uint32_t width, std::uint32_t height,
+                             std::uint32_t& x, std::uint32_t& y) noexcept;
+
+        std::unordered_map<Key, Glyph, KeyHash> glyphs;
+        std::vector<Page> pages;
+        std::uint64_t currentUse = 1;
+    };
+}
+
+#endif // OUZEL_GUI_GLYPHATLAS_HPP
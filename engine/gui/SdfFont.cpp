@@ -0,0 +1,229 @@
+// Ouzel by Elviss Strazdins
+
+#include <array>
+#include <stdexcept>
+#include "SdfFont.hpp"
+#include "../core/Engine.hpp"
+#include "../graphics/Graphics.hpp"
+#include "../utils/Utf8.hpp"
+#include "../utils/Utils.hpp"
+
+namespace ouzel::gui
+{
+    namespace
+    {
+        constexpr std::uint32_t version = 1;
+
+        class Reader final
+        {
+        public:
+            explicit Reader(const std::vector<std::byte>& initData) noexcept:
+                data{initData}
+            {
+            }
+
+            template <typename T>
+            T read()
+            {
+                if (data.size() - offset < sizeof(T))
+                    throw std::runtime_error("Invalid SDF font");
+
+                const auto result = decodeLittleEndian<T>(data.begin() + static_cast<std::ptrdiff_t>(offset));
+                offset += sizeof(T);
+                return result;
+            }
+
+            float readFloat()
+            {
+                return bitCast<float>(read<std::uint32_t>());
+            }
+
+            auto getRemaining() const noexcept { return data.size() - offset; }
+            auto getPosition() const noexcept { return data.begin() + static_cast<std::ptrdiff_t>(offset); }
+
+        private:
+            const std::vector<std::byte>& data;
+            std::size_t offset = 0;
+        };
+    }
+
+    SdfFont::SdfFont(const std::vector<std::byte>& data, bool mipmaps)
+    {
+        Reader reader{data};
+
+        if (reader.read<std::uint8_t>() != 'O' ||
+            reader.read<std::uint8_t>() != 'S' ||
+            reader.read<std::uint8_t>() != 'D' ||
+            reader.read<std::uint8_t>() != 'F')
+            throw std::runtime_error("Not an SDF font");
+
+        if (reader.read<std::uint32_t>() != version)
+            throw std::runtime_error("Unsupported SDF font version");
+
+        size = reader.readFloat();
+        reader.readFloat(); // the range of the distances, the shader smooths the edges by their screen-space derivatives
+        ascent = reader.readFloat();
+        descent = reader.readFloat();
+        lineGap = reader.readFloat();
+
+        if (!(size > 0.0F))
+            throw std::runtime_error("Invalid SDF font size");
+
+        const auto width = reader.read<std::uint32_t>();
+        const auto height = reader.read<std::uint32_t>();
+
+        const auto glyphCount = reader.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < glyphCount; ++i)
+        {
+            const char32_t codepoint = reader.read<std::uint32_t>();
+
+            Glyph glyph;
+            glyph.x = reader.read<std::uint16_t>();
+            glyph.y = reader.read<std::uint16_t>();
+            glyph.width = reader.read<std::uint16_t>();
+            glyph.height = reader.read<std::uint16_t>();
+            glyph.offset.v[0] = reader.readFloat();
+            glyph.offset.v[1] = reader.readFloat();
+            glyph.advance = reader.readFloat();
+
+            if (glyph.x + glyph.width > width || glyph.y + glyph.height > height)
+                throw std::runtime_error("Invalid SDF glyph");
+
+            glyphs[codepoint] = glyph;
+        }
+
+        const auto kerningCount = reader.read<std::uint32_t>();
+        for (std::uint32_t i = 0; i < kerningCount; ++i)
+        {
+            const std::uint64_t first = reader.read<std::uint32_t>();
+            const std::uint64_t second = reader.read<std::uint32_t>();
+            kerningPairs[(first << 32) | second] = reader.readFloat();
+        }
+
+        if (reader.getRemaining() != static_cast<std::size_t>(width) * height)
+            throw std::runtime_error("Invalid SDF font page");
+
+        // the distance is stored in the alpha channel, so that the font can also be drawn with the texture shader
+        std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4, 255);
+        auto distance = reader.getPosition();
+        for (std::size_t i = 3; i < pixels.size(); i += 4, ++distance)
+            pixels[i] = static_cast<std::uint8_t>(*distance);
+
+        texture = std::make_shared<graphics::Texture>(*engine->getGraphics(),
+                                                      pixels,
+                                                      Size<std::uint32_t, 2>{width, height},
+                                                      graphics::Flags::none,
+                                                      mipmaps ? 0 : 1);
+    }
+
+    Font::RenderData SdfFont::getRenderData(const std::string& text,
+                                            Color color,
+                                            float fontSize,
+                                            const Vector<float, 2>& anchor) const
+    {
+        if (!texture)
+            throw std::runtime_error("Font not loaded");
+
+        const float s = fontSize / size;
+
+        const std::u32string utf32Text = utf8::toUtf32(text);
+
+        RenderData result;
+        result.indices.reserve(utf32Text.size() * 6);
+        result.vertices.reserve(utf32Text.size() * 4);
+
+        const Size<float, 2> textureSize{
+            static_cast<float>(texture->getSize().v[0]),
+            static_cast<float>(texture->getSize().v[1])
+        };
+
+        Vector<float, 2> position;
+        std::size_t firstChar = 0;
+
+        for (auto i = utf32Text.begin(); i != utf32Text.end(); ++i)
+        {
+            if (const auto glyphIterator = glyphs.find(*i); glyphIterator != glyphs.end())
+            {
+                const auto& f = glyphIterator->second;
+
+                // the glyphs without pixels only advance the position
+                if (f.width && f.height)
+                {
+                    const Vector<float, 2> leftTop{
+                        static_cast<float>(f.x) / textureSize.v[0],
+                        static_cast<float>(f.y) / textureSize.v[1]
+                    };
+
+                    const Vector<float, 2> rightBottom{
+                        static_cast<float>(f.x + f.width) / textureSize.v[0],
+                        static_cast<float>(f.y + f.height) / textureSize.v[1]
+                    };
+
+                    const std::array<Vector<float, 2>, 4> textCoords{
+                        Vector<float, 2>{leftTop.v[0], rightBottom.v[1]},
+                        Vector<float, 2>{rightBottom.v[0], rightBottom.v[1]},
+                        Vector<float, 2>{leftTop.v[0], leftTop.v[1]},
+                        Vector<float, 2>{rightBottom.v[0], leftTop.v[1]}
+                    };
+
+                    const auto left = position.v[0] + f.offset.v[0] * s;
+                    const auto top = -position.v[1] - (f.offset.v[1] + ascent - descent) * s;
+                    const auto width = static_cast<float>(f.width) * s;
+                    const auto height = static_cast<float>(f.height) * s;
+
+                    const auto startVertex = static_cast<std::uint16_t>(result.vertices.size());
+                    result.indices.push_back(startVertex + 0);
+                    result.indices.push_back(startVertex + 1);
+                    result.indices.push_back(startVertex + 2);
+
+                    result.indices.push_back(startVertex + 1);
+                    result.indices.push_back(startVertex + 3);
+                    result.indices.push_back(startVertex + 2);
+
+                    result.vertices.emplace_back(Vector<float, 3>{left, top - height, 0.0F},
+                                                 color, textCoords[0], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                    result.vertices.emplace_back(Vector<float, 3>{left + width, top - height, 0.0F},
+                                                 color, textCoords[1], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                    result.vertices.emplace_back(Vector<float, 3>{left, top, 0.0F},
+                                                 color, textCoords[2], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                    result.vertices.emplace_back(Vector<float, 3>{left + width, top, 0.0F},
+                                                 color, textCoords[3], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                }
+
+                if ((i + 1) != utf32Text.end())
+                    position.v[0] += getKerning(*i, *(i + 1)) * s;
+
+                position.v[0] += f.advance * s;
+            }
+
+            if (*i == static_cast<std::uint32_t>('\n') || // line feed
+                (i + 1) == utf32Text.end()) // end of string
+            {
+                const float lineWidth = position.v[0];
+                position.v[0] = 0.0F;
+                position.v[1] += fontSize + lineGap * s;
+
+                for (std::size_t c = firstChar; c < result.vertices.size(); ++c)
+                    result.vertices[c].position.v[0] -= lineWidth * anchor.v[0];
+
+                firstChar = result.vertices.size();
+            }
+        }
+
+        const float textHeight = position.v[1];
+
+        for (graphics::Vertex& vertex : result.vertices)
+            vertex.position.v[1] += textHeight * (1.0F - anchor.v[1]);
+
+        if (!result.indices.empty())
+            result.batches.push_back(RenderData::Batch{texture, 0, static_cast<std::uint32_t>(result.indices.size())});
+
+        return result;
+    }
+
+    float SdfFont::getKerning(char32_t first, char32_t second) const
+    {
+        const auto i = kerningPairs.find((static_cast<std::uint64_t>(first) << 32) | second);
+        return i != kerningPairs.end() ? i->second : 0.0F;
+    }
+}
@@ -0,0 +1,50 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_GUI_SDFFONT_HPP
+#define OUZEL_GUI_SDFFONT_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include "Font.hpp"
+
+namespace ouzel::gui
+{
+    // font with the signed distance fields of its glyphs baked by the ouzel tool, a single page
+    // of the distance fields is used for all of the font sizes
+    class SdfFont final: public Font
+    {
+    public:
+        SdfFont() = default;
+        explicit SdfFont(const std::vector<std::byte>& data, bool mipmaps = true);
+
+        RenderData getRenderData(const std::string& text,
+                                 Color color,
+                                 float fontSize,
+                                 const Vector<float, 2>& anchor) const final;
+
+        bool isDistanceField() const noexcept final { return true; }
+
+    private:
+        float getKerning(char32_t first, char32_t second) const;
+
+        struct Glyph final
+        {
+            std::uint16_t x = 0;
+            std::uint16_t y = 0;
+            std::uint16_t width = 0;
+            std::uint16_t height = 0;
+            Vector<float, 2> offset;
+            float advance = 0.0F;
+        };
+
+        float size = 0.0F; // pixel height of the baked glyphs
+        float ascent = 0.0F;
+        float descent = 0.0F;
+        float lineGap = 0.0F;
+        std::unordered_map<char32_t, Glyph> glyphs;
+        std::unordered_map<std::uint64_t, float> kerningPairs;
+        std::shared_ptr<graphics::Texture> texture;
+    };
+}
+
+#endif // OUZEL_GUI_SDFFONT_HPP
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <stdexcept>
 #include "TTFont.hpp"
+#include "GlyphAtlas.hpp"
 #include "../core/Engine.hpp"
 #include "../utils/Utf8.hpp"
 
@@ -42,6 +43,11 @@ namespace ouzel::gui
             throw std::runtime_error("Failed to load font");
     }
 
+    TTFont::~TTFont()
+    {
+        if (engine) engine->getGlyphAtlas().removeFont(*this);
+    }
+
     Font::RenderData TTFont::getRenderData(const std::string& text,
                                            Color color,
                                            float fontSize,
@@ -50,170 +56,119 @@ namespace ouzel::gui
         if (!font)
             throw std::runtime_error("Font not loaded");
 
-        constexpr std::uint32_t spacing = 2U;
-
         const float s = stbtt_ScaleForPixelHeight(font.get(), fontSize);
 
         const std::u32string utf32Text = utf8::toUtf32(text);
 
-        std::set<char32_t> glyphs;
-        for (const char32_t i : utf32Text)
-            glyphs.insert(i);
-
-        std::uint16_t width = 0;
-        std::uint16_t height = 0;
-
         int ascent;
         int descent;
         int lineGap;
         stbtt_GetFontVMetrics(font.get(), &ascent, &descent, &lineGap);
 
-        struct CharDescriptor final
-        {
-            std::uint16_t x = 0;
-            std::uint16_t y = 0;
-            std::uint16_t width = 0;
-            std::uint16_t height = 0;
-            Vector<float, 2> offset;
-            float advance = 0;
-            std::vector<std::uint8_t> bitmap;
-        };
+        // only the glyphs that are not in the atlas yet are rasterized
+        auto& glyphAtlas = engine->getGlyphAtlas();
+        glyphAtlas.beginText();
 
-        std::unordered_map<std::uint32_t, CharDescriptor> chars;
+        const auto getGlyph = [this, &glyphAtlas, s, fontSize, ascent, descent](char32_t c) -> const GlyphAtlas::Glyph* {
+            const GlyphAtlas::Key key{this, fontSize, c};
+            if (const auto glyph = glyphAtlas.getGlyph(key))
+                return glyph;
 
-        for (const char32_t c : glyphs)
-        {
-            if (const auto index = stbtt_FindGlyphIndex(font.get(), static_cast<int>(c)))
-            {
-                int advance;
-                int leftBearing;
-                stbtt_GetGlyphHMetrics(font.get(), index, &advance, &leftBearing);
+            const auto index = stbtt_FindGlyphIndex(font.get(), static_cast<int>(c));
+            if (!index) return nullptr;
 
-                CharDescriptor charDesc;
-                int w;
-                int h;
-                int xoff;
-                int yoff;
+            int advance;
+            int leftBearing;
+            stbtt_GetGlyphHMetrics(font.get(), index, &advance, &leftBearing);
 
-                if (const auto bitmap = stbtt_GetGlyphBitmapSubpixel(font.get(), s, s, 0.0F, 0.0F, index, &w, &h, &xoff, &yoff))
-                {
-                    charDesc.width = static_cast<std::uint16_t>(w);
-                    charDesc.height = static_cast<std::uint16_t>(h);
-                    charDesc.offset.v[0] = static_cast<float>(leftBearing * s);
-                    charDesc.offset.v[1] = static_cast<float>(yoff + (ascent - descent) * s);
-                    charDesc.bitmap = std::vector<std::uint8_t>(bitmap, bitmap + h * w);
-                    charDesc.x = width;
+            GlyphAtlas::Glyph glyph;
+            glyph.advance = static_cast<float>(advance * s);
 
-                    width += static_cast<std::uint16_t>(w);
-                    height = std::max(height, static_cast<std::uint16_t>(h));
+            int w;
+            int h;
+            int xoff;
+            int yoff;
 
-                    stbtt_FreeBitmap(bitmap, nullptr);
-                }
-
-                charDesc.advance = static_cast<float>(advance * s);
-
-                if (!chars.empty())
-                    width += spacing;
-
-                chars[c] = charDesc;
-            }
-        }
-
-        std::vector<std::uint8_t> textureData(width * height * 4);
-
-        for (std::uint16_t posX = 0; posX < width; ++posX)
-            for (std::uint16_t posY = 0; posY < height; ++posY)
+            if (const auto bitmap = stbtt_GetGlyphBitmapSubpixel(font.get(), s, s, 0.0F, 0.0F, index, &w, &h, &xoff, &yoff))
             {
-                textureData[(posY * width + posX) * 4 + 0] = 255;
-                textureData[(posY * width + posX) * 4 + 1] = 255;
-                textureData[(posY * width + posX) * 4 + 2] = 255;
-                textureData[(posY * width + posX) * 4 + 3] = 0;
-            }
-
-        for (const auto& c : chars)
-        {
-            const auto& charDesc = c.second;
+                glyph.width = static_cast<std::uint32_t>(w);
+                glyph.height = static_cast<std::uint32_t>(h);
+                glyph.offset.v[0] = static_cast<float>(leftBearing * s);
+                glyph.offset.v[1] = static_cast<float>(yoff + (ascent - descent) * s);
 
-            for (std::uint16_t posX = 0; posX < charDesc.width; ++posX)
-            {
-                for (std::uint16_t posY = 0; posY < charDesc.height; ++posY)
+                try
                 {
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 0] = 255;
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 1] = 255;
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 2] = 255;
-                    textureData[(posY * width + posX + charDesc.x) * 4 + 3] = charDesc.bitmap[posY * charDesc.width + posX];
+                    const auto& result = glyphAtlas.addGlyph(key, glyph, bitmap);
+                    stbtt_FreeBitmap(bitmap, nullptr);
+                    return &result;
+                }
+                catch (...)
+                {
+                    stbtt_FreeBitmap(bitmap, nullptr);
+                    throw;
                 }
             }
-        }
+
+            return &glyphAtlas.addGlyph(key, glyph, nullptr);
+        };
 
         RenderData result;
+        result.indices.reserve(utf32Text.size() * 6);
+        result.vertices.reserve(utf32Text.size() * 4);
 
-        auto texture = std::make_shared<graphics::Texture>(*engine->getGraphics(),
-                                                           textureData,
-                                                           Size<std::uint32_t, 2>{width, height},
-                                                           graphics::Flags::none,
-                                                           mipmaps ? 0 : 1);
+        // the atlas page of every quad, the indices are grouped by the page after the layout
+        std::vector<std::size_t> quadPages;
+        quadPages.reserve(utf32Text.size());
 
         Vector<float, 2> position;
-
-        std::vector<std::uint16_t> indices;
-        std::vector<graphics::Vertex> vertices;
-        indices.reserve(utf32Text.size() * 6);
-        vertices.reserve(utf32Text.size() * 4);
-
         std::size_t firstChar = 0;
 
         for (auto i = utf32Text.begin(); i != utf32Text.end(); ++i)
         {
-            auto iter = chars.find(*i);
-
-            if (iter != chars.end())
+            if (const auto glyph = getGlyph(*i))
             {
-                const auto& f = iter->second;
-
-                const auto startIndex = static_cast<std::uint16_t>(vertices.size());
-                indices.push_back(startIndex + 0);
-                indices.push_back(startIndex + 1);
-                indices.push_back(startIndex + 2);
-
-                indices.push_back(startIndex + 1);
-                indices.push_back(startIndex + 3);
-                indices.push_back(startIndex + 2);
-
-                const Vector<float, 2> leftTop{
-                    f.x / static_cast<float>(width),
-                    f.y / static_cast<float>(height)
-                };
-
-                const Vector<float, 2> rightBottom{
-                    (f.x + f.width) / static_cast<float>(width),
-                    (f.y + f.height) / static_cast<float>(height)
-                };
-
-                const std::array<Vector<float, 2>, 4> textCoords{
-                    Vector<float, 2>{leftTop.v[0], rightBottom.v[1]},
-                    Vector<float, 2>{rightBottom.v[0], rightBottom.v[1]},
-                    Vector<float, 2>{leftTop.v[0], leftTop.v[1]},
-                    Vector<float, 2>{rightBottom.v[0], leftTop.v[1]}
-                };
-
-                vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0], -position.v[1] - f.offset.v[1] - f.height, 0.0F},
-                                      color, textCoords[0], Vector<float, 3>{0.0F, 0.0F, -1.0F});
-                vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0] + f.width, -position.v[1] - f.offset.v[1] - f.height, 0.0F},
-                                      color, textCoords[1], Vector<float, 3>{0.0F, 0.0F, -1.0F});
-                vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0], -position.v[1] - f.offset.v[1], 0.0F},
-                                      color, textCoords[2], Vector<float, 3>{0.0F, 0.0F, -1.0F});
-                vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0] + f.width, -position.v[1] - f.offset.v[1], 0.0F},
-                                      color, textCoords[3], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                const auto& f = *glyph;
 
-                if ((i + 1) != utf32Text.end())
+                // the glyphs without pixels only advance the position
+                if (f.width && f.height)
                 {
-                    const auto kernAdvance = stbtt_GetCodepointKernAdvance(font.get(),
-                                                                          static_cast<int>(*i),
-                                                                          static_cast<int>(*(i + 1)));
-                    position.v[0] += static_cast<float>(kernAdvance) * s;
+                    const auto pageSize = static_cast<float>(glyphAtlas.getPageSize(f.page));
+
+                    const Vector<float, 2> leftTop{
+                        static_cast<float>(f.x) / pageSize,
+                        static_cast<float>(f.y) / pageSize
+                    };
+
+                    const Vector<float, 2> rightBottom{
+                        static_cast<float>(f.x + f.width) / pageSize,
+                        static_cast<float>(f.y + f.height) / pageSize
+                    };
+
+                    const std::array<Vector<float, 2>, 4> textCoords{
+                        Vector<float, 2>{leftTop.v[0], rightBottom.v[1]},
+                        Vector<float, 2>{rightBottom.v[0], rightBottom.v[1]},
+                        Vector<float, 2>{leftTop.v[0], leftTop.v[1]},
+                        Vector<float, 2>{rightBottom.v[0], leftTop.v[1]}
+                    };
+
+                    const auto width = static_cast<float>(f.width);
+                    const auto height = static_cast<float>(f.height);
+
+                    result.vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0], -position.v[1] - f.offset.v[1] - height, 0.0F},
+                                                 color, textCoords[0], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                    result.vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0] + width, -position.v[1] - f.offset.v[1] - height, 0.0F},
+                                                 color, textCoords[1], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                    result.vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0], -position.v[1] - f.offset.v[1], 0.0F},
+                                                 color, textCoords[2], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+                    result.vertices.emplace_back(Vector<float, 3>{position.v[0] + f.offset.v[0] + width, -position.v[1] - f.offset.v[1], 0.0F},
+                                                 color, textCoords[3], Vector<float, 3>{0.0F, 0.0F, -1.0F});
+
+                    quadPages.push_back(f.page);
                 }
 
+                if ((i + 1) != utf32Text.end())
+                    position.v[0] += static_cast<float>(getKerning(*i, *(i + 1))) * s;
+
                 position.v[0] += f.advance;
             }
 
@@ -224,18 +179,54 @@ namespace ouzel::gui
                 position.v[0] = 0.0F;
                 position.v[1] += fontSize + lineGap;
 
-                for (std::size_t c = firstChar; c < vertices.size(); ++c)
-                    vertices[c].position.v[0] -= lineWidth * anchor.v[0];
+                for (std::size_t c = firstChar; c < result.vertices.size(); ++c)
+                    result.vertices[c].position.v[0] -= lineWidth * anchor.v[0];
 
-                firstChar = vertices.size();
+                firstChar = result.vertices.size();
             }
         }
 
         const float textHeight = position.v[1];
 
-        for (graphics::Vertex& vertex : vertices)
+        for (graphics::Vertex& vertex : result.vertices)
             vertex.position.v[1] += textHeight * (1.0F - anchor.v[1]);
 
-        return std::make_tuple(std::move(indices), std::move(vertices), std::move(texture));
+        // one batch per atlas page
+        for (std::size_t page = 0; page < glyphAtlas.getPageCount(); ++page)
+        {
+            const auto startIndex = static_cast<std::uint32_t>(result.indices.size());
+
+            for (std::size_t quad = 0; quad < quadPages.size(); ++quad)
+                if (quadPages[quad] == page)
+                {
+                    const auto startVertex = static_cast<std::uint16_t>(quad * 4);
+                    result.indices.push_back(startVertex + 0);
+                    result.indices.push_back(startVertex + 1);
+                    result.indices.push_back(startVertex + 2);
+
+                    result.indices.push_back(startVertex + 1);
+                    result.indices.push_back(startVertex + 3);
+                    result.indices.push_back(startVertex + 2);
+                }
+
+            if (const auto indexCount = static_cast<std::uint32_t>(result.indices.size()) - startIndex)
+                result.batches.push_back(RenderData::Batch{glyphAtlas.getTexture(page), startIndex, indexCount});
+        }
+
+        return result;
+    }
+
+    int TTFont::getKerning(char32_t first, char32_t second) const
+    {
+        const auto key = (static_cast<std::uint64_t>(first) << 32) | second;
+
+        if (const auto i = kerningPairs.find(key); i != kerningPairs.end())
+            return i->second;
+
+        const auto kerning = stbtt_GetCodepointKernAdvance(font.get(),
+                                                           static_cast<int>(first),
+                                                           static_cast<int>(second));
+        kerningPairs[key] = kerning;
+        return kerning;
     }
 }
@@ -3,6 +3,8 @@
 #ifndef OUZEL_GUI_TTFONT_HPP
 #define OUZEL_GUI_TTFONT_HPP
 
+#include <cstdint>
+#include <unordered_map>
 #include "../gui/Font.hpp"
 
 struct stbtt_fontinfo;
@@ -14,6 +16,7 @@ namespace ouzel::gui
     public:
         TTFont() = default;
         TTFont(const std::vector<std::byte>& newData, bool newMipmaps = true);
+        ~TTFont() override;
 
         RenderData getRenderData(const std::string& text,
                                  Color color,
@@ -23,9 +26,13 @@ namespace ouzel::gui
         float getStringWidth(const std::string& text);
 
     private:
+        // unscaled kerning of the pair of codepoints
+        int getKerning(char32_t first, char32_t second) const;
+
         std::unique_ptr<stbtt_fontinfo> font;
         std::vector<std::byte> data;
-        bool mipmaps = true;
+        bool mipmaps = true; // unused, the glyphs are packed into the pages of the glyph atlas without mipmaps
+        mutable std::unordered_map<std::uint64_t, int> kerningPairs;
     };
 }
 
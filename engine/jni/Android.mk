@@ -30,13 +30,18 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../assets/ParticleSystemLoader.cpp \
     ../assets/SpriteLoader.cpp \
     ../assets/TtfLoader.cpp \
+    ../assets/SdfLoader.cpp \
     ../assets/VorbisLoader.cpp \
     ../assets/WaveLoader.cpp \
     ../audio/mixer/Bus.cpp \
+    ../audio/mixer/ChannelMatrix.cpp \
+    ../audio/mixer/Resampler.cpp \
+    ../audio/mixer/AllocationGuard.cpp \
     ../audio/mixer/Mixer.cpp \
     ../audio/opensl/OSLAudioDevice.cpp \
     ../audio/Audio.cpp \
     ../audio/AudioDevice.cpp \
+    ../audio/SampleConverter.cpp \
     ../audio/Containers.cpp \
     ../audio/Cue.cpp \
     ../audio/Effect.cpp \
@@ -71,13 +76,19 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../graphics/BlendState.cpp \
     ../graphics/Buffer.cpp \
     ../graphics/DepthStencilState.cpp \
+    ../graphics/FrameCapture.cpp \
     ../graphics/Graphics.cpp \
     ../graphics/RenderDevice.cpp \
+    ../graphics/software/SoftwareRasterizer.cpp \
+    ../graphics/software/SoftwareRenderDevice.cpp \
+    ../graphics/software/SoftwareTexture.cpp \
     ../graphics/RenderTarget.cpp \
     ../graphics/Shader.cpp \
     ../graphics/Texture.cpp \
     ../gui/BMFont.cpp \
     ../gui/TTFont.cpp \
+    ../gui/SdfFont.cpp \
+    ../gui/GlyphAtlas.cpp \
     ../gui/Widget.cpp \
     ../gui/Widgets.cpp \
     ../input/android/GamepadDeviceAndroid.cpp \
@@ -104,6 +115,7 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../scene/Animators.cpp \
     ../scene/Camera.cpp \
     ../scene/Component.cpp \
+    ../scene/DrawQueue.cpp \
     ../scene/Layer.cpp \
     ../scene/Light.cpp \
     ../scene/ParticleSystem.cpp \
@@ -111,9 +123,14 @@ LOCAL_SRC_FILES := ../assets/BmfLoader.cpp \
     ../scene/SceneManager.cpp \
     ../scene/ShapeRenderer.cpp \
     ../scene/SkinnedMeshRenderer.cpp \
+    ../scene/SpatialIndex.cpp \
     ../scene/SpriteRenderer.cpp \
+    ../scene/SpriteBatch.cpp \
+    ../scene/MeshBatch.cpp \
     ../scene/StaticMeshRenderer.cpp \
     ../scene/TextRenderer.cpp \
+    ../scene/TransformHierarchy.cpp \
+    ../scene/UpdateScheduler.cpp \
     ../storage/FileSystem.cpp \
     ../utils/Log.cpp
 
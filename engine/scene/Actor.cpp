@@ -18,6 +18,7 @@ namespace ouzel::scene
             if (entered) actor->leave();
             actor->parent = nullptr;
             actor->setLayer(nullptr);
+            actor->setTransformHierarchy(nullptr);
         }
     }
 
@@ -36,6 +37,7 @@ namespace ouzel::scene
 
         actor.parent = this;
         actor.setLayer(layer);
+        actor.setTransformHierarchy(&getTransformHierarchy());
         if (entered) actor.enter();
         children.push_back(&actor);
     }
@@ -51,6 +53,7 @@ namespace ouzel::scene
             if (entered) child->leave();
             child->parent = nullptr;
             child->setLayer(nullptr);
+            child->setTransformHierarchy(nullptr);
             children.erase(childIterator);
 
             result = true;
@@ -89,6 +92,7 @@ namespace ouzel::scene
         if (const auto i = std::find(children.begin(), children.end(), &actor); i != children.end())
         {
             std::rotate(children.begin(), i, i + 1);
+            if (transformHierarchy) transformHierarchy->setOrderChanged();
             return true;
         }
 
@@ -100,6 +104,7 @@ namespace ouzel::scene
         if (const auto i = std::find(children.begin(), children.end(), &actor); i != children.end())
         {
             std::rotate(i, i + 1, children.end());
+            if (transformHierarchy) transformHierarchy->setOrderChanged();
             return true;
         }
 
@@ -112,6 +117,7 @@ namespace ouzel::scene
         {
             if (entered) actor->leave();
             actor->parent = nullptr;
+            actor->setTransformHierarchy(nullptr);
         }
 
         children.clear();
@@ -155,6 +161,17 @@ namespace ouzel::scene
             actor->setLayer(layer);
     }
 
+    TransformHierarchy& ActorContainer::getTransformHierarchy() const
+    {
+        if (!transformHierarchy)
+        {
+            ownedTransformHierarchy = std::make_unique<TransformHierarchy>();
+            transformHierarchy = ownedTransformHierarchy.get();
+        }
+
+        return *transformHierarchy;
+    }
+
     std::vector<std::pair<Actor*, Vector<float, 3>>> ActorContainer::findActors(const Vector<float, 2>& position) const
     {
         std::vector<std::pair<Actor*, Vector<float, 3>>> actors;
@@ -237,9 +254,7 @@ namespace ouzel::scene
             component->setActor(nullptr);
     }
 
-    void Actor::visit(std::vector<Actor*>& drawQueue,
-                      const Matrix<float, 4>& newParentTransform,
-                      bool parentTransformDirty,
+    void Actor::visit(DrawQueue& drawQueue,
                       Camera* camera,
                       Order parentOrder,
                       bool parentHidden)
@@ -247,34 +262,47 @@ namespace ouzel::scene
         worldOrder = parentOrder + order;
         worldHidden = parentHidden || hidden;
 
-        if (parentTransformDirty) updateTransform(newParentTransform);
-        if (transformDirty) calculateTransform();
+        if (!worldHidden && checkVisibility(*camera))
+            drawQueue.add(this, worldOrder, getSortKey());
 
-        if (!worldHidden)
-        {
-            const auto boundingBox = getBoundingBox();
+        for (const auto actor : children)
+            actor->visit(drawQueue, camera, worldOrder, worldHidden);
+    }
 
-            if (cullDisabled || (!boundingBox.isEmpty() && camera->checkVisibility(getTransform(), boundingBox)))
-            {
-                const auto upperBound = std::upper_bound(drawQueue.begin(), drawQueue.end(), this,
-                                                         [](const auto a, const auto b) noexcept {
-                                                             return a->worldOrder > b->worldOrder;
-                                                         });
+    void Actor::calculateWorldOrder()
+    {
+        worldOrder = 0;
+        worldHidden = false;
 
-                drawQueue.insert(upperBound, this);
-            }
+        // the actors in the layer are always in its transform hierarchy
+        for (auto index = transformIndex; index != TransformHierarchy::noIndex; index = transformHierarchy->getParent(index))
+        {
+            const auto actor = transformHierarchy->getActor(index);
+            worldOrder += actor->order;
+            worldHidden = worldHidden || actor->hidden;
         }
+    }
 
-        for (const auto actor : children)
-            actor->visit(drawQueue, transform, updateChildrenTransform, camera, worldOrder, worldHidden);
+    bool Actor::checkVisibility(const Camera& camera) const
+    {
+        if (cullDisabled) return true;
 
-        updateChildrenTransform = false;
+        const auto boundingBox = getBoundingBox();
+        return !boundingBox.isEmpty() && camera.checkVisibility(getTransform(), boundingBox);
+    }
+
+    std::uint32_t Actor::getSortKey() const noexcept
+    {
+        for (const auto component : components)
+            if (!component->isHidden())
+                return component->getSortKey();
+
+        return 0;
     }
 
     void Actor::draw(Camera* camera, bool wireframe)
     {
-        if (transformDirty)
-            calculateTransform();
+        const auto& transform = getTransform();
 
         for (const auto component : components)
             if (!component->isHidden())
@@ -284,13 +312,6 @@ namespace ouzel::scene
                                 wireframe);
     }
 
-    void Actor::addChild(Actor& actor)
-    {
-        ActorContainer::addChild(actor);
-
-        actor.updateTransform(getTransform());
-    }
-
     void Actor::setPosition(const Vector<float, 2>& newPosition)
     {
         position.v[0] = newPosition.v[0];
@@ -405,19 +426,62 @@ namespace ouzel::scene
         return false;
     }
 
+    TransformHierarchy& Actor::getTransformHierarchy() const
+    {
+        // a detached actor without children is the root of its own hierarchy
+        if (!transformHierarchy)
+        {
+            ownedTransformHierarchy = std::make_unique<TransformHierarchy>();
+            setTransformHierarchy(ownedTransformHierarchy.get());
+        }
+
+        return *transformHierarchy;
+    }
+
+    void Actor::setTransformHierarchy(TransformHierarchy* newTransformHierarchy) const
+    {
+        if (transformHierarchy == newTransformHierarchy) return;
+
+        if (transformHierarchy) transformHierarchy->remove(transformIndex);
+
+        transformHierarchy = newTransformHierarchy;
+        transformIndex = transformHierarchy ?
+            transformHierarchy->add(*this, parent ? parent->transformIndex : TransformHierarchy::noIndex) :
+            TransformHierarchy::noIndex;
+
+        for (const auto actor : children)
+            actor->setTransformHierarchy(newTransformHierarchy);
+
+        if (ownedTransformHierarchy && ownedTransformHierarchy.get() != transformHierarchy)
+            ownedTransformHierarchy.reset();
+
+        if (transformHierarchy) updateTransform();
+    }
+
     void Actor::updateLocalTransform()
     {
-        localTransformDirty = transformDirty = inverseTransformDirty = true;
-        for (const auto component : components)
-            component->updateTransform();
+        if (transformHierarchy) transformHierarchy->setLocalTransformDirty(transformIndex);
+        updateTransform();
     }
 
-    void Actor::updateTransform(const Matrix<float, 4>& newParentTransform)
+    void Actor::updateTransform() const
     {
-        parentTransform = newParentTransform;
-        transformDirty = inverseTransformDirty = true;
         for (const auto component : components)
             component->updateTransform();
+
+        if (spatialIndex) spatialIndex->updateActor(*this);
+    }
+
+    void Actor::updateBoundingBox() const
+    {
+        if (spatialIndex) spatialIndex->updateActor(*this);
+    }
+
+    void Actor::setCullDisabled(bool newCullDisabled)
+    {
+        cullDisabled = newCullDisabled;
+
+        updateBoundingBox();
     }
 
     Vector<float, 3> Actor::getWorldPosition() const
@@ -449,14 +513,14 @@ namespace ouzel::scene
         return worldPosition;
     }
 
-    void Actor::calculateLocalTransform() const
+    void Actor::calculateLocalTransform(Matrix<float, 4>& result) const
     {
-        localTransform.setTranslation(position);
+        result.setTranslation(position);
 
         Matrix<float, 4> rotationMatrix;
         rotationMatrix.setRotation(rotation);
 
-        localTransform *= rotationMatrix;
+        result *= rotationMatrix;
 
         const auto finalScale = Vector<float, 3>{
             scale.v[0] * (flipX ? -1.0F : 1.0F),
@@ -467,24 +531,7 @@ namespace ouzel::scene
         Matrix<float, 4> scaleMatrix;
         scaleMatrix.setScale(finalScale);
 
-        localTransform *= scaleMatrix;
-
-        localTransformDirty = false;
-    }
-
-    void Actor::calculateTransform() const
-    {
-        transform = parentTransform * getLocalTransform();
-        transformDirty = false;
-
-        updateChildrenTransform = true;
-    }
-
-    void Actor::calculateInverseTransform() const
-    {
-        inverseTransform = getTransform();
-        inverseTransform.invert();
-        inverseTransformDirty = false;
+        result *= scaleMatrix;
     }
 
     void Actor::removeFromParent()
@@ -505,6 +552,8 @@ namespace ouzel::scene
 
         component.setActor(this);
         components.push_back(&component);
+
+        updateBoundingBox();
     }
 
     bool Actor::removeComponent(Component& component)
@@ -518,6 +567,8 @@ namespace ouzel::scene
             component.setActor(nullptr);
             components.erase(componentIterator);
             result = true;
+
+            updateBoundingBox();
         }
 
         const auto ownedComponentIterator = std::find_if(ownedComponents.begin(), ownedComponents.end(), [&component](const auto& ownedComponent) noexcept {
@@ -536,14 +587,22 @@ namespace ouzel::scene
 
         components.clear();
         ownedComponents.clear();
+
+        updateBoundingBox();
     }
 
     void Actor::setLayer(Layer* newLayer)
     {
+        if (spatialIndex) spatialIndex->removeActor(*this);
+
         ActorContainer::setLayer(newLayer);
 
         for (const auto component : components)
             component->setLayer(newLayer);
+
+        if (layer)
+            if (const auto layerSpatialIndex = layer->getSpatialIndex())
+                layerSpatialIndex->addActor(*this);
     }
 
     Box<float, 3> Actor::getBoundingBox() const
@@ -5,6 +5,9 @@
 
 #include <memory>
 #include <vector>
+#include "DrawQueue.hpp"
+#include "SpatialIndex.hpp"
+#include "TransformHierarchy.hpp"
 #include "../math/Box.hpp"
 #include "../math/Color.hpp"
 #include "../math/Matrix.hpp"
@@ -21,6 +24,8 @@ namespace ouzel::scene
 
     class ActorContainer
     {
+        friend Actor;
+        friend TransformHierarchy;
     public:
         ActorContainer() = default;
         virtual ~ActorContainer();
@@ -44,8 +49,8 @@ namespace ouzel::scene
 
         auto getLayer() const noexcept { return layer; }
 
-        std::vector<std::pair<Actor*, Vector<float, 3>>> findActors(const Vector<float, 2>& position) const;
-        std::vector<Actor*> findActors(const std::vector<Vector<float, 2>>& edges) const;
+        virtual std::vector<std::pair<Actor*, Vector<float, 3>>> findActors(const Vector<float, 2>& position) const;
+        virtual std::vector<Actor*> findActors(const std::vector<Vector<float, 2>>& edges) const;
 
     protected:
         virtual void setLayer(Layer* newLayer);
@@ -53,26 +58,35 @@ namespace ouzel::scene
         virtual void enter();
         virtual void leave();
 
+        // creates the hierarchy if this is the topmost container
+        virtual TransformHierarchy& getTransformHierarchy() const;
+
         std::vector<Actor*> children;
         std::vector<std::unique_ptr<Actor>> ownedChildren;
 
         Layer* layer = nullptr;
         bool entered = false;
+
+        // shared by all of the actors below the topmost container, which owns it
+        mutable TransformHierarchy* transformHierarchy = nullptr;
+        mutable std::unique_ptr<TransformHierarchy> ownedTransformHierarchy;
+        mutable TransformHierarchy::Index transformIndex = TransformHierarchy::noIndex;
     };
 
     class Actor: public ActorContainer
     {
         friend ActorContainer;
+        friend Component;
         friend Layer;
+        friend SpatialIndex;
+        friend TransformHierarchy;
     public:
         using Order = std::int32_t;
 
         Actor() = default;
         ~Actor() override;
 
-        virtual void visit(std::vector<Actor*>& drawQueue,
-                           const Matrix<float, 4>& newParentTransform,
-                           bool parentTransformDirty,
+        virtual void visit(DrawQueue& drawQueue,
                            Camera* camera,
                            Order parentOrder,
                            bool parentHidden);
@@ -107,7 +121,7 @@ namespace ouzel::scene
         virtual void setPickable(bool newPickable) { pickable = newPickable; }
 
         virtual bool isCullDisabled() const noexcept { return cullDisabled; }
-        virtual void setCullDisabled(bool newCullDisabled) { cullDisabled = newCullDisabled; }
+        virtual void setCullDisabled(bool newCullDisabled);
 
         virtual bool isHidden() const noexcept { return hidden; }
         virtual void setHidden(bool newHidden);
@@ -118,23 +132,17 @@ namespace ouzel::scene
 
         auto& getLocalTransform() const
         {
-            if (localTransformDirty) calculateLocalTransform();
-
-            return localTransform;
+            return getTransformHierarchy().getLocalTransform(transformIndex);
         }
 
         auto& getTransform() const
         {
-            if (transformDirty) calculateTransform();
-
-            return transform;
+            return getTransformHierarchy().getTransform(transformIndex);
         }
 
         auto& getInverseTransform() const
         {
-            if (inverseTransformDirty) calculateInverseTransform();
-
-            return inverseTransform;
+            return getTransformHierarchy().getInverseTransform(transformIndex);
         }
 
         Vector<float, 3> getWorldPosition() const;
@@ -146,8 +154,6 @@ namespace ouzel::scene
         auto getParent() const noexcept { return parent; }
         void removeFromParent();
 
-        void addChild(Actor& actor) override;
-
         void addComponent(std::unique_ptr<Component> component);
         void addComponent(Component& component);
         bool removeComponent(Component& component);
@@ -160,23 +166,21 @@ namespace ouzel::scene
     protected:
         void setLayer(Layer* newLayer) override;
 
-        void updateLocalTransform();
-        void updateTransform(const Matrix<float, 4>& newParentTransform);
-
-        virtual void calculateLocalTransform() const;
-        virtual void calculateTransform() const;
+        TransformHierarchy& getTransformHierarchy() const override;
+        // moves the actor and its children to the hierarchy of the new topmost container
+        void setTransformHierarchy(TransformHierarchy* newTransformHierarchy) const;
 
-        virtual void calculateInverseTransform() const;
+        void updateLocalTransform();
+        // notifies the components and the spatial index about the change of the world transform
+        void updateTransform() const;
+        void updateBoundingBox() const;
 
-        Matrix<float, 4> parentTransform;
-        mutable Matrix<float, 4> transform;
-        mutable Matrix<float, 4> inverseTransform;
-        mutable Matrix<float, 4> localTransform;
+        // used instead of visit when the actors are found with the spatial index of the layer
+        void calculateWorldOrder();
+        bool checkVisibility(const Camera& camera) const;
+        std::uint32_t getSortKey() const noexcept;
 
-        mutable bool transformDirty = true;
-        mutable bool inverseTransformDirty = true;
-        mutable bool localTransformDirty = true;
-        mutable bool updateChildrenTransform = true;
+        virtual void calculateLocalTransform(Matrix<float, 4>& result) const;
 
         bool flipX = false;
         bool flipY = false;
@@ -195,6 +199,9 @@ namespace ouzel::scene
 
         ActorContainer* parent = nullptr;
 
+        mutable SpatialIndex* spatialIndex = nullptr;
+        mutable std::uint32_t spatialIndexEntry = 0;
+
         std::vector<Component*> components;
         std::vector<std::unique_ptr<Component>> ownedComponents;
 
@@ -11,14 +11,12 @@ namespace ouzel::scene
     Animator::Animator(float initLength):
         length{initLength}
     {
-        updateHandler.updateHandler = [this](const UpdateEvent& event) {
-            update(event.delta);
-            return false;
-        };
     }
 
     Animator::~Animator()
     {
+        engine->getUpdateScheduler().removeAnimator(*this);
+
         if (parent) parent->removeAnimator(*this);
 
         for (const auto& animator : animators)
@@ -55,12 +53,12 @@ namespace ouzel::scene
             updateProgress();
         }
         else
-            updateHandler.remove();
+            engine->getUpdateScheduler().removeAnimator(*this);
     }
 
     void Animator::start()
     {
-        engine->getEventDispatcher().addEventHandler(updateHandler);
+        engine->getUpdateScheduler().addAnimator(*this);
         play();
 
         auto startEvent = std::make_unique<AnimationEvent>();
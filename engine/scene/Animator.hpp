@@ -6,13 +6,14 @@
 #include <memory>
 #include <vector>
 #include "Component.hpp"
-#include "../events/EventHandler.hpp"
+#include "UpdateScheduler.hpp"
 
 namespace ouzel::scene
 {
     class Animator: public Component
     {
         friend Actor;
+        friend UpdateScheduler;
     public:
         explicit Animator(float initLength);
         ~Animator() override;
@@ -57,7 +58,7 @@ namespace ouzel::scene
         Animator* parent = nullptr;
         Actor* targetActor = nullptr;
 
-        EventHandler updateHandler;
+        std::size_t updateIndex = UpdateScheduler::noIndex; // position in the list of the update scheduler
 
         std::vector<Animator*> animators;
         std::vector<std::unique_ptr<Animator>> ownedAnimators;
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <limits>
 #include "Camera.hpp"
 #include "Actor.hpp"
 #include "Layer.hpp"
@@ -267,6 +268,47 @@ namespace ouzel::scene
         }
     }
 
+    Box<float, 3> Camera::getFrustumBoundingBox() const
+    {
+        const Box<float, 3> unbounded{
+            Vector<float, 3>{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()},
+            Vector<float, 3>{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()}
+        };
+
+        const auto& inverse = getInverseViewProjection();
+        Box<float, 3> result;
+
+        // corners of the clip space, the depth is in the range [0, 1]
+        for (std::size_t corner = 0; corner < 8; ++corner)
+        {
+            Vector<float, 4> worldPosition;
+            inverse.transformVector(Vector<float, 4>{
+                (corner & 1) ? 1.0F : -1.0F,
+                (corner & 2) ? 1.0F : -1.0F,
+                (corner & 4) ? 1.0F : 0.0F,
+                1.0F
+            }, worldPosition);
+
+            // the frustum is not bounded if the corner is at the infinity
+            if (worldPosition.v[3] <= 0.0F) return unbounded;
+
+            result.insertPoint(Vector<float, 3>{
+                worldPosition.v[0] / worldPosition.v[3],
+                worldPosition.v[1] / worldPosition.v[3],
+                worldPosition.v[2] / worldPosition.v[3]
+            });
+        }
+
+        // the orthographic visibility check ignores the depth
+        if (projectionMode == ProjectionMode::orthographic)
+        {
+            result.min.v[2] = unbounded.min.v[2];
+            result.max.v[2] = unbounded.max.v[2];
+        }
+
+        return result;
+    }
+
     void Camera::setViewport(const Rect<float>& newViewport)
     {
         viewport = newViewport;
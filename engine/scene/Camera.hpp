@@ -62,6 +62,8 @@ namespace ouzel::scene
         Vector<float, 2> convertWorldToNormalized(const Vector<float, 3>& worldPosition) const;
 
         bool checkVisibility(const Matrix<float, 4>& boxTransform, const Box<float, 3>& box) const;
+        // world space box that contains every box that passes checkVisibility
+        Box<float, 3> getFrustumBoundingBox() const;
 
         auto& getViewport() const noexcept { return viewport; }
         auto& getRenderViewport() const noexcept { return renderViewport; }
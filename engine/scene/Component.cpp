@@ -2,6 +2,7 @@
 
 #include "Component.hpp"
 #include "Actor.hpp"
+#include "Layer.hpp"
 #include "../math/MathUtils.hpp"
 
 namespace ouzel::scene
@@ -16,6 +17,19 @@ namespace ouzel::scene
                          const Matrix<float, 4>&,
                          bool)
     {
+        // sprites and meshes batched before this component must be drawn first
+        if (layer)
+        {
+            layer->getSpriteBatch().flush();
+            layer->getMeshBatch().flush();
+        }
+    }
+
+    void Component::setBoundingBox(const Box<float, 3>& newBoundingBox)
+    {
+        boundingBox = newBoundingBox;
+
+        updateBoundingBox();
     }
 
     bool Component::pointOn(const Vector<float, 2>& position) const
@@ -112,4 +126,9 @@ namespace ouzel::scene
     void Component::updateTransform()
     {
     }
+
+    void Component::updateBoundingBox()
+    {
+        if (actor) actor->updateBoundingBox();
+    }
 }
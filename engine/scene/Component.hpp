@@ -3,6 +3,7 @@
 #ifndef OUZEL_SCENE_COMPONENT_HPP
 #define OUZEL_SCENE_COMPONENT_HPP
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "../math/Box.hpp"
@@ -35,7 +36,10 @@ namespace ouzel::scene
                           bool wireframe);
 
         virtual const Box<float, 3>& getBoundingBox() const noexcept { return boundingBox; }
-        virtual void setBoundingBox(const Box<float, 3>& newBoundingBox) { boundingBox = newBoundingBox; }
+        virtual void setBoundingBox(const Box<float, 3>& newBoundingBox);
+
+        // components that render with the same state return the same key, so that the draw queue can group them
+        virtual std::uint32_t getSortKey() const noexcept { return 0; }
 
         virtual bool pointOn(const Vector<float, 2>& position) const;
         virtual bool shapeOverlaps(const std::vector<Vector<float, 2>>& edges) const;
@@ -50,6 +54,8 @@ namespace ouzel::scene
         virtual void setActor(Actor* newActor);
         virtual void setLayer(Layer* newLayer);
         virtual void updateTransform();
+        // must be called after the bounding box changes
+        void updateBoundingBox();
 
         Box<float, 3> boundingBox;
         bool hidden = false;
@@ -0,0 +1,49 @@
+// Ouzel by Elviss Strazdins
+
+#include <array>
+#include <cstddef>
+#include "DrawQueue.hpp"
+
+namespace ouzel::scene
+{
+    void DrawQueue::sort(bool sortByMaterial)
+    {
+        if (entries.size() < 2) return;
+
+        constexpr std::size_t digitBits = 8;
+        constexpr std::size_t digitCount = 64 / digitBits;
+        constexpr std::size_t bucketCount = 1 << digitBits;
+
+        // the least significant radix sort, the histograms of all of the digits are built in one pass
+        std::array<std::array<std::size_t, bucketCount>, digitCount> histograms{};
+
+        for (const auto& entry : entries)
+            for (std::size_t digit = 0; digit < digitCount; ++digit)
+                ++histograms[digit][(entry.key >> (digit * digitBits)) & (bucketCount - 1)];
+
+        sortBuffer.resize(entries.size());
+
+        for (std::size_t digit = sortByMaterial ? 0 : digitCount / 2; digit < digitCount; ++digit)
+        {
+            auto& histogram = histograms[digit];
+            const auto shift = digit * digitBits;
+
+            // skip the digits that are the same for all of the entries (e.g. the high bits of the order)
+            if (histogram[(entries.front().key >> shift) & (bucketCount - 1)] == entries.size())
+                continue;
+
+            std::size_t offset = 0;
+            for (auto& count : histogram)
+            {
+                const auto bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+
+            for (const auto& entry : entries)
+                sortBuffer[histogram[(entry.key >> shift) & (bucketCount - 1)]++] = entry;
+
+            entries.swap(sortBuffer);
+        }
+    }
+}
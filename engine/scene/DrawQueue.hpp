@@ -0,0 +1,49 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SCENE_DRAWQUEUE_HPP
+#define OUZEL_SCENE_DRAWQUEUE_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace ouzel::scene
+{
+    class Actor;
+
+    // collects the visible actors of a camera and sorts them in linear time,
+    // the memory is reused between cameras and frames
+    class DrawQueue final
+    {
+    public:
+        struct Entry final
+        {
+            Actor* actor = nullptr;
+            std::uint64_t key = 0; // world order in the high 32 bits and the sort key of the material in the low 32 bits
+        };
+
+        void clear() noexcept { entries.clear(); }
+
+        void add(Actor* actor, std::int32_t worldOrder, std::uint32_t materialKey)
+        {
+            // flip the sign bit and invert the order, so that the actors with a higher order are drawn first
+            const auto orderKey = ~(static_cast<std::uint32_t>(worldOrder) ^ 0x80000000U);
+            entries.push_back(Entry{actor, (static_cast<std::uint64_t>(orderKey) << 32) | materialKey});
+        }
+
+        // stable, so the actors with equal keys are drawn in the order they were added,
+        // the material is ignored unless sortByMaterial is set
+        void sort(bool sortByMaterial);
+
+        auto begin() const noexcept { return entries.begin(); }
+        auto end() const noexcept { return entries.end(); }
+
+        auto size() const noexcept { return entries.size(); }
+        auto empty() const noexcept { return entries.empty(); }
+
+    private:
+        std::vector<Entry> entries;
+        std::vector<Entry> sortBuffer;
+    };
+}
+
+#endif // OUZEL_SCENE_DRAWQUEUE_HPP
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <algorithm>
+#include <limits>
 #include "Layer.hpp"
 #include "Actor.hpp"
 #include "Camera.hpp"
@@ -21,32 +22,85 @@ namespace ouzel::scene
     Layer::~Layer()
     {
         if (scene) scene->removeLayer(*this);
+
+        // the actors are removed from the layer after the index is destroyed
+        spatialIndex.reset();
+    }
+
+    void Layer::updateTransforms()
+    {
+        getTransformHierarchy().update();
+    }
+
+    void Layer::notifyTransforms()
+    {
+        getTransformHierarchy().notifyActors();
+    }
+
+    void Layer::cull()
+    {
+        // the actors moved by the notified components are recorded here and notified with the next update
+        getTransformHierarchy().update();
+        if (spatialIndex) spatialIndex->update();
+
+        if (drawQueues.size() < cameras.size()) drawQueues.resize(cameras.size());
+
+        for (std::size_t i = 0; i < cameras.size(); ++i)
+        {
+            const auto camera = cameras[i];
+            auto& drawQueue = drawQueues[i];
+            drawQueue.clear();
+
+            if (spatialIndex)
+            {
+                findIndexedActors(camera->getFrustumBoundingBox());
+
+                for (const auto actor : indexedActors)
+                {
+                    actor->calculateWorldOrder();
+
+                    if (!actor->worldHidden && actor->checkVisibility(*camera))
+                        drawQueue.add(actor, actor->worldOrder, actor->getSortKey());
+                }
+            }
+            else
+                for (const auto actor : children)
+                    actor->visit(drawQueue, camera, 0, false);
+
+            drawQueue.sort(materialSorting);
+        }
+
+        culled = true;
     }
 
     void Layer::draw()
     {
-        for (const auto camera : cameras)
+        if (!culled || drawQueues.size() < cameras.size())
         {
-            std::vector<Actor*> drawQueue;
+            updateTransforms();
+            notifyTransforms();
+            cull();
+        }
+        culled = false;
 
-            for (const auto actor : children)
-                actor->visit(drawQueue, Matrix<float, 4>::identity(), false, camera, 0, false);
+        spriteBatch.reset();
+        meshBatch.reset();
+
+        for (std::size_t i = 0; i < cameras.size(); ++i)
+        {
+            const auto camera = cameras[i];
 
             engine->getGraphics()->setRenderTarget(camera->getRenderTarget() ? camera->getRenderTarget()->getResource() : 0);
             engine->getGraphics()->setViewport(camera->getRenderViewport());
             engine->getGraphics()->setDepthStencilState(camera->getDepthStencilState() ? camera->getDepthStencilState()->getResource() : 0,
                                                         camera->getStencilReferenceValue());
 
-            for (const auto actor : drawQueue)
-                actor->draw(camera, camera->getWireframe());
-        }
-    }
+            for (const auto& entry : drawQueues[i])
+                entry.actor->draw(camera, camera->getWireframe());
 
-    void Layer::addChild(Actor& actor)
-    {
-        ActorContainer::addChild(actor);
-
-        actor.updateTransform(Matrix<float, 4>::identity());
+            spriteBatch.flush();
+            meshBatch.flush();
+        }
     }
 
     void Layer::addCamera(Camera& camera)
@@ -131,6 +185,114 @@ namespace ouzel::scene
         return result;
     }
 
+    std::vector<std::pair<Actor*, Vector<float, 3>>> Layer::findActors(const Vector<float, 2>& position) const
+    {
+        if (!spatialIndex) return ActorContainer::findActors(position);
+
+        updateSpatialIndex();
+
+        findIndexedActors(Box<float, 3>{
+            Vector<float, 3>{position.v[0], position.v[1], std::numeric_limits<float>::lowest()},
+            Vector<float, 3>{position.v[0], position.v[1], std::numeric_limits<float>::max()}
+        });
+
+        std::vector<std::pair<Actor*, Vector<float, 3>>> actors;
+
+        // the actors later in the hierarchy are in front of the ones with the same order
+        for (auto i = indexedActors.rbegin(); i != indexedActors.rend(); ++i)
+        {
+            Actor* actor = *i;
+            actor->calculateWorldOrder();
+
+            if (!actor->worldHidden && actor->isPickable() && actor->pointOn(position))
+                actors.emplace_back(actor, actor->convertWorldToLocal(Vector<float, 3>{position}));
+        }
+
+        std::stable_sort(actors.begin(), actors.end(), [](const auto& a, const auto& b) noexcept {
+            return a.first->worldOrder < b.first->worldOrder;
+        });
+
+        return actors;
+    }
+
+    std::vector<Actor*> Layer::findActors(const std::vector<Vector<float, 2>>& edges) const
+    {
+        if (!spatialIndex) return ActorContainer::findActors(edges);
+
+        updateSpatialIndex();
+
+        Box<float, 3> box;
+        for (const auto& edge : edges)
+            box.insertPoint(Vector<float, 3>{edge});
+
+        box.min.v[2] = std::numeric_limits<float>::lowest();
+        box.max.v[2] = std::numeric_limits<float>::max();
+
+        findIndexedActors(box);
+
+        std::vector<Actor*> actors;
+
+        for (auto i = indexedActors.rbegin(); i != indexedActors.rend(); ++i)
+        {
+            Actor* actor = *i;
+            actor->calculateWorldOrder();
+
+            if (!actor->worldHidden && actor->isPickable() && actor->shapeOverlaps(edges))
+                actors.push_back(actor);
+        }
+
+        std::stable_sort(actors.begin(), actors.end(), [](const auto a, const auto b) noexcept {
+            return a->worldOrder < b->worldOrder;
+        });
+
+        return actors;
+    }
+
+    void Layer::setSpatialIndexing(bool newSpatialIndexing)
+    {
+        if (newSpatialIndexing == isSpatialIndexing()) return;
+
+        if (newSpatialIndexing)
+        {
+            spatialIndex = std::make_unique<SpatialIndex>();
+
+            for (const auto actor : children)
+                addToSpatialIndex(*actor);
+        }
+        else
+            spatialIndex.reset();
+    }
+
+    void Layer::addToSpatialIndex(Actor& actor)
+    {
+        spatialIndex->addActor(actor);
+
+        for (const auto child : actor.getChildren())
+            addToSpatialIndex(*child);
+    }
+
+    void Layer::updateSpatialIndex() const
+    {
+        getTransformHierarchy().update();
+        getTransformHierarchy().notifyActors();
+        spatialIndex->update();
+    }
+
+    // the actors are sorted by their position in the traversal that the hierarchy update recorded,
+    // so they are drawn and picked with the same order like the traversal without the index
+    void Layer::findIndexedActors(const Box<float, 3>& box) const
+    {
+        indexedActors.clear();
+        spatialIndex->query(box, [this](Actor* actor) {
+            indexedActors.push_back(actor);
+        });
+
+        const auto& hierarchy = getTransformHierarchy();
+        std::sort(indexedActors.begin(), indexedActors.end(), [&hierarchy](const auto a, const auto b) noexcept {
+            return hierarchy.getTraversalIndex(a->transformIndex) < hierarchy.getTraversalIndex(b->transformIndex);
+        });
+    }
+
     void Layer::setOrder(std::int32_t newOrder)
     {
         order = newOrder;
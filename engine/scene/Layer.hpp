@@ -4,8 +4,13 @@
 #define OUZEL_SCENE_LAYER_HPP
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include "../scene/Actor.hpp"
+#include "../scene/DrawQueue.hpp"
+#include "../scene/SpatialIndex.hpp"
+#include "../scene/MeshBatch.hpp"
+#include "../scene/SpriteBatch.hpp"
 #include "../math/Vector.hpp"
 
 namespace ouzel::scene
@@ -27,21 +32,53 @@ namespace ouzel::scene
 
         virtual void draw();
 
-        void addChild(Actor& actor) override;
-
         auto& getCameras() const noexcept { return cameras; }
 
         std::pair<Actor*, Vector<float, 3>> pickActor(const Vector<float, 2>& position, bool renderTargets = false) const;
         std::vector<std::pair<Actor*, Vector<float, 3>>> pickActors(const Vector<float, 2>& position, bool renderTargets = false) const;
         std::vector<Actor*> pickActors(const std::vector<Vector<float, 2>>& edges, bool renderTargets = false) const;
 
+        std::vector<std::pair<Actor*, Vector<float, 3>>> findActors(const Vector<float, 2>& position) const override;
+        std::vector<Actor*> findActors(const std::vector<Vector<float, 2>>& edges) const override;
+
         auto getOrder() const noexcept { return order; }
         void setOrder(Order newOrder);
 
         auto getScene() const noexcept { return scene; }
         void removeFromScene();
 
+        auto isSpriteBatching() const noexcept { return spriteBatching; }
+        void setSpriteBatching(bool newSpriteBatching) { spriteBatching = newSpriteBatching; }
+        auto& getSpriteBatch() noexcept { return spriteBatch; }
+
+        // draws the consecutive actors with the same mesh and material with one instanced draw call
+        auto isMeshInstancing() const noexcept { return meshInstancing; }
+        void setMeshInstancing(bool newMeshInstancing) { meshInstancing = newMeshInstancing; }
+        auto& getMeshBatch() noexcept { return meshBatch; }
+
+        // draws the actors with the same order grouped by their material, so that more of them can be batched,
+        // the actors with the same order can overlap in a different order than they were added in
+        auto isMaterialSorting() const noexcept { return materialSorting; }
+        void setMaterialSorting(bool newMaterialSorting) { materialSorting = newMaterialSorting; }
+
+        // keeps the world bounding boxes of the actors in a tree, so that culling and picking
+        // do not have to visit every actor, worth it for the layers with many actors that are mostly off screen
+        auto isSpatialIndexing() const noexcept { return spatialIndex != nullptr; }
+        void setSpatialIndexing(bool newSpatialIndexing);
+        auto getSpatialIndex() const noexcept { return spatialIndex.get(); }
+
     protected:
+        // recalculates the world transforms of the actors, the scene updates its layers in parallel on the job system,
+        // so this must not touch anything outside of the layer
+        void updateTransforms();
+        // notifies the components of the actors whose world transform changed in updateTransforms,
+        // the components can touch anything (e.g. the panners send commands to the audio), so this is called on one thread
+        void notifyTransforms();
+
+        // finds the visible actors of every camera, the scene culls its layers in parallel on the job system,
+        // so this must not touch anything outside of the layer
+        virtual void cull();
+
         void addCamera(Camera& camera);
         void removeCamera(Camera& camera);
 
@@ -57,6 +94,24 @@ namespace ouzel::scene
         std::vector<Light*> lights;
 
         Order order = 0;
+
+        SpriteBatch spriteBatch;
+        bool spriteBatching = true;
+
+        MeshBatch meshBatch;
+        bool meshInstancing = true;
+
+        std::vector<DrawQueue> drawQueues; // one for every camera, kept between the frames
+        bool materialSorting = false;
+        bool culled = false;
+
+    private:
+        void addToSpatialIndex(Actor& actor);
+        void updateSpatialIndex() const;
+        void findIndexedActors(const Box<float, 3>& box) const;
+
+        std::unique_ptr<SpatialIndex> spatialIndex;
+        mutable std::vector<Actor*> indexedActors; // reused between the queries
     };
 }
 
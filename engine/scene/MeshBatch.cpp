@@ -0,0 +1,83 @@
+// Ouzel by Elviss Strazdins
+
+#include "MeshBatch.hpp"
+#include "../core/Engine.hpp"
+#include "../utils/Utils.hpp"
+
+namespace ouzel::scene
+{
+    void MeshBatch::reset()
+    {
+        instances.clear();
+        currentInstanceBuffer = 0;
+
+        // the shaders can be replaced in the cache between the frames
+        textureShader = engine->getCache().getShader(shaderTexture);
+        instancedShader = engine->getCache().getShader(shaderTextureInstanced);
+    }
+
+    void MeshBatch::draw(const graphics::Buffer& indexBuffer,
+                         std::uint32_t indexCount,
+                         std::uint32_t indexSize,
+                         const graphics::Buffer& vertexBuffer,
+                         const Matrix<float, 4>& modelViewProjection,
+                         float opacity,
+                         const graphics::Material& material,
+                         bool wireframe)
+    {
+        State newState;
+        newState.indexBuffer = indexBuffer.getResource();
+        newState.indexCount = indexCount;
+        newState.indexSize = indexSize;
+        newState.vertexBuffer = vertexBuffer.getResource();
+        newState.blendState = material.blendState->getResource();
+        for (std::size_t layer = 0; layer < graphics::Material::textureLayers; ++layer)
+            newState.textures[layer] = material.textures[layer] ? material.textures[layer]->getResource() : 0;
+        newState.cullMode = material.cullMode;
+        newState.wireframe = wireframe;
+        newState.color = {
+            material.diffuseColor.normR(),
+            material.diffuseColor.normG(),
+            material.diffuseColor.normB(),
+            material.diffuseColor.normA() * material.opacity
+        };
+
+        if (!instances.empty() && newState != state)
+            flush();
+
+        state = newState;
+
+        // the opacity of the actor is the only color that differs between the instances
+        instances.emplace_back(modelViewProjection, Color{1.0F, 1.0F, 1.0F, opacity});
+    }
+
+    void MeshBatch::flush()
+    {
+        if (instances.empty()) return;
+
+        graphics::Graphics& graphics = *engine->getGraphics();
+
+        if (currentInstanceBuffer == instanceBuffers.size())
+            instanceBuffers.emplace_back(graphics, graphics::BufferType::vertex, graphics::Flags::dynamic);
+
+        graphics::Buffer& instanceBuffer = instanceBuffers[currentInstanceBuffer++];
+        instanceBuffer.setData(instances.data(), static_cast<std::uint32_t>(getVectorSize(instances)));
+
+        graphics.setPipelineState(state.blendState,
+                                  instancedShader->getResource(),
+                                  state.cullMode,
+                                  state.wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
+        graphics.setShaderConstants({{state.color.data(), state.color.size()}}, {});
+        graphics.setTextures(std::vector<std::size_t>(state.textures.begin(), state.textures.end()));
+        graphics.drawInstanced(state.indexBuffer,
+                               state.indexCount,
+                               state.indexSize,
+                               state.vertexBuffer,
+                               instanceBuffer.getResource(),
+                               static_cast<std::uint32_t>(instances.size()),
+                               graphics::DrawMode::triangleList,
+                               0);
+
+        instances.clear();
+    }
+}
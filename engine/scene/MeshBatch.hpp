@@ -0,0 +1,92 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SCENE_MESHBATCH_HPP
+#define OUZEL_SCENE_MESHBATCH_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "../graphics/Buffer.hpp"
+#include "../graphics/Material.hpp"
+#include "../graphics/Vertex.hpp"
+#include "../math/Matrix.hpp"
+
+namespace ouzel::scene
+{
+    // merges consecutive draws of the same mesh with the same material into one instanced draw call,
+    // only the meshes drawn with the texture shader are instanced
+    class MeshBatch final
+    {
+    public:
+        MeshBatch() = default;
+
+        MeshBatch(const MeshBatch&) = delete;
+        MeshBatch& operator=(const MeshBatch&) = delete;
+
+        MeshBatch(MeshBatch&&) = delete;
+        MeshBatch& operator=(MeshBatch&&) = delete;
+
+        void reset();
+
+        // false if the device has no instanced shader or the material uses a custom shader
+        bool canDraw(const graphics::Material& material) const noexcept
+        {
+            return instancedShader && material.shader == textureShader;
+        }
+
+        void draw(const graphics::Buffer& indexBuffer,
+                  std::uint32_t indexCount,
+                  std::uint32_t indexSize,
+                  const graphics::Buffer& vertexBuffer,
+                  const Matrix<float, 4>& modelViewProjection,
+                  float opacity,
+                  const graphics::Material& material,
+                  bool wireframe);
+
+        void flush();
+
+    private:
+        struct State final
+        {
+            std::size_t indexBuffer = 0;
+            std::uint32_t indexCount = 0;
+            std::uint32_t indexSize = 0;
+            std::size_t vertexBuffer = 0;
+            std::size_t blendState = 0;
+            std::array<std::size_t, graphics::Material::textureLayers> textures{};
+            graphics::CullMode cullMode = graphics::CullMode::none;
+            bool wireframe = false;
+            std::array<float, 4> color{};
+
+            bool operator==(const State& other) const noexcept
+            {
+                return indexBuffer == other.indexBuffer &&
+                    indexCount == other.indexCount &&
+                    indexSize == other.indexSize &&
+                    vertexBuffer == other.vertexBuffer &&
+                    blendState == other.blendState &&
+                    textures == other.textures &&
+                    cullMode == other.cullMode &&
+                    wireframe == other.wireframe &&
+                    color == other.color;
+            }
+
+            bool operator!=(const State& other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        const graphics::Shader* textureShader = nullptr;
+        const graphics::Shader* instancedShader = nullptr;
+
+        State state;
+        std::vector<graphics::Instance> instances;
+
+        // every flush in a frame gets its own buffer, so that the data is uploaded only once per buffer
+        std::vector<graphics::Buffer> instanceBuffers;
+        std::size_t currentInstanceBuffer = 0;
+    };
+}
+
+#endif // OUZEL_SCENE_MESHBATCH_HPP
@@ -1,8 +1,15 @@
 // Ouzel by Elviss Strazdins
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <stdexcept>
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+#  include <arm_neon.h>
+#elif defined(__SSE__)
+#  include <xmmintrin.h>
+#endif
 #include "ParticleSystem.hpp"
 #include "SceneManager.hpp"
 #include "Actor.hpp"
@@ -18,19 +25,287 @@ namespace ouzel::scene
 {
     namespace
     {
-        constexpr float updateStep = 1.0F / 60.0F;
+        // number of particles updated by one job, a multiple of the width of the kernels
+        constexpr std::size_t chunkSize = 16384;
+
+        // the kernels process four particles at a time and the rest one by one, the vector and the scalar
+        // paths do the same operations in the same order, so the results do not depend on the path
+#if defined(__ARM_NEON__) && (defined(__arm64__) || defined(__aarch64__))
+        using Float4 = float32x4_t;
+        inline Float4 load(const float* data) noexcept { return vld1q_f32(data); }
+        inline void store(float* data, Float4 value) noexcept { vst1q_f32(data, value); }
+        inline Float4 set(float value) noexcept { return vdupq_n_f32(value); }
+        inline Float4 add(Float4 a, Float4 b) noexcept { return vaddq_f32(a, b); }
+        inline Float4 subtract(Float4 a, Float4 b) noexcept { return vsubq_f32(a, b); }
+        inline Float4 multiply(Float4 a, Float4 b) noexcept { return vmulq_f32(a, b); }
+        inline Float4 divide(Float4 a, Float4 b) noexcept { return vdivq_f32(a, b); }
+        inline Float4 squareRoot(Float4 a) noexcept { return vsqrtq_f32(a); }
+        inline Float4 minimum(Float4 a, Float4 b) noexcept { return vminq_f32(a, b); }
+        inline Float4 maximum(Float4 a, Float4 b) noexcept { return vmaxq_f32(a, b); }
+        inline Float4 negate(Float4 a) noexcept { return vnegq_f32(a); }
+        inline Float4 equal(Float4 a, Float4 b) noexcept { return vreinterpretq_f32_u32(vceqq_f32(a, b)); }
+        inline Float4 lessEqual(Float4 a, Float4 b) noexcept { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+        inline Float4 either(Float4 a, Float4 b) noexcept
+        {
+            return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+        }
+        inline Float4 select(Float4 mask, Float4 a, Float4 b) noexcept
+        {
+            return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+        }
+        inline float horizontalMinimum(Float4 a) noexcept { return vminvq_f32(a); }
+        inline float horizontalMaximum(Float4 a) noexcept { return vmaxvq_f32(a); }
+#  define OUZEL_PARTICLE_SIMD
+#elif defined(__SSE__)
+        using Float4 = __m128;
+        inline Float4 load(const float* data) noexcept { return _mm_loadu_ps(data); }
+        inline void store(float* data, Float4 value) noexcept { _mm_storeu_ps(data, value); }
+        inline Float4 set(float value) noexcept { return _mm_set1_ps(value); }
+        inline Float4 add(Float4 a, Float4 b) noexcept { return _mm_add_ps(a, b); }
+        inline Float4 subtract(Float4 a, Float4 b) noexcept { return _mm_sub_ps(a, b); }
+        inline Float4 multiply(Float4 a, Float4 b) noexcept { return _mm_mul_ps(a, b); }
+        inline Float4 divide(Float4 a, Float4 b) noexcept { return _mm_div_ps(a, b); }
+        inline Float4 squareRoot(Float4 a) noexcept { return _mm_sqrt_ps(a); }
+        inline Float4 minimum(Float4 a, Float4 b) noexcept { return _mm_min_ps(a, b); }
+        inline Float4 maximum(Float4 a, Float4 b) noexcept { return _mm_max_ps(a, b); }
+        inline Float4 negate(Float4 a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0F)); }
+        inline Float4 equal(Float4 a, Float4 b) noexcept { return _mm_cmpeq_ps(a, b); }
+        inline Float4 lessEqual(Float4 a, Float4 b) noexcept { return _mm_cmple_ps(a, b); }
+        inline Float4 either(Float4 a, Float4 b) noexcept { return _mm_or_ps(a, b); }
+        inline Float4 select(Float4 mask, Float4 a, Float4 b) noexcept
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+        inline float horizontalMinimum(Float4 a) noexcept
+        {
+            a = _mm_min_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+            a = _mm_min_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(a);
+        }
+        inline float horizontalMaximum(Float4 a) noexcept
+        {
+            a = _mm_max_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+            a = _mm_max_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_cvtss_f32(a);
+        }
+#  define OUZEL_PARTICLE_SIMD
+#endif
+
+        // values += deltas * step
+        void integrate(float* values, const float* deltas, float step, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+
+#if defined(OUZEL_PARTICLE_SIMD)
+            if (core::isSimdAvailable)
+            {
+                const auto s = set(step);
+                for (; i + 4 <= count; i += 4)
+                    store(values + i, add(load(values + i), multiply(load(deltas + i), s)));
+            }
+#endif
+
+            for (; i < count; ++i)
+                values[i] += deltas[i] * step;
+        }
+
+        // values = max(0, values + deltas * step)
+        void integrateNonNegative(float* values, const float* deltas, float step, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+
+#if defined(OUZEL_PARTICLE_SIMD)
+            if (core::isSimdAvailable)
+            {
+                const auto s = set(step);
+                const auto zero = set(0.0F);
+                for (; i + 4 <= count; i += 4)
+                    store(values + i, maximum(zero, add(load(values + i), multiply(load(deltas + i), s))));
+            }
+#endif
+
+            for (; i < count; ++i)
+                values[i] = std::max(0.0F, values[i] + deltas[i] * step);
+        }
+
+        // values -= step
+        void decrease(float* values, float step, std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+
+#if defined(OUZEL_PARTICLE_SIMD)
+            if (core::isSimdAvailable)
+            {
+                const auto s = set(step);
+                for (; i + 4 <= count; i += 4)
+                    store(values + i, subtract(load(values + i), s));
+            }
+#endif
+
+            for (; i < count; ++i)
+                values[i] -= step;
+        }
+
+        // moves the particles of a gravity emitter by the gravity and the radial and tangential accelerations,
+        // the positions are multiplied by zero when the y coordinate is not flipped like the original emitter did
+        void updateGravity(float* positionX, float* positionY,
+                           float* directionX, float* directionY,
+                           const float* radialAcceleration, const float* tangentialAcceleration,
+                           const Vector<float, 2>& gravity, float flip, float step,
+                           std::size_t count) noexcept
+        {
+            std::size_t i = 0;
+
+#if defined(OUZEL_PARTICLE_SIMD)
+            if (core::isSimdAvailable)
+            {
+                const auto zero = set(0.0F);
+                const auto one = set(1.0F);
+                const auto minLength = set(std::numeric_limits<float>::min());
+                const auto gravityX = set(gravity.v[0]);
+                const auto gravityY = set(gravity.v[1]);
+                const auto f = set(flip);
+                const auto s = set(step);
+
+                for (; i + 4 <= count; i += 4)
+                {
+                    const auto x = load(positionX + i);
+                    const auto y = load(positionY + i);
+
+                    // the position is normalized unless its squared length is one or its length is close to zero
+                    const auto squared = add(multiply(x, x), multiply(y, y));
+                    const auto length = squareRoot(squared);
+                    const auto multiplier = divide(one, length);
+                    const auto keep = either(equal(squared, one), lessEqual(length, minLength));
+                    const auto normalX = select(keep, x, multiply(x, multiplier));
+                    const auto normalY = select(keep, y, multiply(y, multiplier));
+
+                    // radial acceleration only for the particles on an axis
+                    const auto onAxis = either(equal(x, zero), equal(y, zero));
+                    const auto radialX = select(onAxis, normalX, zero);
+                    const auto radialY = select(onAxis, normalY, zero);
+
+                    const auto radial = load(radialAcceleration + i);
+                    const auto tangential = load(tangentialAcceleration + i);
+
+                    const auto accelerationX = multiply(add(add(multiply(radialX, radial), multiply(radialY, negate(tangential))), gravityX), s);
+                    const auto accelerationY = multiply(add(add(multiply(radialY, radial), multiply(radialX, tangential)), gravityY), s);
+
+                    const auto dx = add(load(directionX + i), accelerationX);
+                    const auto dy = add(load(directionY + i), accelerationY);
+                    store(directionX + i, dx);
+                    store(directionY + i, dy);
+
+                    store(positionX + i, add(x, multiply(multiply(dx, s), f)));
+                    store(positionY + i, add(y, multiply(multiply(dy, s), f)));
+                }
+            }
+#endif
+
+            for (; i < count; ++i)
+            {
+                const Vector<float, 2> position{positionX[i], positionY[i]};
+
+                Vector<float, 2> radial;
+                if (position.v[0] == 0.0F || position.v[1] == 0.0F)
+                    radial = position.normalized();
+
+                const float accelerationX = (radial.v[0] * radialAcceleration[i] + radial.v[1] * -tangentialAcceleration[i] + gravity.v[0]) * step;
+                const float accelerationY = (radial.v[1] * radialAcceleration[i] + radial.v[0] * tangentialAcceleration[i] + gravity.v[1]) * step;
+
+                directionX[i] += accelerationX;
+                directionY[i] += accelerationY;
+
+                positionX[i] += directionX[i] * step * flip;
+                positionY[i] += directionY[i] * step * flip;
+            }
+        }
+
+        // places the particles of a radius emitter on their circles, there are no vector instructions
+        // for the trigonometric functions, so only the angles and the radiuses are integrated in the kernels
+        void updateRadius(float* positionX, float* positionY,
+                          const float* angle, const float* radius,
+                          float flip, std::size_t count) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                positionX[i] = -std::cos(angle[i]) * radius[i];
+                positionY[i] = -std::sin(angle[i]) * radius[i] * flip;
+            }
+        }
+
+        Box<float, 2> getBounds(const float* positionX, const float* positionY, std::size_t count) noexcept
+        {
+            Vector<float, 2> min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+            Vector<float, 2> max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+            std::size_t i = 0;
+
+#if defined(OUZEL_PARTICLE_SIMD)
+            if (core::isSimdAvailable && count >= 4)
+            {
+                auto minX = load(positionX);
+                auto minY = load(positionY);
+                auto maxX = minX;
+                auto maxY = minY;
+
+                for (i = 4; i + 4 <= count; i += 4)
+                {
+                    const auto x = load(positionX + i);
+                    const auto y = load(positionY + i);
+                    minX = minimum(minX, x);
+                    minY = minimum(minY, y);
+                    maxX = maximum(maxX, x);
+                    maxY = maximum(maxY, y);
+                }
+
+                min = Vector<float, 2>{horizontalMinimum(minX), horizontalMinimum(minY)};
+                max = Vector<float, 2>{horizontalMaximum(maxX), horizontalMaximum(maxY)};
+            }
+#endif
+
+            for (; i < count; ++i)
+            {
+                min.v[0] = std::min(min.v[0], positionX[i]);
+                min.v[1] = std::min(min.v[1], positionY[i]);
+                max.v[0] = std::max(max.v[0], positionX[i]);
+                max.v[1] = std::max(max.v[1], positionY[i]);
+            }
+
+            return Box<float, 2>{min, max};
+        }
+    }
+
+    template <class Function>
+    void ParticleSystem::Particles::forEachAttribute(const Function& function)
+    {
+        for (auto attribute : {
+            &life, &positionX, &positionY,
+            &colorRed, &colorGreen, &colorBlue, &colorAlpha,
+            &deltaColorRed, &deltaColorGreen, &deltaColorBlue, &deltaColorAlpha,
+            &size, &deltaSize, &rotation, &deltaRotation,
+            &directionX, &directionY, &radialAcceleration, &tangentialAcceleration,
+            &angle, &radius, &degreesPerSecond, &deltaRadius
+        })
+            function(*attribute);
+    }
+
+    void ParticleSystem::Particles::resize(std::size_t newSize)
+    {
+        forEachAttribute([newSize](std::vector<float>& attribute) { attribute.resize(newSize); });
+    }
+
+    void ParticleSystem::Particles::move(std::size_t from, std::size_t to) noexcept
+    {
+        forEachAttribute([from, to](std::vector<float>& attribute) noexcept { attribute[to] = attribute[from]; });
     }
 
     ParticleSystem::ParticleSystem():
+        randomEngine{core::randomEngine()},
         shader{engine->getCache().getShader(shaderTexture)},
         blendState{engine->getCache().getBlendState(blendAlpha)}
     {
         whitePixelTexture = engine->getCache().getTexture(textureWhitePixel);
-
-        updateHandler.updateHandler = [this](const UpdateEvent& event) {
-            update(event.delta);
-            return false;
-        };
     }
 
     ParticleSystem::ParticleSystem(const ParticleSystemData& initParticleSystemData):
@@ -39,6 +314,11 @@ namespace ouzel::scene
         init(initParticleSystemData);
     }
 
+    ParticleSystem::~ParticleSystem()
+    {
+        engine->getUpdateScheduler().removeParticleSystem(*this);
+    }
+
     void ParticleSystem::draw(const Matrix<float, 4>& transformMatrix,
                               float opacity,
                               const Matrix<float, 4>& renderViewProjection,
@@ -67,172 +347,190 @@ namespace ouzel::scene
 
             const float colorVector[] = {1.0F, 1.0F, 1.0F, opacity};
 
-            std::vector<std::vector<float>> pixelShaderConstants(1);
-            pixelShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
-
-            std::vector<std::vector<float>> vertexShaderConstants(1);
-            vertexShaderConstants[0] = {std::begin(transform.m), std::end(transform.m)};
-
             engine->getGraphics()->setPipelineState(blendState->getResource(),
                                                     shader->getResource(),
                                                     graphics::CullMode::none,
                                                     wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
-            engine->getGraphics()->setShaderConstants(pixelShaderConstants,
-                                                      vertexShaderConstants);
+            engine->getGraphics()->setShaderConstants({{colorVector, std::size(colorVector)}},
+                                                      {{transform.m.data(), transform.m.size()}});
             engine->getGraphics()->setTextures({wireframe ? whitePixelTexture->getResource() : texture->getResource()});
             engine->getGraphics()->draw(indexBuffer->getResource(),
                                         particleCount * 6,
-                                        sizeof(std::uint16_t),
+                                        indexSize,
                                         vertexBuffer->getResource(),
                                         graphics::DrawMode::triangleList,
                                         0);
         }
     }
 
-    void ParticleSystem::update(float delta)
+    void ParticleSystem::prepareUpdate()
     {
-        timeSinceUpdate += delta;
+        if (actor)
+        {
+            emitterPosition = (particleSystemData.positionType == ParticleSystemData::PositionType::free) ?
+                Vector<float, 2>{actor->convertLocalToWorld(Vector<float, 3>{})} :
+                (particleSystemData.positionType == ParticleSystemData::PositionType::parent) ?
+                Vector<float, 2>{actor->convertLocalToWorld(Vector<float, 3>{}) - actor->getPosition()} :
+                (particleSystemData.positionType == ParticleSystemData::PositionType::grouped) ?
+                Vector<float, 2>{} :
+                throw std::runtime_error("Invalid position type");
 
-        bool needsBoundingBoxUpdate = false;
+            if (particleSystemData.positionType != ParticleSystemData::PositionType::grouped)
+                inverseTransform = actor->getInverseTransform();
+        }
+    }
 
-        while (timeSinceUpdate >= updateStep)
+    // called once for every fixed step of the update scheduler
+    void ParticleSystem::update(float delta)
+    {
+        if (running && particleSystemData.emissionRate > 0.0F)
         {
-            timeSinceUpdate -= updateStep;
+            const float rate = 1.0F / particleSystemData.emissionRate;
 
-            if (running && particleSystemData.emissionRate > 0.0F)
+            if (particleCount < particleSystemData.maxParticles)
             {
-                const float rate = 1.0F / particleSystemData.emissionRate;
-
-                if (particleCount < particleSystemData.maxParticles)
-                {
-                    emitCounter += updateStep;
-                    if (emitCounter < 0.0F)
-                        emitCounter = 0.0F;
-                }
+                emitCounter += delta;
+                if (emitCounter < 0.0F)
+                    emitCounter = 0.0F;
+            }
 
-                const auto emitCount = static_cast<std::uint32_t>(std::min(static_cast<float>(particleSystemData.maxParticles - particleCount), emitCounter / rate));
-                emitParticles(emitCount);
-                emitCounter -= rate * emitCount;
+            const auto emitCount = static_cast<std::uint32_t>(std::min(static_cast<float>(particleSystemData.maxParticles - particleCount), emitCounter / rate));
+            emitParticles(emitCount);
+            emitCounter -= rate * emitCount;
 
-                elapsed += updateStep;
-                if (elapsed < 0.0F)
-                    elapsed = 0.0F;
-                if (particleSystemData.duration >= 0.0F && particleSystemData.duration < elapsed)
-                {
-                    finished = true;
-                    stop();
-                }
-            }
-            else if (active && !particleCount)
+            elapsed += delta;
+            if (elapsed < 0.0F)
+                elapsed = 0.0F;
+            if (particleSystemData.duration >= 0.0F && particleSystemData.duration < elapsed)
             {
-                active = false;
-                updateHandler.remove();
+                finished = true;
+                stop();
+            }
+        }
+        else if (active && !particleCount)
+        {
+            // the system is removed from the scheduler and the event is dispatched by finishUpdate
+            active = false;
+            needsFinish = true;
+            return;
+        }
 
-                auto finishEvent = std::make_unique<AnimationEvent>();
-                finishEvent->type = Event::Type::animationFinish;
-                finishEvent->component = this;
-                engine->getEventDispatcher().dispatchEvent(std::move(finishEvent));
+        if (active)
+        {
+            updateParticles(delta);
+            calculateBoundingBox();
 
-                return;
-            }
+            needsMeshUpdate = true;
+        }
+    }
 
-            if (active)
+    void ParticleSystem::finishUpdate()
+    {
+        if (needsBoundingBoxUpdate)
+        {
+            updateBoundingBox();
+            needsBoundingBoxUpdate = false;
+        }
+
+        if (needsFinish)
+        {
+            needsFinish = false;
+            engine->getUpdateScheduler().removeParticleSystem(*this);
+
+            auto finishEvent = std::make_unique<AnimationEvent>();
+            finishEvent->type = Event::Type::animationFinish;
+            finishEvent->component = this;
+            engine->getEventDispatcher().dispatchEvent(std::move(finishEvent));
+        }
+    }
+
+    void ParticleSystem::updateParticles(float delta)
+    {
+        const float flip = particleSystemData.yCoordFlipped ? 1.0F : 0.0F;
+
+        // the chunks are the same for any number of workers, so the results are too
+        const auto updateChunk = [this, flip, delta](std::size_t chunk) {
+            const auto offset = chunk * chunkSize;
+            const auto count = std::min(chunkSize, particleCount - offset);
+
+            decrease(particles.life.data() + offset, delta, count);
+
+            if (particleSystemData.emitterType == ParticleSystemData::EmitterType::gravity)
+                updateGravity(particles.positionX.data() + offset, particles.positionY.data() + offset,
+                              particles.directionX.data() + offset, particles.directionY.data() + offset,
+                              particles.radialAcceleration.data() + offset, particles.tangentialAcceleration.data() + offset,
+                              particleSystemData.gravity, flip, delta,
+                              count);
+            else
             {
-                for (std::uint32_t counter = particleCount; counter > 0; --counter)
-                {
-                    const std::size_t i = counter - 1;
+                integrate(particles.angle.data() + offset, particles.degreesPerSecond.data() + offset, delta, count);
+                integrate(particles.radius.data() + offset, particles.deltaRadius.data() + offset, delta, count);
+                updateRadius(particles.positionX.data() + offset, particles.positionY.data() + offset,
+                             particles.angle.data() + offset, particles.radius.data() + offset,
+                             flip, count);
+            }
 
-                    particles[i].life -= updateStep;
+            integrate(particles.colorRed.data() + offset, particles.deltaColorRed.data() + offset, delta, count);
+            integrate(particles.colorGreen.data() + offset, particles.deltaColorGreen.data() + offset, delta, count);
+            integrate(particles.colorBlue.data() + offset, particles.deltaColorBlue.data() + offset, delta, count);
+            integrate(particles.colorAlpha.data() + offset, particles.deltaColorAlpha.data() + offset, delta, count);
+            integrateNonNegative(particles.size.data() + offset, particles.deltaSize.data() + offset, delta, count);
+            integrate(particles.rotation.data() + offset, particles.deltaRotation.data() + offset, delta, count);
+        };
 
-                    if (particles[i].life >= 0.0F)
-                    {
-                        if (particleSystemData.emitterType == ParticleSystemData::EmitterType::gravity)
-                        {
-                            Vector<float, 2> tmp;
-                            Vector<float, 2> radial;
-                            Vector<float, 2> tangential;
-
-                            // radial acceleration
-                            if (particles[i].position.v[0] == 0.0F || particles[i].position.v[1] == 0.0F)
-                                radial = particles[i].position.normalized();
-
-                            tangential = radial;
-                            radial *= particles[i].radialAcceleration;
-
-                            // tangential acceleration
-                            std::swap(tangential.v[0], tangential.v[1]);
-                            tangential.v[0] *= - particles[i].tangentialAcceleration;
-                            tangential.v[1] *= particles[i].tangentialAcceleration;
-
-                            // (gravity + radial + tangential) * updateStep
-                            tmp.v[0] = radial.v[0] + tangential.v[0] + particleSystemData.gravity.v[0];
-                            tmp.v[1] = radial.v[1] + tangential.v[1] + particleSystemData.gravity.v[1];
-                            tmp *= updateStep;
-
-                            particles[i].direction.v[0] += tmp.v[0];
-                            particles[i].direction.v[1] += tmp.v[1];
-                            tmp.v[0] = particles[i].direction.v[0] * updateStep * (particleSystemData.yCoordFlipped ? 1.0F : 0.0F);
-                            tmp.v[1] = particles[i].direction.v[1] * updateStep * (particleSystemData.yCoordFlipped ? 1.0F : 0.0F);
-                            particles[i].position.v[0] += tmp.v[0];
-                            particles[i].position.v[1] += tmp.v[1];
-                        }
-                        else
-                        {
-                            particles[i].angle += particles[i].degreesPerSecond * updateStep;
-                            particles[i].radius += particles[i].deltaRadius * updateStep;
-                            particles[i].position.v[0] = -std::cos(particles[i].angle) * particles[i].radius;
-                            particles[i].position.v[1] = -std::sin(particles[i].angle) * particles[i].radius * (particleSystemData.yCoordFlipped ? 1.0F : 0.0F);
-                        }
-
-                        // color r,g,b,a
-                        particles[i].colorRed += particles[i].deltaColorRed * updateStep;
-                        particles[i].colorGreen += particles[i].deltaColorGreen * updateStep;
-                        particles[i].colorBlue += particles[i].deltaColorBlue * updateStep;
-                        particles[i].colorAlpha += particles[i].deltaColorAlpha * updateStep;
-
-                        // size
-                        particles[i].size += (particles[i].deltaSize * updateStep);
-                        particles[i].size = std::max(0.0F, particles[i].size);
-
-                        // angle
-                        particles[i].rotation += particles[i].deltaRotation * updateStep;
-                    }
-                    else
-                    {
-                        particles[i] = particles[particleCount - 1];
-                        --particleCount;
-                    }
-                }
+        const auto chunkCount = (particleCount + chunkSize - 1) / chunkSize;
+
+        if (const auto jobSystem = engine->getJobSystem())
+            jobSystem->parallelFor(chunkCount, updateChunk);
+        else
+            for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+                updateChunk(chunk);
 
-                needsMeshUpdate = true;
-                needsBoundingBoxUpdate = true;
+        // the dead particles are replaced by the last ones, the particles after them are already alive
+        for (std::uint32_t counter = particleCount; counter > 0; --counter)
+        {
+            const std::size_t i = counter - 1;
+
+            if (particles.life[i] < 0.0F)
+            {
+                particles.move(particleCount - 1, i);
+                --particleCount;
             }
         }
+    }
 
-        if (needsBoundingBoxUpdate)
+    void ParticleSystem::calculateBoundingBox()
+    {
+        boundingBox.reset();
+
+        if (particleCount)
         {
-            // Update bounding box
-            boundingBox.reset();
+            const auto bounds = getBounds(particles.positionX.data(), particles.positionY.data(), particleCount);
 
             if (particleSystemData.positionType == ParticleSystemData::PositionType::free ||
                 particleSystemData.positionType == ParticleSystemData::PositionType::parent)
             {
                 if (actor)
                 {
-                    const auto& inverseTransform = actor->getInverseTransform();
-
-                    for (std::uint32_t i = 0; i < particleCount; ++i)
+                    // the corners of the bounds are transformed instead of every particle
+                    for (std::size_t corner = 0; corner < 4; ++corner)
                     {
-                        auto position = Vector<float, 3>{particles[i].position};
+                        Vector<float, 3> position{
+                            (corner & 1) ? bounds.max.v[0] : bounds.min.v[0],
+                            (corner & 2) ? bounds.max.v[1] : bounds.min.v[1],
+                            0.0F
+                        };
                         inverseTransform.transformPoint(position);
                         boundingBox.insertPoint(position);
                     }
                 }
             }
             else if (particleSystemData.positionType == ParticleSystemData::PositionType::grouped)
-                for (std::uint32_t i = 0; i < particleCount; ++i)
-            boundingBox.insertPoint(Vector<float, 3>{particles[i].position});
+                boundingBox = Box<float, 3>{bounds};
         }
+
+        // runs on the workers, so the new box is reported to the actor by finishUpdate
+        needsBoundingBoxUpdate = true;
     }
 
     void ParticleSystem::init(const ParticleSystemData& newParticleSystemData)
@@ -258,7 +556,7 @@ namespace ouzel::scene
             if (!active)
             {
                 active = true;
-                engine->getEventDispatcher().addEventHandler(updateHandler);
+                engine->getUpdateScheduler().addParticleSystem(*this);
             }
 
             if (particleCount == 0)
@@ -280,46 +578,50 @@ namespace ouzel::scene
     {
         emitCounter = 0.0F;
         elapsed = 0.0F;
-        timeSinceUpdate = 0.0F;
         particleCount = 0;
         finished = false;
     }
 
     void ParticleSystem::createParticleMesh()
     {
-        indices.reserve(particleSystemData.maxParticles * 6);
-        vertices.reserve(particleSystemData.maxParticles * 4);
+        // 16-bit indices can address only 16384 particles
+        const auto vertexCount = static_cast<std::size_t>(particleSystemData.maxParticles) * 4;
+        indexSize = vertexCount > std::numeric_limits<std::uint16_t>::max() + 1U ?
+            sizeof(std::uint32_t) : sizeof(std::uint16_t);
 
-        for (std::uint16_t i = 0; i < particleSystemData.maxParticles; ++i)
-        {
-            indices.push_back(i * 4 + 0);
-            indices.push_back(i * 4 + 1);
-            indices.push_back(i * 4 + 2);
-            indices.push_back(i * 4 + 1);
-            indices.push_back(i * 4 + 3);
-            indices.push_back(i * 4 + 2);
-
-            vertices.emplace_back(Vector<float, 3>{-1.0F, -1.0F, 0.0F}, Color::white(),
-                                  Vector<float, 2>{0.0F, 1.0F}, Vector<float, 3>{0.0F, 0.0F, -1.0F});
-            vertices.emplace_back(Vector<float, 3>{1.0F, -1.0F, 0.0F}, Color::white(),
-                                  Vector<float, 2>{1.0F, 1.0F}, Vector<float, 3>{0.0F, 0.0F, -1.0F});
-            vertices.emplace_back(Vector<float, 3>{-1.0F, 1.0F, 0.0F}, Color::white(),
-                                  Vector<float, 2>{0.0F, 0.0F}, Vector<float, 3>{0.0F, 0.0F, -1.0F});
-            vertices.emplace_back(Vector<float, 3>{1.0F, 1.0F, 0.0F}, Color::white(),
-                                  Vector<float, 2>{1.0F, 0.0F}, Vector<float, 3>{0.0F, 0.0F, -1.0F});
-        }
+        const auto createIndices = [this](auto indexType) {
+            using Index = decltype(indexType);
+
+            std::vector<Index> indices;
+            indices.reserve(static_cast<std::size_t>(particleSystemData.maxParticles) * 6);
+
+            for (std::uint32_t i = 0; i < particleSystemData.maxParticles; ++i)
+            {
+                indices.push_back(static_cast<Index>(i * 4 + 0));
+                indices.push_back(static_cast<Index>(i * 4 + 1));
+                indices.push_back(static_cast<Index>(i * 4 + 2));
+                indices.push_back(static_cast<Index>(i * 4 + 1));
+                indices.push_back(static_cast<Index>(i * 4 + 3));
+                indices.push_back(static_cast<Index>(i * 4 + 2));
+            }
 
-        indexBuffer = std::make_unique<graphics::Buffer>(*engine->getGraphics(),
-                                                         graphics::BufferType::index,
-                                                         graphics::Flags::none,
-                                                         indices.data(),
-                                                         static_cast<std::uint32_t>(getVectorSize(indices)));
+            indexBuffer = std::make_unique<graphics::Buffer>(*engine->getGraphics(),
+                                                             graphics::BufferType::index,
+                                                             graphics::Flags::none,
+                                                             indices.data(),
+                                                             static_cast<std::uint32_t>(getVectorSize(indices)));
+        };
+
+        if (indexSize == sizeof(std::uint32_t))
+            createIndices(std::uint32_t{});
+        else
+            createIndices(std::uint16_t{});
 
+        // the vertices of the live particles are streamed to the buffer every frame
         vertexBuffer = std::make_unique<graphics::Buffer>(*engine->getGraphics(),
                                                           graphics::BufferType::vertex,
                                                           graphics::Flags::dynamic,
-                                                          vertices.data(),
-                                                          static_cast<std::uint32_t>(getVectorSize(vertices)));
+                                                          static_cast<std::uint32_t>(vertexCount * sizeof(graphics::Vertex)));
 
         particles.resize(particleSystemData.maxParticles);
     }
@@ -328,52 +630,54 @@ namespace ouzel::scene
     {
         if (actor)
         {
-            for (std::uint32_t counter = particleCount; counter > 0; --counter)
-            {
-                const std::size_t i = counter - 1;
-
-                const Vector<float, 2> position = (particleSystemData.positionType == ParticleSystemData::PositionType::free) ?
-                    particles[i].position :
-                    (particleSystemData.positionType == ParticleSystemData::PositionType::parent) ?
-                    Vector<float, 2>{actor->getPosition()} + particles[i].position :
-                    (particleSystemData.positionType == ParticleSystemData::PositionType::grouped) ?
-                    Vector<float, 2>{} :
-                    throw std::runtime_error("Invalid position type");
-
-                const float halfSize = particles[i].size / 2.0F;
-                const Vector<float, 2> v1{-halfSize, -halfSize};
-                const Vector<float, 2> v2{halfSize, halfSize};
+            const bool grouped = (particleSystemData.positionType == ParticleSystemData::PositionType::grouped);
+            const Vector<float, 2> offset = (particleSystemData.positionType == ParticleSystemData::PositionType::free) ?
+                Vector<float, 2>{} :
+                (particleSystemData.positionType == ParticleSystemData::PositionType::parent) ?
+                Vector<float, 2>{actor->getPosition()} :
+                grouped ?
+                Vector<float, 2>{} :
+                throw std::runtime_error("Invalid position type");
 
-                const float r = -degToRad(particles[i].rotation);
-                const float cr = std::cos(r);
-                const float sr = std::sin(r);
+            // the vertices are written straight into the memory that is uploaded to the buffer
+            auto vertices = static_cast<graphics::Vertex*>(vertexBuffer->streamData(static_cast<std::uint32_t>(particleCount * 4 * sizeof(graphics::Vertex))));
 
-                const Vector<float, 2> a{v1.v[0] * cr - v1.v[1] * sr, v1.v[0] * sr + v1.v[1] * cr};
-                const Vector<float, 2> b{v2.v[0] * cr - v1.v[1] * sr, v2.v[0] * sr + v1.v[1] * cr};
-                const Vector<float, 2> c{v2.v[0] * cr - v2.v[1] * sr, v2.v[0] * sr + v2.v[1] * cr};
-                const Vector<float, 2> d{v1.v[0] * cr - v2.v[1] * sr, v1.v[0] * sr + v2.v[1] * cr};
+            const Vector<float, 3> normal{0.0F, 0.0F, -1.0F};
 
-                const Color color{
-                    particles[i].colorRed,
-                    particles[i].colorGreen,
-                    particles[i].colorBlue,
-                    particles[i].colorAlpha
+            for (std::uint32_t i = 0; i < particleCount; ++i)
+            {
+                const Vector<float, 2> position = grouped ? Vector<float, 2>{} : Vector<float, 2>{
+                    offset.v[0] + particles.positionX[i],
+                    offset.v[1] + particles.positionY[i]
                 };
 
-                vertices[i * 4 + 0].position = Vector<float, 3>{a + position};
-                vertices[i * 4 + 0].color = color;
+                const float halfSize = particles.size[i] / 2.0F;
 
-                vertices[i * 4 + 1].position = Vector<float, 3>{b + position};
-                vertices[i * 4 + 1].color = color;
+                const float r = -degToRad(particles.rotation[i]);
+                const float cr = std::cos(r) * halfSize;
+                const float sr = std::sin(r) * halfSize;
 
-                vertices[i * 4 + 2].position = Vector<float, 3>{d + position};
-                vertices[i * 4 + 2].color = color;
+                const Vector<float, 2> a{-cr + sr, -sr - cr};
+                const Vector<float, 2> b{cr + sr, sr - cr};
+                const Vector<float, 2> c{cr - sr, sr + cr};
+                const Vector<float, 2> d{-cr - sr, -sr + cr};
 
-                vertices[i * 4 + 3].position = Vector<float, 3>{c + position};
-                vertices[i * 4 + 3].color = color;
-            }
+                const Color color{
+                    particles.colorRed[i],
+                    particles.colorGreen[i],
+                    particles.colorBlue[i],
+                    particles.colorAlpha[i]
+                };
 
-            vertexBuffer->setData(vertices.data(), static_cast<std::uint32_t>(getVectorSize(vertices)));
+                new (&vertices[i * 4 + 0]) graphics::Vertex{Vector<float, 3>{a + position}, color,
+                    Vector<float, 2>{0.0F, 1.0F}, normal};
+                new (&vertices[i * 4 + 1]) graphics::Vertex{Vector<float, 3>{b + position}, color,
+                    Vector<float, 2>{1.0F, 1.0F}, normal};
+                new (&vertices[i * 4 + 2]) graphics::Vertex{Vector<float, 3>{d + position}, color,
+                    Vector<float, 2>{0.0F, 0.0F}, normal};
+                new (&vertices[i * 4 + 3]) graphics::Vertex{Vector<float, 3>{c + position}, color,
+                    Vector<float, 2>{1.0F, 0.0F}, normal};
+            }
         }
     }
 
@@ -382,81 +686,80 @@ namespace ouzel::scene
         if (particleCount + count > particleSystemData.maxParticles)
             count = particleSystemData.maxParticles - particleCount;
 
+        // the emitter position was captured by prepareUpdate, the actor must not be accessed from the workers
         if (count && actor)
         {
-            const Vector<float, 2> position = (particleSystemData.positionType == ParticleSystemData::PositionType::free) ?
-                Vector<float, 2>{actor->convertLocalToWorld(Vector<float, 3>{})} :
-                (particleSystemData.positionType == ParticleSystemData::PositionType::parent) ?
-                Vector<float, 2>{actor->convertLocalToWorld(Vector<float, 3>{}) - actor->getPosition()} :
-                (particleSystemData.positionType == ParticleSystemData::PositionType::grouped) ?
-                Vector<float, 2>{} :
-                throw std::runtime_error("Invalid position type");
+            const auto& position = emitterPosition;
 
             for (std::uint32_t i = particleCount; i < particleCount + count; ++i)
             {
                 if (particleSystemData.emitterType == ParticleSystemData::EmitterType::gravity)
                 {
-                    particles[i].life = std::max(particleSystemData.particleLifespan + particleSystemData.particleLifespanVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F);
+                    particles.life[i] = std::max(particleSystemData.particleLifespan + particleSystemData.particleLifespanVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F);
 
-                    particles[i].position = particleSystemData.sourcePosition + position + Vector<float, 2>{
-                        particleSystemData.sourcePositionVariance.v[0] * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine),
-                        particleSystemData.sourcePositionVariance.v[1] * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine)
+                    const auto particlePosition = particleSystemData.sourcePosition + position + Vector<float, 2>{
+                        particleSystemData.sourcePositionVariance.v[0] * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine),
+                        particleSystemData.sourcePositionVariance.v[1] * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine)
                     };
+                    particles.positionX[i] = particlePosition.v[0];
+                    particles.positionY[i] = particlePosition.v[1];
 
-                    particles[i].size = std::max(particleSystemData.startParticleSize + particleSystemData.startParticleSizeVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F);
+                    particles.size[i] = std::max(particleSystemData.startParticleSize + particleSystemData.startParticleSizeVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F);
 
-                    const float finishSize = std::max(particleSystemData.finishParticleSize + particleSystemData.finishParticleSizeVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F);
-                    particles[i].deltaSize = (finishSize - particles[i].size) / particles[i].life;
+                    const float finishSize = std::max(particleSystemData.finishParticleSize + particleSystemData.finishParticleSizeVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F);
+                    particles.deltaSize[i] = (finishSize - particles.size[i]) / particles.life[i];
 
-                    particles[i].colorRed = std::clamp(particleSystemData.startColorRed + particleSystemData.startColorRedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
-                    particles[i].colorGreen = std::clamp(particleSystemData.startColorGreen + particleSystemData.startColorGreenVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
-                    particles[i].colorBlue = std::clamp(particleSystemData.startColorBlue + particleSystemData.startColorBlueVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
-                    particles[i].colorAlpha = std::clamp(particleSystemData.startColorAlpha + particleSystemData.startColorAlphaVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
+                    particles.colorRed[i] = std::clamp(particleSystemData.startColorRed + particleSystemData.startColorRedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
+                    particles.colorGreen[i] = std::clamp(particleSystemData.startColorGreen + particleSystemData.startColorGreenVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
+                    particles.colorBlue[i] = std::clamp(particleSystemData.startColorBlue + particleSystemData.startColorBlueVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
+                    particles.colorAlpha[i] = std::clamp(particleSystemData.startColorAlpha + particleSystemData.startColorAlphaVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
 
-                    const float finishColorRed = std::clamp(particleSystemData.finishColorRed + particleSystemData.finishColorRedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
-                    const float finishColorGreen = std::clamp(particleSystemData.finishColorGreen + particleSystemData.finishColorGreenVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
-                    const float finishColorBlue = std::clamp(particleSystemData.finishColorBlue + particleSystemData.finishColorBlueVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
-                    const float finishColorAlpha = std::clamp(particleSystemData.finishColorAlpha + particleSystemData.finishColorAlphaVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine), 0.0F, 1.0F);
+                    const float finishColorRed = std::clamp(particleSystemData.finishColorRed + particleSystemData.finishColorRedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
+                    const float finishColorGreen = std::clamp(particleSystemData.finishColorGreen + particleSystemData.finishColorGreenVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
+                    const float finishColorBlue = std::clamp(particleSystemData.finishColorBlue + particleSystemData.finishColorBlueVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
+                    const float finishColorAlpha = std::clamp(particleSystemData.finishColorAlpha + particleSystemData.finishColorAlphaVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine), 0.0F, 1.0F);
 
-                    particles[i].deltaColorRed = (finishColorRed - particles[i].colorRed) / particles[i].life;
-                    particles[i].deltaColorGreen = (finishColorGreen - particles[i].colorGreen) / particles[i].life;
-                    particles[i].deltaColorBlue = (finishColorBlue - particles[i].colorBlue) / particles[i].life;
-                    particles[i].deltaColorAlpha = (finishColorAlpha - particles[i].colorAlpha) / particles[i].life;
+                    particles.deltaColorRed[i] = (finishColorRed - particles.colorRed[i]) / particles.life[i];
+                    particles.deltaColorGreen[i] = (finishColorGreen - particles.colorGreen[i]) / particles.life[i];
+                    particles.deltaColorBlue[i] = (finishColorBlue - particles.colorBlue[i]) / particles.life[i];
+                    particles.deltaColorAlpha[i] = (finishColorAlpha - particles.colorAlpha[i]) / particles.life[i];
 
-                    particles[i].rotation = particleSystemData.startRotation + particleSystemData.startRotationVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
+                    particles.rotation[i] = particleSystemData.startRotation + particleSystemData.startRotationVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
 
-                    const float finishRotation = particleSystemData.finishRotation + particleSystemData.finishRotationVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
-                    particles[i].deltaRotation = (finishRotation - particles[i].rotation) / particles[i].life;
+                    const float finishRotation = particleSystemData.finishRotation + particleSystemData.finishRotationVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
+                    particles.deltaRotation[i] = (finishRotation - particles.rotation[i]) / particles.life[i];
 
-                    particles[i].radialAcceleration = particleSystemData.radialAcceleration + particleSystemData.radialAcceleration * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
-                    particles[i].tangentialAcceleration = particleSystemData.tangentialAcceleration + particleSystemData.tangentialAcceleration * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
+                    particles.radialAcceleration[i] = particleSystemData.radialAcceleration + particleSystemData.radialAcceleration * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
+                    particles.tangentialAcceleration[i] = particleSystemData.tangentialAcceleration + particleSystemData.tangentialAcceleration * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
 
                     if (particleSystemData.rotationIsDir)
                     {
-                        const float a = degToRad(particleSystemData.angle + particleSystemData.angleVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine));
+                        const float a = degToRad(particleSystemData.angle + particleSystemData.angleVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine));
                         const Vector<float, 2> v{std::cos(a), std::sin(a)};
-                        const float s = particleSystemData.speed + particleSystemData.speedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
+                        const float s = particleSystemData.speed + particleSystemData.speedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
                         const auto dir = v * s;
-                        particles[i].direction = dir;
-                        particles[i].rotation = -radToDeg(dir.getAngle());
+                        particles.directionX[i] = dir.v[0];
+                        particles.directionY[i] = dir.v[1];
+                        particles.rotation[i] = -radToDeg(dir.getAngle());
                     }
                     else
                     {
-                        const float a = degToRad(particleSystemData.angle + particleSystemData.angleVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine));
+                        const float a = degToRad(particleSystemData.angle + particleSystemData.angleVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine));
                         const Vector<float, 2> v{std::cos(a), std::sin(a)};
-                        const float s = particleSystemData.speed + particleSystemData.speedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
+                        const float s = particleSystemData.speed + particleSystemData.speedVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
                         const auto dir = v * s;
-                        particles[i].direction = dir;
+                        particles.directionX[i] = dir.v[0];
+                        particles.directionY[i] = dir.v[1];
                     }
                 }
                 else
                 {
-                    particles[i].radius = particleSystemData.maxRadius + particleSystemData.maxRadiusVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
-                    particles[i].angle = degToRad(particleSystemData.angle + particleSystemData.angleVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine));
-                    particles[i].degreesPerSecond = degToRad(particleSystemData.rotatePerSecond + particleSystemData.rotatePerSecondVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine));
+                    particles.radius[i] = particleSystemData.maxRadius + particleSystemData.maxRadiusVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
+                    particles.angle[i] = degToRad(particleSystemData.angle + particleSystemData.angleVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine));
+                    particles.degreesPerSecond[i] = degToRad(particleSystemData.rotatePerSecond + particleSystemData.rotatePerSecondVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine));
 
-                    const float endRadius = particleSystemData.minRadius + particleSystemData.minRadiusVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(core::randomEngine);
-                    particles[i].deltaRadius = (endRadius - particles[i].radius) / particles[i].life;
+                    const float endRadius = particleSystemData.minRadius + particleSystemData.minRadiusVariance * std::uniform_real_distribution<float>{-1.0F, 1.0F}(randomEngine);
+                    particles.deltaRadius[i] = (endRadius - particles.radius[i]) / particles.life[i];
                 }
             }
 
@@ -3,13 +3,15 @@
 #ifndef OUZEL_SCENE_PARTICLESYSTEM_HPP
 #define OUZEL_SCENE_PARTICLESYSTEM_HPP
 
+#include <random>
 #include <string>
 #include <vector>
 #include <functional>
 #include "Component.hpp"
+#include "UpdateScheduler.hpp"
 #include "../math/Color.hpp"
+#include "../math/Matrix.hpp"
 #include "../math/Vector.hpp"
-#include "../events/EventHandler.hpp"
 #include "../graphics/Vertex.hpp"
 #include "../graphics/BlendState.hpp"
 #include "../graphics/Buffer.hpp"
@@ -115,9 +117,11 @@ namespace ouzel::scene
 
     class ParticleSystem: public Component
     {
+        friend UpdateScheduler;
     public:
         ParticleSystem();
         explicit ParticleSystem(const ParticleSystemData& initParticleSystemData);
+        ~ParticleSystem() override;
 
         void draw(const Matrix<float, 4>& transformMatrix,
                   float opacity,
@@ -132,6 +136,11 @@ namespace ouzel::scene
 
         auto isRunning() const noexcept { return running; }
         auto isActive() const noexcept { return active; }
+        auto getParticleCount() const noexcept { return particleCount; }
+
+        // every system has its own random number generator, so the same seed gives the same
+        // particles regardless of the other systems and the number of workers that update them
+        void setSeed(std::uint32_t seed) { randomEngine.seed(seed); }
 
         auto getPositionType() const noexcept
         {
@@ -144,7 +153,14 @@ namespace ouzel::scene
         }
 
     private:
+        // the update scheduler calls prepareUpdate and finishUpdate on the update thread and
+        // update in parallel for all of the systems, so update must touch only the system's own state
+        void prepareUpdate();
         void update(float delta);
+        void finishUpdate();
+
+        void updateParticles(float delta);
+        void calculateBoundingBox();
 
         void createParticleMesh();
         void updateParticleMesh();
@@ -152,66 +168,80 @@ namespace ouzel::scene
         void emitParticles(std::uint32_t count);
 
         ParticleSystemData particleSystemData;
+        std::mt19937 randomEngine;
 
         const graphics::Shader* shader = nullptr;
         const graphics::BlendState* blendState = nullptr;
         std::shared_ptr<graphics::Texture> texture;
         std::shared_ptr<graphics::Texture> whitePixelTexture;
 
-        struct Particle final
+        // the particles are stored as a structure of arrays, so that the update kernels can process several of them at once
+        struct Particles final
         {
-            float life = 0.0F;
+            void resize(std::size_t size);
+            void move(std::size_t from, std::size_t to) noexcept;
 
-            Vector<float, 2> position;
+            template <class Function>
+            void forEachAttribute(const Function& function);
 
-            float colorRed = 0.0F;
-            float colorGreen = 0.0F;
-            float colorBlue = 0.0F;
-            float colorAlpha = 0.0F;
+            std::vector<float> life;
 
-            float deltaColorRed = 0.0F;
-            float deltaColorGreen = 0.0F;
-            float deltaColorBlue = 0.0F;
-            float deltaColorAlpha = 0.0F;
+            std::vector<float> positionX;
+            std::vector<float> positionY;
 
-            float angle = 0.0F;
-            float speed = 0.0F;
+            std::vector<float> colorRed;
+            std::vector<float> colorGreen;
+            std::vector<float> colorBlue;
+            std::vector<float> colorAlpha;
 
-            float size = 0.0F;
-            float deltaSize = 0.0F;
+            std::vector<float> deltaColorRed;
+            std::vector<float> deltaColorGreen;
+            std::vector<float> deltaColorBlue;
+            std::vector<float> deltaColorAlpha;
 
-            float rotation = 0.0F;
-            float deltaRotation = 0.0F;
+            std::vector<float> size;
+            std::vector<float> deltaSize;
 
-            float radialAcceleration = 0.0F;
-            float tangentialAcceleration = 0.0F;
+            std::vector<float> rotation;
+            std::vector<float> deltaRotation;
 
-            Vector<float, 2> direction;
-            float radius = 0.0F;
-            float degreesPerSecond = 0.0F;
-            float deltaRadius = 0.0F;
+            // gravity emitter
+            std::vector<float> directionX;
+            std::vector<float> directionY;
+            std::vector<float> radialAcceleration;
+            std::vector<float> tangentialAcceleration;
+
+            // radius emitter
+            std::vector<float> angle;
+            std::vector<float> radius;
+            std::vector<float> degreesPerSecond;
+            std::vector<float> deltaRadius;
         };
 
-        std::vector<Particle> particles;
+        Particles particles;
 
         std::unique_ptr<graphics::Buffer> indexBuffer;
         std::unique_ptr<graphics::Buffer> vertexBuffer;
 
-        std::vector<std::uint16_t> indices;
-        std::vector<graphics::Vertex> vertices;
+        std::uint32_t indexSize = 0;
 
         std::uint32_t particleCount = 0;
 
         float emitCounter = 0.0F;
         float elapsed = 0.0F;
-        float timeSinceUpdate = 0.0F;
         bool active = false;
         bool running = false;
         bool finished = false;
 
         bool needsMeshUpdate = false;
+        bool needsBoundingBoxUpdate = false;
+        bool needsFinish = false;
+
+        // the state of the actor captured by prepareUpdate
+        Vector<float, 2> emitterPosition;
+        Matrix<float, 4> inverseTransform;
 
-        EventHandler updateHandler;
+        std::size_t updateIndex = UpdateScheduler::noIndex; // position in the list of the update scheduler
     };
 }
 
@@ -36,6 +36,19 @@ namespace ouzel::scene
             return a->getOrder() > b->getOrder();
         });
 
+        // the layers do not share actors, so their transforms are updated in parallel, the components are notified
+        // about the moved actors on this thread, then the layers are culled in parallel and drawn in order
+        engine->getJobSystem()->parallelFor(layers.size(), [this](std::size_t i) {
+            layers[i]->updateTransforms();
+        });
+
+        for (Layer* layer : layers)
+            layer->notifyTransforms();
+
+        engine->getJobSystem()->parallelFor(layers.size(), [this](std::size_t i) {
+            layers[i]->cull();
+        });
+
         std::set<graphics::RenderTarget*> clearedRenderTargets;
 
         for (Layer* layer : layers)
@@ -44,18 +44,12 @@ namespace ouzel::scene
 
         for (const DrawCommand& drawCommand : drawCommands)
         {
-            std::vector<std::vector<float>> fragmentShaderConstants(1);
-            fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
-
-            std::vector<std::vector<float>> vertexShaderConstants(1);
-            vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
-
             engine->getGraphics()->setPipelineState(blendState->getResource(),
                                                     shader->getResource(),
                                                     graphics::CullMode::none,
                                                     wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
-            engine->getGraphics()->setShaderConstants(fragmentShaderConstants,
-                                                      vertexShaderConstants);
+            engine->getGraphics()->setShaderConstants({{colorVector, std::size(colorVector)}},
+                                                      {{modelViewProj.m.data(), modelViewProj.m.size()}});
             engine->getGraphics()->draw(indexBuffer.getResource(),
                                         drawCommand.indexCount,
                                         sizeof(std::uint16_t),
@@ -74,6 +68,8 @@ namespace ouzel::scene
         vertices.clear();
 
         dirty = true;
+
+        updateBoundingBox();
     }
 
     void ShapeRenderer::line(const Vector<float, 2>& start, const Vector<float, 2>& finish, Color color, float thickness)
@@ -136,6 +132,8 @@ namespace ouzel::scene
         drawCommands.push_back(command);
 
         dirty = true;
+
+        updateBoundingBox();
     }
 
     void ShapeRenderer::circle(const Vector<float, 2>& position,
@@ -248,6 +246,8 @@ namespace ouzel::scene
         drawCommands.push_back(command);
 
         dirty = true;
+
+        updateBoundingBox();
     }
 
     void ShapeRenderer::rectangle(const Rect<float>& rectangle,
@@ -395,6 +395,8 @@ namespace ouzel::scene
         drawCommands.push_back(command);
 
         dirty = true;
+
+        updateBoundingBox();
     }
 
     void ShapeRenderer::polygon(const std::vector<Vector<float, 2>>& edges,
@@ -457,6 +459,8 @@ namespace ouzel::scene
         drawCommands.push_back(command);
 
         dirty = true;
+
+        updateBoundingBox();
     }
 
     namespace
@@ -532,5 +536,7 @@ namespace ouzel::scene
         drawCommands.push_back(command);
 
         dirty = true;
+
+        updateBoundingBox();
     }
 }
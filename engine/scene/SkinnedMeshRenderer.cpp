@@ -17,7 +17,7 @@ namespace ouzel::scene
 
     void SkinnedMeshRenderer::init(const SkinnedMeshData& meshData)
     {
-        boundingBox = meshData.boundingBox;
+        setBoundingBox(meshData.boundingBox);
         material = meshData.material;
     }
 
@@ -45,6 +45,7 @@ namespace ouzel::scene
                   bool wireframe) override;
 
         auto& getMaterial() const noexcept { return material; }
+        std::uint32_t getSortKey() const noexcept override { return material ? material->getSortKey() : 0; }
         void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; }
 
     private:
@@ -0,0 +1,363 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <array>
+#include "SpatialIndex.hpp"
+#include "Actor.hpp"
+#include "Component.hpp"
+
+namespace ouzel::scene
+{
+    namespace
+    {
+        Box<float, 3> merge(const Box<float, 3>& a, const Box<float, 3>& b) noexcept
+        {
+            Box<float, 3> result = a;
+            result.merge(b);
+            return result;
+        }
+
+        // surface area heuristic, the flat boxes of the 2D actors still have a margin on the z axis
+        float getCost(const Box<float, 3>& box) noexcept
+        {
+            const auto x = box.max.v[0] - box.min.v[0];
+            const auto y = box.max.v[1] - box.min.v[1];
+            const auto z = box.max.v[2] - box.min.v[2];
+            return x * y + y * z + z * x;
+        }
+
+        Box<float, 3> transformBox(const Box<float, 3>& box, const Matrix<float, 4>& transform) noexcept
+        {
+            Box<float, 3> result;
+
+            for (std::size_t corner = 0; corner < 8; ++corner)
+            {
+                Vector<float, 3> point{
+                    (corner & 1) ? box.max.v[0] : box.min.v[0],
+                    (corner & 2) ? box.max.v[1] : box.min.v[1],
+                    (corner & 4) ? box.max.v[2] : box.min.v[2]
+                };
+                transform.transformPoint(point);
+                result.insertPoint(point);
+            }
+
+            return result;
+        }
+
+        Box<float, 3> enlargeBox(const Box<float, 3>& box) noexcept
+        {
+            const auto size = box.getSize();
+            const auto margin = std::max({size.v[0], size.v[1], size.v[2]}) * 0.1F;
+
+            return Box<float, 3>{
+                box.min - Vector<float, 3>{margin, margin, margin},
+                box.max + Vector<float, 3>{margin, margin, margin}
+            };
+        }
+    }
+
+    SpatialIndex::~SpatialIndex()
+    {
+        for (const auto& entry : entries)
+            if (entry.actor) entry.actor->spatialIndex = nullptr;
+    }
+
+    void SpatialIndex::addActor(Actor& actor)
+    {
+        std::uint32_t entryIndex;
+
+        if (freeEntries.empty())
+        {
+            entryIndex = static_cast<std::uint32_t>(entries.size());
+            entries.emplace_back();
+        }
+        else
+        {
+            entryIndex = freeEntries.back();
+            freeEntries.pop_back();
+        }
+
+        entries[entryIndex].actor = &actor;
+        actor.spatialIndex = this;
+        actor.spatialIndexEntry = entryIndex;
+
+        updateActor(actor);
+    }
+
+    void SpatialIndex::removeActor(const Actor& actor) noexcept
+    {
+        const auto entryIndex = actor.spatialIndexEntry;
+        auto& entry = entries[entryIndex];
+
+        if (entry.node != nullNode)
+        {
+            removeLeaf(entry.node);
+            freeNode(entry.node);
+        }
+
+        if (entry.unbounded) setUnbounded(entry, entryIndex, false);
+
+        // the entry might still be in the queue, but it is skipped because it is not queued anymore
+        entry = Entry{};
+        freeEntries.push_back(entryIndex);
+
+        actor.spatialIndex = nullptr;
+    }
+
+    void SpatialIndex::updateActor(const Actor& actor)
+    {
+        auto& entry = entries[actor.spatialIndexEntry];
+        if (entry.queued) return;
+
+        entry.queued = true;
+        queuedEntries.push_back(actor.spatialIndexEntry);
+    }
+
+    void SpatialIndex::update()
+    {
+        for (const auto entryIndex : queuedEntries)
+            if (entries[entryIndex].queued)
+                updateEntry(entryIndex);
+
+        queuedEntries.clear();
+    }
+
+    void SpatialIndex::updateEntry(std::uint32_t entryIndex)
+    {
+        auto& entry = entries[entryIndex];
+        entry.queued = false;
+
+        const auto actor = entry.actor;
+
+        // the hidden components are included, because they can still be picked
+        Box<float, 3> boundingBox;
+        if (!actor->isCullDisabled())
+            for (const auto component : actor->components)
+                boundingBox.merge(component->getBoundingBox());
+
+        if (actor->isCullDisabled() || boundingBox.isEmpty())
+        {
+            if (entry.node != nullNode)
+            {
+                removeLeaf(entry.node);
+                freeNode(entry.node);
+                entry.node = nullNode;
+            }
+
+            // the actors without a bounding box are never visible unless culling is disabled
+            setUnbounded(entry, entryIndex, actor->isCullDisabled());
+            return;
+        }
+
+        setUnbounded(entry, entryIndex, false);
+
+        const auto worldBox = transformBox(boundingBox, actor->getTransform());
+
+        if (entry.node == nullNode)
+        {
+            const auto node = allocateNode();
+            nodes[node].box = enlargeBox(worldBox);
+            nodes[node].entry = entryIndex;
+            insertLeaf(node);
+            entries[entryIndex].node = node;
+        }
+        else if (!contains(nodes[entry.node].box, worldBox))
+        {
+            removeLeaf(entry.node);
+            nodes[entry.node].box = enlargeBox(worldBox);
+            insertLeaf(entry.node);
+        }
+    }
+
+    void SpatialIndex::setUnbounded(Entry& entry, std::uint32_t entryIndex, bool unbounded)
+    {
+        if (entry.unbounded == unbounded) return;
+
+        if (unbounded)
+        {
+            entry.unboundedPosition = static_cast<std::uint32_t>(unboundedEntries.size());
+            unboundedEntries.push_back(entryIndex);
+        }
+        else
+        {
+            const auto lastEntry = unboundedEntries.back();
+            unboundedEntries[entry.unboundedPosition] = lastEntry;
+            entries[lastEntry].unboundedPosition = entry.unboundedPosition;
+            unboundedEntries.pop_back();
+        }
+
+        entry.unbounded = unbounded;
+    }
+
+    SpatialIndex::NodeIndex SpatialIndex::allocateNode()
+    {
+        if (freeNodes == nullNode)
+        {
+            nodes.emplace_back();
+            return static_cast<NodeIndex>(nodes.size() - 1);
+        }
+
+        const auto index = freeNodes;
+        freeNodes = nodes[index].parent;
+        nodes[index] = Node{};
+        return index;
+    }
+
+    void SpatialIndex::freeNode(NodeIndex index) noexcept
+    {
+        nodes[index].parent = freeNodes;
+        nodes[index].height = -1;
+        freeNodes = index;
+    }
+
+    void SpatialIndex::insertLeaf(NodeIndex leaf)
+    {
+        if (root == nullNode)
+        {
+            root = leaf;
+            nodes[root].parent = nullNode;
+            return;
+        }
+
+        // find the sibling with the lowest cost
+        const auto leafBox = nodes[leaf].box;
+        auto index = root;
+
+        while (!nodes[index].isLeaf())
+        {
+            const auto& node = nodes[index];
+
+            const auto area = getCost(node.box);
+            const auto combinedArea = getCost(merge(node.box, leafBox));
+
+            // cost of creating a new parent for this node and the new leaf
+            const auto cost = 2.0F * combinedArea;
+
+            // minimum cost of pushing the leaf further down the tree
+            const auto inheritanceCost = 2.0F * (combinedArea - area);
+
+            std::array<float, 2> childCosts;
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                const auto& child = nodes[node.children[i]];
+                const auto childArea = getCost(merge(child.box, leafBox));
+                childCosts[i] = (child.isLeaf() ? childArea : childArea - getCost(child.box)) + inheritanceCost;
+            }
+
+            if (cost < childCosts[0] && cost < childCosts[1]) break;
+
+            index = childCosts[0] < childCosts[1] ? node.children[0] : node.children[1];
+        }
+
+        const auto sibling = index;
+        const auto oldParent = nodes[sibling].parent;
+        const auto newParent = allocateNode();
+
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].box = merge(leafBox, nodes[sibling].box);
+        nodes[newParent].height = nodes[sibling].height + 1;
+        nodes[newParent].children[0] = sibling;
+        nodes[newParent].children[1] = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent == nullNode)
+            root = newParent;
+        else if (nodes[oldParent].children[0] == sibling)
+            nodes[oldParent].children[0] = newParent;
+        else
+            nodes[oldParent].children[1] = newParent;
+
+        refit(newParent);
+    }
+
+    void SpatialIndex::removeLeaf(NodeIndex leaf) noexcept
+    {
+        if (leaf == root)
+        {
+            root = nullNode;
+            return;
+        }
+
+        const auto parent = nodes[leaf].parent;
+        const auto grandParent = nodes[parent].parent;
+        const auto sibling = nodes[parent].children[0] == leaf ? nodes[parent].children[1] : nodes[parent].children[0];
+
+        nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        if (grandParent == nullNode)
+            root = sibling;
+        else
+        {
+            if (nodes[grandParent].children[0] == parent)
+                nodes[grandParent].children[0] = sibling;
+            else
+                nodes[grandParent].children[1] = sibling;
+
+            refit(grandParent);
+        }
+    }
+
+    void SpatialIndex::refit(NodeIndex index) noexcept
+    {
+        while (index != nullNode)
+        {
+            index = balance(index);
+
+            auto& node = nodes[index];
+            const auto& child0 = nodes[node.children[0]];
+            const auto& child1 = nodes[node.children[1]];
+            node.height = 1 + std::max(child0.height, child1.height);
+            node.box = merge(child0.box, child1.box);
+
+            index = node.parent;
+        }
+    }
+
+    // rotates the higher child up if the subtrees differ in height by more than one
+    SpatialIndex::NodeIndex SpatialIndex::balance(NodeIndex a) noexcept
+    {
+        if (nodes[a].isLeaf() || nodes[a].height < 2) return a;
+
+        const auto b = nodes[a].children[0];
+        const auto c = nodes[a].children[1];
+        const auto difference = nodes[c].height - nodes[b].height;
+
+        if (difference > -2 && difference < 2) return a;
+
+        // the higher child and the side of the node it is on
+        const std::size_t side = difference > 1 ? 1 : 0;
+        const auto up = nodes[a].children[side];
+        const auto other = nodes[a].children[1 - side];
+        const auto upChild0 = nodes[up].children[0];
+        const auto upChild1 = nodes[up].children[1];
+
+        // the up node replaces the node in its parent
+        nodes[up].children[0] = a;
+        nodes[up].parent = nodes[a].parent;
+        nodes[a].parent = up;
+
+        if (const auto parent = nodes[up].parent; parent == nullNode)
+            root = up;
+        else if (nodes[parent].children[0] == a)
+            nodes[parent].children[0] = up;
+        else
+            nodes[parent].children[1] = up;
+
+        // the higher grandchild stays under the up node and the lower one moves under the node
+        const auto keep = nodes[upChild0].height > nodes[upChild1].height ? upChild0 : upChild1;
+        const auto move = keep == upChild0 ? upChild1 : upChild0;
+
+        nodes[up].children[1] = keep;
+        nodes[a].children[side] = move;
+        nodes[move].parent = a;
+
+        nodes[a].box = merge(nodes[other].box, nodes[move].box);
+        nodes[a].height = 1 + std::max(nodes[other].height, nodes[move].height);
+        nodes[up].box = merge(nodes[a].box, nodes[keep].box);
+        nodes[up].height = 1 + std::max(nodes[a].height, nodes[keep].height);
+
+        return up;
+    }
+}
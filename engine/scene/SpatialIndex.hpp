@@ -0,0 +1,128 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SCENE_SPATIALINDEX_HPP
+#define OUZEL_SCENE_SPATIALINDEX_HPP
+
+#include <cstdint>
+#include <vector>
+#include "../math/Box.hpp"
+
+namespace ouzel::scene
+{
+    class Actor;
+
+    // dynamic AABB tree of the world bounding boxes of the actors in a layer,
+    // the changed actors are queued and moved in the tree on the next update
+    class SpatialIndex final
+    {
+    public:
+        SpatialIndex() = default;
+        ~SpatialIndex();
+
+        SpatialIndex(const SpatialIndex&) = delete;
+        SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+        SpatialIndex(SpatialIndex&&) = delete;
+        SpatialIndex& operator=(SpatialIndex&&) = delete;
+
+        void addActor(Actor& actor);
+        void removeActor(const Actor& actor) noexcept;
+        // called when the transform or the bounding box of the actor changes
+        void updateActor(const Actor& actor);
+
+        void update();
+
+        // calls the function for every actor whose bounding box might overlap the box,
+        // the actors with culling disabled are always reported, the function must not query the index
+        template <class Function>
+        void query(const Box<float, 3>& box, Function function) const
+        {
+            for (const auto entry : unboundedEntries)
+                function(entries[entry].actor);
+
+            if (root == nullNode) return;
+
+            queryStack.clear();
+            queryStack.push_back(root);
+
+            while (!queryStack.empty())
+            {
+                const auto& node = nodes[queryStack.back()];
+                queryStack.pop_back();
+
+                if (!overlaps(node.box, box)) continue;
+
+                if (node.isLeaf())
+                    function(entries[node.entry].actor);
+                else
+                {
+                    queryStack.push_back(node.children[0]);
+                    queryStack.push_back(node.children[1]);
+                }
+            }
+        }
+
+        auto getHeight() const noexcept { return root == nullNode ? 0 : nodes[root].height; }
+
+    private:
+        using NodeIndex = std::int32_t;
+        static constexpr NodeIndex nullNode = -1;
+
+        struct Node final
+        {
+            bool isLeaf() const noexcept { return children[0] == nullNode; }
+
+            Box<float, 3> box; // enlarged for the leaves, so that small movements do not change the tree
+            NodeIndex parent = nullNode; // next free node if the node is not used
+            NodeIndex children[2]{nullNode, nullNode};
+            std::int32_t height = 0; // 0 for the leaves
+            std::uint32_t entry = 0;
+        };
+
+        struct Entry final
+        {
+            Actor* actor = nullptr; // nullptr if the entry is free
+            NodeIndex node = nullNode;
+            std::uint32_t unboundedPosition = 0;
+            bool unbounded = false;
+            bool queued = false;
+        };
+
+        static bool overlaps(const Box<float, 3>& a, const Box<float, 3>& b) noexcept
+        {
+            return a.min.v[0] <= b.max.v[0] && a.max.v[0] >= b.min.v[0] &&
+                a.min.v[1] <= b.max.v[1] && a.max.v[1] >= b.min.v[1] &&
+                a.min.v[2] <= b.max.v[2] && a.max.v[2] >= b.min.v[2];
+        }
+
+        static bool contains(const Box<float, 3>& a, const Box<float, 3>& b) noexcept
+        {
+            return a.min.v[0] <= b.min.v[0] && a.max.v[0] >= b.max.v[0] &&
+                a.min.v[1] <= b.min.v[1] && a.max.v[1] >= b.max.v[1] &&
+                a.min.v[2] <= b.min.v[2] && a.max.v[2] >= b.max.v[2];
+        }
+
+        void updateEntry(std::uint32_t entryIndex);
+        void setUnbounded(Entry& entry, std::uint32_t entryIndex, bool unbounded);
+
+        NodeIndex allocateNode();
+        void freeNode(NodeIndex index) noexcept;
+        void insertLeaf(NodeIndex leaf);
+        void removeLeaf(NodeIndex leaf) noexcept;
+        NodeIndex balance(NodeIndex index) noexcept;
+        void refit(NodeIndex index) noexcept;
+
+        std::vector<Node> nodes;
+        NodeIndex root = nullNode;
+        NodeIndex freeNodes = nullNode;
+
+        std::vector<Entry> entries;
+        std::vector<std::uint32_t> freeEntries;
+        std::vector<std::uint32_t> queuedEntries;
+        std::vector<std::uint32_t> unboundedEntries;
+
+        mutable std::vector<NodeIndex> queryStack;
+    };
+}
+
+#endif // OUZEL_SCENE_SPATIALINDEX_HPP
@@ -0,0 +1,106 @@
+// Ouzel by Elviss Strazdins
+
+#include <limits>
+#include "SpriteBatch.hpp"
+#include "../core/Engine.hpp"
+#include "../utils/Utils.hpp"
+
+namespace ouzel::scene
+{
+    namespace
+    {
+        constexpr std::uint8_t modulate(std::uint8_t a, std::uint8_t b) noexcept
+        {
+            return static_cast<std::uint8_t>((static_cast<std::uint32_t>(a) * b + 127U) / 255U);
+        }
+    }
+
+    void SpriteBatch::reset()
+    {
+        vertices.clear();
+        indices.clear();
+        currentBuffers = 0;
+
+        // the shader can be replaced in the cache between the frames
+        textureShader = engine->getCache().getShader(shaderTexture);
+    }
+
+    void SpriteBatch::draw(const std::vector<graphics::Vertex>& spriteVertices,
+                           const std::vector<std::uint16_t>& spriteIndices,
+                           const Matrix<float, 4>& transformMatrix,
+                           Color color,
+                           const Matrix<float, 4>& renderViewProjection,
+                           const graphics::Material& material,
+                           bool wireframe)
+    {
+        State newState;
+        newState.blendState = material.blendState->getResource();
+        newState.shader = material.shader->getResource();
+        for (std::size_t layer = 0; layer < graphics::Material::textureLayers; ++layer)
+            newState.textures[layer] = material.textures[layer] ? material.textures[layer]->getResource() : 0;
+        newState.wireframe = wireframe;
+        newState.renderViewProjection = renderViewProjection;
+
+        if (!indices.empty() &&
+            (newState != state ||
+             vertices.size() + spriteVertices.size() > std::numeric_limits<std::uint16_t>::max() + 1U))
+            flush();
+
+        state = newState;
+
+        const auto firstVertex = static_cast<std::uint16_t>(vertices.size());
+
+        for (const graphics::Vertex& spriteVertex : spriteVertices)
+        {
+            graphics::Vertex& vertex = vertices.emplace_back(spriteVertex);
+            transformMatrix.transformPoint(spriteVertex.position, vertex.position);
+            vertex.color = Color{
+                modulate(spriteVertex.color.v[0], color.v[0]),
+                modulate(spriteVertex.color.v[1], color.v[1]),
+                modulate(spriteVertex.color.v[2], color.v[2]),
+                modulate(spriteVertex.color.v[3], color.v[3])
+            };
+        }
+
+        for (const std::uint16_t index : spriteIndices)
+            indices.push_back(static_cast<std::uint16_t>(firstVertex + index));
+    }
+
+    void SpriteBatch::flush()
+    {
+        if (indices.empty()) return;
+
+        graphics::Graphics& graphics = *engine->getGraphics();
+
+        if (currentBuffers == buffers.size())
+            buffers.push_back(Buffers{
+                graphics::Buffer{graphics, graphics::BufferType::index, graphics::Flags::dynamic},
+                graphics::Buffer{graphics, graphics::BufferType::vertex, graphics::Flags::dynamic}
+            });
+
+        Buffers& currentBuffer = buffers[currentBuffers++];
+        currentBuffer.indexBuffer.setData(indices.data(), static_cast<std::uint32_t>(getVectorSize(indices)));
+        currentBuffer.vertexBuffer.setData(vertices.data(), static_cast<std::uint32_t>(getVectorSize(vertices)));
+
+        // the sprite color is baked into the vertex colors
+        const float colorVector[] = {1.0F, 1.0F, 1.0F, 1.0F};
+
+        graphics.setPipelineState(state.blendState,
+                                  state.shader,
+                                  graphics::CullMode::none,
+                                  state.wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
+        graphics.setShaderConstants({{colorVector, std::size(colorVector)}},
+                                    {{state.renderViewProjection.m.data(), state.renderViewProjection.m.size()}});
+        textures.assign(state.textures.begin(), state.textures.end());
+        graphics.setTextures(textures);
+        graphics.draw(currentBuffer.indexBuffer.getResource(),
+                      static_cast<std::uint32_t>(indices.size()),
+                      sizeof(std::uint16_t),
+                      currentBuffer.vertexBuffer.getResource(),
+                      graphics::DrawMode::triangleList,
+                      0);
+
+        vertices.clear();
+        indices.clear();
+    }
+}
@@ -0,0 +1,91 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SCENE_SPRITEBATCH_HPP
+#define OUZEL_SCENE_SPRITEBATCH_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "../graphics/Buffer.hpp"
+#include "../graphics/Material.hpp"
+#include "../graphics/Vertex.hpp"
+#include "../math/Color.hpp"
+#include "../math/Matrix.hpp"
+
+namespace ouzel::scene
+{
+    // merges consecutive sprites that share the shader, blend state and textures into one draw call,
+    // only the sprites drawn with the texture shader are batched, because their vertices are transformed on the CPU
+    class SpriteBatch final
+    {
+    public:
+        SpriteBatch() = default;
+
+        SpriteBatch(const SpriteBatch&) = delete;
+        SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+        SpriteBatch(SpriteBatch&&) = delete;
+        SpriteBatch& operator=(SpriteBatch&&) = delete;
+
+        void reset();
+
+        // false if the material uses a custom shader, which can expect different constants
+        bool canDraw(const graphics::Material& material) const noexcept
+        {
+            return textureShader && material.shader == textureShader;
+        }
+
+        void draw(const std::vector<graphics::Vertex>& spriteVertices,
+                  const std::vector<std::uint16_t>& spriteIndices,
+                  const Matrix<float, 4>& transformMatrix,
+                  Color color,
+                  const Matrix<float, 4>& renderViewProjection,
+                  const graphics::Material& material,
+                  bool wireframe);
+
+        void flush();
+
+    private:
+        struct State final
+        {
+            std::size_t blendState = 0;
+            std::size_t shader = 0;
+            std::array<std::size_t, graphics::Material::textureLayers> textures{};
+            bool wireframe = false;
+            Matrix<float, 4> renderViewProjection;
+
+            bool operator==(const State& other) const noexcept
+            {
+                return blendState == other.blendState &&
+                    shader == other.shader &&
+                    textures == other.textures &&
+                    wireframe == other.wireframe &&
+                    renderViewProjection == other.renderViewProjection;
+            }
+
+            bool operator!=(const State& other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        struct Buffers final
+        {
+            graphics::Buffer indexBuffer;
+            graphics::Buffer vertexBuffer;
+        };
+
+        const graphics::Shader* textureShader = nullptr;
+
+        State state;
+        std::vector<std::size_t> textures; // reused by flush
+        std::vector<graphics::Vertex> vertices;
+        std::vector<std::uint16_t> indices;
+
+        // every flush in a frame gets its own buffers, so that the data is uploaded only once per buffer
+        std::vector<Buffers> buffers;
+        std::size_t currentBuffers = 0;
+    };
+}
+
+#endif // OUZEL_SCENE_SPRITEBATCH_HPP
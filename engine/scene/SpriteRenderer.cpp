@@ -98,6 +98,8 @@ namespace ouzel::scene
                                                           graphics::Flags::none,
                                                           vertices.data(),
                                                           static_cast<std::uint32_t>(getVectorSize(vertices)));
+        indexData = indices;
+        vertexData = vertices;
     }
 
     SpriteData::Frame::Frame(const std::string& frameName,
@@ -121,6 +123,8 @@ namespace ouzel::scene
                                                           graphics::Flags::none,
                                                           vertices.data(),
                                                           static_cast<std::uint32_t>(getVectorSize(vertices)));
+        indexData = indices;
+        vertexData = vertices;
     }
 
     SpriteData::Frame::Frame(const std::string& frameName,
@@ -154,15 +158,12 @@ namespace ouzel::scene
                                                           graphics::Flags::none,
                                                           vertices.data(),
                                                           static_cast<std::uint32_t>(getVectorSize(vertices)));
+        indexData = indices;
+        vertexData = vertices;
     }
 
     SpriteRenderer::SpriteRenderer()
     {
-        updateHandler.updateHandler = [this](const UpdateEvent& event) {
-            update(event.delta);
-            return false;
-        };
-
         currentAnimation = animationQueue.end();
     }
 
@@ -186,6 +187,11 @@ namespace ouzel::scene
         init(texture, spritesX, spritesY, pivot);
     }
 
+    SpriteRenderer::~SpriteRenderer()
+    {
+        engine->getUpdateScheduler().removeSpriteRenderer(*this);
+    }
+
     void SpriteRenderer::init(const SpriteData& spriteData)
     {
         material = std::make_shared<graphics::Material>();
@@ -352,10 +358,15 @@ namespace ouzel::scene
                               const Matrix<float, 4>& renderViewProjection,
                               bool wireframe)
     {
-        Component::draw(transformMatrix,
-                        opacity,
-                        renderViewProjection,
-                        wireframe);
+        // the sprites with a custom shader are drawn on their own
+        const bool batching = layer && layer->isSpriteBatching() &&
+            material && layer->getSpriteBatch().canDraw(*material);
+
+        if (!batching)
+            Component::draw(transformMatrix,
+                            opacity,
+                            renderViewProjection,
+                            wireframe);
 
         if (currentAnimation != animationQueue.end() &&
             currentAnimation->animation->frameInterval > 0.0F &&
@@ -366,6 +377,26 @@ namespace ouzel::scene
             if (currentFrame >= currentAnimation->animation->frames.size())
                 currentFrame = currentAnimation->animation->frames.size() - 1;
 
+            const auto& frame = currentAnimation->animation->frames[currentFrame];
+
+            if (batching)
+            {
+                layer->getMeshBatch().flush();
+                layer->getSpriteBatch().draw(frame.getVertexData(),
+                                             frame.getIndexData(),
+                                             transformMatrix * offsetMatrix,
+                                             Color{
+                                                 material->diffuseColor.normR(),
+                                                 material->diffuseColor.normG(),
+                                                 material->diffuseColor.normB(),
+                                                 material->diffuseColor.normA() * opacity * material->opacity
+                                             },
+                                             renderViewProjection,
+                                             *material,
+                                             wireframe);
+                return;
+            }
+
             const auto modelViewProj = renderViewProjection * transformMatrix * offsetMatrix;
             const float colorVector[] = {
                 material->diffuseColor.normR(),
@@ -374,12 +405,6 @@ namespace ouzel::scene
                 material->diffuseColor.normA() * opacity * material->opacity
             };
 
-            std::vector<std::vector<float>> fragmentShaderConstants(1);
-            fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
-
-            std::vector<std::vector<float>> vertexShaderConstants(1);
-            vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
-
             std::vector<std::size_t> textures;
             textures.reserve(graphics::Material::textureLayers);
             for (const std::shared_ptr<graphics::Texture>& texture : material->textures)
@@ -389,12 +414,10 @@ namespace ouzel::scene
                                                     material->shader->getResource(),
                                                     graphics::CullMode::none,
                                                     wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
-            engine->getGraphics()->setShaderConstants(fragmentShaderConstants,
-                                                      vertexShaderConstants);
+            engine->getGraphics()->setShaderConstants({{colorVector, std::size(colorVector)}},
+                                                      {{modelViewProj.m.data(), modelViewProj.m.size()}});
             engine->getGraphics()->setTextures(textures);
 
-            const auto& frame = currentAnimation->animation->frames[currentFrame];
-
             engine->getGraphics()->draw(frame.getIndexBuffer()->getResource(),
                                         frame.getIndexCount(),
                                         sizeof(std::uint16_t),
@@ -415,7 +438,7 @@ namespace ouzel::scene
     {
         if (!playing)
         {
-            engine->getEventDispatcher().addEventHandler(updateHandler);
+            engine->getUpdateScheduler().addSpriteRenderer(*this);
             playing = true;
             running = true;
         }
@@ -427,7 +450,7 @@ namespace ouzel::scene
         {
             playing = false;
             running = false;
-            updateHandler.remove();
+            engine->getUpdateScheduler().removeSpriteRenderer(*this);
         }
 
         if (resetAnimation) reset();
@@ -537,5 +560,7 @@ namespace ouzel::scene
         }
         else
             boundingBox.reset();
+
+        Component::updateBoundingBox();
     }
 }
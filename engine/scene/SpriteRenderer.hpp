@@ -8,11 +8,11 @@
 #include <memory>
 #include <vector>
 #include "Component.hpp"
+#include "UpdateScheduler.hpp"
 #include "../math/Box.hpp"
 #include "../math/Rect.hpp"
 #include "../math/Size.hpp"
 #include "../math/Vector.hpp"
-#include "../events/EventHandler.hpp"
 #include "../graphics/BlendState.hpp"
 #include "../graphics/Buffer.hpp"
 #include "../graphics/Material.hpp"
@@ -54,6 +54,8 @@ namespace ouzel::scene
             auto getIndexCount() const noexcept { return indexCount; }
             auto& getIndexBuffer() const noexcept { return indexBuffer; }
             auto& getVertexBuffer() const noexcept { return vertexBuffer; }
+            auto& getIndexData() const noexcept { return indexData; }
+            auto& getVertexData() const noexcept { return vertexData; }
 
         private:
             std::string name;
@@ -61,6 +63,10 @@ namespace ouzel::scene
             std::uint32_t indexCount = 0;
             std::shared_ptr<graphics::Buffer> indexBuffer;
             std::shared_ptr<graphics::Buffer> vertexBuffer;
+
+            // CPU copies of the geometry used by the sprite batch
+            std::vector<std::uint16_t> indexData;
+            std::vector<graphics::Vertex> vertexData;
         };
 
         struct Animation final
@@ -78,6 +84,7 @@ namespace ouzel::scene
 
     class SpriteRenderer: public Component
     {
+        friend UpdateScheduler;
     public:
         SpriteRenderer();
         explicit SpriteRenderer(const SpriteData& spriteData);
@@ -85,6 +92,7 @@ namespace ouzel::scene
         explicit SpriteRenderer(std::shared_ptr<graphics::Texture> texture,
                                 std::uint32_t spritesX = 1, std::uint32_t spritesY = 1,
                                 const Vector<float, 2>& pivot = Vector<float, 2>{0.5F, 0.5F});
+        ~SpriteRenderer() override;
 
         void init(const SpriteData& spriteData);
         void init(const std::string& filename);
@@ -100,6 +108,7 @@ namespace ouzel::scene
                   bool wireframe) override;
 
         auto& getMaterial() const noexcept { return material; }
+        std::uint32_t getSortKey() const noexcept override { return material ? material->getSortKey() : 0; }
         void setMaterial(const std::shared_ptr<graphics::Material>& newMaterial) { material = newMaterial; }
 
         auto& getOffset() const noexcept { return offset; }
@@ -141,7 +150,7 @@ namespace ouzel::scene
         bool running = false;
         float currentTime = 0.0F;
 
-        EventHandler updateHandler;
+        std::size_t updateIndex = UpdateScheduler::noIndex; // position in the list of the update scheduler
     };
 }
 
@@ -2,6 +2,7 @@
 
 #include <limits>
 #include "StaticMeshRenderer.hpp"
+#include "Layer.hpp"
 #include "../core/Engine.hpp"
 #include "../utils/Utils.hpp"
 
@@ -60,7 +61,7 @@ namespace ouzel::scene
 
     void StaticMeshRenderer::init(const StaticMeshData& meshData)
     {
-        boundingBox = meshData.boundingBox;
+        setBoundingBox(meshData.boundingBox);
         material = meshData.material;
         indexCount = meshData.indexCount;
         indexSize = meshData.indexSize;
@@ -68,11 +69,36 @@ namespace ouzel::scene
         vertexBuffer = &meshData.vertexBuffer;
     }
 
+    std::uint32_t StaticMeshRenderer::getSortKey() const noexcept
+    {
+        if (!material) return 0;
+
+        // the actors with the same mesh and material end up next to each other, so that they can be instanced
+        auto hash = static_cast<std::uint64_t>(material->getSortKey());
+        hash = (hash ^ static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(vertexBuffer))) * 1099511628211ULL;
+        return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+    }
+
     void StaticMeshRenderer::draw(const Matrix<float, 4>& transformMatrix,
                                   float opacity,
                                   const Matrix<float, 4>& renderViewProjection,
                                   bool wireframe)
     {
+        if (layer && layer->isMeshInstancing() && layer->getMeshBatch().canDraw(*material))
+        {
+            // sprites batched before this mesh must be drawn first
+            layer->getSpriteBatch().flush();
+            layer->getMeshBatch().draw(*indexBuffer,
+                                       indexCount,
+                                       indexSize,
+                                       *vertexBuffer,
+                                       renderViewProjection * transformMatrix,
+                                       opacity,
+                                       *material,
+                                       wireframe);
+            return;
+        }
+
         Component::draw(transformMatrix,
                         opacity,
                         renderViewProjection,
@@ -86,12 +112,6 @@ namespace ouzel::scene
             material->diffuseColor.normA() * opacity * material->opacity
         };
 
-        std::vector<std::vector<float>> fragmentShaderConstants(1);
-        fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
-
-        std::vector<std::vector<float>> vertexShaderConstants(1);
-        vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
-
         std::vector<std::size_t> textures;
         for (const std::shared_ptr<graphics::Texture>& texture : material->textures)
             textures.push_back(texture ? texture->getResource() : 0);
@@ -100,8 +120,8 @@ namespace ouzel::scene
                                                 material->shader->getResource(),
                                                 material->cullMode,
                                                 wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
-        engine->getGraphics()->setShaderConstants(fragmentShaderConstants,
-                                                  vertexShaderConstants);
+        engine->getGraphics()->setShaderConstants({{colorVector, std::size(colorVector)}},
+                                                  {{modelViewProj.m.data(), modelViewProj.m.size()}});
         engine->getGraphics()->setTextures(textures);
         engine->getGraphics()->draw(indexBuffer->getResource(),
                                     indexCount,
@@ -42,6 +42,7 @@ namespace ouzel::scene
                   bool wireframe) override;
 
         auto& getMaterial() const noexcept { return material; }
+        std::uint32_t getSortKey() const noexcept override;
         void setMaterial(const graphics::Material* newMaterial)
         {
             material = newMaterial;
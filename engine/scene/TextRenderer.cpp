@@ -31,6 +31,7 @@ namespace ouzel::scene
 
         font = engine->getCache().getFont(fontFile);
 
+        updateShader();
         updateText();
     }
 
@@ -38,6 +39,7 @@ namespace ouzel::scene
     {
         font = engine->getCache().getFont(fontFile);
 
+        updateShader();
         updateText();
     }
 
@@ -65,10 +67,12 @@ namespace ouzel::scene
                         renderViewProjection,
                         wireframe);
 
+        if (renderData.indices.empty()) return;
+
         if (needsMeshUpdate)
         {
-            indexBuffer.setData(indices.data(), static_cast<std::uint32_t>(getVectorSize(indices)));
-            vertexBuffer.setData(vertices.data(), static_cast<std::uint32_t>(getVectorSize(vertices)));
+            indexBuffer.setData(renderData.indices.data(), static_cast<std::uint32_t>(getVectorSize(renderData.indices)));
+            vertexBuffer.setData(renderData.vertices.data(), static_cast<std::uint32_t>(getVectorSize(renderData.vertices)));
 
             needsMeshUpdate = false;
         }
@@ -76,25 +80,24 @@ namespace ouzel::scene
         const auto modelViewProj = renderViewProjection * transformMatrix;
         const float colorVector[] = {color.normR(), color.normG(), color.normB(), color.normA() * opacity};
 
-        std::vector<std::vector<float>> fragmentShaderConstants(1);
-        fragmentShaderConstants[0] = {std::begin(colorVector), std::end(colorVector)};
-
-        std::vector<std::vector<float>> vertexShaderConstants(1);
-        vertexShaderConstants[0] = {std::begin(modelViewProj.m), std::end(modelViewProj.m)};
-
         engine->getGraphics()->setPipelineState(blendState->getResource(),
                                                 shader->getResource(),
                                                 graphics::CullMode::none,
                                                 wireframe ? graphics::FillMode::wireframe : graphics::FillMode::solid);
-        engine->getGraphics()->setShaderConstants(fragmentShaderConstants,
-                                                  vertexShaderConstants);
-        engine->getGraphics()->setTextures({wireframe ? whitePixelTexture->getResource() : texture ? texture->getResource() : 0U});
-        engine->getGraphics()->draw(indexBuffer.getResource(),
-                                    static_cast<std::uint32_t>(indices.size()),
-                                    sizeof(std::uint16_t),
-                                    vertexBuffer.getResource(),
-                                    graphics::DrawMode::triangleList,
-                                    0);
+        engine->getGraphics()->setShaderConstants({{colorVector, std::size(colorVector)}},
+                                                  {{modelViewProj.m.data(), modelViewProj.m.size()}});
+
+        // the glyphs can be on different pages of the glyph atlas
+        for (const auto& batch : renderData.batches)
+        {
+            engine->getGraphics()->setTextures({wireframe ? whitePixelTexture->getResource() : batch.texture ? batch.texture->getResource() : 0U});
+            engine->getGraphics()->draw(indexBuffer.getResource(),
+                                        batch.indexCount,
+                                        sizeof(std::uint16_t),
+                                        vertexBuffer.getResource(),
+                                        graphics::DrawMode::triangleList,
+                                        batch.startIndex);
+        }
     }
 
     void TextRenderer::setText(const std::string& newText)
@@ -109,23 +112,31 @@ namespace ouzel::scene
         color = newColor;
     }
 
+    void TextRenderer::updateShader()
+    {
+        if (customShader) return;
+
+        const auto& cache = engine->getCache();
+        shader = cache.getShader(font && font->isDistanceField() ? shaderDistanceField : shaderTexture);
+    }
+
     void TextRenderer::updateText()
     {
         boundingBox.reset();
 
         if (font)
         {
-            std::tie(indices, vertices, texture) = font->getRenderData(text, Color::white(), fontSize, textAnchor);
+            renderData = font->getRenderData(text, Color::white(), fontSize, textAnchor);
             needsMeshUpdate = true;
 
-            for (const graphics::Vertex& vertex : vertices)
+            for (const graphics::Vertex& vertex : renderData.vertices)
                 boundingBox.insertPoint(vertex.position);
         }
         else
         {
-            indices.clear();
-            vertices.clear();
-            texture.reset();
+            renderData = gui::Font::RenderData{};
         }
+
+        updateBoundingBox();
     }
 }
@@ -46,6 +46,7 @@ namespace ouzel::scene
         void setShader(const graphics::Shader* newShader)
         {
             shader = newShader;
+            customShader = true;
         }
 
         auto& getBlendState() const noexcept { return blendState; }
@@ -55,15 +56,16 @@ namespace ouzel::scene
         }
 
     private:
+        void updateShader();
         void updateText();
 
         const graphics::Shader* shader = nullptr;
+        bool customShader = false; // otherwise the shader is chosen by the type of the font
         const graphics::BlendState* blendState = nullptr;
 
         graphics::Buffer indexBuffer;
         graphics::Buffer vertexBuffer;
 
-        std::shared_ptr<graphics::Texture> texture;
         std::shared_ptr<graphics::Texture> whitePixelTexture;
 
         const gui::Font* font = nullptr;
@@ -71,8 +73,7 @@ namespace ouzel::scene
         float fontSize = 1.0F;
         Vector<float, 2> textAnchor;
 
-        std::vector<std::uint16_t> indices;
-        std::vector<graphics::Vertex> vertices;
+        gui::Font::RenderData renderData;
 
         Color color = Color::white();
 
@@ -0,0 +1,207 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include "TransformHierarchy.hpp"
+#include "Actor.hpp"
+
+namespace ouzel::scene
+{
+    TransformHierarchy::Index TransformHierarchy::add(const Actor& actor, Index parent)
+    {
+        // appending keeps the parents before their children
+        const auto index = static_cast<Index>(actors.size());
+
+        parents.push_back(parent);
+        flags.push_back(localTransformDirty | transformDirty | inverseTransformDirty);
+        versions.push_back(0);
+        parentVersions.push_back(0);
+        actors.push_back(&actor);
+        localTransforms.emplace_back();
+        transforms.emplace_back();
+        inverseTransforms.emplace_back();
+        traversalIndices.push_back(0);
+
+        changed = true;
+        orderChanged = true;
+
+        return index;
+    }
+
+    void TransformHierarchy::remove(Index index) noexcept
+    {
+        actors[index] = nullptr;
+        ++freeCount;
+        changed = true;
+        orderChanged = true;
+    }
+
+    const Matrix<float, 4>& TransformHierarchy::getLocalTransform(Index index)
+    {
+        if (flags[index] & localTransformDirty)
+        {
+            actors[index]->calculateLocalTransform(localTransforms[index]);
+            flags[index] = (flags[index] & ~localTransformDirty) | transformDirty;
+        }
+
+        return localTransforms[index];
+    }
+
+    const Matrix<float, 4>& TransformHierarchy::getTransform(Index index)
+    {
+        // nothing has changed since the last update
+        if (changed) updateTransform(index);
+
+        return transforms[index];
+    }
+
+    const Matrix<float, 4>& TransformHierarchy::getInverseTransform(Index index)
+    {
+        if (changed) updateTransform(index);
+
+        if (flags[index] & inverseTransformDirty)
+        {
+            inverseTransforms[index] = transforms[index];
+            inverseTransforms[index].invert();
+            flags[index] &= ~inverseTransformDirty;
+        }
+
+        return inverseTransforms[index];
+    }
+
+    void TransformHierarchy::update()
+    {
+        if (freeCount > actors.size() / 2) compact();
+
+        if (!changed) return;
+
+        if (orderChanged) updateTraversalIndices();
+
+        for (Index index = 0; index < actors.size(); ++index)
+        {
+            const auto actor = actors[index];
+            if (!actor) continue;
+
+            if (isTransformDirty(index)) calculateTransform(index);
+
+            // the setters of the actor notify about the changes of the local transform,
+            // the flag is set by calculateTransform, so the changes seen by the queries between the updates are not lost
+            if (flags[index] & parentTransformChanged)
+                changedActors.push_back(index);
+        }
+
+        changed = false;
+    }
+
+    void TransformHierarchy::notifyActors()
+    {
+        // the index of an actor that was recorded twice has its flag cleared the first time
+        for (const auto index : changedActors)
+            if (const auto actor = actors[index]; actor && (flags[index] & parentTransformChanged))
+            {
+                flags[index] &= ~parentTransformChanged;
+                actor->updateTransform();
+            }
+
+        changedActors.clear();
+    }
+
+    void TransformHierarchy::updateTransform(Index index)
+    {
+        if (const auto parent = parents[index]; parent != noIndex)
+            updateTransform(parent);
+
+        if (isTransformDirty(index)) calculateTransform(index);
+    }
+
+    void TransformHierarchy::calculateTransform(Index index)
+    {
+        const auto& localTransform = getLocalTransform(index);
+
+        if (const auto parent = parents[index]; parent != noIndex)
+        {
+            transforms[parent].multiply(localTransform, transforms[index]);
+            if (parentVersions[index] != versions[parent])
+            {
+                parentVersions[index] = versions[parent];
+                flags[index] |= parentTransformChanged;
+            }
+        }
+        else
+            transforms[index] = localTransform;
+
+        ++versions[index];
+        flags[index] = static_cast<std::uint8_t>((flags[index] & ~transformDirty) | inverseTransformDirty);
+    }
+
+    void TransformHierarchy::compact()
+    {
+        remap.resize(actors.size());
+
+        // the actors that were not notified yet keep their flags and get new indices after the move
+        changedActors.erase(std::remove_if(changedActors.begin(), changedActors.end(), [this](Index index) noexcept {
+            return !actors[index];
+        }), changedActors.end());
+
+        Index count = 0;
+        for (Index index = 0; index < actors.size(); ++index)
+        {
+            if (!actors[index]) continue;
+
+            // the parent was already moved, because it comes before the child
+            const auto parent = parents[index];
+            parents[count] = (parent == noIndex) ? noIndex : remap[parent];
+            flags[count] = flags[index];
+            versions[count] = versions[index];
+            parentVersions[count] = parentVersions[index];
+            actors[count] = actors[index];
+            localTransforms[count] = localTransforms[index];
+            transforms[count] = transforms[index];
+            inverseTransforms[count] = inverseTransforms[index];
+
+            actors[count]->transformIndex = count;
+            remap[index] = count++;
+        }
+
+        for (auto& index : changedActors) index = remap[index];
+
+        parents.resize(count);
+        flags.resize(count);
+        versions.resize(count);
+        parentVersions.resize(count);
+        actors.resize(count);
+        localTransforms.resize(count);
+        transforms.resize(count);
+        inverseTransforms.resize(count);
+        traversalIndices.resize(count);
+
+        freeCount = 0;
+    }
+
+    void TransformHierarchy::updateTraversalIndices()
+    {
+        std::uint32_t traversalIndex = 0;
+
+        // all of the actors without a parent actor are the children of the topmost container,
+        // unless the topmost container is an actor without a parent
+        for (Index index = 0; index < actors.size(); ++index)
+            if (const auto actor = actors[index]; actor && parents[index] == noIndex)
+            {
+                if (actor->parent)
+                    for (const auto child : actor->parent->getChildren())
+                        updateTraversalIndices(*child, traversalIndex);
+                else
+                    updateTraversalIndices(*actor, traversalIndex);
+                break;
+            }
+
+        orderChanged = false;
+    }
+
+    void TransformHierarchy::updateTraversalIndices(const Actor& actor, std::uint32_t& traversalIndex)
+    {
+        traversalIndices[actor.transformIndex] = traversalIndex++;
+
+        for (const auto child : actor.getChildren())
+            updateTraversalIndices(*child, traversalIndex);
+    }
+}
@@ -0,0 +1,110 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SCENE_TRANSFORMHIERARCHY_HPP
+#define OUZEL_SCENE_TRANSFORMHIERARCHY_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../math/Matrix.hpp"
+
+namespace ouzel::scene
+{
+    class Actor;
+
+    // stores the transforms of all of the actors below the topmost container in contiguous arrays,
+    // the parents always come before their children, so that the changed subtrees are updated in one pass
+    class TransformHierarchy final
+    {
+    public:
+        using Index = std::uint32_t;
+        static constexpr Index noIndex = std::numeric_limits<Index>::max();
+
+        TransformHierarchy() = default;
+
+        TransformHierarchy(const TransformHierarchy&) = delete;
+        TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+        TransformHierarchy(TransformHierarchy&&) = delete;
+        TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+
+        // the parent must already be in the hierarchy
+        Index add(const Actor& actor, Index parent);
+        // the children must be removed too before the next update
+        void remove(Index index) noexcept;
+
+        // recalculates the local transform from the position, rotation and scale of the actor
+        void setLocalTransformDirty(Index index) noexcept
+        {
+            flags[index] |= localTransformDirty;
+            changed = true;
+        }
+
+        // the children of one of the containers were reordered
+        void setOrderChanged() noexcept
+        {
+            orderChanged = true;
+            changed = true;
+        }
+
+        const Matrix<float, 4>& getLocalTransform(Index index);
+        const Matrix<float, 4>& getTransform(Index index);
+        const Matrix<float, 4>& getInverseTransform(Index index);
+
+        // recalculates the world transforms of the changed subtrees and records the actors whose parent moved,
+        // touches nothing outside of the hierarchy, so the hierarchies of the layers can be updated in parallel
+        void update();
+        // notifies the actors recorded by update, their components can touch anything, so this is called on one thread
+        void notifyActors();
+
+        auto getSize() const noexcept { return actors.size() - freeCount; }
+
+        auto getParent(Index index) const noexcept { return parents[index]; }
+        // position of the actor in the pre-order traversal of the containers as of the last update
+        auto getTraversalIndex(Index index) const noexcept { return traversalIndices[index]; }
+        auto getActor(Index index) const noexcept { return actors[index]; }
+
+    private:
+        enum Flags: std::uint8_t
+        {
+            localTransformDirty = 0x01,
+            transformDirty = 0x02,
+            inverseTransformDirty = 0x04,
+            parentTransformChanged = 0x08 // the actor is notified on the next update
+        };
+
+        bool isTransformDirty(Index index) const noexcept
+        {
+            const auto parent = parents[index];
+            return (flags[index] & (localTransformDirty | transformDirty)) ||
+                (parent != noIndex && parentVersions[index] != versions[parent]);
+        }
+
+        void updateTransform(Index index);
+        void calculateTransform(Index index);
+        void compact();
+        void updateTraversalIndices();
+        void updateTraversalIndices(const Actor& actor, std::uint32_t& traversalIndex);
+
+        // hot data used by the update pass
+        std::vector<Index> parents;
+        std::vector<std::uint8_t> flags;
+        std::vector<std::uint32_t> versions; // incremented every time the world transform changes
+        std::vector<std::uint32_t> parentVersions; // version of the parent the world transform was calculated from
+
+        std::vector<const Actor*> actors; // nullptr for the removed actors
+        std::vector<Matrix<float, 4>> localTransforms;
+        std::vector<Matrix<float, 4>> transforms;
+        std::vector<Matrix<float, 4>> inverseTransforms;
+        // the actors are stored in the order they were added in, which differs from the traversal order
+        std::vector<std::uint32_t> traversalIndices;
+
+        std::vector<Index> changedActors; // recorded by update for notifyActors
+        std::vector<Index> remap; // reused by compact
+        std::size_t freeCount = 0;
+        bool changed = false;
+        bool orderChanged = false;
+    };
+}
+
+#endif // OUZEL_SCENE_TRANSFORMHIERARCHY_HPP
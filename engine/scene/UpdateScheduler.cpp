@@ -0,0 +1,161 @@
+// Ouzel by Elviss Strazdins
+
+#include "UpdateScheduler.hpp"
+#include "Animator.hpp"
+#include "ParticleSystem.hpp"
+#include "SpriteRenderer.hpp"
+#include "../core/Engine.hpp"
+
+namespace ouzel::scene
+{
+    UpdateScheduler::~UpdateScheduler()
+    {
+        clear(particleSystems);
+        clear(animators);
+        clear(spriteRenderers);
+    }
+
+    void UpdateScheduler::addAnimator(Animator& animator)
+    {
+        add(animators, animator);
+    }
+
+    void UpdateScheduler::removeAnimator(Animator& animator) noexcept
+    {
+        remove(animators, animator);
+    }
+
+    void UpdateScheduler::addParticleSystem(ParticleSystem& particleSystem)
+    {
+        add(particleSystems, particleSystem);
+    }
+
+    void UpdateScheduler::removeParticleSystem(ParticleSystem& particleSystem) noexcept
+    {
+        remove(particleSystems, particleSystem);
+    }
+
+    void UpdateScheduler::addSpriteRenderer(SpriteRenderer& spriteRenderer)
+    {
+        add(spriteRenderers, spriteRenderer);
+    }
+
+    void UpdateScheduler::removeSpriteRenderer(SpriteRenderer& spriteRenderer) noexcept
+    {
+        remove(spriteRenderers, spriteRenderer);
+    }
+
+    void UpdateScheduler::update(float delta)
+    {
+        // fixed step phase
+        fixedTime += delta;
+
+        for (std::uint32_t step = 0; fixedTime >= fixedStep; ++step)
+        {
+            // a long hitch would otherwise be caught up with an unbounded number of steps
+            if (step == maxFixedSteps)
+            {
+                fixedTime = 0.0F;
+                break;
+            }
+
+            fixedTime -= fixedStep;
+            updateParticleSystems(fixedStep);
+        }
+
+        // variable step phase
+        update(animators, delta);
+        update(spriteRenderers, delta);
+    }
+
+    template <class T>
+    void UpdateScheduler::add(UpdateList<T>& list, T& object)
+    {
+        if (object.updateIndex != noIndex) return;
+
+        object.updateIndex = list.objects.size();
+        list.objects.push_back(&object);
+    }
+
+    template <class T>
+    void UpdateScheduler::remove(UpdateList<T>& list, T& object) noexcept
+    {
+        if (object.updateIndex == noIndex) return;
+
+        // the list is compacted after the update, so that the objects keep their order
+        list.objects[object.updateIndex] = nullptr;
+        ++list.removedCount;
+        object.updateIndex = noIndex;
+    }
+
+    template <class T>
+    void UpdateScheduler::update(UpdateList<T>& list, float delta)
+    {
+        // the update can add objects to the list and reallocate it
+        const auto count = list.objects.size();
+
+        for (std::size_t i = 0; i < count; ++i)
+            if (const auto object = list.objects[i])
+                object->update(delta);
+
+        compact(list);
+    }
+
+    // the systems are simulated in parallel, everything that accesses the actors
+    // or dispatches events happens before or after that on the update thread
+    void UpdateScheduler::updateParticleSystems(float delta)
+    {
+        const auto count = particleSystems.objects.size();
+
+        for (std::size_t i = 0; i < count; ++i)
+            if (const auto particleSystem = particleSystems.objects[i])
+                particleSystem->prepareUpdate();
+
+        const auto updateParticleSystem = [this, delta](std::size_t i) {
+            if (const auto particleSystem = particleSystems.objects[i])
+                particleSystem->update(delta);
+        };
+
+        if (const auto jobSystem = engine->getJobSystem())
+            jobSystem->parallelFor(count, updateParticleSystem);
+        else
+            for (std::size_t i = 0; i < count; ++i)
+                updateParticleSystem(i);
+
+        // the finish event handlers can remove any of the systems
+        for (std::size_t i = 0; i < count; ++i)
+            if (const auto particleSystem = particleSystems.objects[i])
+                particleSystem->finishUpdate();
+
+        compact(particleSystems);
+    }
+
+    template <class T>
+    void UpdateScheduler::compact(UpdateList<T>& list) noexcept
+    {
+        if (list.removedCount)
+        {
+            std::size_t newSize = 0;
+
+            for (const auto object : list.objects)
+                if (object)
+                {
+                    object->updateIndex = newSize;
+                    list.objects[newSize++] = object;
+                }
+
+            list.objects.resize(newSize);
+            list.removedCount = 0;
+        }
+    }
+
+    template <class T>
+    void UpdateScheduler::clear(UpdateList<T>& list) noexcept
+    {
+        for (const auto object : list.objects)
+            if (object) object->updateIndex = noIndex;
+
+        list.objects.clear();
+        list.removedCount = 0;
+    }
+}
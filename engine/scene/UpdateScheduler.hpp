@@ -0,0 +1,70 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SCENE_UPDATESCHEDULER_HPP
+#define OUZEL_SCENE_UPDATESCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ouzel::scene
+{
+    class Animator;
+    class ParticleSystem;
+    class SpriteRenderer;
+
+    // updates the running animators, particle systems and sprite animations once per frame,
+    // the particle systems are stepped with a fixed time step on the job system and the rest with the frame time
+    class UpdateScheduler final
+    {
+    public:
+        static constexpr std::size_t noIndex = std::numeric_limits<std::size_t>::max();
+        static constexpr float fixedStep = 1.0F / 60.0F;
+        static constexpr std::uint32_t maxFixedSteps = 4; // per update, the rest of a long frame is dropped
+
+        UpdateScheduler() = default;
+        ~UpdateScheduler();
+
+        UpdateScheduler(const UpdateScheduler&) = delete;
+        UpdateScheduler& operator=(const UpdateScheduler&) = delete;
+
+        UpdateScheduler(UpdateScheduler&&) = delete;
+        UpdateScheduler& operator=(UpdateScheduler&&) = delete;
+
+        // the objects added during an update are first updated on the next one
+        void addAnimator(Animator& animator);
+        void removeAnimator(Animator& animator) noexcept;
+
+        void addParticleSystem(ParticleSystem& particleSystem);
+        void removeParticleSystem(ParticleSystem& particleSystem) noexcept;
+
+        void addSpriteRenderer(SpriteRenderer& spriteRenderer);
+        void removeSpriteRenderer(SpriteRenderer& spriteRenderer) noexcept;
+
+        void update(float delta);
+
+    private:
+        template <class T>
+        struct UpdateList final
+        {
+            std::vector<T*> objects; // the removed objects are set to nullptr until the end of the update
+            std::size_t removedCount = 0;
+        };
+
+        template <class T> static void add(UpdateList<T>& list, T& object);
+        template <class T> static void remove(UpdateList<T>& list, T& object) noexcept;
+        template <class T> static void update(UpdateList<T>& list, float delta);
+        template <class T> static void compact(UpdateList<T>& list) noexcept;
+        void updateParticleSystems(float delta);
+        template <class T> static void clear(UpdateList<T>& list) noexcept;
+
+        UpdateList<ParticleSystem> particleSystems;
+        UpdateList<Animator> animators;
+        UpdateList<SpriteRenderer> spriteRenderers;
+
+        float fixedTime = 0.0F; // not yet simulated by the fixed step phase
+    };
+}
+
+#endif // OUZEL_SCENE_UPDATESCHEDULER_HPP
@@ -0,0 +1,252 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_THREAD_JOBSYSTEM_HPP
+#define OUZEL_THREAD_JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Thread.hpp"
+
+namespace ouzel::thread
+{
+    // pool of worker threads, each with its own queue of jobs, the workers that run out of jobs
+    // steal them from the other queues and the thread that waits for a group helps to run them
+    class JobSystem final
+    {
+    public:
+        // jobs that are waited for together, the first exception thrown by them is rethrown by wait
+        class Group final
+        {
+            friend JobSystem;
+        public:
+            Group() = default;
+
+            Group(const Group&) = delete;
+            Group& operator=(const Group&) = delete;
+
+            Group(Group&&) = delete;
+            Group& operator=(Group&&) = delete;
+
+        private:
+            std::atomic_size_t pendingCount{0};
+            std::mutex exceptionMutex;
+            std::exception_ptr exception;
+        };
+
+        explicit JobSystem(std::size_t workerCount)
+        {
+            workers.reserve(workerCount);
+            for (std::size_t i = 0; i < workerCount; ++i)
+                workers.push_back(std::make_unique<Worker>());
+
+            // the workers are started after all of the queues exist, because they steal from each other
+            for (std::size_t i = 0; i < workerCount; ++i)
+                workers[i]->thread = Thread(&JobSystem::workerMain, this, i);
+        }
+
+        ~JobSystem()
+        {
+            std::unique_lock lock(sleepMutex);
+            running = false;
+            lock.unlock();
+            sleepCondition.notify_all();
+
+            for (const auto& worker : workers)
+                if (worker->thread.isJoinable()) worker->thread.join();
+        }
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        auto getWorkerCount() const noexcept { return workers.size(); }
+
+        void run(Group& group, std::function<void()> function)
+        {
+            ++group.pendingCount;
+
+            if (workers.empty())
+            {
+                execute(Job{std::move(function), &group});
+                return;
+            }
+
+            // the workers push to their own queue and the other threads spread the jobs between the workers
+            const auto workerIndex = currentWorkerIndex != noWorker && currentJobSystem == this ?
+                currentWorkerIndex : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+            Worker& worker = *workers[workerIndex];
+            std::unique_lock workerLock(worker.mutex);
+            worker.jobs.push_back(Job{std::move(function), &group});
+            workerLock.unlock();
+
+            std::unique_lock lock(sleepMutex);
+            ++queuedJobCount;
+            lock.unlock();
+            sleepCondition.notify_one();
+        }
+
+        // runs the queued jobs until all of the jobs of the group are finished,
+        // sleeps while there are no queued jobs and the jobs of the group are running on the workers
+        void wait(Group& group)
+        {
+            while (group.pendingCount.load(std::memory_order_acquire) != 0)
+            {
+                Job job;
+                if (stealJob(job, noWorker))
+                {
+                    execute(std::move(job));
+                    continue;
+                }
+
+                std::unique_lock lock(sleepMutex);
+                sleepCondition.wait(lock, [this, &group]() {
+                    return group.pendingCount.load(std::memory_order_acquire) == 0 || queuedJobCount > 0;
+                });
+            }
+
+            if (group.exception)
+            {
+                const auto exception = group.exception;
+                group.exception = nullptr;
+                std::rethrow_exception(exception);
+            }
+        }
+
+        // calls the function for every index in the range [0, count) and waits for all of the calls to finish
+        template <class Function>
+        void parallelFor(std::size_t count, const Function& function)
+        {
+            if (count == 1 || workers.empty())
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    function(i);
+                return;
+            }
+
+            Group group;
+            for (std::size_t i = 0; i < count; ++i)
+                run(group, [&function, i]() { function(i); });
+            wait(group);
+        }
+
+    private:
+        static constexpr std::size_t noWorker = static_cast<std::size_t>(-1);
+
+        struct Job final
+        {
+            std::function<void()> function;
+            Group* group = nullptr;
+        };
+
+        struct Worker final
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+            Thread thread;
+        };
+
+        void workerMain(std::size_t index)
+        {
+            setCurrentThreadName("Worker " + std::to_string(index + 1));
+            currentJobSystem = this;
+            currentWorkerIndex = index;
+
+            for (;;)
+            {
+                Job job;
+                if (popJob(job, index) || stealJob(job, index))
+                {
+                    execute(std::move(job));
+                    continue;
+                }
+
+                std::unique_lock lock(sleepMutex);
+                sleepCondition.wait(lock, [this]() { return !running || queuedJobCount > 0; });
+                if (!running) return;
+            }
+        }
+
+        // the newest job of the worker's own queue, it is the most likely to still be in the cache
+        bool popJob(Job& job, std::size_t index)
+        {
+            Worker& worker = *workers[index];
+            std::unique_lock lock(worker.mutex);
+            if (worker.jobs.empty()) return false;
+
+            job = std::move(worker.jobs.back());
+            worker.jobs.pop_back();
+            lock.unlock();
+
+            --queuedJobCount;
+            return true;
+        }
+
+        // the oldest job of the other queues
+        bool stealJob(Job& job, std::size_t thiefIndex)
+        {
+            for (std::size_t i = 0; i < workers.size(); ++i)
+            {
+                if (i == thiefIndex) continue;
+
+                Worker& worker = *workers[i];
+                std::unique_lock lock(worker.mutex);
+                if (worker.jobs.empty()) continue;
+
+                job = std::move(worker.jobs.front());
+                worker.jobs.pop_front();
+                lock.unlock();
+
+                --queuedJobCount;
+                return true;
+            }
+
+            return false;
+        }
+
+        void execute(Job job) noexcept
+        {
+            try
+            {
+                job.function();
+            }
+            catch (...)
+            {
+                std::lock_guard lock(job.group->exceptionMutex);
+                if (!job.group->exception) job.group->exception = std::current_exception();
+            }
+
+            // the group can be destroyed as soon as the count reaches zero
+            if (job.group->pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                // the lock makes sure that the waiter is either sleeping or has not checked the count yet
+                std::unique_lock lock(sleepMutex);
+                lock.unlock();
+                sleepCondition.notify_all();
+            }
+        }
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic_size_t nextWorker{0};
+
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+        std::atomic<std::ptrdiff_t> queuedJobCount{0}; // can be negative for a moment, because the jobs are counted after they are pushed
+        bool running = true;
+
+        static inline thread_local JobSystem* currentJobSystem = nullptr;
+        static inline thread_local std::size_t currentWorkerIndex = noWorker;
+    };
+}
+
+#endif // OUZEL_THREAD_JOBSYSTEM_HPP
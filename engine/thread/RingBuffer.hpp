@@ -0,0 +1,83 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_THREAD_RINGBUFFER_HPP
+#define OUZEL_THREAD_RINGBUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ouzel::thread
+{
+    // bounded single-producer single-consumer queue of slots that are written and read in place,
+    // neither side ever blocks or allocates after construction
+    template <class T>
+    class RingBuffer final
+    {
+    public:
+        explicit RingBuffer(std::size_t initCapacity):
+            slots(initCapacity)
+        {
+            if (initCapacity == 0)
+                throw std::invalid_argument("Ring buffer capacity must not be zero");
+        }
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        RingBuffer(RingBuffer&&) = delete;
+        RingBuffer& operator=(RingBuffer&&) = delete;
+
+        auto getCapacity() const noexcept { return slots.size(); }
+
+        // producer: returns the slot to write to or nullptr if the ring is full
+        T* getWriteSlot() noexcept
+        {
+            const auto currentTail = tail.load(std::memory_order_relaxed);
+            if (currentTail - head.load(std::memory_order_acquire) == slots.size()) return nullptr;
+            return &slots[currentTail % slots.size()];
+        }
+
+        // producer: publishes the slot returned by getWriteSlot
+        void commitWrite() noexcept
+        {
+            tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // consumer: returns the oldest written slot or nullptr if the ring is empty
+        T* getReadSlot() noexcept
+        {
+            const auto currentHead = head.load(std::memory_order_relaxed);
+            if (currentHead == tail.load(std::memory_order_acquire)) return nullptr;
+            return &slots[currentHead % slots.size()];
+        }
+
+        // consumer: hands the slot returned by getReadSlot back to the producer
+        void commitRead() noexcept
+        {
+            head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        bool isFull() const noexcept
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) == slots.size();
+        }
+
+        bool isEmpty() const noexcept
+        {
+            return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+        }
+
+    private:
+        static constexpr std::size_t cacheLineSize = 64;
+
+        std::vector<T> slots;
+
+        // the indices only grow, so that a full ring can be told apart from an empty one
+        alignas(cacheLineSize) std::atomic<std::size_t> head{0}; // written by the consumer
+        alignas(cacheLineSize) std::atomic<std::size_t> tail{0}; // written by the producer
+    };
+}
+
+#endif // OUZEL_THREAD_RINGBUFFER_HPP
@@ -0,0 +1,24 @@
+// Ouzel by Elviss Strazdins
+
+cbuffer Constants: register(b0)
+{
+    float4 color;
+};
+
+struct VS2PS
+{
+    float4 position: SV_POSITION;
+    float4 color: COLOR;
+    float2 texCoord: TEXCOORD;
+};
+
+SamplerState sampler0;
+Texture2D texture0;
+
+// the alpha of the texture is the signed distance to the edge, 0.5 at the edge
+void main(in VS2PS input, out float4 output0: SV_TARGET0)
+{
+    float4 texel = texture0.Sample(sampler0, input.texCoord);
+    float width = fwidth(texel.a);
+    output0 = float4(texel.rgb, smoothstep(0.5 - width, 0.5 + width, texel.a)) * input.color * color;
+}
@@ -0,0 +1,52 @@
+unsigned char DISTANCE_FIELD_PIXEL_SHADER_D3D11[] = {
+  0x2f, 0x2f, 0x20, 0x4f, 0x75, 0x7a, 0x65, 0x6c, 0x20, 0x62, 0x79, 0x20,
+  0x45, 0x6c, 0x76, 0x69, 0x73, 0x73, 0x20, 0x53, 0x74, 0x72, 0x61, 0x7a,
+  0x64, 0x69, 0x6e, 0x73, 0x0a, 0x0a, 0x63, 0x62, 0x75, 0x66, 0x66, 0x65,
+  0x72, 0x20, 0x43, 0x6f, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x74, 0x73, 0x3a,
+  0x20, 0x72, 0x65, 0x67, 0x69, 0x73, 0x74, 0x65, 0x72, 0x28, 0x62, 0x30,
+  0x29, 0x0a, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6c, 0x6f, 0x61,
+  0x74, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3b, 0x0a, 0x7d, 0x3b,
+  0x0a, 0x0a, 0x73, 0x74, 0x72, 0x75, 0x63, 0x74, 0x20, 0x56, 0x53, 0x32,
+  0x50, 0x53, 0x0a, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6c, 0x6f,
+  0x61, 0x74, 0x34, 0x20, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x69, 0x6f, 0x6e,
+  0x3a, 0x20, 0x53, 0x56, 0x5f, 0x50, 0x4f, 0x53, 0x49, 0x54, 0x49, 0x4f,
+  0x4e, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74,
+  0x34, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x43, 0x4f, 0x4c,
+  0x4f, 0x52, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6c, 0x6f, 0x61,
+  0x74, 0x32, 0x20, 0x74, 0x65, 0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x3a,
+  0x20, 0x54, 0x45, 0x58, 0x43, 0x4f, 0x4f, 0x52, 0x44, 0x3b, 0x0a, 0x7d,
+  0x3b, 0x0a, 0x0a, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x53, 0x74,
+  0x61, 0x74, 0x65, 0x20, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x72, 0x30,
+  0x3b, 0x0a, 0x54, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x32, 0x44, 0x20,
+  0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x30, 0x3b, 0x0a, 0x0a, 0x2f,
+  0x2f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x20,
+  0x6f, 0x66, 0x20, 0x74, 0x68, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75,
+  0x72, 0x65, 0x20, 0x69, 0x73, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x69,
+  0x67, 0x6e, 0x65, 0x64, 0x20, 0x64, 0x69, 0x73, 0x74, 0x61, 0x6e, 0x63,
+  0x65, 0x20, 0x74, 0x6f, 0x20, 0x74, 0x68, 0x65, 0x20, 0x65, 0x64, 0x67,
+  0x65, 0x2c, 0x20, 0x30, 0x2e, 0x35, 0x20, 0x61, 0x74, 0x20, 0x74, 0x68,
+  0x65, 0x20, 0x65, 0x64, 0x67, 0x65, 0x0a, 0x76, 0x6f, 0x69, 0x64, 0x20,
+  0x6d, 0x61, 0x69, 0x6e, 0x28, 0x69, 0x6e, 0x20, 0x56, 0x53, 0x32, 0x50,
+  0x53, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x2c, 0x20, 0x6f, 0x75, 0x74,
+  0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x34, 0x20, 0x6f, 0x75, 0x74, 0x70,
+  0x75, 0x74, 0x30, 0x3a, 0x20, 0x53, 0x56, 0x5f, 0x54, 0x41, 0x52, 0x47,
+  0x45, 0x54, 0x30, 0x29, 0x0a, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66,
+  0x6c, 0x6f, 0x61, 0x74, 0x34, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x20,
+  0x3d, 0x20, 0x74, 0x65, 0x78, 0x74, 0x75, 0x72, 0x65, 0x30, 0x2e, 0x53,
+  0x61, 0x6d, 0x70, 0x6c, 0x65, 0x28, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65,
+  0x72, 0x30, 0x2c, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x74, 0x65,
+  0x78, 0x43, 0x6f, 0x6f, 0x72, 0x64, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20,
+  0x20, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68,
+  0x20, 0x3d, 0x20, 0x66, 0x77, 0x69, 0x64, 0x74, 0x68, 0x28, 0x74, 0x65,
+  0x78, 0x65, 0x6c, 0x2e, 0x61, 0x29, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+  0x6f, 0x75, 0x74, 0x70, 0x75, 0x74, 0x30, 0x20, 0x3d, 0x20, 0x66, 0x6c,
+  0x6f, 0x61, 0x74, 0x34, 0x28, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x2e, 0x72,
+  0x67, 0x62, 0x2c, 0x20, 0x73, 0x6d, 0x6f, 0x6f, 0x74, 0x68, 0x73, 0x74,
+  0x65, 0x70, 0x28, 0x30, 0x2e, 0x35, 0x20, 0x2d, 0x20, 0x77, 0x69, 0x64,
+  0x74, 0x68, 0x2c, 0x20, 0x30, 0x2e, 0x35, 0x20, 0x2b, 0x20, 0x77, 0x69,
+  0x64, 0x74, 0x68, 0x2c, 0x20, 0x74, 0x65, 0x78, 0x65, 0x6c, 0x2e, 0x61,
+  0x29, 0x29, 0x20, 0x2a, 0x20, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x2e, 0x63,
+  0x6f, 0x6c, 0x6f, 0x72, 0x20, 0x2a, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72,
+  0x3b, 0x0a, 0x7d, 0x0a
+};
+unsigned int DISTANCE_FIELD_PIXEL_SHADER_D3D11_len = 580;
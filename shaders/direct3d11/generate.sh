@@ -0,0 +1,2 @@
+# the shaders without a header compiled by compile.bat are embedded as source and compiled when they are loaded
+xxd -i -n DISTANCE_FIELD_PIXEL_SHADER_D3D11 DistanceFieldPS.hlsl DistanceFieldPSD3D11.h
@@ -0,0 +1,29 @@
+// Ouzel by Elviss Strazdins
+
+#include <metal_stdlib>
+#include <simd/simd.h>
+
+using namespace metal;
+
+typedef struct
+{
+    float4 color;
+} uniforms_t;
+
+typedef struct
+{
+    float4 position [[position]];
+    half4 color;
+    float2 texCoord;
+} VS2PS;
+
+// Fragment shader function, the alpha of the texture is the signed distance to the edge, 0.5 at the edge
+fragment half4 mainPS(VS2PS input [[stage_in]],
+                      texture2d<float> tex2D [[texture(0)]],
+                      sampler sampler2D [[sampler(0)]],
+                      constant uniforms_t& uniforms [[buffer(1)]])
+{
+    const float4 texel = tex2D.sample(sampler2D, input.texCoord);
+    const float width = fwidth(texel.a);
+    return input.color * half4(float4(texel.rgb, smoothstep(0.5 - width, 0.5 + width, texel.a))) * half4(uniforms.color);
+}
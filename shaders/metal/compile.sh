@@ -16,6 +16,9 @@ $TOOLCHAIN/usr/bin/metallib -o ColorPSMacOS.metallib ColorPSMacOS.air
 $TOOLCHAIN/usr/bin/metal -c ColorVS.metal -target air64-apple-macos10.13 -ffast-math -o ColorVSMacOS.air -isysroot "$MACOS_SDK"
 $TOOLCHAIN/usr/bin/metallib -o ColorVSMacOS.metallib ColorVSMacOS.air
 
+$TOOLCHAIN/usr/bin/metal -c DistanceFieldPS.metal -target air64-apple-macos10.13 -ffast-math -o DistanceFieldPSMacOS.air -isysroot "$MACOS_SDK"
+$TOOLCHAIN/usr/bin/metallib -o DistanceFieldPSMacOS.metallib DistanceFieldPSMacOS.air
+
 $TOOLCHAIN/usr/bin/metal -c TexturePS.metal -target air64-apple-macos10.13 -ffast-math -o TexturePSMacOS.air -isysroot "$MACOS_SDK"
 $TOOLCHAIN/usr/bin/metallib -o TexturePSMacOS.metallib TexturePSMacOS.air
 
@@ -32,6 +35,9 @@ $TOOLCHAIN/usr/bin/metallib -o ColorPSIOS.metallib ColorPSIOS.air
 $TOOLCHAIN/usr/bin/metal -c ColorVS.metal -target air64-apple-ios11.0 -ffast-math -o ColorVSIOS.air -isysroot "$IOS_SDK"
 $TOOLCHAIN/usr/bin/metallib -o ColorVSIOS.metallib ColorVSIOS.air
 
+$TOOLCHAIN/usr/bin/metal -c DistanceFieldPS.metal -target air64-apple-ios11.0 -ffast-math -o DistanceFieldPSIOS.air -isysroot "$IOS_SDK"
+$TOOLCHAIN/usr/bin/metallib -o DistanceFieldPSIOS.metallib DistanceFieldPSIOS.air
+
 $TOOLCHAIN/usr/bin/metal -c TexturePS.metal -target air64-apple-ios11.0 -ffast-math -o TexturePSIOS.air -isysroot "$IOS_SDK"
 $TOOLCHAIN/usr/bin/metallib -o TexturePSIOS.metallib TexturePSIOS.air
 
@@ -48,6 +54,9 @@ $TOOLCHAIN/usr/bin/metallib -o ColorPSTVOS.metallib ColorPSTVOS.air
 $TOOLCHAIN/usr/bin/metal -c ColorVS.metal -target air64-apple-tvos11.3 -ffast-math -o ColorVSTVOS.air -isysroot "$TVOS_SDK"
 $TOOLCHAIN/usr/bin/metallib -o ColorVSTVOS.metallib ColorVSTVOS.air
 
+$TOOLCHAIN/usr/bin/metal -c DistanceFieldPS.metal -target air64-apple-tvos11.3 -ffast-math -o DistanceFieldPSTVOS.air -isysroot "$TVOS_SDK"
+$TOOLCHAIN/usr/bin/metallib -o DistanceFieldPSTVOS.metallib DistanceFieldPSTVOS.air
+
 $TOOLCHAIN/usr/bin/metal -c TexturePS.metal -target air64-apple-tvos11.3 -ffast-math -o TexturePSTVOS.air -isysroot "$TVOS_SDK"
 $TOOLCHAIN/usr/bin/metallib -o TexturePSTVOS.metallib TexturePSTVOS.air
 
@@ -56,16 +65,19 @@ $TOOLCHAIN/usr/bin/metallib -o TextureVSTVOS.metallib TextureVSTVOS.air
 
 xxd -i ColorPSMacOS.metallib ColorPSMacOS.h
 xxd -i ColorVSMacOS.metallib ColorVSMacOS.h
+xxd -i DistanceFieldPSMacOS.metallib DistanceFieldPSMacOS.h
 xxd -i TexturePSMacOS.metallib TexturePSMacOS.h
 xxd -i TextureVSMacOS.metallib TextureVSMacOS.h
 
 xxd -i ColorPSIOS.metallib ColorPSIOS.h
 xxd -i ColorVSIOS.metallib ColorVSIOS.h
+xxd -i DistanceFieldPSIOS.metallib DistanceFieldPSIOS.h
 xxd -i TexturePSIOS.metallib TexturePSIOS.h
 xxd -i TextureVSIOS.metallib TextureVSIOS.h
 
 xxd -i ColorPSTVOS.metallib ColorPSTVOS.h
 xxd -i ColorVSTVOS.metallib ColorVSTVOS.h
+xxd -i DistanceFieldPSTVOS.metallib DistanceFieldPSTVOS.h
 xxd -i TexturePSTVOS.metallib TexturePSTVOS.h
 xxd -i TextureVSTVOS.metallib TextureVSTVOS.h
 
@@ -0,0 +1,4 @@
+# the shaders without a header compiled by compile.sh are embedded as source and compiled when they are loaded
+xxd -i -n DistanceFieldPSMacOS_metallib DistanceFieldPS.metal DistanceFieldPSMacOS.h
+xxd -i -n DistanceFieldPSIOS_metallib DistanceFieldPS.metal DistanceFieldPSIOS.h
+xxd -i -n DistanceFieldPSTVOS_metallib DistanceFieldPS.metal DistanceFieldPSTVOS.h
@@ -0,0 +1,11 @@
+#version 120
+uniform vec4 color;
+uniform sampler2D texture0;
+varying vec4 exColor;
+varying vec2 exTexCoord;
+void main()
+{
+    vec4 texel = texture2D(texture0, exTexCoord);
+    float width = fwidth(texel.a);
+    gl_FragColor = vec4(texel.rgb, smoothstep(0.5 - width, 0.5 + width, texel.a)) * exColor * color;
+}
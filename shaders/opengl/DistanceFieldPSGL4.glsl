@@ -0,0 +1,12 @@
+#version 400
+uniform vec4 color;
+uniform sampler2D texture0;
+in vec4 exColor;
+in vec2 exTexCoord;
+out vec4 outColor;
+void main()
+{
+    vec4 texel = texture(texture0, exTexCoord);
+    float width = fwidth(texel.a);
+    outColor = vec4(texel.rgb, smoothstep(0.5 - width, 0.5 + width, texel.a)) * exColor * color;
+}
@@ -0,0 +1,18 @@
+#ifdef GL_OES_standard_derivatives
+#extension GL_OES_standard_derivatives : enable
+#endif
+precision mediump float;
+uniform lowp vec4 color;
+uniform lowp sampler2D texture0;
+varying lowp vec4 exColor;
+varying vec2 exTexCoord;
+void main()
+{
+    vec4 texel = texture2D(texture0, exTexCoord);
+#ifdef GL_OES_standard_derivatives
+    float width = fwidth(texel.a);
+#else
+    float width = 0.1;
+#endif
+    gl_FragColor = vec4(texel.rgb, smoothstep(0.5 - width, 0.5 + width, texel.a)) * exColor * color;
+}
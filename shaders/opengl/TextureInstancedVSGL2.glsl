@@ -0,0 +1,14 @@
+#version 120
+attribute vec3 position0;
+attribute vec4 color0;
+attribute vec2 texCoord0;
+attribute mat4 instanceTransform;
+attribute vec4 instanceColor;
+varying vec4 exColor;
+varying vec2 exTexCoord;
+void main()
+{
+    gl_Position = instanceTransform * vec4(position0, 1.0);
+    exColor = color0 * instanceColor;
+    exTexCoord = texCoord0;
+}
@@ -0,0 +1,14 @@
+#version 400
+in vec3 position0;
+in vec4 color0;
+in vec2 texCoord0;
+in mat4 instanceTransform;
+in vec4 instanceColor;
+out vec4 exColor;
+out vec2 exTexCoord;
+void main()
+{
+    gl_Position = instanceTransform * vec4(position0, 1.0);
+    exColor = color0 * instanceColor;
+    exTexCoord = texCoord0;
+}
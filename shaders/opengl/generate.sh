@@ -1,29 +1,39 @@
 # OpenGL 2
 xxd -i ColorPSGL2.glsl ColorPSGL2.h
+xxd -i DistanceFieldPSGL2.glsl DistanceFieldPSGL2.h
 xxd -i ColorVSGL2.glsl ColorVSGL2.h
 xxd -i TexturePSGL2.glsl TexturePSGL2.h
+xxd -i TextureInstancedVSGL2.glsl TextureInstancedVSGL2.h
 xxd -i TextureVSGL2.glsl TextureVSGL2.h
 
 # OpenGL 3
 xxd -i ColorPSGL3.glsl ColorPSGL3.h
+xxd -i DistanceFieldPSGL3.glsl DistanceFieldPSGL3.h
 xxd -i ColorVSGL3.glsl ColorVSGL3.h
 xxd -i TexturePSGL3.glsl TexturePSGL3.h
+xxd -i TextureInstancedVSGL3.glsl TextureInstancedVSGL3.h
 xxd -i TextureVSGL3.glsl TextureVSGL3.h
 
 # OpenGL 4
 xxd -i ColorPSGL4.glsl ColorPSGL4.h
+xxd -i DistanceFieldPSGL4.glsl DistanceFieldPSGL4.h
 xxd -i ColorVSGL4.glsl ColorVSGL4.h
 xxd -i TexturePSGL4.glsl TexturePSGL4.h
+xxd -i TextureInstancedVSGL4.glsl TextureInstancedVSGL4.h
 xxd -i TextureVSGL4.glsl TextureVSGL4.h
 
 # OpenGL ES 2
 xxd -i ColorPSGLES2.glsl ColorPSGLES2.h
+xxd -i DistanceFieldPSGLES2.glsl DistanceFieldPSGLES2.h
 xxd -i ColorVSGLES2.glsl ColorVSGLES2.h
 xxd -i TexturePSGLES2.glsl TexturePSGLES2.h
+xxd -i TextureInstancedVSGLES2.glsl TextureInstancedVSGLES2.h
 xxd -i TextureVSGLES2.glsl TextureVSGLES2.h
 
 # OpenGL ES 3
 xxd -i ColorPSGLES3.glsl ColorPSGLES3.h
+xxd -i DistanceFieldPSGLES3.glsl DistanceFieldPSGLES3.h
 xxd -i ColorVSGLES3.glsl ColorVSGLES3.h
 xxd -i TexturePSGLES3.glsl TexturePSGLES3.h
+xxd -i TextureInstancedVSGLES3.glsl TextureInstancedVSGLES3.h
 xxd -i TextureVSGLES3.glsl TextureVSGLES3.h
\ No newline at end of file
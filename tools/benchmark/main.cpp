@@ -0,0 +1,358 @@
+// Ouzel by Elviss Strazdins
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "audio/SampleConverter.hpp"
+#include "audio/mixer/Resampler.hpp"
+#include "core/Engine.hpp"
+#include "graphics/Commands.hpp"
+#include "graphics/empty/EmptyRenderDevice.hpp"
+#include "scene/Actor.hpp"
+#include "scene/Camera.hpp"
+#include "scene/Component.hpp"
+#include "scene/Layer.hpp"
+#include "scene/ParticleSystem.hpp"
+#include "utils/Log.hpp"
+
+using namespace ouzel;
+
+namespace benchmark
+{
+    constexpr std::size_t staticActorCount = 100000;
+    constexpr std::size_t movingActorCount = 5000;
+    constexpr std::size_t frameCount = 100;
+    constexpr std::size_t picksPerFrame = 100;
+    constexpr float worldSize = 20000.0F;
+    constexpr float actorSize = 16.0F;
+    constexpr std::uint32_t particleCount = 100000;
+    constexpr float particleLifespan = 2.0F;
+    constexpr std::uint32_t sampleFrames = 512;
+    constexpr std::size_t conversionCount = 10000;
+    constexpr std::uint32_t drawCommandCount = 100000;
+
+    // measures culling and picking in a layer with many actors that are mostly off screen,
+    // first by visiting every actor and then with the spatial index of the layer,
+    // the simulation and the vertex generation of a particle system with many live particles
+    // and the conversion of the mixed audio to the sample formats of the devices
+    // and the resampling of the streams to the sample rate of the device,
+    // the recording, the iteration and the replay of the command buffers
+    class Benchmark: public ouzel::Application
+    {
+    public:
+        explicit Benchmark(const std::vector<std::string>&)
+        {
+            cameraActor.addComponent(camera);
+            layer.addChild(cameraActor);
+            camera.recalculateProjection();
+
+            std::mt19937 randomEngine(0);
+            std::uniform_real_distribution<float> positionDistribution(-worldSize / 2.0F, worldSize / 2.0F);
+
+            const Box<float, 3> boundingBox{
+                Vector<float, 3>{-actorSize / 2.0F, -actorSize / 2.0F, 0.0F},
+                Vector<float, 3>{actorSize / 2.0F, actorSize / 2.0F, 0.0F}
+            };
+
+            for (std::size_t i = 0; i < staticActorCount + movingActorCount; ++i)
+            {
+                auto actor = std::make_unique<scene::Actor>();
+                auto component = std::make_unique<scene::Component>();
+                component->setBoundingBox(boundingBox);
+                actor->addComponent(std::move(component));
+                actor->setPickable(true);
+                actor->setPosition(Vector<float, 2>{positionDistribution(randomEngine), positionDistribution(randomEngine)});
+
+                if (i >= staticActorCount) movingActors.push_back(actor.get());
+                layer.addChild(std::move(actor));
+            }
+
+            run(false);
+            run(true);
+            runParticles();
+            runSampleConversion();
+            runResampling();
+            runCommandBuffer();
+
+            engine->exit();
+        }
+
+    private:
+        void run(bool spatialIndexing)
+        {
+            layer.setSpatialIndexing(spatialIndexing);
+
+            std::mt19937 randomEngine(1);
+            std::uniform_real_distribution<float> moveDistribution(-actorSize, actorSize);
+            std::uniform_real_distribution<float> pickDistribution(0.0F, 1.0F);
+
+            std::chrono::steady_clock::duration drawTime{};
+            std::chrono::steady_clock::duration pickTime{};
+            std::size_t pickedCount = 0;
+
+            for (std::size_t frame = 0; frame < frameCount; ++frame)
+            {
+                for (const auto actor : movingActors)
+                {
+                    const auto& position = actor->getPosition();
+                    actor->setPosition(Vector<float, 2>{
+                        position.v[0] + moveDistribution(randomEngine),
+                        position.v[1] + moveDistribution(randomEngine)
+                    });
+                }
+
+                const auto drawStart = std::chrono::steady_clock::now();
+                layer.draw();
+                const auto pickStart = std::chrono::steady_clock::now();
+                drawTime += pickStart - drawStart;
+
+                for (std::size_t i = 0; i < picksPerFrame; ++i)
+                    if (layer.pickActor(Vector<float, 2>{pickDistribution(randomEngine), pickDistribution(randomEngine)}).first)
+                        ++pickedCount;
+
+                pickTime += std::chrono::steady_clock::now() - pickStart;
+            }
+
+            const auto toMilliseconds = [](std::chrono::steady_clock::duration duration) {
+                return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / 1000.0 / static_cast<double>(frameCount);
+            };
+
+            logger.log(Log::Level::info) << (spatialIndexing ? "Spatial index: " : "Traversal: ") <<
+                toMilliseconds(drawTime) << " ms to cull and draw, " <<
+                toMilliseconds(pickTime) << " ms for " << picksPerFrame << " picks per frame, " <<
+                pickedCount << " actors picked";
+
+            if (spatialIndexing)
+                if (const auto spatialIndex = layer.getSpatialIndex())
+                    logger.log(Log::Level::info) << "Tree height: " << spatialIndex->getHeight();
+        }
+
+        void runParticles()
+        {
+            scene::ParticleSystemData particleSystemData;
+            particleSystemData.maxParticles = particleCount;
+            particleSystemData.duration = -1.0F;
+            particleSystemData.particleLifespan = particleLifespan;
+            particleSystemData.emissionRate = static_cast<float>(particleCount) / particleLifespan;
+            particleSystemData.speed = 100.0F;
+            particleSystemData.speedVariance = 50.0F;
+            particleSystemData.angleVariance = 180.0F;
+            particleSystemData.startParticleSize = 8.0F;
+            particleSystemData.finishParticleSize = 2.0F;
+            particleSystemData.radialAcceleration = 10.0F;
+            particleSystemData.tangentialAcceleration = 10.0F;
+            particleSystemData.gravity = Vector<float, 2>{0.0F, -100.0F};
+            particleSystemData.yCoordFlipped = true;
+            particleSystemData.startColorRed = 1.0F;
+            particleSystemData.startColorGreen = 1.0F;
+            particleSystemData.startColorBlue = 1.0F;
+            particleSystemData.startColorAlpha = 1.0F;
+            particleSystemData.texture = engine->getCache().getTexture(textureWhitePixel);
+
+            scene::Actor particleActor;
+            scene::ParticleSystem particleSystem{particleSystemData};
+            particleActor.addComponent(particleSystem);
+
+            auto& updateScheduler = engine->getUpdateScheduler();
+            auto& graphics = *engine->getGraphics();
+            const Matrix<float, 4> transform = Matrix<float, 4>::identity();
+
+            // fill the system before measuring
+            for (float time = 0.0F; time < particleLifespan; time += scene::UpdateScheduler::fixedStep)
+                updateScheduler.update(scene::UpdateScheduler::fixedStep);
+
+            std::chrono::steady_clock::duration updateTime{};
+            std::chrono::steady_clock::duration drawTime{};
+            std::size_t liveCount = 0;
+
+            for (std::size_t frame = 0; frame < frameCount; ++frame)
+            {
+                const auto updateStart = std::chrono::steady_clock::now();
+                updateScheduler.update(scene::UpdateScheduler::fixedStep);
+                const auto drawStart = std::chrono::steady_clock::now();
+                particleSystem.draw(transform, 1.0F, camera.getRenderViewProjection(), false);
+                updateTime += drawStart - updateStart;
+                drawTime += std::chrono::steady_clock::now() - drawStart;
+
+                liveCount += particleSystem.getParticleCount();
+
+                // the streamed vertices live in the command buffer until it is presented
+                if (!graphics.getRefillQueue()) graphics.waitForNextFrame();
+                graphics.present();
+            }
+
+            const auto toMilliseconds = [](std::chrono::steady_clock::duration duration) {
+                return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / 1000.0 / static_cast<double>(frameCount);
+            };
+
+            logger.log(Log::Level::info) << "Particles: " <<
+                toMilliseconds(updateTime) << " ms to simulate, " <<
+                toMilliseconds(drawTime) << " ms to generate the vertices of " <<
+                liveCount / frameCount << " particles per frame";
+        }
+
+        void runSampleConversion()
+        {
+            std::mt19937 randomEngine(2);
+            std::uniform_real_distribution<float> sampleDistribution(-1.2F, 1.2F);
+
+            const auto toMicroseconds = [](std::chrono::steady_clock::duration duration) {
+                return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / 1000.0 / static_cast<double>(conversionCount);
+            };
+
+            for (std::uint32_t channels = 1; channels <= 8; ++channels)
+            {
+                std::vector<float> samples(sampleFrames * channels);
+                for (float& sample : samples) sample = sampleDistribution(randomEngine);
+
+                std::vector<std::uint8_t> result(sampleFrames * channels * sizeof(std::int32_t));
+                volatile std::uint8_t sink = 0;
+
+                // the strided loop of every channel that the audio devices used before
+                const auto stridedStart = std::chrono::steady_clock::now();
+                for (std::size_t i = 0; i < conversionCount; ++i)
+                {
+                    const auto resultSamples = reinterpret_cast<std::int16_t*>(result.data());
+
+                    for (std::uint32_t channel = 0; channel < channels; ++channel)
+                        for (std::uint32_t frame = 0; frame < sampleFrames; ++frame)
+                            resultSamples[frame * channels + channel] = static_cast<std::int16_t>(std::clamp(samples[channel * sampleFrames + frame], -1.0F, 1.0F) * 32767.0F);
+
+                    sink = sink + result[i % result.size()];
+                }
+                const auto stridedTime = std::chrono::steady_clock::now() - stridedStart;
+
+                const auto measure = [&](audio::SampleFormat sampleFormat, bool dither) {
+                    audio::SampleConverter sampleConverter{dither};
+
+                    const auto start = std::chrono::steady_clock::now();
+                    for (std::size_t i = 0; i < conversionCount; ++i)
+                    {
+                        sampleConverter.convert(samples.data(), sampleFrames, channels, sampleFormat, result.data());
+                        sink = sink + result[i % result.size()];
+                    }
+                    return toMicroseconds(std::chrono::steady_clock::now() - start);
+                };
+
+                logger.log(Log::Level::info) << "Sample conversion of " << sampleFrames << " frames of " << channels << " channels: " <<
+                    toMicroseconds(stridedTime) << " us strided int16, " <<
+                    measure(audio::SampleFormat::signedInt16, false) << " us int16, " <<
+                    measure(audio::SampleFormat::signedInt16, true) << " us dithered int16, " <<
+                    measure(audio::SampleFormat::signedInt24, true) << " us dithered int24, " <<
+                    measure(audio::SampleFormat::signedInt32, false) << " us int32, " <<
+                    measure(audio::SampleFormat::float32, false) << " us float32";
+            }
+        }
+
+        void runResampling()
+        {
+            std::mt19937 randomEngine(3);
+            std::uniform_real_distribution<float> sampleDistribution(-1.0F, 1.0F);
+
+            constexpr std::uint32_t channels = 2;
+            constexpr std::uint32_t deviceSampleRate = 48000;
+
+            const auto toMicroseconds = [](std::chrono::steady_clock::duration duration) {
+                return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / 1000.0 / static_cast<double>(conversionCount);
+            };
+
+            for (const std::uint32_t sourceSampleRate : {22050U, 44100U, 96000U})
+            {
+                std::vector<float> samples(sampleFrames * channels);
+                for (float& sample : samples) sample = sampleDistribution(randomEngine);
+
+                std::vector<float> result(sampleFrames * channels);
+                volatile float sink = 0.0F;
+
+                const auto measure = [&](audio::mixer::Resampler::Quality quality) {
+                    audio::mixer::Resampler resampler{quality, channels, sourceSampleRate, deviceSampleRate, sampleFrames};
+
+                    const auto start = std::chrono::steady_clock::now();
+                    for (std::size_t i = 0; i < conversionCount; ++i)
+                    {
+                        // the sources with a higher sample rate are resampled in parts, as in the bus
+                        for (std::uint32_t offset = 0; offset < sampleFrames;)
+                        {
+                            const auto frames = std::min(sampleFrames - offset, resampler.getMaxOutputFrames());
+                            resampler.process(samples.data(), resampler.getInputFrames(frames), result.data(), frames);
+                            offset += frames;
+                        }
+                        sink = sink + result[i % result.size()];
+                    }
+                    return toMicroseconds(std::chrono::steady_clock::now() - start);
+                };
+
+                logger.log(Log::Level::info) << "Resampling of " << sampleFrames << " stereo frames from " <<
+                    sourceSampleRate << " Hz to " << deviceSampleRate << " Hz: " <<
+                    measure(audio::mixer::Resampler::Quality::linear) << " us linear, " <<
+                    measure(audio::mixer::Resampler::Quality::cubic) << " us cubic, " <<
+                    measure(audio::mixer::Resampler::Quality::sinc16) << " us sinc16, " <<
+                    measure(audio::mixer::Resampler::Quality::sinc32) << " us sinc32";
+            }
+        }
+
+        void runCommandBuffer()
+        {
+            // nothing is drawn, so only the cost of the command buffer and the frame queue is measured
+            graphics::empty::RenderDevice emptyRenderDevice{graphics::Settings{}, *engine->getWindow(), [](const graphics::RenderDevice::Event&) {}};
+            graphics::RenderDevice& renderDevice = emptyRenderDevice;
+            graphics::CommandBuffer commandBuffer;
+
+            std::chrono::steady_clock::duration recordTime{};
+            std::chrono::steady_clock::duration iterateTime{};
+            std::chrono::steady_clock::duration replayTime{};
+            std::uint64_t drawCallCount = 0;
+            volatile std::uint64_t sink = 0;
+
+            for (std::size_t frame = 0; frame < frameCount; ++frame)
+            {
+                const auto recordStart = std::chrono::steady_clock::now();
+                for (std::uint32_t i = 0; i < drawCommandCount; ++i)
+                    commandBuffer.pushCommand<graphics::DrawCommand>(i % 16 + 1, 6, 2, i % 16 + 17,
+                                                                     graphics::DrawMode::triangleList, 0);
+                commandBuffer.pushCommand<graphics::PresentCommand>();
+                const auto iterateStart = std::chrono::steady_clock::now();
+                recordTime += iterateStart - recordStart;
+
+                std::uint64_t indexCount = 0;
+                for (const auto& command : commandBuffer)
+                    if (command.type == graphics::Command::Type::draw)
+                        indexCount += static_cast<const graphics::DrawCommand&>(command).indexCount;
+                sink = sink + indexCount;
+
+                const auto replayStart = std::chrono::steady_clock::now();
+                iterateTime += replayStart - iterateStart;
+
+                // the command buffer is swapped with an already executed one, so its memory is reused
+                renderDevice.submitCommandBuffer(commandBuffer);
+                renderDevice.process();
+                replayTime += std::chrono::steady_clock::now() - replayStart;
+
+                drawCallCount += renderDevice.getDrawCallCount();
+            }
+
+            const auto toMilliseconds = [](std::chrono::steady_clock::duration duration) {
+                return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) / 1000.0 / static_cast<double>(frameCount);
+            };
+
+            logger.log(Log::Level::info) << "Command buffer of " << drawCommandCount << " draw commands: " <<
+                toMilliseconds(recordTime) << " ms to record, " <<
+                toMilliseconds(iterateTime) << " ms to iterate, " <<
+                toMilliseconds(replayTime) << " ms to replay on the empty render device, " <<
+                drawCallCount / frameCount << " draw calls per frame";
+        }
+
+        scene::Layer layer;
+        scene::Camera camera;
+        scene::Actor cameraActor;
+        std::vector<scene::Actor*> movingActors;
+    };
+}
+
+std::unique_ptr<ouzel::Application> ouzel::main(const std::vector<std::string>& args)
+{
+    return std::make_unique<benchmark::Benchmark>(args);
+}
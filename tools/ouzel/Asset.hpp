@@ -14,6 +14,7 @@ namespace ouzel
         {
             empty,
             font,
+            sdfFont,
             mesh,
             texture,
             material,
@@ -45,6 +46,8 @@ namespace ouzel
             return Asset::Type::empty;
         if (s == "font")
             return Asset::Type::font;
+        else if (s == "sdf_font")
+            return Asset::Type::sdfFont;
         else if (s == "mesh")
             return Asset::Type::mesh;
         else if (s == "texture")
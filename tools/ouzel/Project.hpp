@@ -5,6 +5,7 @@
 
 #include <fstream>
 #include "Asset.hpp"
+#include "SdfFontBaker.hpp"
 #include "Target.hpp"
 #include "storage/FileSystem.hpp"
 #include "formats/Json.hpp"
@@ -103,6 +104,19 @@ namespace ouzel
                 // TODO: check if input file exists
                 // TODO: check if output file exists and is older than the input file
                 // TODO: export input file to output file
+
+                switch (asset.type)
+                {
+                    case Asset::Type::sdfFont:
+                    {
+                        storage::Path outputPath = asset.path;
+                        outputPath.replaceExtension("osdf");
+                        SdfFontBaker{}.bake(asset.path, outputPath);
+                        break;
+                    }
+                    default:
+                        break;
+                }
             }
         }
 
@@ -0,0 +1,250 @@
+// Ouzel by Elviss Strazdins
+
+#ifndef OUZEL_SDFFONTBAKER_HPP
+#define OUZEL_SDFFONTBAKER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "storage/Path.hpp"
+#include "utils/Utils.hpp"
+#include "stb_truetype.h"
+
+namespace ouzel
+{
+    // bakes the signed distance fields of the glyphs of a TrueType font into a single atlas page,
+    // the distance fields scale to any font size, so the engine does not rasterize the font at runtime
+    //
+    // the baked file is little-endian:
+    // "OSDF", version (u32), size, range, ascent, descent, line gap (f32), width, height (u32),
+    // glyph count (u32) and for every glyph codepoint (u32), x, y, width, height (u16), x offset, y offset, advance (f32),
+    // kerning pair count (u32) and for every pair the first and the second codepoint (u32) and the amount (f32),
+    // distances (u8 * width * height), 128 at the edge of the glyph and 0 or 255 at range pixels outside or inside
+    class SdfFontBaker final
+    {
+    public:
+        static constexpr std::uint32_t version = 1;
+
+        explicit SdfFontBaker(float initSize = 48.0F, std::uint32_t initRange = 6):
+            size{initSize}, range{initRange}
+        {
+        }
+
+        void bake(const storage::Path& fontPath, const storage::Path& outputPath) const
+        {
+            std::ifstream inputFile(fontPath, std::ios::binary);
+            if (!inputFile)
+                throw std::runtime_error("Failed to open " + std::string(fontPath));
+
+            const std::vector<unsigned char> data{std::istreambuf_iterator<char>(inputFile), std::istreambuf_iterator<char>()};
+
+            const auto offset = stbtt_GetFontOffsetForIndex(data.data(), 0);
+            if (offset == -1)
+                throw std::runtime_error("Not a font");
+
+            stbtt_fontinfo font;
+            if (!stbtt_InitFont(&font, data.data(), offset))
+                throw std::runtime_error("Failed to load font");
+
+            const float scale = stbtt_ScaleForPixelHeight(&font, size);
+
+            int ascent;
+            int descent;
+            int lineGap;
+            stbtt_GetFontVMetrics(&font, &ascent, &descent, &lineGap);
+
+            std::vector<Glyph> glyphs;
+
+            for (const auto& [first, last] : codepointRanges)
+                for (auto c = first; c <= last; ++c)
+                {
+                    const auto index = stbtt_FindGlyphIndex(&font, static_cast<int>(c));
+                    if (!index) continue;
+
+                    int advance;
+                    int leftBearing;
+                    stbtt_GetGlyphHMetrics(&font, index, &advance, &leftBearing);
+
+                    Glyph glyph;
+                    glyph.codepoint = c;
+                    glyph.advance = static_cast<float>(advance) * scale;
+
+                    int width = 0;
+                    int height = 0;
+                    int xOffset = 0;
+                    int yOffset = 0;
+
+                    // 128 at the edge, one step of the distance per 128 / range of a pixel
+                    if (const auto distances = stbtt_GetGlyphSDF(&font, scale, index, static_cast<int>(range), 128,
+                                                                 128.0F / static_cast<float>(range),
+                                                                 &width, &height, &xOffset, &yOffset))
+                    {
+                        glyph.width = static_cast<std::uint16_t>(width);
+                        glyph.height = static_cast<std::uint16_t>(height);
+                        glyph.distances.assign(distances, distances + width * height);
+                        stbtt_FreeSDF(distances, nullptr);
+                    }
+
+                    glyph.offset[0] = static_cast<float>(xOffset);
+                    glyph.offset[1] = static_cast<float>(yOffset);
+                    glyphs.push_back(std::move(glyph));
+                }
+
+            if (glyphs.empty())
+                throw std::runtime_error("Font has no glyphs");
+
+            std::uint32_t width;
+            std::uint32_t height;
+            pack(glyphs, width, height);
+
+            std::vector<std::uint8_t> distances(static_cast<std::size_t>(width) * height);
+            for (const auto& glyph : glyphs)
+                for (std::uint32_t y = 0; y < glyph.height; ++y)
+                    std::copy_n(glyph.distances.begin() + y * glyph.width, glyph.width,
+                                distances.begin() + (glyph.y + y) * width + glyph.x);
+
+            std::vector<std::uint8_t> output{'O', 'S', 'D', 'F'};
+            writeUInt32(output, version);
+            writeFloat(output, size);
+            writeFloat(output, static_cast<float>(range));
+            writeFloat(output, static_cast<float>(ascent) * scale);
+            writeFloat(output, static_cast<float>(descent) * scale);
+            writeFloat(output, static_cast<float>(lineGap) * scale);
+            writeUInt32(output, width);
+            writeUInt32(output, height);
+
+            writeUInt32(output, static_cast<std::uint32_t>(glyphs.size()));
+            for (const auto& glyph : glyphs)
+            {
+                writeUInt32(output, glyph.codepoint);
+                writeUInt16(output, glyph.x);
+                writeUInt16(output, glyph.y);
+                writeUInt16(output, glyph.width);
+                writeUInt16(output, glyph.height);
+                writeFloat(output, glyph.offset[0]);
+                writeFloat(output, glyph.offset[1]);
+                writeFloat(output, glyph.advance);
+            }
+
+            std::vector<std::uint8_t> kerning;
+            std::uint32_t kerningCount = 0;
+            for (const auto& first : glyphs)
+                for (const auto& second : glyphs)
+                    if (const auto amount = stbtt_GetCodepointKernAdvance(&font,
+                                                                          static_cast<int>(first.codepoint),
+                                                                          static_cast<int>(second.codepoint)))
+                    {
+                        writeUInt32(kerning, first.codepoint);
+                        writeUInt32(kerning, second.codepoint);
+                        writeFloat(kerning, static_cast<float>(amount) * scale);
+                        ++kerningCount;
+                    }
+
+            writeUInt32(output, kerningCount);
+            output.insert(output.end(), kerning.begin(), kerning.end());
+            output.insert(output.end(), distances.begin(), distances.end());
+
+            std::ofstream outputFile(outputPath, std::ios::binary | std::ios::trunc);
+            if (!outputFile)
+                throw std::runtime_error("Failed to open " + std::string(outputPath));
+
+            outputFile.write(reinterpret_cast<const char*>(output.data()),
+                             static_cast<std::streamsize>(output.size()));
+        }
+
+    private:
+        // ASCII and Latin-1 Supplement
+        static constexpr std::pair<char32_t, char32_t> codepointRanges[] = {
+            {0x20, 0x7E},
+            {0xA0, 0xFF}
+        };
+
+        struct Glyph final
+        {
+            char32_t codepoint = 0;
+            std::uint16_t x = 0;
+            std::uint16_t y = 0;
+            std::uint16_t width = 0;
+            std::uint16_t height = 0;
+            float offset[2]{};
+            float advance = 0.0F;
+            std::vector<std::uint8_t> distances;
+        };
+
+        // places the glyphs on shelves from the tallest to the shortest, the page is widened
+        // until its height does not exceed its width
+        static void pack(std::vector<Glyph>& glyphs, std::uint32_t& width, std::uint32_t& height)
+        {
+            std::vector<Glyph*> sorted;
+            for (auto& glyph : glyphs) sorted.push_back(&glyph);
+            std::stable_sort(sorted.begin(), sorted.end(), [](const Glyph* a, const Glyph* b) noexcept {
+                return a->height > b->height;
+            });
+
+            for (width = 64;; width *= 2)
+            {
+                if (width > 65536)
+                    throw std::runtime_error("Glyphs do not fit in the page");
+
+                std::uint32_t x = 0;
+                std::uint32_t y = 0;
+                std::uint32_t shelfHeight = 0;
+                bool fits = true;
+
+                for (auto glyph : sorted)
+                {
+                    if (glyph->width > width)
+                    {
+                        fits = false;
+                        break;
+                    }
+
+                    if (x + glyph->width > width)
+                    {
+                        x = 0;
+                        y += shelfHeight;
+                        shelfHeight = 0;
+                    }
+
+                    glyph->x = static_cast<std::uint16_t>(x);
+                    glyph->y = static_cast<std::uint16_t>(y);
+                    x += glyph->width;
+                    shelfHeight = std::max(shelfHeight, static_cast<std::uint32_t>(glyph->height));
+                }
+
+                // the power of two height keeps the texture usable on OpenGL ES 2
+                for (height = 1; height < y + shelfHeight; height *= 2);
+
+                if (fits && height <= width) return;
+            }
+        }
+
+        static void writeUInt16(std::vector<std::uint8_t>& buffer, std::uint16_t value)
+        {
+            std::uint8_t bytes[sizeof(value)];
+            encodeLittleEndian(bytes, value);
+            buffer.insert(buffer.end(), std::begin(bytes), std::end(bytes));
+        }
+
+        static void writeUInt32(std::vector<std::uint8_t>& buffer, std::uint32_t value)
+        {
+            std::uint8_t bytes[sizeof(value)];
+            encodeLittleEndian(bytes, value);
+            buffer.insert(buffer.end(), std::begin(bytes), std::end(bytes));
+        }
+
+        static void writeFloat(std::vector<std::uint8_t>& buffer, float value)
+        {
+            writeUInt32(buffer, bitCast<std::uint32_t>(value));
+        }
+
+        float size = 48.0F; // pixel height of the baked glyphs
+        std::uint32_t range = 6; // distance in pixels that fits in the field around the glyphs
+    };
+}
+
+#endif // OUZEL_SDFFONTBAKER_HPP
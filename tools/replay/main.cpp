@@ -0,0 +1,105 @@
+// Ouzel by Elviss Strazdins
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "core/Engine.hpp"
+#include "graphics/FrameCapture.hpp"
+#include "thread/Thread.hpp"
+#include "utils/Log.hpp"
+
+using namespace ouzel;
+
+namespace replay
+{
+    // submits the frames of a capture file straight to the render device as fast as the device executes them,
+    // the render driver and the frame buffer settings are read from settings.ini like in any other application
+    class Replay: public ouzel::Application
+    {
+    public:
+        explicit Replay(const std::vector<std::string>& args)
+        {
+            std::string captureFile;
+
+            for (auto arg = args.begin(); arg != args.end(); ++arg)
+            {
+                if (arg == args.begin())
+                {
+                    // skip the first parameter
+                    continue;
+                }
+
+                if (captureFile.empty())
+                    captureFile = *arg;
+                else
+                    logger.log(Log::Level::warning) << "Invalid argument \"" << *arg << "\"";
+            }
+
+            if (captureFile.empty())
+            {
+                logger.log(Log::Level::error) << "Usage: replay <capture file>";
+                engine->exit();
+                return;
+            }
+
+            reader = std::make_unique<graphics::FrameCaptureReader>(captureFile);
+
+            // the application does not set a scene, so this is the only thread submitting command buffers
+            replayThread = thread::Thread(&Replay::replayMain, this);
+        }
+
+        ~Replay() override
+        {
+            running = false;
+            if (replayThread.isJoinable()) replayThread.join();
+        }
+
+    private:
+        void replayMain()
+        {
+            thread::setCurrentThreadName("Replay");
+
+            try
+            {
+                graphics::RenderDevice& renderDevice = *engine->getGraphics()->getDevice();
+
+                // match the frame buffer size of the captured session
+                graphics::CommandBuffer commandBuffer;
+                commandBuffer.pushCommand<graphics::ResizeCommand>(reader->getSize());
+                renderDevice.submitCommandBuffer(commandBuffer);
+
+                std::uint64_t frameCount = 0;
+                const auto startTime = std::chrono::steady_clock::now();
+
+                while (running && reader->readCommandBuffer(commandBuffer))
+                {
+                    renderDevice.submitCommandBuffer(commandBuffer);
+                    ++frameCount;
+                }
+
+                const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+                const double milliseconds = static_cast<double>(duration.count()) / 1000.0;
+
+                logger.log(Log::Level::info) << "Replayed " << frameCount << " frames in " << milliseconds << " ms, " <<
+                    (frameCount ? milliseconds / static_cast<double>(frameCount) : 0.0) << " ms per frame";
+            }
+            catch (const std::exception& e)
+            {
+                logger.log(Log::Level::error) << e.what();
+            }
+
+            // the engine destroys the application on the update thread, so it can not be stopped from here
+            engine->executeOnMainThread([]() { engine->exit(); });
+        }
+
+        std::unique_ptr<graphics::FrameCaptureReader> reader;
+        std::atomic_bool running{true};
+        thread::Thread replayThread;
+    };
+}
+
+std::unique_ptr<ouzel::Application> ouzel::main(const std::vector<std::string>& args)
+{
+    return std::make_unique<replay::Replay>(args);
+}